@@ -21,36 +21,49 @@
 #define ENGINE_UNIT_TESTS_AUTOMATION                    1
 #define ENGINE_UNIT_TESTS_AUTOMATION_CURVE_LIST         1
 #define ENGINE_UNIT_TESTS_AUX_SEND                      1
+#define ENGINE_UNIT_TESTS_BIQUAD_CASCADE                1
+#define ENGINE_UNIT_TESTS_CLIP_EFFECTS                  1
 #define ENGINE_UNIT_TESTS_CLIPBOARD                     1
 #define ENGINE_UNIT_TESTS_CLIPSLOT                      1
 #define ENGINE_UNIT_TESTS_CONSTRAINED_CACHED_VALUE      1
+#define ENGINE_UNIT_TESTS_CONVOLUTION                   1
 #define ENGINE_UNIT_TESTS_DELAY_PLUGIN                  1
 #define ENGINE_UNIT_TESTS_EDIT                          1
 #define ENGINE_UNIT_TESTS_EDITCLIP                      1
 #define ENGINE_UNIT_TESTS_EDIT_LOADER                   1
 #define ENGINE_UNIT_TESTS_EDIT_TIME                     1
+#define ENGINE_UNIT_TESTS_ENGINE                        1
+#define ENGINE_UNIT_TESTS_EXTERNAL_CONTROLLER           1
 #define ENGINE_UNIT_TESTS_FREEZE                        1
 #define ENGINE_UNIT_TESTS_FOLLOW_ACTIONS                1
+#define ENGINE_UNIT_TESTS_FOUR_OSC                      1
 #define ENGINE_UNIT_TESTS_LATENCY                       1
 #define ENGINE_UNIT_TESTS_LAUNCH_HANDLE                 1
 #define ENGINE_UNIT_TESTS_LAUNCHER_CLIP_PLAYBACK_HANDLE 1
 #define ENGINE_UNIT_TESTS_LAUNCH_QUANTISATION           1
+#define ENGINE_UNIT_TESTS_LEVEL_MEASURER                1
 #define ENGINE_UNIT_TESTS_LOOPINGMIDINODE               1
 #define ENGINE_UNIT_TESTS_LOOP_INFO                     1
 #define ENGINE_UNIT_TESTS_MIDILIST                      1
+#define ENGINE_UNIT_TESTS_MIDI_INPUT_RING               1
 #define ENGINE_UNIT_TESTS_MODIFIERS                     1
 #define ENGINE_UNIT_TESTS_PAN_LAW                       1
 #define ENGINE_UNIT_TESTS_PLAYBACK                      1
 #define ENGINE_UNIT_TESTS_PLUGINS                       1
 #define ENGINE_UNIT_TESTS_PDC                           1
+#define ENGINE_UNIT_TESTS_PEAK_PYRAMID                  1
+#define ENGINE_UNIT_TESTS_PROJECT_SEARCH_INDEX          1
 #define ENGINE_UNIT_TESTS_RACKINSTANCE                  1
 #define ENGINE_UNIT_TESTS_RECORDING                     1
 #define ENGINE_UNIT_TESTS_RENDERING                     1
+#define ENGINE_UNIT_TESTS_RENDER_CACHE                  1
 #define ENGINE_UNIT_TESTS_TIMESTRETCHER                 1
+#define ENGINE_UNIT_TESTS_UNDO_DELTA                    1
 #define ENGINE_UNIT_TESTS_CLIPS                         1
 #define ENGINE_UNIT_TESTS_SELECTABLE                    1
 #define ENGINE_UNIT_TESTS_AUDIO_FILE                    1
 #define ENGINE_UNIT_TESTS_AUDIO_FILE_CACHE              1
+#define ENGINE_UNIT_TESTS_AUDIO_FILE_ANALYSER           1
 #define ENGINE_UNIT_TESTS_VOLPANPLUGIN                  1
 #define ENGINE_UNIT_TESTS_TEMPO_SEQUENCE                1
 #define ENGINE_UNIT_TESTS_QUANTISATION_TYPE             1
@@ -67,6 +80,7 @@
 
 #define GRAPH_UNIT_TESTS_AUDIOBUFFERPOOL                1
 #define GRAPH_UNIT_TESTS_SEMAPHORE                      1
+#define GRAPH_UNIT_TESTS_THREADS                        1
 #define GRAPH_UNIT_TESTS_ALLOCATION                     1
 
 // Benchmarks
@@ -84,3 +98,4 @@
 #define ENGINE_BENCHMARKS_RACKS                         1
 #define ENGINE_BENCHMARKS_SELECTABLE                    1
 #define ENGINE_BENCHMARKS_PLUGINNODE                    1
+#define ENGINE_BENCHMARKS_EQUALISER                     1
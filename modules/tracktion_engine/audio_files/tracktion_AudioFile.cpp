@@ -239,9 +239,13 @@ juce::ThreadPoolJob::JobStatus AudioProxyGenerator::GeneratorJob::runJob()
     auto& afm = proxy.engine->getAudioFileManager();
     juce::FloatVectorOperations::disableDenormalisedNumberSupport();
     proxy.deleteFile();
+    proxy.getFile().getParentDirectory().createDirectory();
 
     if (render())
+    {
         afm.checkFileForChangesAsync (proxy);
+        proxy.engine->getRenderCache().renderCompleted();
+    }
     else
         proxy.deleteFile();
 
@@ -488,11 +492,18 @@ enum { initialTimerDelay = 10 };
 
 bool SmartThumbnail::enabled = true;
 
+static std::unique_ptr<juce::AudioThumbnailBase> createDefaultThumbnail (Engine& e)
+{
+    if (e.getEngineBehaviour().usePeakPyramidThumbnails())
+        return std::make_unique<PeakPyramidThumbnail> (e);
+
+    return e.getUIBehaviour().createAudioThumbnail (256,
+                                                    e.getAudioFileFormatManager().readFormatManager,
+                                                    e.getAudioFileManager().getAudioThumbnailCache());
+}
+
 SmartThumbnail::SmartThumbnail (Engine& e, const AudioFile& f, juce::Component& componentToRepaint, Edit* ed)
-    : SmartThumbnail (e, f, componentToRepaint, ed,
-                      e.getUIBehaviour().createAudioThumbnail (256,
-                                                               e.getAudioFileFormatManager().readFormatManager,
-                                                               e.getAudioFileManager().getAudioThumbnailCache()))
+    : SmartThumbnail (e, f, componentToRepaint, ed, createDefaultThumbnail (e))
 {
 }
 
@@ -589,6 +600,15 @@ void SmartThumbnail::createThumbnailReader()
 {
     if (enabled)
     {
+        // Peak pyramids only depend on the source audio so can be shared with
+        // the ones written whilst recording and rendering
+        if (auto pyramidThumb = dynamic_cast<PeakPyramidThumbnail*> (thumbnail.get()))
+        {
+            pyramidThumb->setSource (file);
+            thumbnailIsInvalid = false;
+            return;
+        }
+
         // This hashing takes in to account the type of the thumb to avoid clashes if
         // you're using different types for different displays
         // N.B. if this changes, AudioFileManager::callListeners will also need to be updated
@@ -778,7 +798,7 @@ void SmartThumbnail::timerCallback()
 
 //==============================================================================
 AudioFileManager::AudioFileManager (Engine& e)
-    : engine (e), cache (e), thumbnailCache (std::make_unique<TracktionThumbnailCache> (e))
+    : engine (e), cache (e), peakPyramids (e), thumbnailCache (std::make_unique<TracktionThumbnailCache> (e))
 {
 }
 
@@ -914,6 +934,8 @@ void AudioFileManager::callListeners (const AudioFile& file)
         thumbnailCache->removeThumb (static_cast<juce::int64> (hashCode));
     }
 
+    peakPyramids.sourceChanged (file);
+
     const juce::ScopedLock sl (activeThumbnailLock);
 
     for (auto t : activeThumbnails)
@@ -0,0 +1,588 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+// Bump this if any of the analysis changes so old results get replaced
+static constexpr int audioFileAnalysisVersion = 1;
+
+//==============================================================================
+/**
+    Runs all the analysers over the blocks of a file as it's read.
+*/
+struct AudioFileAnalyser::Pass
+{
+    Pass (int numChannelsToUse, double sampleRateToUse)
+        : numChannels (numChannelsToUse), sampleRate (sampleRateToUse),
+          tempoDetect (numChannels, sampleRate)
+    {
+        beatDetect.setSensitivity (0.5);
+        beatDetect.setSampleRate (sampleRate);
+        beatBlock.setSize (numChannels, (int) beatDetect.getBlockSize());
+
+        transientHopLength = std::max (1, juce::roundToInt (sampleRate / 172.0));
+        transientMinSpacing = juce::roundToInt (sampleRate * 0.05);
+        lastSamples.resize ((size_t) numChannels, 0.0f);
+
+        // BS.1770 K-weighting, a high shelf followed by the RLB high-pass
+        numLoudnessChannels = std::min (numChannels, BiquadCascade::maxNumChannels);
+        kWeighting.prepare (numLoudnessChannels, 2);
+
+        {
+            const auto K = std::tan (juce::MathConstants<double>::pi * 1681.974450955533 / sampleRate);
+            const auto Q = 0.7071752369554196;
+            const auto Vh = std::pow (10.0, 3.999843853973347 / 20.0);
+            const auto Vb = std::pow (Vh, 0.4996667741545416);
+            const auto a0 = 1.0 + K / Q + K * K;
+
+            kWeighting.setCoefficients (0, { (float) ((Vh + Vb * K / Q + K * K) / a0),
+                                             (float) (2.0 * (K * K - Vh) / a0),
+                                             (float) ((Vh - Vb * K / Q + K * K) / a0),
+                                             (float) (2.0 * (K * K - 1.0) / a0),
+                                             (float) ((1.0 - K / Q + K * K) / a0) }, false);
+        }
+
+        {
+            const auto K = std::tan (juce::MathConstants<double>::pi * 38.13547087602444 / sampleRate);
+            const auto Q = 0.5003270373238773;
+            const auto a0 = 1.0 + K / Q + K * K;
+
+            kWeighting.setCoefficients (1, { 1.0f, -2.0f, 1.0f,
+                                             (float) (2.0 * (K * K - 1.0) / a0),
+                                             (float) ((1.0 - K / Q + K * K) / a0) }, false);
+        }
+
+        loudnessStepLength = std::max (1, juce::roundToInt (sampleRate * 0.1));
+        silenceWindowLength = std::max (1, juce::roundToInt (sampleRate * 0.01));
+        minSilenceLength = juce::roundToInt (sampleRate * 0.1);
+    }
+
+    void process (juce::AudioBuffer<float>& buffer, int numSamples)
+    {
+        tempoDetect.processSection (buffer.getArrayOfReadPointers(), numSamples);
+
+        // The loudness is measured on a filtered copy
+        loudnessBuffer.setSize (numLoudnessChannels, numSamples, false, false, true);
+
+        for (int c = 0; c < numLoudnessChannels; ++c)
+            loudnessBuffer.copyFrom (c, 0, buffer, c, 0, numSamples);
+
+        kWeighting.process (loudnessBuffer, 0, numSamples);
+
+        auto channels = buffer.getArrayOfReadPointers();
+        auto weightedChannels = loudnessBuffer.getArrayOfReadPointers();
+        auto beatChannels = beatBlock.getArrayOfWritePointers();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float samplePeak = 0.0f;
+            double differenceSquares = 0.0, weightedSquares = 0.0;
+
+            for (int c = 0; c < numChannels; ++c)
+            {
+                const auto x = channels[c][i];
+                const auto difference = (double) (x - lastSamples[(size_t) c]);
+                lastSamples[(size_t) c] = x;
+
+                samplePeak = std::max (samplePeak, std::abs (x));
+                differenceSquares += difference * difference;
+                beatChannels[c][beatBlockPosition] = x;
+            }
+
+            for (int c = 0; c < numLoudnessChannels; ++c)
+                weightedSquares += (double) weightedChannels[c][i] * weightedChannels[c][i];
+
+            peak = std::max (peak, samplePeak);
+
+            if (++beatBlockPosition == beatBlock.getNumSamples())
+            {
+                beatDetect.audioProcess (toBufferView (beatBlock));
+                beatBlockPosition = 0;
+            }
+
+            addTransientSample (differenceSquares);
+            addLoudnessSample (weightedSquares);
+            addSilenceSample (samplePeak);
+            ++position;
+        }
+    }
+
+    AudioFileAnalysis finish()
+    {
+        AudioFileAnalysis analysis;
+        analysis.sampleRate = sampleRate;
+        analysis.lengthInSamples = position;
+        analysis.bpm = std::max (0.0f, tempoDetect.finishAndDetect());
+        analysis.beats = beatDetect.getBeats();
+        analysis.transients = transients;
+        analysis.integratedLoudness = getIntegratedLoudness();
+        analysis.peakDb = juce::Decibels::gainToDecibels (peak);
+
+        endSilence();
+        analysis.silentRanges = silentRanges;
+
+        return analysis;
+    }
+
+private:
+    const int numChannels;
+    const double sampleRate;
+    SampleCount position = 0;
+    float peak = 0.0f;
+
+    TempoDetect tempoDetect;
+
+    BeatDetect beatDetect;
+    juce::AudioBuffer<float> beatBlock;
+    int beatBlockPosition = 0;
+
+    // Transients are rises in the energy of the first difference, which emphasises
+    // the high frequencies of attacks, over ~6ms hops compared to the last ~100ms
+    static constexpr int transientHistoryLength = 20;
+    std::vector<float> lastSamples;
+    int transientHopLength = 0, transientHopPosition = 0, transientMinSpacing = 0;
+    double transientHopEnergy = 0.0, transientHistory[transientHistoryLength] = {};
+    int numTransientHops = 0;
+    juce::Array<SampleCount> transients;
+
+    BiquadCascade kWeighting;
+    juce::AudioBuffer<float> loudnessBuffer;
+    int numLoudnessChannels = 0, loudnessStepLength = 0, loudnessStepPosition = 0;
+    double loudnessStepEnergy = 0.0;
+    std::vector<double> loudnessSteps;
+
+    int silenceWindowLength = 0, silenceWindowPosition = 0, minSilenceLength = 0;
+    float silenceWindowPeak = 0.0f;
+    SampleCount silenceStart = -1;
+    juce::Array<juce::Range<SampleCount>> silentRanges;
+
+    void addTransientSample (double energy)
+    {
+        transientHopEnergy += energy;
+
+        if (++transientHopPosition < transientHopLength)
+            return;
+
+        const auto hopEnergy = transientHopEnergy / transientHopLength;
+        const auto hopStart = position + 1 - transientHopLength;
+        transientHopEnergy = 0.0;
+        transientHopPosition = 0;
+
+        if (numTransientHops >= transientHistoryLength)
+        {
+            double average = 0.0;
+
+            for (auto e : transientHistory)
+                average += e;
+
+            average /= transientHistoryLength;
+
+            if (hopEnergy > 4.0 * average && hopEnergy > 1.0e-5
+                 && (transients.isEmpty() || hopStart - transients.getLast() >= transientMinSpacing))
+                transients.add (hopStart);
+        }
+
+        transientHistory[numTransientHops++ % transientHistoryLength] = hopEnergy;
+    }
+
+    void addLoudnessSample (double weightedSquares)
+    {
+        loudnessStepEnergy += weightedSquares;
+
+        if (++loudnessStepPosition < loudnessStepLength)
+            return;
+
+        loudnessSteps.push_back (loudnessStepEnergy / loudnessStepLength);
+        loudnessStepEnergy = 0.0;
+        loudnessStepPosition = 0;
+    }
+
+    float getIntegratedLoudness() const
+    {
+        // The gating blocks are 400ms long and overlap by 75%
+        std::vector<double> blocks;
+
+        for (size_t i = 3; i < loudnessSteps.size(); ++i)
+            blocks.push_back ((loudnessSteps[i - 3] + loudnessSteps[i - 2] + loudnessSteps[i - 1] + loudnessSteps[i]) / 4.0);
+
+        auto toLoudness = [] (double meanSquare) { return -0.691 + 10.0 * std::log10 (meanSquare); };
+        auto fromLoudness = [] (double lufs) { return std::pow (10.0, (lufs + 0.691) / 10.0); };
+
+        auto getGatedMean = [&blocks] (double threshold)
+        {
+            double total = 0.0;
+            int num = 0;
+
+            for (auto b : blocks)
+            {
+                if (b > threshold)
+                {
+                    total += b;
+                    ++num;
+                }
+            }
+
+            return num > 0 ? total / num : 0.0;
+        };
+
+        const auto absoluteGated = getGatedMean (fromLoudness (-70.0));
+
+        if (absoluteGated <= 0.0)
+            return -100.0f;
+
+        const auto relativeGated = getGatedMean (fromLoudness (toLoudness (absoluteGated) - 10.0));
+
+        if (relativeGated <= 0.0)
+            return -100.0f;
+
+        return (float) std::max (-100.0, toLoudness (relativeGated));
+    }
+
+    void addSilenceSample (float samplePeak)
+    {
+        silenceWindowPeak = std::max (silenceWindowPeak, samplePeak);
+
+        if (++silenceWindowPosition < silenceWindowLength)
+            return;
+
+        const auto windowStart = position + 1 - silenceWindowLength;
+
+        if (silenceWindowPeak < juce::Decibels::decibelsToGain (-60.0f))
+        {
+            if (silenceStart < 0)
+                silenceStart = windowStart;
+        }
+        else
+        {
+            endSilence (windowStart);
+        }
+
+        silenceWindowPeak = 0.0f;
+        silenceWindowPosition = 0;
+    }
+
+    void endSilence()
+    {
+        endSilence (position - silenceWindowPosition);
+    }
+
+    void endSilence (SampleCount end)
+    {
+        if (silenceStart >= 0 && end - silenceStart >= minSilenceLength)
+            silentRanges.add ({ silenceStart, end });
+
+        silenceStart = -1;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Pass)
+};
+
+//==============================================================================
+class AudioFileAnalyser::AnalysisJob  : public ThreadPoolJobWithProgress
+{
+public:
+    AnalysisJob (AudioFileAnalyser& a, int jobIDToUse, const AudioFile& f)
+        : ThreadPoolJobWithProgress (TRANS("Analysing audio")),
+          analyser (a), jobID (jobIDToUse), file (f)
+    {
+    }
+
+    ~AnalysisJob() override
+    {
+        prepareForJobDeletion();
+    }
+
+    JobStatus runJob() override
+    {
+        CRASH_TRACER
+        // This checks the cache first so files that have already been analysed are quick
+        auto analysis = analyser.analyse (file, [this] (float p)
+                                                {
+                                                    progress = p;
+                                                    return ! shouldExit();
+                                                });
+
+        if (shouldExit())
+            return jobHasFinished;
+
+        // The pool owns and deletes this job so the analyser only needs its ID
+        juce::MessageManager::callAsync ([weakAnalyser = juce::WeakReference<AudioFileAnalyser> (&analyser),
+                                          id = jobID, analysis = std::move (analysis)]
+                                         {
+                                             if (auto a = weakAnalyser.get())
+                                                 a->jobFinished (id, std::move (analysis));
+                                         });
+
+        return jobHasFinished;
+    }
+
+    float getCurrentTaskProgress() override     { return progress; }
+    bool canCancel() const override             { return true; }
+
+    AudioFileAnalyser& analyser;
+    const int jobID;
+    const AudioFile file;
+
+private:
+    std::atomic<float> progress { 0.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisJob)
+};
+
+//==============================================================================
+AudioFileAnalyser::AudioFileAnalyser (Engine& e)
+    : engine (e)
+{
+}
+
+AudioFileAnalyser::~AudioFileAnalyser()
+{
+    cancelPendingAnalysis();
+}
+
+static bool isSameSource (const juce::File& source, juce::int64 fileSize, juce::int64 fileTime)
+{
+    return fileSize == source.getSize()
+        && fileTime == source.getLastModificationTime().toMilliseconds();
+}
+
+std::optional<AudioFileAnalysis> AudioFileAnalyser::getCachedAnalysis (const AudioFile& file)
+{
+    if (file.isNull())
+        return {};
+
+    std::optional<CachedResult> cached;
+
+    {
+        const std::scoped_lock sl (resultsMutex);
+
+        if (auto found = results.find (file.getHash()); found != results.end())
+            cached = found->second;
+    }
+
+    // Results for files that have changed since they were analysed are ignored
+    if (cached && isSameSource (file.getFile(), cached->fileSize, cached->fileTime))
+        return cached->analysis;
+
+    if (auto analysis = loadFromCache (file))
+    {
+        addResult (file, *analysis);
+        return analysis;
+    }
+
+    return {};
+}
+
+std::optional<AudioFileAnalysis> AudioFileAnalyser::analyse (const AudioFile& file, std::function<bool (float)> progressCallback)
+{
+    CRASH_TRACER
+
+    if (auto cached = getCachedAnalysis (file))
+        return cached;
+
+    std::unique_ptr<juce::AudioFormatReader> reader (AudioFileUtils::createReaderFor (engine, file.getFile()));
+
+    if (reader == nullptr || reader->numChannels == 0 || reader->sampleRate <= 0.0)
+        return {};
+
+    const auto numChannels = (int) reader->numChannels;
+    const auto numSamples = reader->lengthInSamples;
+    const int blockSize = 65536;
+
+    Pass pass (numChannels, reader->sampleRate);
+    juce::AudioBuffer<float> buffer (numChannels, blockSize);
+    SampleCount startSample = 0;
+
+    while (startSample < numSamples)
+    {
+        if (progressCallback && ! progressCallback ((float) startSample / (float) numSamples))
+            return {};
+
+        auto numThisTime = (int) std::min (numSamples - startSample, (SampleCount) blockSize);
+
+        if (! reader->read (&buffer, 0, numThisTime, startSample, true, true))
+            return {};
+
+        pass.process (buffer, numThisTime);
+        startSample += numThisTime;
+    }
+
+    auto analysis = pass.finish();
+    saveToCache (file, analysis);
+    addResult (file, analysis);
+
+    return analysis;
+}
+
+//==============================================================================
+void AudioFileAnalyser::analyseInBackground (const juce::Array<AudioFile>& files, Callback callback)
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    auto& backgroundJobs = engine.getBackgroundJobs();
+
+    for (auto& file : files)
+    {
+        const auto jobID = ++nextJobID;
+        pendingFiles.emplace (jobID, PendingFile { file, callback });
+        backgroundJobs.addJob (new AnalysisJob (*this, jobID, file), true);
+    }
+}
+
+int AudioFileAnalyser::getNumPendingFiles() const
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    return (int) pendingFiles.size();
+}
+
+void AudioFileAnalyser::cancelPendingAnalysis()
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    pendingFiles.clear();
+
+    // Only the pool knows which jobs are still alive so let it find and delete ours
+    struct ThisAnalysersJobs  : public juce::ThreadPool::JobSelector
+    {
+        ThisAnalysersJobs (AudioFileAnalyser& a) : analyser (a) {}
+
+        bool isJobSuitable (juce::ThreadPoolJob* job) override
+        {
+            if (auto analysisJob = dynamic_cast<AnalysisJob*> (job))
+                return &analysisJob->analyser == &analyser;
+
+            return false;
+        }
+
+        AudioFileAnalyser& analyser;
+    };
+
+    ThisAnalysersJobs selector (*this);
+    engine.getBackgroundJobs().getPool().removeAllJobs (true, 10000, &selector);
+}
+
+void AudioFileAnalyser::jobFinished (int jobID, std::optional<AudioFileAnalysis> analysis)
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+
+    auto found = pendingFiles.find (jobID);
+
+    // Cancelled
+    if (found == pendingFiles.end())
+        return;
+
+    auto pending = std::move (found->second);
+    pendingFiles.erase (found);
+
+    if (analysis && pending.callback)
+        pending.callback (pending.file, *analysis);
+}
+
+//==============================================================================
+void AudioFileAnalyser::clearCache()
+{
+    {
+        const std::scoped_lock sl (resultsMutex);
+        results.clear();
+    }
+
+    engine.getTemporaryFileManager().getAnalysisFolder().deleteRecursively();
+}
+
+void AudioFileAnalyser::addResult (const AudioFile& file, const AudioFileAnalysis& analysis)
+{
+    const auto& source = file.getFile();
+    CachedResult result { source.getSize(), source.getLastModificationTime().toMilliseconds(), analysis };
+
+    const std::scoped_lock sl (resultsMutex);
+    results[file.getHash()] = std::move (result);
+}
+
+juce::File AudioFileAnalyser::getCacheFile (const AudioFile& file) const
+{
+    return engine.getTemporaryFileManager().getAnalysisFolder().getChildFile (file.getHashString() + ".xml");
+}
+
+template<typename ArrayType, typename Fn>
+static juce::String joinValues (const ArrayType& values, Fn&& toString)
+{
+    juce::StringArray s;
+
+    for (auto& v : values)
+        s.add (toString (v));
+
+    return s.joinIntoString (" ");
+}
+
+static juce::StringArray splitValues (const juce::String& s)
+{
+    return juce::StringArray::fromTokens (s, " ", {});
+}
+
+void AudioFileAnalyser::saveToCache (const AudioFile& file, const AudioFileAnalysis& analysis) const
+{
+    const auto& source = file.getFile();
+
+    juce::XmlElement xml ("AUDIOANALYSIS");
+    xml.setAttribute ("version", audioFileAnalysisVersion);
+    xml.setAttribute ("fileSize", juce::String (source.getSize()));
+    xml.setAttribute ("fileTime", juce::String (source.getLastModificationTime().toMilliseconds()));
+    xml.setAttribute ("sampleRate", analysis.sampleRate);
+    xml.setAttribute ("length", juce::String (analysis.lengthInSamples));
+    xml.setAttribute ("bpm", analysis.bpm);
+    xml.setAttribute ("loudness", analysis.integratedLoudness);
+    xml.setAttribute ("peak", analysis.peakDb);
+    xml.setAttribute ("beats", joinValues (analysis.beats, [] (auto b) { return juce::String (b); }));
+    xml.setAttribute ("transients", joinValues (analysis.transients, [] (auto t) { return juce::String (t); }));
+    xml.setAttribute ("silence", joinValues (analysis.silentRanges, [] (auto r) { return juce::String (r.getStart()) + ":" + juce::String (r.getEnd()); }));
+
+    auto cacheFile = getCacheFile (file);
+
+    if (! cacheFile.getParentDirectory().createDirectory())
+        return;
+
+    // Write to a temporary file first in case another process is reading it
+    juce::TemporaryFile temp (cacheFile);
+
+    if (xml.writeTo (temp.getFile()))
+        temp.overwriteTargetFileWithTemporary();
+}
+
+std::optional<AudioFileAnalysis> AudioFileAnalyser::loadFromCache (const AudioFile& file) const
+{
+    const auto& source = file.getFile();
+    auto xml = juce::parseXMLIfTagMatches (getCacheFile (file), "AUDIOANALYSIS");
+
+    if (xml == nullptr
+        || xml->getIntAttribute ("version") != audioFileAnalysisVersion
+        || ! isSameSource (source, xml->getStringAttribute ("fileSize").getLargeIntValue(),
+                           xml->getStringAttribute ("fileTime").getLargeIntValue()))
+        return {};
+
+    AudioFileAnalysis analysis;
+    analysis.sampleRate = xml->getDoubleAttribute ("sampleRate");
+    analysis.lengthInSamples = xml->getStringAttribute ("length").getLargeIntValue();
+    analysis.bpm = (float) xml->getDoubleAttribute ("bpm");
+    analysis.integratedLoudness = (float) xml->getDoubleAttribute ("loudness", -100.0);
+    analysis.peakDb = (float) xml->getDoubleAttribute ("peak", -100.0);
+
+    for (auto& b : splitValues (xml->getStringAttribute ("beats")))
+        analysis.beats.add (b.getLargeIntValue());
+
+    for (auto& t : splitValues (xml->getStringAttribute ("transients")))
+        analysis.transients.add (t.getLargeIntValue());
+
+    for (auto& r : splitValues (xml->getStringAttribute ("silence")))
+        analysis.silentRanges.add ({ r.upToFirstOccurrenceOf (":", false, false).getLargeIntValue(),
+                                     r.fromFirstOccurrenceOf (":", false, false).getLargeIntValue() });
+
+    return analysis;
+}
+
+}} // namespace tracktion { inline namespace engine
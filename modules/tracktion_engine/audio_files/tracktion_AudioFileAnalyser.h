@@ -0,0 +1,124 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+/**
+    The results of analysing an audio file with the AudioFileAnalyser.
+    All the positions are in samples from the start of the file.
+*/
+struct AudioFileAnalysis
+{
+    double sampleRate = 0.0;                            ///< The sample rate of the file
+    SampleCount lengthInSamples = 0;                    ///< The length of the file
+
+    float bpm = 0.0f;                                   ///< The tempo TempoDetect found, or 0 if there wasn't one
+    juce::Array<SampleCount> beats;                     ///< The beats BeatDetect found at a sensitivity of 0.5
+    juce::Array<SampleCount> transients;                ///< The onsets of any sharp rises in level
+
+    float integratedLoudness = -100.0f;                 ///< The BS.1770 integrated loudness in LUFS, -100 if it's silent
+    float peakDb = -100.0f;                             ///< The highest sample peak in decibels
+    juce::Array<juce::Range<SampleCount>> silentRanges; ///< Sections of at least 100ms below -60dB
+};
+
+//==============================================================================
+/**
+    Analyses audio files for their tempo, beats, transients, loudness and silent
+    sections in a single pass and caches the results.
+
+    Results are kept in memory and in a folder in the temp directory, keyed by the
+    AudioFile's hash, so a file is only ever analysed again if it's been modified.
+    Batches of files can be analysed on the BackgroundJobManager's threads so large
+    libraries are spread across the available cores.
+
+    You shouldn't need to create one of these, use Engine::getAudioFileAnalyser().
+*/
+class AudioFileAnalyser
+{
+public:
+    //==============================================================================
+    /** Creates an analyser. Use the Engine's rather than creating your own. */
+    AudioFileAnalyser (Engine&);
+
+    /** Destructor. This cancels any background analysis. */
+    ~AudioFileAnalyser();
+
+    //==============================================================================
+    /** Returns the analysis of a file if it's already been done, either in this
+        session or a previous one. This doesn't read the audio so is quick to call.
+    */
+    std::optional<AudioFileAnalysis> getCachedAnalysis (const AudioFile&);
+
+    /** Analyses a file on the calling thread, returning the cached analysis if there is one.
+        The progress callback is called with the proportion done as the file is read,
+        if it returns false the analysis is abandoned.
+        Returns nothing if the file couldn't be read or the analysis was abandoned.
+    */
+    std::optional<AudioFileAnalysis> analyse (const AudioFile&, std::function<bool (float)> progressCallback = {});
+
+    //==============================================================================
+    /** Called on the message thread as each file's analysis completes. */
+    using Callback = std::function<void (const AudioFile&, const AudioFileAnalysis&)>;
+
+    /** Analyses some files on the BackgroundJobManager's threads.
+        The callback is made on the message thread for each file that's read successfully,
+        including those that were already in the cache.
+    */
+    void analyseInBackground (const juce::Array<AudioFile>&, Callback);
+
+    /** Returns the number of files still being analysed in the background. */
+    int getNumPendingFiles() const;
+
+    /** Stops any background analysis that hasn't finished. Their callbacks won't be made. */
+    void cancelPendingAnalysis();
+
+    //==============================================================================
+    /** Removes all the cached results, both in memory and on disk. */
+    void clearCache();
+
+    Engine& engine;
+
+private:
+    //==============================================================================
+    class AnalysisJob;
+    struct Pass;
+
+    struct CachedResult
+    {
+        juce::int64 fileSize = 0, fileTime = 0;
+        AudioFileAnalysis analysis;
+    };
+
+    std::mutex resultsMutex;
+    std::unordered_map<HashCode, CachedResult> results;
+
+    struct PendingFile
+    {
+        AudioFile file;
+        Callback callback;
+    };
+
+    // The jobs themselves are owned by the BackgroundJobManager's pool
+    std::unordered_map<int, PendingFile> pendingFiles;
+    int nextJobID = 0;
+
+    juce::File getCacheFile (const AudioFile&) const;
+    std::optional<AudioFileAnalysis> loadFromCache (const AudioFile&) const;
+    void saveToCache (const AudioFile&, const AudioFileAnalysis&) const;
+    void addResult (const AudioFile&, const AudioFileAnalysis&);
+    void jobFinished (int jobID, std::optional<AudioFileAnalysis>);
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (AudioFileAnalyser)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFileAnalyser)
+};
+
+}} // namespace tracktion { inline namespace engine
@@ -0,0 +1,190 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_AUDIO_FILE_ANALYSER
+
+#include "../utilities/tracktion_TestUtilities.h"
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+//==============================================================================
+class AudioFileAnalyserTests    : public juce::UnitTest
+{
+public:
+    AudioFileAnalyserTests()
+        : juce::UnitTest ("AudioFileAnalyser", "tracktion_engine")
+    {
+    }
+
+    void runTest() override
+    {
+        auto& engine = *Engine::getEngines().getFirst();
+        runAnalysisTests (engine);
+        runBackgroundTests (engine);
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int numSamples = (int) sampleRate;
+
+    // Writes 1s of silence followed by 1s of a -20dB 997Hz sine
+    void writeTestFile (const AudioFile& audioFile)
+    {
+        juce::WavAudioFormat format;
+        const int numChannels = 2;
+
+        AudioFileWriter writer (audioFile, &format, numChannels, sampleRate, 24, {}, 0);
+        expect (writer.isOpen());
+
+        juce::AudioBuffer<float> buffer (numChannels, numSamples * 2);
+        buffer.clear();
+
+        for (int i = 0; i < numSamples; ++i)
+            for (int c = 0; c < numChannels; ++c)
+                buffer.setSample (c, numSamples + i, 0.1f * std::sin (juce::MathConstants<float>::twoPi * 997.0f * (float) i / (float) sampleRate));
+
+        writer.appendBuffer (buffer, buffer.getNumSamples());
+    }
+
+    void runAnalysisTests (Engine& engine)
+    {
+        // Check the silence, transient, peak and loudness
+        // Check it's cached in memory and on disk
+
+        beginTest ("Analysis and caching");
+
+        juce::TemporaryFile tempFile (".wav");
+        AudioFile audioFile (engine, tempFile.getFile());
+        writeTestFile (audioFile);
+
+        auto& analyser = engine.getAudioFileAnalyser();
+        analyser.clearCache();
+        expect (! analyser.getCachedAnalysis (audioFile).has_value());
+
+        auto analysis = analyser.analyse (audioFile);
+        expect (analysis.has_value());
+
+        if (! analysis)
+            return;
+
+        expectEquals (analysis->lengthInSamples, (SampleCount) numSamples * 2);
+        expectEquals (analysis->silentRanges.size(), 1);
+        expect (analysis->silentRanges.getFirst() == juce::Range<SampleCount> (0, numSamples));
+        expectEquals (analysis->transients.size(), 1);
+        expect (std::abs (analysis->transients.getFirst() - numSamples) < 512);
+        expectWithinAbsoluteError (analysis->peakDb, -20.0f, 0.1f);
+
+        // A 0.1 sine in both channels is -20 LUFS but the gating blocks that overlap the
+        // start of it take the integrated loudness down to 10 * log10 (0.85) - 20
+        expectWithinAbsoluteError (analysis->integratedLoudness, -20.7f, 0.2f);
+
+        expect (analyser.getCachedAnalysis (audioFile).has_value());
+
+        {
+            AudioFileAnalyser newAnalyser (engine);
+            auto loaded = newAnalyser.getCachedAnalysis (audioFile);
+            expect (loaded.has_value());
+
+            if (loaded)
+            {
+                expect (loaded->silentRanges == analysis->silentRanges);
+                expect (loaded->transients == analysis->transients);
+                expect (loaded->beats == analysis->beats);
+                expectWithinAbsoluteError (loaded->integratedLoudness, analysis->integratedLoudness, 0.001f);
+            }
+        }
+
+        // Results in memory are ignored once the file has changed, as they are on disk
+        audioFile.getFile().setLastModificationTime (juce::Time::getCurrentTime() + juce::RelativeTime::minutes (1.0));
+        expect (! analyser.getCachedAnalysis (audioFile).has_value());
+
+        expect (analyser.analyse (audioFile).has_value());
+        expect (analyser.getCachedAnalysis (audioFile).has_value());
+
+        analyser.clearCache();
+        expect (! analyser.getCachedAnalysis (audioFile).has_value());
+    }
+
+    void runBackgroundTests (Engine& engine)
+    {
+        auto& analyser = engine.getAudioFileAnalyser();
+        analyser.clearCache();
+
+        juce::TemporaryFile cachedTempFile (".wav"), newTempFile (".wav");
+        const AudioFile cachedFile (engine, cachedTempFile.getFile()), newFile (engine, newTempFile.getFile());
+        writeTestFile (cachedFile);
+        writeTestFile (newFile);
+
+        const auto expected = analyser.analyse (cachedFile);
+        expect (expected.has_value());
+
+        if (! expected)
+            return;
+
+        beginTest ("Background analysis calls back for new and cached files");
+        {
+            std::vector<std::pair<AudioFile, AudioFileAnalysis>> results;
+            std::atomic<bool> finished { false };
+
+            analyser.analyseInBackground ({ cachedFile, newFile },
+                                          [&] (const AudioFile& f, const AudioFileAnalysis& a)
+                                          {
+                                              results.emplace_back (f, a);
+                                              finished = results.size() == 2;
+                                          });
+
+            // Nothing is called back until the jobs have finished
+            expectEquals (analyser.getNumPendingFiles(), 2);
+            expect (results.empty());
+
+            test_utilities::runDispatchLoopUntilTrue (finished);
+            expectEquals (analyser.getNumPendingFiles(), 0);
+            expectEquals ((int) results.size(), 2);
+
+            for (auto& [f, a] : results)
+            {
+                expect (f == cachedFile || f == newFile);
+                expect (a.silentRanges == expected->silentRanges);
+                expect (a.transients == expected->transients);
+                expectWithinAbsoluteError (a.integratedLoudness, expected->integratedLoudness, 0.001f);
+            }
+
+            expect (results[0].first != results[1].first);
+            expect (analyser.getCachedAnalysis (newFile).has_value());
+        }
+
+        beginTest ("Cancelled background analysis doesn't call back");
+        {
+            analyser.clearCache();
+            bool calledBack = false;
+
+            analyser.analyseInBackground ({ cachedFile, newFile },
+                                          [&] (const AudioFile&, const AudioFileAnalysis&) { calledBack = true; });
+            analyser.cancelPendingAnalysis();
+            expectEquals (analyser.getNumPendingFiles(), 0);
+
+            // Cancelling waits for running jobs so any completions they posted arrive before this one's
+            std::atomic<bool> finished { false };
+            analyser.analyseInBackground ({ cachedFile }, [&] (const AudioFile&, const AudioFileAnalysis&) { finished = true; });
+            test_utilities::runDispatchLoopUntilTrue (finished);
+            expect (! calledBack);
+        }
+
+        analyser.clearCache();
+    }
+};
+
+static AudioFileAnalyserTests audioFileAnalyserTests;
+
+}} // namespace tracktion { inline namespace engine
+
+#endif
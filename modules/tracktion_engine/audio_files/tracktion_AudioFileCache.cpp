@@ -21,13 +21,97 @@ FallbackReader::FallbackReader()
 
 //==============================================================================
 //==============================================================================
-static void clearSetOfChannels (int* const* channels, int numChannels, int offset, int numSamples) noexcept
+template<typename SampleType>
+static void clearSetOfChannels (SampleType* const* channels, int numChannels, int offset, int numSamples) noexcept
 {
     for (int i = 0; i < numChannels; ++i)
         if (auto chan = (float*) channels[i])
             juce::FloatVectorOperations::clear (chan + offset, numSamples);
 }
 
+static void convertFixedToFloat (float* const* channels, int numChannels, int offset, int numSamples) noexcept
+{
+    for (int i = 0; i < numChannels; ++i)
+        if (auto chan = channels[i])
+            juce::FloatVectorOperations::convertFixedToFloat (chan + offset, (const int*) chan + offset, 1.0f / 0x7fffffff, numSamples);
+}
+
+//==============================================================================
+namespace mapped_decoding
+{
+    /** Converts interleaved samples straight from a mapped file to float channels. */
+    using DecodeFunction = void (*) (const void* source, int numSourceChannels,
+                                     float* const* dest, int numDestChannels, int destOffset,
+                                     int numSamples);
+
+    template<typename SampleFormat, typename Endianness>
+    static void decode (const void* source, int numSourceChannels,
+                        float* const* dest, int numDestChannels, int destOffset,
+                        int numSamples) noexcept
+    {
+        using SourceType = juce::AudioData::Pointer<SampleFormat, Endianness, juce::AudioData::Interleaved, juce::AudioData::Const>;
+        using DestType = juce::AudioData::Pointer<juce::AudioData::Float32, juce::AudioData::NativeEndian, juce::AudioData::NonInterleaved, juce::AudioData::NonConst>;
+
+        for (int i = 0; i < numDestChannels; ++i)
+        {
+            if (auto destChan = dest[i])
+            {
+                DestType d (destChan + destOffset);
+
+                if (i < numSourceChannels)
+                    d.convertSamples (SourceType (juce::addBytesToPointer (source, i * SourceType::getBytesPerSample()), numSourceChannels), numSamples);
+                else
+                    d.clear (numSamples);
+            }
+        }
+    }
+
+    /** Gives access to the mapped data of any MemoryMappedAudioFormatReader. */
+    struct MappedData  : public juce::MemoryMappedAudioFormatReader
+    {
+        static const void* getPointer (const juce::MemoryMappedAudioFormatReader& r, SampleCount sample) noexcept
+        {
+            return (r.*(&MappedData::sampleToPointer)) (sample);
+        }
+
+        static int getBytesPerFrame (const juce::MemoryMappedAudioFormatReader& r) noexcept
+        {
+            return r.*(&MappedData::bytesPerFrame);
+        }
+    };
+
+    /** Returns a function that can decode the reader's mapped data, or nullptr
+        if it's a layout that has to go via the reader.
+        Only WAV files are decoded directly as other formats can store their
+        samples in ways that aren't visible from the reader.
+    */
+    static DecodeFunction findDecodeFunction (const juce::MemoryMappedAudioFormatReader& r, const juce::AudioFormat* format)
+    {
+        using namespace juce::AudioData;
+
+        if (dynamic_cast<const juce::WavAudioFormat*> (format) == nullptr
+            || MappedData::getBytesPerFrame (r) != (int) (r.numChannels * r.bitsPerSample / 8))
+            return nullptr;
+
+        if (r.usesFloatingPointData)
+        {
+            if (r.bitsPerSample == 32)
+                return decode<Float32, LittleEndian>;
+
+            return nullptr;
+        }
+
+        switch (r.bitsPerSample)
+        {
+            case 8:     return decode<UInt8, LittleEndian>;
+            case 16:    return decode<Int16, LittleEndian>;
+            case 24:    return decode<Int24, LittleEndian>;
+            case 32:    return decode<Int32, LittleEndian>;
+            default:    return nullptr;
+        }
+    }
+}
+
 //==============================================================================
 //==============================================================================
 struct AudioFileCache::ScopedFileRead
@@ -73,11 +157,12 @@ public:
             mapEntireFile = true;
     }
 
-    enum { readAheadSamples = 48000 };
+    enum { readAheadSamples = 48000, prefetchTimeoutMs = 1000 };
 
-    void touchFiles()
+    void touchFiles (int64_t& prefetchBytesRemaining)
     {
         juce::Array<SampleCount> readPoints;
+        juce::Array<SampleRange> prefetchRanges;
         readPoints.ensureStorageAllocated (64);
 
         {
@@ -96,6 +181,9 @@ public:
 
                     readPoints.addIfNotAlreadyThere (std::max (SampleCount(), readPos));
                 }
+
+                if (auto range = getPrefetchRange (*r))
+                    prefetchRanges.addIfNotAlreadyThere (*range);
             }
         }
 
@@ -110,6 +198,21 @@ public:
         for (int distanceAhead = 4096; distanceAhead < 48000; distanceAhead += 8192)
             for (auto pos : readPoints)
                 touchAllReaders ({ pos + distanceAhead, pos + distanceAhead + 8192 });
+
+        // Touching the prefetched ranges on every pass keeps their pages resident
+        // until the playhead gets there, as long as they fit in the budget
+        const auto bytesPerFrame = std::max<int64_t> (1, info.numChannels * info.bitsPerSample / 8);
+
+        for (auto range : prefetchRanges)
+        {
+            const auto numFrames = std::min (range.getLength(), prefetchBytesRemaining / bytesPerFrame);
+
+            if (numFrames <= 0)
+                break;
+
+            touchAllReaders (range.withLength (numFrames));
+            prefetchBytesRemaining -= numFrames * bytesPerFrame;
+        }
     }
 
     void touchAllReaders (SampleRange range) const
@@ -184,6 +287,15 @@ public:
                     const auto loopStart = r->loopStart.load();
                     const auto loopLength = r->loopLength.load();
 
+                    if (auto range = getPrefetchRange (*r))
+                    {
+                        auto start = std::max (0, (int) (range->getStart() / blockSize));
+                        auto end   = std::min (lastPossibleBlockIndex, (int) ((range->getEnd() - 1) / blockSize));
+
+                        for (int i = start; i <= end; ++i)
+                            blocksNeeded.addIfNotAlreadyThere (i);
+                    }
+
                     if (loopLength > 0)
                     {
                         auto loopEnd = loopStart + loopLength;
@@ -290,6 +402,7 @@ public:
             failedToOpenFile = false;
 
             info = AudioFileInfo (file, r.get(), af);
+            decodeFunction = mapped_decoding::findDecodeFunction (*r, af);
             return r.release();
         }
 
@@ -386,7 +499,8 @@ public:
         JUCE_DECLARE_NON_COPYABLE (LockedReaderFinder)
     };
 
-    bool read (SampleCount startSample, int* const* destSamples, int numDestChannels,
+    template<typename SampleType>
+    bool read (SampleCount startSample, SampleType* const* destSamples, int numDestChannels,
                int startOffsetInDestBuffer, int numSamples, int timeoutMs)
     {
         jassert (destSamples != nullptr);
@@ -410,7 +524,10 @@ public:
             {
                 auto numThisTime = int (std::min<int64_t> (numSamples, l.reader->getMappedSection().getEnd() - startSample));
 
-                l.reader->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer, startSample, numThisTime);
+                if constexpr (std::is_same_v<SampleType, float>)
+                    readFloatSamples (*l.reader, destSamples, numDestChannels, startOffsetInDestBuffer, startSample, numThisTime);
+                else
+                    l.reader->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer, startSample, numThisTime);
 
                 startSample += numThisTime;
                 startOffsetInDestBuffer += numThisTime;
@@ -419,6 +536,7 @@ public:
             else
             {
                 allDataRead = false;
+                ++numMisses;
                 clearSetOfChannels (destSamples, numDestChannels, startOffsetInDestBuffer, numSamples);
                 DBG ("*** Cache miss");
                 break;
@@ -484,12 +602,22 @@ public:
         clients.add (r);
     }
 
+    void addPrefetchRanges (std::vector<SampleRange>& ranges) const
+    {
+        const juce::ScopedReadLock sl (clientListLock);
+
+        for (auto r : clients)
+            if (auto range = getPrefetchRange (*r))
+                ranges.push_back (*range);
+    }
+
     AudioFileCache& cache;
     AudioFile file;
     AudioFileInfo info;
 
     std::atomic<uint32_t> lastReadTime { juce::Time::getApproximateMillisecondCounter() };
     std::atomic<int64_t> totalBytesInUse { 0 };
+    std::atomic<int> numMisses { 0 };
 
 private:
     juce::OwnedArray<juce::MemoryMappedAudioFormatReader> readers;
@@ -498,6 +626,7 @@ private:
     juce::CriticalSection blockUpdateLock;
     juce::Array<int> currentBlocks;
 
+    std::atomic<mapped_decoding::DecodeFunction> decodeFunction { nullptr };
     bool mapEntireFile = false;
     std::atomic<bool> failedToOpenFile { false };
     uint32_t lastFailedOpenAttempt = 0;
@@ -505,6 +634,19 @@ private:
 
     juce::ReadWriteLock clientListLock, readerLock;
 
+    std::optional<SampleRange> getPrefetchRange (const Reader& r) const
+    {
+        if (juce::Time::getApproximateMillisecondCounter() > r.prefetchTime + prefetchTimeoutMs)
+            return {};
+
+        auto range = r.getPrefetchRange().getIntersectionWith ({ 0, info.lengthInSamples });
+
+        if (range.isEmpty())
+            return {};
+
+        return range;
+    }
+
     juce::MemoryMappedAudioFormatReader* findReaderFor (SampleCount sample) const
     {
         for (auto r : readers)
@@ -514,6 +656,24 @@ private:
         return {};
     }
 
+    void readFloatSamples (juce::MemoryMappedAudioFormatReader& r,
+                           float* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                           SampleCount startSample, int numSamples)
+    {
+        // Decoding straight from the mapped file avoids the reader's int32 intermediate
+        if (auto decode = decodeFunction.load (std::memory_order_relaxed))
+        {
+            decode (mapped_decoding::MappedData::getPointer (r, startSample), (int) r.numChannels,
+                    destSamples, numDestChannels, startOffsetInDestBuffer, numSamples);
+            return;
+        }
+
+        r.readSamples ((int* const*) destSamples, numDestChannels, startOffsetInDestBuffer, startSample, numSamples);
+
+        if (! r.usesFloatingPointData)
+            convertFixedToFloat (destSamples, numDestChannels, startOffsetInDestBuffer, numSamples);
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedFile)
 };
 
@@ -738,12 +898,13 @@ bool AudioFileCache::serviceNextReader()
 void AudioFileCache::touchReaders()
 {
     int64_t totalBytes = 0;
+    int64_t prefetchBytesRemaining = prefetchBudget;
 
     const juce::ScopedReadLock sl (fileListLock);
 
     for (auto f : activeFiles)
     {
-        f->touchFiles();
+        f->touchFiles (prefetchBytesRemaining);
         totalBytes += f->totalBytesInUse;
     }
 
@@ -760,6 +921,40 @@ bool AudioFileCache::hasCacheMissed (bool clearMissedFlag)
     return didMiss;
 }
 
+std::vector<AudioFileCache::CacheMiss> AudioFileCache::getCacheMisses (bool clearMisses)
+{
+    std::vector<CacheMiss> misses;
+    const juce::ScopedReadLock sl (fileListLock);
+
+    for (auto f : activeFiles)
+    {
+        const auto numMisses = clearMisses ? f->numMisses.exchange (0)
+                                           : f->numMisses.load();
+
+        if (numMisses > 0)
+            misses.push_back ({ f->file, numMisses });
+    }
+
+    return misses;
+}
+
+std::vector<SampleRange> AudioFileCache::getPrefetchRanges (const AudioFile& file)
+{
+    std::vector<SampleRange> ranges;
+    const juce::ScopedReadLock sl (fileListLock);
+
+    for (auto f : activeFiles)
+        if (f->file == file)
+            f->addPrefetchRanges (ranges);
+
+    return ranges;
+}
+
+void AudioFileCache::setPrefetchBudget (int64_t numBytes)
+{
+    prefetchBudget = std::max<int64_t> (0, numBytes);
+}
+
 TimeDuration AudioFileCache::getCpuUsage() const
 {
     return TimeDuration::fromSeconds (lastBlockDurationMs.load (std::memory_order_acquire) / 1000.0);
@@ -867,17 +1062,20 @@ AudioFileCache::Reader::~Reader()
 {
 }
 
-void AudioFileCache::Reader::setReadPosition (SampleCount pos) noexcept
+static SampleCount getPositionInLoop (SampleCount pos, SampleCount loopStart, SampleCount loopLength) noexcept
 {
-    const auto localLoopStart = loopStart.load();
-    const auto localLoopLength = loopLength.load();
-
     if (loopLength == 0)
-        readPos = pos;
-    else if (pos >= 0)
-        readPos = localLoopStart + (pos % localLoopLength);
-    else
-        readPos = localLoopStart + juce::negativeAwareModulo (pos, localLoopLength);
+        return pos;
+
+    if (pos >= 0)
+        return loopStart + (pos % loopLength);
+
+    return loopStart + juce::negativeAwareModulo (pos, loopLength);
+}
+
+void AudioFileCache::Reader::setReadPosition (SampleCount pos) noexcept
+{
+    readPos = getPositionInLoop (pos, loopStart.load(), loopLength.load());
 }
 
 int AudioFileCache::Reader::getNumChannels() const noexcept
@@ -898,6 +1096,21 @@ void AudioFileCache::Reader::setLoopRange (SampleRange newRange)
     loopLength = newRange.getLength();
 }
 
+void AudioFileCache::Reader::prefetch (SampleRange range) noexcept
+{
+    const auto localLoopStart = loopStart.load();
+    const auto localLoopLength = loopLength.load();
+
+    if (localLoopLength > 0)
+        range = SampleRange::withStartAndLength (getPositionInLoop (range.getStart(), localLoopStart, localLoopLength),
+                                                 std::min (range.getLength(), localLoopLength));
+
+    // The range and time are written separately, so this may pair a new range with the
+    // previous time for an instant but the range itself is never torn
+    prefetchRange.store (range);
+    prefetchTime = juce::Time::getApproximateMillisecondCounter();
+}
+
 bool AudioFileCache::Reader::readSamples (int numSamples,
                                           juce::AudioBuffer<float>& destBuffer,
                                           const juce::AudioChannelSet& destBufferChannels,
@@ -914,7 +1127,6 @@ bool AudioFileCache::Reader::readSamples (int numSamples,
         static constexpr int maxNumChannels = 32;
         float* chans[maxNumChannels] = {};
         auto numSourceChans = std::min (maxNumChannels, sourceBufferChannels.size());
-        int highestUsedSourceChan = 0;
 
         for (int destIndex = 0; destIndex < numDestChans; ++destIndex)
         {
@@ -923,28 +1135,13 @@ bool AudioFileCache::Reader::readSamples (int numSamples,
             auto sourceIndex = sourceBufferChannels.getChannelIndexForType (destType);
 
             if (sourceIndex >= 0 && sourceIndex < maxNumChannels)
-            {
                 chans[sourceIndex] = destData;
-                highestUsedSourceChan = std::max (highestUsedSourceChan, sourceIndex);
-            }
             else
-            {
                 juce::FloatVectorOperations::clear (destData, numSamples);
-            }
         }
 
-        if (readSamples ((int**) chans, numSourceChans, 0, numSamples, timeoutMs))
-        {
-            bool isFloatingPoint = (file != nullptr) ? static_cast<CachedFile*> (file)->info.isFloatingPoint
-                                                     : fallbackReader->usesFloatingPointData;
-
-            if (! isFloatingPoint)
-                for (int i = 0; i <= highestUsedSourceChan; ++i)
-                    if (auto chan = chans[i])
-                        juce::FloatVectorOperations::convertFixedToFloat (chan, (const int*) chan, 1.0f / 0x7fffffff, numSamples);
-
+        if (readSamples (chans, numSourceChans, 0, numSamples, timeoutMs))
             return true;
-        }
     }
     else
     {
@@ -982,16 +1179,8 @@ bool AudioFileCache::Reader::readSamples (int numSamples,
                 chans[1] = destBuffer.getWritePointer (0, startOffsetInDestBuffer);
         }
 
-        if (readSamples ((int**) chans, 2, 0, numSamples, timeoutMs))
+        if (readSamples (chans, 2, 0, numSamples, timeoutMs))
         {
-            const bool isFloatingPoint = (file != nullptr) ? static_cast<CachedFile*> (file)->info.isFloatingPoint
-                                                           : fallbackReader->usesFloatingPointData;
-
-            if (! isFloatingPoint)
-                for (int i = 0; i < 2; ++i)
-                    if (auto* chan = chans[i])
-                        juce::FloatVectorOperations::convertFixedToFloat (chan, (const int*) chan, 1.0f / 0x7fffffff, numSamples);
-
             if (dupeChannel)
             {
                 if (chans[0] == nullptr)
@@ -1007,8 +1196,26 @@ bool AudioFileCache::Reader::readSamples (int numSamples,
     return false;
 }
 
-bool AudioFileCache::Reader::readSamples (int* const* destSamples, int numDestChannels,
-                                          int startOffsetInDestBuffer, int numSamples, int timeoutMs)
+static bool readFallbackSamples (FallbackReader& r, int* const* destSamples, int numDestChannels,
+                                 int startOffsetInDestBuffer, SampleCount startSample, int numSamples)
+{
+    return r.readSamples (destSamples, numDestChannels, startOffsetInDestBuffer, startSample, numSamples);
+}
+
+static bool readFallbackSamples (FallbackReader& r, float* const* destSamples, int numDestChannels,
+                                 int startOffsetInDestBuffer, SampleCount startSample, int numSamples)
+{
+    const bool ok = r.readSamples ((int* const*) destSamples, numDestChannels, startOffsetInDestBuffer, startSample, numSamples);
+
+    if (! r.usesFloatingPointData)
+        convertFixedToFloat (destSamples, numDestChannels, startOffsetInDestBuffer, numSamples);
+
+    return ok;
+}
+
+template<typename SampleType>
+bool AudioFileCache::Reader::readSamplesInternal (SampleType* const* destSamples, int numDestChannels,
+                                                  int startOffsetInDestBuffer, int numSamples, int timeoutMs)
 {
     jassert (numSamples < CachedFile::readAheadSamples); // this method fails unless broken down into chunks smaller than this
     jassert (getReferenceCount() > 1 || file == nullptr); // may be being used after the cache has been deleted
@@ -1042,7 +1249,7 @@ bool AudioFileCache::Reader::readSamples (int* const* destSamples, int numDestCh
         else
         {
             fallbackReader->setReadTimeout (timeoutMs);
-            allOk = fallbackReader->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer, readPos, numSamples);
+            allOk = readFallbackSamples (*fallbackReader, destSamples, numDestChannels, startOffsetInDestBuffer, readPos, numSamples);
         }
 
         readPos += numSamples;
@@ -1062,7 +1269,7 @@ bool AudioFileCache::Reader::readSamples (int* const* destSamples, int numDestCh
             else
             {
                 fallbackReader->setReadTimeout (timeoutMs);
-                allOk = fallbackReader->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer, readPos, numToRead) && allOk;
+                allOk = readFallbackSamples (*fallbackReader, destSamples, numDestChannels, startOffsetInDestBuffer, readPos, numToRead) && allOk;
             }
 
             readPos += numToRead;
@@ -1087,6 +1294,18 @@ bool AudioFileCache::Reader::readSamples (int* const* destSamples, int numDestCh
     return allOk;
 }
 
+bool AudioFileCache::Reader::readSamples (int* const* destSamples, int numDestChannels,
+                                          int startOffsetInDestBuffer, int numSamples, int timeoutMs)
+{
+    return readSamplesInternal (destSamples, numDestChannels, startOffsetInDestBuffer, numSamples, timeoutMs);
+}
+
+bool AudioFileCache::Reader::readSamples (float* const* destSamples, int numDestChannels,
+                                          int startOffsetInDestBuffer, int numSamples, int timeoutMs)
+{
+    return readSamplesInternal (destSamples, numDestChannels, startOffsetInDestBuffer, numSamples, timeoutMs);
+}
+
 bool AudioFileCache::Reader::getRange (int numSamples, float& lmax, float& lmin, float& rmax, float& rmin, int timeoutMs)
 {
     jassert (getReferenceCount() > 1 || file == nullptr); // may be being used after the cache has been deleted
@@ -57,6 +57,16 @@ public:
                           int numSamples,
                           int timeoutMs);
 
+        /** Reads float samples, converting them from the file's format in a single pass.
+            For WAV files this decodes straight from the mapped file so unlike the
+            int version, nothing goes through an intermediate int32 buffer.
+        */
+        bool readSamples (float* const* destSamples,
+                          int numDestChannels,
+                          int startOffsetInDestBuffer,
+                          int numSamples,
+                          int timeoutMs);
+
         bool getRange (int numSamples,
                        float& lmax, float& lmin,
                        float& rmax, float& rmin,
@@ -64,6 +74,19 @@ public:
 
         void setLoopRange (SampleRange);
 
+        /** Tells the cache that this range of the file is likely to be read soon,
+            e.g. because the playhead is about to jump back to the start of a loop.
+            The cache's threads will then fault in this section ahead of time.
+            This is safe to call from the audio thread and a hint only lasts for
+            a second or so, so should be made again each block whilst it applies.
+        */
+        void prefetch (SampleRange) noexcept;
+
+        /** Returns the range most recently passed to prefetch, mapped in to the loop
+            range the same way setReadPosition maps positions.
+        */
+        SampleRange getPrefetchRange() const noexcept   { return prefetchRange.load(); }
+
         int getNumChannels() const noexcept;
         double getSampleRate() const noexcept;
 
@@ -73,10 +96,15 @@ public:
         AudioFileCache& cache;
         void* file;
         std::atomic<SampleCount> readPos { 0 }, loopStart { 0 }, loopLength { 0 };
+        crill::seqlock_object<SampleRange> prefetchRange;
+        std::atomic<uint32_t> prefetchTime { 0 };
         std::unique_ptr<FallbackReader> fallbackReader;
 
         Reader (AudioFileCache&, void*, std::unique_ptr<FallbackReader>);
 
+        template<typename SampleType>
+        bool readSamplesInternal (SampleType* const*, int, int, int, int);
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Reader)
     };
 
@@ -105,6 +133,30 @@ public:
 
     bool hasCacheMissed (bool clearMissedFlag);
 
+    /** The number of reads from a file that failed because its data wasn't ready in time. */
+    struct CacheMiss
+    {
+        AudioFile file;
+        int numMisses = 0;
+    };
+
+    /** Returns the files that have missed since the misses were last cleared.
+        Unlike hasCacheMissed, this only covers memory mapped files.
+    */
+    std::vector<CacheMiss> getCacheMisses (bool clearMisses);
+
+    /** Sets the number of bytes the cache's threads will keep faulted in for the
+        ranges readers have been asked to prefetch. Ranges beyond this are ignored.
+        @see Reader::prefetch
+    */
+    void setPrefetchBudget (int64_t numBytes);
+    int64_t getPrefetchBudget() const               { return prefetchBudget; }
+
+    /** Returns the ranges of a file its readers have been asked to prefetch
+        that haven't expired yet.
+    */
+    std::vector<SampleRange> getPrefetchRanges (const AudioFile&);
+
     /** Returns the amount of time spent reading files in the last block. */
     TimeDuration getCpuUsage() const;
 
@@ -118,6 +170,7 @@ private:
     Engine& engine;
     SampleCount totalBytesUsed = 0, cacheSizeSamples = 0;
     bool cacheMissed = false;
+    std::atomic<int64_t> prefetchBudget { 64 * 1024 * 1024 };
 
     std::atomic<double> blockDurationMs { 0.0 }, lastBlockDurationMs { 0.0 };
     struct ScopedFileRead;
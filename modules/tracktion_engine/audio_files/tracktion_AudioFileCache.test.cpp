@@ -32,6 +32,8 @@ public:
     void runTest() override
     {
         runCacheReadTest();
+        runFloatReadTest();
+        runPrefetchTest();
     }
 
 private:
@@ -60,6 +62,122 @@ private:
         beginTest ("Read a sin wav file");
         expectAudioBuffer (*this, bufferFromFile, bufferFromCache);
     }
+
+    void runFloatReadTest()
+    {
+        Engine& engine = *Engine::getEngines().getFirst();
+
+        using namespace graph::test_utilities;
+        auto sourceBuffer = createSineBuffer (2, 44'100, getPhaseIncrement (220.0f, 44100.0));
+
+        // N.B. JUCE writes 32-bit WAV files as floating point
+        for (int bitDepth : { 8, 16, 24, 32 })
+        {
+            beginTest ("Read float samples from a " + juce::String (bitDepth) + "-bit wav file");
+
+            juce::TemporaryFile tempFile (".wav");
+
+            {
+                juce::WavAudioFormat format;
+                std::unique_ptr<juce::AudioFormatWriter> writer (format.createWriterFor (tempFile.getFile().createOutputStream().release(),
+                                                                                         44100.0, 2, bitDepth, {}, 0));
+                expect (writer != nullptr);
+
+                if (writer == nullptr)
+                    continue;
+
+                writer->writeFromAudioSampleBuffer (toAudioBuffer (sourceBuffer), 0, (int) sourceBuffer.getNumFrames());
+            }
+
+            auto fileReader = std::unique_ptr<juce::AudioFormatReader> (AudioFileUtils::createReaderFor (engine, tempFile.getFile()));
+            juce::AudioBuffer<float> bufferFromFile ((int) fileReader->numChannels, (int) fileReader->lengthInSamples);
+            fileReader->read (&bufferFromFile, 0, (int) fileReader->lengthInSamples, 0, true, true);
+
+            auto cacheReader = engine.getAudioFileManager().cache.createReader (AudioFile (engine, tempFile.getFile()));
+            juce::AudioBuffer<float> bufferFromCache ((int) fileReader->numChannels, (int) fileReader->lengthInSamples);
+
+            for (int i = 0; i < bufferFromCache.getNumSamples(); i += 4096)
+            {
+                const int numToRead = std::min (bufferFromCache.getNumSamples() - i, 4096);
+                expect (cacheReader->readSamples (bufferFromCache.getArrayOfWritePointers(), bufferFromCache.getNumChannels(),
+                                                  i, numToRead, 5'000));
+            }
+
+            // The file reader goes via int32 so the scaling can differ by a rounding error
+            expect (buffersAreEqual (bufferFromFile, bufferFromCache, 1.0e-6f));
+        }
+    }
+
+    void runPrefetchTest()
+    {
+        Engine& engine = *Engine::getEngines().getFirst();
+        auto& cache = engine.getAudioFileManager().cache;
+
+        using namespace graph::test_utilities;
+        auto tempFile = getSquareFile<juce::WavAudioFormat> (44100.0, 10.0, 2);
+        const AudioFile audioFile (engine, tempFile->getFile());
+        auto cacheReader = cache.createReader (audioFile);
+
+        beginTest ("Prefetched ranges are mapped ahead of being read");
+        {
+            const SampleRange range (44'100 * 8, 44'100 * 9);
+
+            for (int i = 0; i < 500 && ! cache.hasMappedReader (audioFile, range.getStart()); ++i)
+            {
+                cacheReader->prefetch (range);
+                juce::Thread::sleep (10);
+            }
+
+            expect (cache.hasMappedReader (audioFile, range.getStart()));
+
+            juce::AudioBuffer<float> buffer (2, 4096);
+            cacheReader->setReadPosition (range.getStart());
+            expect (cacheReader->readSamples (buffer.getArrayOfWritePointers(), 2, 0, 4096, 0));
+        }
+
+        beginTest ("Prefetched ranges are mapped in to the loop like read positions");
+        {
+            auto loopedReader = cache.createReader (audioFile);
+            const SampleRange loopRange (44'100 * 7, 44'100 * 9);
+            loopedReader->setLoopRange (loopRange);
+
+            for (SampleCount pos : { (SampleCount) 0, (SampleCount) 44'100 * 4 + 1000, loopRange.getStart() + 10,
+                                     loopRange.getEnd() + 10, (SampleCount) -1000 })
+            {
+                loopedReader->prefetch (SampleRange::withStartAndLength (pos, 4096));
+                loopedReader->setReadPosition (pos);
+
+                expect (loopRange.contains (loopedReader->getReadPosition()));
+                expect (loopedReader->getPrefetchRange() == SampleRange::withStartAndLength (loopedReader->getReadPosition(), 4096));
+            }
+
+            // Ranges longer than the loop are limited to its length
+            loopedReader->prefetch ({ 44'100, 44'100 * 5 });
+            expect (loopedReader->getPrefetchRange() == SampleRange::withStartAndLength (loopRange.getStart() + 44'100, loopRange.getLength()));
+
+            for (int i = 0; i < 500 && ! cache.hasMappedReader (audioFile, loopRange.getStart() + 44'100); ++i)
+            {
+                loopedReader->prefetch ({ 44'100, 44'100 * 2 });
+                juce::Thread::sleep (10);
+            }
+
+            expect (cache.hasMappedReader (audioFile, loopRange.getStart() + 44'100));
+        }
+
+        beginTest ("Cache misses are reported per file");
+        {
+            cache.getCacheMisses (true);
+
+            juce::AudioBuffer<float> buffer (2, 4096);
+            cacheReader->setReadPosition (0);
+            expect (cacheReader->readSamples (buffer.getArrayOfWritePointers(), 2, 0, 4096, 5'000));
+
+            for (auto& miss : cache.getCacheMisses (true))
+                expect (miss.file != audioFile);
+
+            expect (cache.getCacheMisses (false).empty());
+        }
+    }
 };
 
 static AudioFileCacheTests audioFileCacheTests;
@@ -39,6 +39,7 @@ public:
     Engine& engine;
     AudioProxyGenerator proxyGenerator;
     AudioFileCache cache;
+    PeakPyramidCache peakPyramids;
 
 private:
     struct KnownFile;
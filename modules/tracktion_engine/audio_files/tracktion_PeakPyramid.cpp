@@ -0,0 +1,891 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+// The bins are read straight out of the mapped file so must have no padding.
+// N.B. The on-disk format is little-endian, the same as all the supported platforms.
+static_assert (sizeof (PeakBin) == 6);
+
+namespace PeakPyramidFormat
+{
+    static constexpr const char* magic = "TPKP";
+    static constexpr int version = 2; // Version 2 adds the source file path after the bins
+    static constexpr size_t fixedHeaderSize = 32;
+
+    static int16_t toFixed (float v) noexcept
+    {
+        return (int16_t) juce::jlimit (-32767, 32767, juce::roundToInt (v * 32767.0f));
+    }
+
+    static float fromFixed (int16_t v) noexcept
+    {
+        return v / 32767.0f;
+    }
+
+    static int64_t getSamplesPerBin (int level) noexcept
+    {
+        int64_t num = PeakPyramidBase::baseSamplesPerBin;
+
+        for (int i = 0; i < level; ++i)
+            num *= PeakPyramidBase::levelDecimation;
+
+        return num;
+    }
+}
+
+//==============================================================================
+PeakPyramidBase::Peak PeakPyramidBase::getPeak (int channel, juce::Range<int64_t> sampleRange, double samplesPerPixel) const
+{
+    Peak result;
+
+    if (channel < 0 || channel >= getNumChannels() || sampleRange.isEmpty())
+        return result;
+
+    const auto numChans = getNumChannels();
+
+    visitLevels ([&] (const Level* levels, int numLevels)
+    {
+        int levelIndex = 0;
+
+        while (levelIndex + 1 < numLevels
+                && levels[levelIndex + 1].numBins > 0
+                && levels[levelIndex + 1].samplesPerBin <= samplesPerPixel)
+            ++levelIndex;
+
+        int16_t minValue = 32767, maxValue = -32767;
+        double sumOfSquares = 0.0, numSamplesSummed = 0.0;
+        auto start = sampleRange.getStart();
+
+        // Whilst building, a coarse level ends at its last complete bin, so
+        // the rest of the range is read from successively finer levels
+        for (; levelIndex >= 0 && start < sampleRange.getEnd(); --levelIndex)
+        {
+            auto& level = levels[levelIndex];
+
+            if (start >= level.numBins * level.samplesPerBin)
+                continue;
+
+            auto firstBin = start / level.samplesPerBin;
+            auto lastBin = std::min ((sampleRange.getEnd() - 1) / level.samplesPerBin, level.numBins - 1);
+
+            for (auto i = firstBin; i <= lastBin; ++i)
+            {
+                auto& bin = level.bins[i * numChans + channel];
+                minValue = std::min (minValue, bin.minValue);
+                maxValue = std::max (maxValue, bin.maxValue);
+
+                auto rms = PeakPyramidFormat::fromFixed (bin.rms);
+                sumOfSquares += rms * rms * (double) level.samplesPerBin;
+                numSamplesSummed += (double) level.samplesPerBin;
+            }
+
+            start = (lastBin + 1) * level.samplesPerBin;
+        }
+
+        if (numSamplesSummed == 0.0)
+            return;
+
+        result.minValue = PeakPyramidFormat::fromFixed (minValue);
+        result.maxValue = PeakPyramidFormat::fromFixed (maxValue);
+        result.rms = (float) std::sqrt (sumOfSquares / numSamplesSummed);
+    });
+
+    return result;
+}
+
+float PeakPyramidBase::getApproximatePeak() const
+{
+    int16_t peak = 0;
+
+    visitLevels ([&] (const Level* levels, int numLevels)
+    {
+        // Start with the coarsest level and use the finer ones for anything it doesn't cover yet
+        int64_t numSamplesCovered = 0;
+
+        for (int i = numLevels; --i >= 0;)
+        {
+            auto& level = levels[i];
+            auto firstBin = numSamplesCovered / level.samplesPerBin;
+
+            if (firstBin >= level.numBins)
+                continue;
+
+            for (auto bin = level.bins + firstBin * getNumChannels(), end = level.bins + level.numBins * getNumChannels(); bin != end; ++bin)
+                peak = std::max (peak, std::max ((int16_t) std::abs (bin->minValue), bin->maxValue));
+
+            numSamplesCovered = level.numBins * level.samplesPerBin;
+        }
+    });
+
+    return PeakPyramidFormat::fromFixed (peak);
+}
+
+void PeakPyramidBase::drawChannel (juce::Graphics& g, juce::Rectangle<int> area,
+                                   juce::Range<double> timeRange, int channel, float verticalZoomFactor) const
+{
+    const auto sampleRate = getSampleRate();
+    const auto numSamples = getNumSamples();
+
+    if (area.isEmpty() || timeRange.isEmpty() || sampleRate <= 0.0 || numSamples == 0)
+        return;
+
+    const auto samplesPerPixel = timeRange.getLength() * sampleRate / area.getWidth();
+    const auto startSample = timeRange.getStart() * sampleRate;
+    const auto midY = (float) area.getCentreY();
+    const auto halfHeight = area.getHeight() * 0.5f;
+
+    juce::RectangleList<float> waveform;
+    waveform.ensureStorageAllocated (area.getWidth());
+
+    for (int x = 0; x < area.getWidth(); ++x)
+    {
+        auto s1 = (int64_t) (startSample + x * samplesPerPixel);
+        auto s2 = std::max (s1 + 1, (int64_t) (startSample + (x + 1) * samplesPerPixel));
+
+        if (s2 <= 0)
+            continue;
+
+        if (s1 >= numSamples)
+            break;
+
+        auto peak = getPeak (channel, { std::max ((int64_t) 0, s1), std::min (numSamples, s2) }, samplesPerPixel);
+        auto top    = midY - halfHeight * juce::jlimit (-1.0f, 1.0f, peak.maxValue * verticalZoomFactor);
+        auto bottom = midY - halfHeight * juce::jlimit (-1.0f, 1.0f, peak.minValue * verticalZoomFactor);
+
+        waveform.addWithoutMerging ({ (float) (area.getX() + x), top, 1.0f, std::max (1.0f, bottom - top) });
+    }
+
+    g.fillRectList (waveform);
+}
+
+//==============================================================================
+PeakPyramid::PeakPyramid (int numChans, double rate)
+    : numChannels (numChans), sampleRate (rate)
+{
+    jassert (numChannels > 0);
+
+    for (auto& acc : accumulators)
+        acc.resize ((size_t) numChannels);
+}
+
+void PeakPyramid::addBlock (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    jassert (! isFinished());
+    const std::unique_lock sl (mutex);
+    const int numSourceChannels = buffer.getNumChannels();
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        auto& acc = accumulators[0][(size_t) chan];
+
+        // Missing source channels are treated as silence
+        auto data = chan < numSourceChannels ? buffer.getReadPointer (chan, startSample) : nullptr;
+
+        for (int done = 0; done < numSamples;)
+        {
+            auto numThisTime = (int) std::min ((int64_t) (numSamples - done), baseSamplesPerBin - acc.count);
+            float minValue = 0.0f, maxValue = 0.0f;
+            double sumOfSquares = 0.0;
+
+            if (data != nullptr)
+            {
+                auto range = juce::FloatVectorOperations::findMinAndMax (data + done, numThisTime);
+                minValue = range.getStart();
+                maxValue = range.getEnd();
+
+                for (int i = 0; i < numThisTime; ++i)
+                    sumOfSquares += data[done + i] * data[done + i];
+            }
+
+            acc.minValue = acc.count == 0 ? minValue : std::min (acc.minValue, minValue);
+            acc.maxValue = acc.count == 0 ? maxValue : std::max (acc.maxValue, maxValue);
+            acc.sumOfSquares += sumOfSquares;
+            acc.count += numThisTime;
+            done += numThisTime;
+
+            if (acc.count == baseSamplesPerBin)
+                emitBin (0, chan);
+        }
+    }
+
+    numSamplesAdded.fetch_add (numSamples, std::memory_order_release);
+}
+
+void PeakPyramid::finish()
+{
+    const std::unique_lock sl (mutex);
+
+    if (finished.load())
+        return;
+
+    // Flush the partial bins, lowest level first so they propagate upwards
+    for (int level = 0; level < maxNumLevels; ++level)
+        for (int chan = 0; chan < numChannels; ++chan)
+            if (accumulators[level][(size_t) chan].count > 0)
+                emitBin (level, chan);
+
+    finished.store (true, std::memory_order_release);
+}
+
+void PeakPyramid::emitBin (int level, int chan)
+{
+    auto& acc = accumulators[level][(size_t) chan];
+    auto& bins = levels[level];
+
+    const auto index = (size_t) (acc.numBinsWritten * numChannels + chan);
+    ++acc.numBinsWritten;
+
+    if (bins.size() <= index)
+        bins.resize ((size_t) (acc.numBinsWritten * numChannels));
+
+    bins[index] = { PeakPyramidFormat::toFixed (acc.minValue),
+                    PeakPyramidFormat::toFixed (acc.maxValue),
+                    PeakPyramidFormat::toFixed ((float) std::sqrt (acc.sumOfSquares / (double) acc.count)) };
+
+    const auto minValue = acc.minValue, maxValue = acc.maxValue;
+    const auto sumOfSquares = acc.sumOfSquares;
+    const auto count = acc.count;
+
+    acc.minValue = acc.maxValue = 0.0f;
+    acc.sumOfSquares = 0.0;
+    acc.count = 0;
+
+    if (level + 1 < maxNumLevels)
+    {
+        auto& next = accumulators[level + 1][(size_t) chan];
+        next.minValue = next.count == 0 ? minValue : std::min (next.minValue, minValue);
+        next.maxValue = next.count == 0 ? maxValue : std::max (next.maxValue, maxValue);
+        next.sumOfSquares += sumOfSquares;
+        next.count += count;
+
+        if (next.count == PeakPyramidFormat::getSamplesPerBin (level + 1))
+            emitBin (level + 1, chan);
+    }
+}
+
+void PeakPyramid::visitLevels (const std::function<void (const Level*, int)>& visitor) const
+{
+    const std::shared_lock sl (mutex);
+    Level views[maxNumLevels];
+
+    for (int i = 0; i < maxNumLevels; ++i)
+        views[i] = { levels[i].data(), (int64_t) levels[i].size() / numChannels, PeakPyramidFormat::getSamplesPerBin (i) };
+
+    visitor (views, maxNumLevels);
+}
+
+bool PeakPyramid::writeTo (juce::OutputStream& out, const juce::File& sourceFile) const
+{
+    const std::shared_lock sl (mutex);
+
+    out.write (PeakPyramidFormat::magic, 4);
+    out.writeInt (PeakPyramidFormat::version);
+    out.writeInt (numChannels);
+    out.writeInt (maxNumLevels);
+    out.writeDouble (sampleRate);
+    out.writeInt64 (numSamplesAdded.load());
+
+    for (auto& level : levels)
+        out.writeInt64 ((juce::int64) (level.size() / (size_t) numChannels));
+
+    for (auto& level : levels)
+        if (! out.write (level.data(), level.size() * sizeof (PeakBin)))
+            return false;
+
+    return out.writeString (sourceFile.getFullPathName());
+}
+
+bool PeakPyramid::writeToFile (const juce::File& file, const juce::File& sourceFile) const
+{
+    juce::TemporaryFile temp (file);
+
+    {
+        juce::FileOutputStream out (temp.getFile());
+
+        if (! (out.openedOk() && writeTo (out, sourceFile)))
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+//==============================================================================
+MappedPeakPyramid::MappedPeakPyramid (const juce::File& file)
+    : mappedFile (file, juce::MemoryMappedFile::readOnly)
+{
+    auto data = static_cast<const char*> (mappedFile.getData());
+    const auto size = mappedFile.getSize();
+
+    if (data == nullptr || size < PeakPyramidFormat::fixedHeaderSize
+         || memcmp (data, PeakPyramidFormat::magic, 4) != 0)
+        return;
+
+    const auto version = (int) juce::ByteOrder::littleEndianInt (data + 4);
+
+    if (version < 1 || version > PeakPyramidFormat::version)
+        return;
+
+    const auto numChans = (int) juce::ByteOrder::littleEndianInt (data + 8);
+    const auto numLevelsInFile = (int) juce::ByteOrder::littleEndianInt (data + 12);
+
+    if (numChans <= 0 || numLevelsInFile <= 0 || numLevelsInFile > maxNumLevels)
+        return;
+
+    auto offset = PeakPyramidFormat::fixedHeaderSize + (size_t) numLevelsInFile * sizeof (int64_t);
+
+    if (size < offset)
+        return;
+
+    auto rateBits = juce::ByteOrder::littleEndianInt64 (data + 16);
+    memcpy (&sampleRate, &rateBits, sizeof (double));
+    numSamples = (int64_t) juce::ByteOrder::littleEndianInt64 (data + 24);
+
+    for (int i = 0; i < numLevelsInFile; ++i)
+    {
+        auto numBins = (int64_t) juce::ByteOrder::littleEndianInt64 (data + PeakPyramidFormat::fixedHeaderSize + (size_t) i * sizeof (int64_t));
+        auto numBytes = (size_t) numBins * (size_t) numChans * sizeof (PeakBin);
+
+        if (numBins < 0 || offset + numBytes > size)
+            return;
+
+        levels[i] = { reinterpret_cast<const PeakBin*> (data + offset), numBins, PeakPyramidFormat::getSamplesPerBin (i) };
+        offset += numBytes;
+    }
+
+    if (version >= 2)
+    {
+        auto pathStart = data + offset;
+        auto pathEnd = std::find (pathStart, data + size, 0);
+
+        if (pathEnd == data + size)
+            return;
+
+        if (pathEnd > pathStart)
+            sourceFile = juce::File (juce::String::fromUTF8 (pathStart, (int) (pathEnd - pathStart)));
+    }
+
+    numChannels = numChans;
+    numLevels = numLevelsInFile;
+}
+
+void MappedPeakPyramid::visitLevels (const std::function<void (const Level*, int)>& visitor) const
+{
+    visitor (levels, numLevels);
+}
+
+//==============================================================================
+PeakPyramidCache::PeakPyramidCache (Engine& e)
+    : engine (e)
+{
+}
+
+PeakPyramidCache::~PeakPyramidCache()
+{
+    if (pool != nullptr)
+        pool->removeAllJobs (true, 10000);
+}
+
+juce::File PeakPyramidCache::getFileFor (HashCode hash) const
+{
+    return engine.getTemporaryFileManager().getThumbnailsFolder()
+             .getChildFile ("peaks_" + juce::String::toHexString (hash) + ".tpk");
+}
+
+std::shared_ptr<const MappedPeakPyramid> PeakPyramidCache::getPyramid (HashCode hash)
+{
+    const std::scoped_lock sl (mutex);
+
+    if (auto found = mappedPyramids.find (hash); found != mappedPyramids.end())
+        return found->second;
+
+    auto file = getFileFor (hash);
+
+    if (! file.existsAsFile())
+        return {};
+
+    auto pyramid = std::make_shared<MappedPeakPyramid> (file);
+
+    if (! pyramid->isValid())
+    {
+        pyramid.reset();
+        file.deleteFile();
+        return {};
+    }
+
+    // This is what purgeOrphanedPyramids uses to age out pyramids without a source file
+    file.setLastAccessTime (juce::Time::getCurrentTime());
+
+    mappedPyramids[hash] = pyramid;
+    return pyramid;
+}
+
+std::shared_ptr<const PeakPyramid> PeakPyramidCache::getPyramidBeingBuilt (HashCode hash) const
+{
+    const std::scoped_lock sl (mutex);
+
+    if (auto found = pyramidsBeingBuilt.find (hash); found != pyramidsBeingBuilt.end())
+        return found->second;
+
+    return {};
+}
+
+std::shared_ptr<const PeakPyramid> PeakPyramidCache::buildAsync (HashCode hash, std::unique_ptr<juce::AudioFormatReader> reader,
+                                                                 const juce::File& sourceFile)
+{
+    if (reader == nullptr || reader->numChannels == 0 || reader->sampleRate <= 0.0)
+        return {};
+
+    if (auto building = getPyramidBeingBuilt (hash))
+        return building;
+
+    if (auto existing = getPyramid (hash))
+    {
+        if (existing->getNumSamples() == reader->lengthInSamples
+             && existing->getNumChannels() == (int) reader->numChannels)
+            return {};
+
+        remove (hash);
+    }
+
+    auto pyramid = std::make_shared<PeakPyramid> ((int) reader->numChannels, reader->sampleRate);
+
+    juce::ThreadPool* buildPool = nullptr;
+
+    {
+        const std::scoped_lock sl (mutex);
+        pyramidsBeingBuilt[hash] = pyramid;
+
+        if (pool == nullptr)
+            pool = std::make_unique<juce::ThreadPool> (juce::jlimit (1, 8, juce::SystemStats::getNumCpus() - 1));
+
+        buildPool = pool.get();
+    }
+
+    buildPool->addJob ([this, hash, pyramid, sourceFile, sourceReader = std::shared_ptr<juce::AudioFormatReader> (std::move (reader))]
+                 {
+                     constexpr int blockSize = 65536;
+                     juce::AudioBuffer<float> buffer ((int) sourceReader->numChannels, blockSize);
+                     bool succeeded = true;
+
+                     for (juce::int64 pos = 0; pos < sourceReader->lengthInSamples; pos += blockSize)
+                     {
+                         if (auto job = juce::ThreadPoolJob::getCurrentThreadPoolJob(); job != nullptr && job->shouldExit())
+                         {
+                             succeeded = false;
+                             break;
+                         }
+
+                         auto numThisTime = (int) std::min ((juce::int64) blockSize, sourceReader->lengthInSamples - pos);
+
+                         if (! sourceReader->read (&buffer, 0, numThisTime, pos, true, true))
+                         {
+                             succeeded = false;
+                             break;
+                         }
+
+                         pyramid->addBlock (buffer, 0, numThisTime);
+                     }
+
+                     pyramid->finish();
+                     buildFinished (hash, pyramid, sourceFile, succeeded);
+                 });
+
+    return pyramid;
+}
+
+std::shared_ptr<const PeakPyramid> PeakPyramidCache::buildAsync (const AudioFile& file)
+{
+    if (file.isNull() || ! file.getFile().existsAsFile())
+        return {};
+
+    const auto hash = file.getHash();
+
+    if (auto building = getPyramidBeingBuilt (hash))
+        return building;
+
+    auto pyramidFile = getFileFor (hash);
+
+    if (pyramidFile.existsAsFile())
+    {
+        if (file.getFile().getLastModificationTime() > pyramidFile.getLastModificationTime() + juce::RelativeTime::seconds (0.1))
+        {
+            remove (hash);
+        }
+        else if (auto existing = getPyramid (hash))
+        {
+            if (existing->getNumSamples() == file.getLengthInSamples()
+                 && existing->getNumChannels() == file.getNumChannels())
+                return {};
+
+            remove (hash);
+        }
+    }
+
+    return buildAsync (hash, std::unique_ptr<juce::AudioFormatReader> (AudioFileUtils::createReaderFor (engine, file.getFile())),
+                       file.getFile());
+}
+
+bool PeakPyramidCache::store (HashCode hash, const PeakPyramid& pyramid)
+{
+    return writeToCache (hash, pyramid, {});
+}
+
+bool PeakPyramidCache::store (const AudioFile& file, const PeakPyramid& pyramid)
+{
+    return writeToCache (file.getHash(), pyramid, file.getFile());
+}
+
+bool PeakPyramidCache::writeToCache (HashCode hash, const PeakPyramid& pyramid, const juce::File& sourceFile)
+{
+    {
+        const std::scoped_lock sl (mutex);
+        mappedPyramids.erase (hash);
+    }
+
+    auto file = getFileFor (hash);
+    return file.getParentDirectory().createDirectory() && pyramid.writeToFile (file, sourceFile);
+}
+
+void PeakPyramidCache::remove (HashCode hash)
+{
+    {
+        const std::scoped_lock sl (mutex);
+        mappedPyramids.erase (hash);
+    }
+
+    getFileFor (hash).deleteFile();
+}
+
+void PeakPyramidCache::sourceChanged (const AudioFile& file)
+{
+    const auto hash = file.getHash();
+    auto pyramidFile = getFileFor (hash);
+
+    {
+        const std::scoped_lock sl (mutex);
+        mappedPyramids.erase (hash);
+    }
+
+    // Pyramids written after the source (e.g. whilst recording or rendering) are still valid
+    if (pyramidFile.existsAsFile()
+         && file.getFile().getLastModificationTime() > pyramidFile.getLastModificationTime() + juce::RelativeTime::seconds (0.1))
+        pyramidFile.deleteFile();
+}
+
+void PeakPyramidCache::purgeOrphanedPyramids()
+{
+    CRASH_TRACER
+
+    for (auto entry : juce::RangedDirectoryIterator (engine.getTemporaryFileManager().getThumbnailsFolder(),
+                                                     false, "peaks_*.tpk"))
+    {
+        auto file = entry.getFile();
+        const auto hash = (HashCode) file.getFileNameWithoutExtension()
+                                         .fromFirstOccurrenceOf ("peaks_", false, false)
+                                         .getHexValue64();
+
+        if (getPyramidBeingBuilt (hash) != nullptr)
+            continue;
+
+        bool isOrphaned = false;
+
+        {
+            MappedPeakPyramid pyramid (file);
+            auto sourceFile = pyramid.getSourceFile();
+
+            if (! pyramid.isValid())
+                isOrphaned = true;
+            else if (sourceFile != juce::File())
+                isOrphaned = ! sourceFile.existsAsFile();
+            else
+                isOrphaned = file.getLastAccessTime() < juce::Time::getCurrentTime() - juce::RelativeTime::days (30);
+        }
+
+        if (isOrphaned)
+            remove (hash);
+    }
+}
+
+void PeakPyramidCache::buildFinished (HashCode hash, std::shared_ptr<PeakPyramid> pyramid,
+                                      const juce::File& sourceFile, bool succeeded)
+{
+    if (succeeded)
+        writeToCache (hash, *pyramid, sourceFile);
+
+    const std::scoped_lock sl (mutex);
+
+    if (auto found = pyramidsBeingBuilt.find (hash); found != pyramidsBeingBuilt.end() && found->second == pyramid)
+        pyramidsBeingBuilt.erase (found);
+}
+
+//==============================================================================
+PeakPyramidThumbnail::PeakPyramidThumbnail (Engine& e)
+    : engine (e)
+{
+}
+
+PeakPyramidThumbnail::~PeakPyramidThumbnail()
+{
+}
+
+std::shared_ptr<const PeakPyramidBase> PeakPyramidThumbnail::getCurrentPyramid() const
+{
+    const std::scoped_lock sl (pyramidLock);
+
+    // Once a background build has finished, switch over to the mapped file
+    if (building != nullptr && building->isFinished())
+    {
+        if (auto mapped = engine.getAudioFileManager().peakPyramids.getPyramid (hash))
+        {
+            pyramid = mapped;
+            building.reset();
+        }
+    }
+
+    return pyramid;
+}
+
+void PeakPyramidThumbnail::setSource (const AudioFile& file)
+{
+    clear();
+
+    auto& cache = engine.getAudioFileManager().peakPyramids;
+    auto newBuild = cache.buildAsync (file);
+
+    const std::scoped_lock sl (pyramidLock);
+    hash = file.getHash();
+    totalSamples = file.getLengthInSamples();
+    building = newBuild;
+    pyramid = newBuild != nullptr ? std::static_pointer_cast<const PeakPyramidBase> (newBuild)
+                                  : cache.getPyramid (hash);
+}
+
+void PeakPyramidThumbnail::clear()
+{
+    {
+        const std::scoped_lock sl (pyramidLock);
+        hash = 0;
+        totalSamples = 0;
+        pyramid.reset();
+        building.reset();
+        liveBlocks.reset();
+    }
+
+    sendChangeMessage();
+}
+
+bool PeakPyramidThumbnail::setSource (juce::InputSource* newSource)
+{
+    std::unique_ptr<juce::InputSource> source (newSource);
+
+    if (source != nullptr)
+    {
+        if (auto stream = source->createInputStream())
+        {
+            if (auto reader = engine.getAudioFileFormatManager().readFormatManager.createReaderFor (std::unique_ptr<juce::InputStream> (stream)))
+            {
+                setReader (reader, source->hashCode());
+                return true;
+            }
+        }
+    }
+
+    clear();
+    return false;
+}
+
+void PeakPyramidThumbnail::setReader (juce::AudioFormatReader* newReader, juce::int64 hashCode)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader (newReader);
+    clear();
+
+    if (reader == nullptr)
+        return;
+
+    auto& cache = engine.getAudioFileManager().peakPyramids;
+    const auto numSourceSamples = reader->lengthInSamples;
+    auto newBuild = cache.buildAsync ((HashCode) hashCode, std::move (reader));
+
+    {
+        const std::scoped_lock sl (pyramidLock);
+        hash = (HashCode) hashCode;
+        totalSamples = numSourceSamples;
+        building = newBuild;
+        pyramid = newBuild != nullptr ? std::static_pointer_cast<const PeakPyramidBase> (newBuild)
+                                      : cache.getPyramid (hash);
+    }
+
+    sendChangeMessage();
+}
+
+bool PeakPyramidThumbnail::loadFrom (juce::InputStream& input)
+{
+    const auto hashToLoad = getHashCode();
+
+    if (hashToLoad == 0)
+        return false;
+
+    auto& cache = engine.getAudioFileManager().peakPyramids;
+    cache.remove ((HashCode) hashToLoad);
+
+    {
+        auto file = cache.getFileFor ((HashCode) hashToLoad);
+        file.getParentDirectory().createDirectory();
+        juce::FileOutputStream out (file);
+
+        if (! out.openedOk() || out.writeFromInputStream (input, -1) <= 0)
+            return false;
+    }
+
+    if (auto mapped = cache.getPyramid ((HashCode) hashToLoad))
+    {
+        const std::scoped_lock sl (pyramidLock);
+        pyramid = mapped;
+        building.reset();
+        totalSamples = mapped->getNumSamples();
+        return true;
+    }
+
+    return false;
+}
+
+void PeakPyramidThumbnail::saveTo (juce::OutputStream& out) const
+{
+    auto p = getCurrentPyramid();
+
+    if (auto mapped = dynamic_cast<const MappedPeakPyramid*> (p.get()))
+        out.write (mapped->getData(), mapped->getDataSize());
+    else if (auto built = dynamic_cast<const PeakPyramid*> (p.get()))
+        built->writeTo (out);
+}
+
+int PeakPyramidThumbnail::getNumChannels() const noexcept
+{
+    if (auto p = getCurrentPyramid())
+        return p->getNumChannels();
+
+    return 0;
+}
+
+double PeakPyramidThumbnail::getTotalLength() const noexcept
+{
+    if (auto p = getCurrentPyramid(); p != nullptr && p->getSampleRate() > 0.0)
+        return (double) std::max ((juce::int64) p->getNumSamples(), totalSamples) / p->getSampleRate();
+
+    return 0.0;
+}
+
+void PeakPyramidThumbnail::drawChannel (juce::Graphics& g, const juce::Rectangle<int>& area, double startTimeSeconds,
+                                        double endTimeSeconds, int channelNum, float verticalZoomFactor)
+{
+    if (auto p = getCurrentPyramid())
+        p->drawChannel (g, area, { startTimeSeconds, endTimeSeconds }, channelNum, verticalZoomFactor);
+}
+
+void PeakPyramidThumbnail::drawChannels (juce::Graphics& g, const juce::Rectangle<int>& area, double startTimeSeconds,
+                                         double endTimeSeconds, float verticalZoomFactor)
+{
+    if (auto p = getCurrentPyramid())
+    {
+        const auto numChannels = p->getNumChannels();
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            auto y1 = juce::roundToInt ((i * area.getHeight()) / (double) numChannels);
+            auto y2 = juce::roundToInt (((i + 1) * area.getHeight()) / (double) numChannels);
+
+            p->drawChannel (g, { area.getX(), area.getY() + y1, area.getWidth(), y2 - y1 },
+                            { startTimeSeconds, endTimeSeconds }, i, verticalZoomFactor);
+        }
+    }
+}
+
+bool PeakPyramidThumbnail::isFullyLoaded() const noexcept
+{
+    if (auto p = getCurrentPyramid())
+        return p->getNumSamples() >= totalSamples;
+
+    return false;
+}
+
+juce::int64 PeakPyramidThumbnail::getNumSamplesFinished() const noexcept
+{
+    if (auto p = getCurrentPyramid())
+        return p->getNumSamples();
+
+    return 0;
+}
+
+float PeakPyramidThumbnail::getApproximatePeak() const
+{
+    if (auto p = getCurrentPyramid())
+        return p->getApproximatePeak();
+
+    return 0.0f;
+}
+
+void PeakPyramidThumbnail::getApproximateMinMax (double startTime, double endTime, int channelIndex,
+                                                 float& minValue, float& maxValue) const noexcept
+{
+    minValue = maxValue = 0.0f;
+
+    if (auto p = getCurrentPyramid(); p != nullptr && p->getSampleRate() > 0.0)
+    {
+        const auto sampleRate = p->getSampleRate();
+        const auto range = juce::Range<int64_t> ((int64_t) (startTime * sampleRate), (int64_t) (endTime * sampleRate));
+        auto peak = p->getPeak (channelIndex, range, (double) range.getLength());
+        minValue = peak.minValue;
+        maxValue = peak.maxValue;
+    }
+}
+
+juce::int64 PeakPyramidThumbnail::getHashCode() const
+{
+    const std::scoped_lock sl (pyramidLock);
+    return (juce::int64) hash;
+}
+
+void PeakPyramidThumbnail::reset (int numChannels, double sampleRate, juce::int64 totalSamplesInSource)
+{
+    const std::scoped_lock sl (pyramidLock);
+    totalSamples = totalSamplesInSource;
+    building.reset();
+    liveBlocks = numChannels > 0 ? std::make_shared<PeakPyramid> (numChannels, sampleRate) : nullptr;
+    pyramid = liveBlocks;
+}
+
+void PeakPyramidThumbnail::addBlock (juce::int64 sampleNumberInSource, const juce::AudioBuffer<float>& incoming,
+                                     int startOffsetInBuffer, int numSamples)
+{
+    std::shared_ptr<PeakPyramid> live;
+    juce::int64 numSourceSamples = 0;
+
+    {
+        const std::scoped_lock sl (pyramidLock);
+        live = liveBlocks;
+        numSourceSamples = totalSamples;
+    }
+
+    if (live == nullptr || live->isFinished())
+        return;
+
+    // Blocks are summarised as they arrive so must be contiguous
+    jassert (sampleNumberInSource == live->getNumSamples());
+    juce::ignoreUnused (sampleNumberInSource);
+
+    live->addBlock (incoming, startOffsetInBuffer, numSamples);
+
+    if (numSourceSamples > 0 && live->getNumSamples() >= numSourceSamples)
+        live->finish();
+}
+
+}} // namespace tracktion { inline namespace engine
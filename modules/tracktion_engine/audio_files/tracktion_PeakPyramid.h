@@ -0,0 +1,307 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+/**
+    A min/max/RMS summary of a block of samples for one channel.
+    Values are stored as 16-bit fixed point so a bin is 6 bytes on disk.
+*/
+struct PeakBin
+{
+    int16_t minValue = 0, maxValue = 0, rms = 0;
+};
+
+//==============================================================================
+/**
+    Base for multi-resolution peak summaries.
+
+    Level 0 holds one PeakBin per channel for every baseSamplesPerBin samples,
+    each subsequent level combines levelDecimation bins of the level below.
+    Bins are interleaved by channel i.e. bin n of channel c is at [n * numChannels + c].
+*/
+class PeakPyramidBase
+{
+public:
+    static constexpr int baseSamplesPerBin = 256;
+    static constexpr int levelDecimation = 4;
+    static constexpr int maxNumLevels = 8;
+
+    struct Level
+    {
+        const PeakBin* bins = nullptr;
+        int64_t numBins = 0;
+        int64_t samplesPerBin = 0;
+    };
+
+    struct Peak
+    {
+        float minValue = 0.0f, maxValue = 0.0f, rms = 0.0f;
+    };
+
+    virtual ~PeakPyramidBase() = default;
+
+    virtual int getNumChannels() const = 0;
+    virtual double getSampleRate() const = 0;
+    virtual int64_t getNumSamples() const = 0;
+
+    /** Returns the min/max/RMS over a range of samples.
+        The coarsest level whose bins are no larger than samplesPerPixel is used
+        so the cost is roughly constant however far out the view is zoomed.
+        Whilst a pyramid is being built, any part of the range the coarse levels
+        don't cover yet is read from the finer ones.
+    */
+    Peak getPeak (int channel, juce::Range<int64_t> sampleRange, double samplesPerPixel) const;
+
+    /** Returns the absolute peak of all the channels. */
+    float getApproximatePeak() const;
+
+    /** Draws a channel as a filled min/max waveform. */
+    void drawChannel (juce::Graphics&, juce::Rectangle<int> area,
+                      juce::Range<double> timeRange, int channel, float verticalZoomFactor) const;
+
+protected:
+    /** Subclasses must lock for the duration of the callback if they're being written to. */
+    virtual void visitLevels (const std::function<void (const Level*, int numLevels)>&) const = 0;
+};
+
+//==============================================================================
+/**
+    A peak pyramid that can be built incrementally from blocks of audio, e.g.
+    whilst recording or rendering, and then written to disk.
+    It's safe to read from this whilst another thread is adding to it.
+*/
+class PeakPyramid  : public PeakPyramidBase
+{
+public:
+    PeakPyramid (int numChannels, double sampleRate);
+
+    /** Adds the next block of samples. Blocks must be added contiguously. */
+    void addBlock (const juce::AudioBuffer<float>&, int startSample, int numSamples);
+
+    /** Completes any partially filled bins. Call this once all the source has been added. */
+    void finish();
+
+    bool isFinished() const noexcept                { return finished.load (std::memory_order_acquire); }
+
+    /** Writes this to a stream in the format MappedPeakPyramid can read.
+        The source file is stored so that pyramids for deleted files can be purged.
+    */
+    bool writeTo (juce::OutputStream&, const juce::File& sourceFile = {}) const;
+
+    /** Writes this to a file, replacing it atomically. */
+    bool writeToFile (const juce::File&, const juce::File& sourceFile = {}) const;
+
+    int getNumChannels() const override             { return numChannels; }
+    double getSampleRate() const override           { return sampleRate; }
+    int64_t getNumSamples() const override          { return numSamplesAdded.load (std::memory_order_acquire); }
+
+private:
+    struct Accumulator
+    {
+        float minValue = 0.0f, maxValue = 0.0f;
+        double sumOfSquares = 0.0;
+        int64_t count = 0, numBinsWritten = 0;
+    };
+
+    const int numChannels;
+    const double sampleRate;
+    std::atomic<int64_t> numSamplesAdded { 0 };
+    std::atomic<bool> finished { false };
+
+    mutable std::shared_mutex mutex;
+    std::vector<PeakBin> levels[maxNumLevels];
+    std::vector<Accumulator> accumulators[maxNumLevels];
+
+    void emitBin (int level, int channel);
+    void visitLevels (const std::function<void (const Level*, int)>&) const override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PeakPyramid)
+};
+
+//==============================================================================
+/**
+    A read-only peak pyramid backed by a memory-mapped file.
+    Only the pages for the levels actually drawn get faulted in so opening one
+    of these is cheap regardless of the length of the source.
+*/
+class MappedPeakPyramid  : public PeakPyramidBase
+{
+public:
+    /** Maps a file. Check isValid() to find out if it could be opened. */
+    MappedPeakPyramid (const juce::File&);
+
+    bool isValid() const noexcept                   { return numLevels > 0; }
+
+    int getNumChannels() const override             { return numChannels; }
+    double getSampleRate() const override           { return sampleRate; }
+    int64_t getNumSamples() const override          { return numSamples; }
+
+    /** Returns the file the pyramid was made from, if it was stored with one. */
+    const juce::File& getSourceFile() const noexcept    { return sourceFile; }
+
+    /** Returns the raw mapped data, suitable for writing to a stream. */
+    const void* getData() const noexcept            { return mappedFile.getData(); }
+    size_t getDataSize() const noexcept             { return mappedFile.getSize(); }
+
+private:
+    juce::MemoryMappedFile mappedFile;
+    int numChannels = 0, numLevels = 0;
+    double sampleRate = 0.0;
+    int64_t numSamples = 0;
+    Level levels[maxNumLevels];
+    juce::File sourceFile;
+
+    void visitLevels (const std::function<void (const Level*, int)>&) const override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MappedPeakPyramid)
+};
+
+//==============================================================================
+/**
+    Stores peak pyramid files for audio sources and builds missing ones on a
+    pool of background threads.
+    Unlike juce::AudioThumbnailCache there's no limit on the number kept open
+    as the data is memory-mapped and paged by the OS.
+*/
+class PeakPyramidCache
+{
+public:
+    PeakPyramidCache (Engine&);
+    ~PeakPyramidCache();
+
+    /** Returns the mapped pyramid for a hash if there's an up-to-date one on disk. */
+    std::shared_ptr<const MappedPeakPyramid> getPyramid (HashCode);
+
+    /** Returns the pyramid currently being built for a hash, if there is one. */
+    std::shared_ptr<const PeakPyramid> getPyramidBeingBuilt (HashCode) const;
+
+    /** Starts building a pyramid from a reader on a background thread if one isn't
+        already on disk or being built. Returns the partial pyramid being built, or
+        nullptr if it's already available from getPyramid.
+    */
+    std::shared_ptr<const PeakPyramid> buildAsync (HashCode, std::unique_ptr<juce::AudioFormatReader>,
+                                                   const juce::File& sourceFile = {});
+
+    /** Same as above but for an AudioFile, checking the file's modification time. */
+    std::shared_ptr<const PeakPyramid> buildAsync (const AudioFile&);
+
+    /** Writes a pyramid that's been built elsewhere (e.g. during recording) to the cache.
+        As there's no source file to check, purgeOrphanedPyramids removes these once
+        they've gone unused for a while.
+    */
+    bool store (HashCode, const PeakPyramid&);
+
+    /** Writes a pyramid for an AudioFile to the cache, so it's purged if the file is deleted. */
+    bool store (const AudioFile&, const PeakPyramid&);
+
+    /** Removes any cached pyramid for a hash. */
+    void remove (HashCode);
+
+    /** Called when an AudioFile changes on disk.
+        This removes the pyramid only if it was written before the file was modified.
+    */
+    void sourceChanged (const AudioFile&);
+
+    /** Deletes any pyramids whose source files no longer exist, that can't be read,
+        or that have no source file and haven't been used for a month.
+        This is called by TemporaryFileManager::cleanUp.
+    */
+    void purgeOrphanedPyramids();
+
+    /** Returns the file a pyramid for the given hash will be stored in. */
+    juce::File getFileFor (HashCode) const;
+
+private:
+    Engine& engine;
+    std::unique_ptr<juce::ThreadPool> pool; // Created on the first build
+    mutable std::mutex mutex;
+    std::unordered_map<HashCode, std::shared_ptr<const MappedPeakPyramid>> mappedPyramids;
+    std::unordered_map<HashCode, std::shared_ptr<PeakPyramid>> pyramidsBeingBuilt;
+
+    bool writeToCache (HashCode, const PeakPyramid&, const juce::File& sourceFile);
+    void buildFinished (HashCode, std::shared_ptr<PeakPyramid>, const juce::File& sourceFile, bool succeeded);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PeakPyramidCache)
+};
+
+//==============================================================================
+/**
+    An AudioThumbnailBase that draws from a PeakPyramidCache instead of using a
+    juce::AudioThumbnailCache.
+
+    Return one of these from UIBehaviour::createAudioThumbnail or enable
+    EngineBehaviour::usePeakPyramidThumbnails to use it for SmartThumbnails.
+    Blocks added with addBlock are summarised directly e.g. whilst recording.
+*/
+class PeakPyramidThumbnail  : public juce::AudioThumbnailBase
+{
+public:
+    PeakPyramidThumbnail (Engine&);
+    ~PeakPyramidThumbnail() override;
+
+    /** Sets an AudioFile as the source, using a cached pyramid if one exists. */
+    void setSource (const AudioFile&);
+
+    //==============================================================================
+    /** @internal. */
+    void clear() override;
+    /** @internal. */
+    bool setSource (juce::InputSource*) override;
+    /** @internal. */
+    void setReader (juce::AudioFormatReader*, juce::int64 hashCode) override;
+    /** @internal. */
+    bool loadFrom (juce::InputStream&) override;
+    /** @internal. */
+    void saveTo (juce::OutputStream&) const override;
+    /** @internal. */
+    int getNumChannels() const noexcept override;
+    /** @internal. */
+    double getTotalLength() const noexcept override;
+    /** @internal. */
+    void drawChannel (juce::Graphics&, const juce::Rectangle<int>& area, double startTimeSeconds,
+                      double endTimeSeconds, int channelNum, float verticalZoomFactor) override;
+    /** @internal. */
+    void drawChannels (juce::Graphics&, const juce::Rectangle<int>& area, double startTimeSeconds,
+                       double endTimeSeconds, float verticalZoomFactor) override;
+    /** @internal. */
+    bool isFullyLoaded() const noexcept override;
+    /** @internal. */
+    juce::int64 getNumSamplesFinished() const noexcept override;
+    /** @internal. */
+    float getApproximatePeak() const override;
+    /** @internal. */
+    void getApproximateMinMax (double startTime, double endTime, int channelIndex,
+                               float& minValue, float& maxValue) const noexcept override;
+    /** @internal. */
+    juce::int64 getHashCode() const override;
+    /** @internal. */
+    void reset (int numChannels, double sampleRate, juce::int64 totalSamplesInSource) override;
+    /** @internal. */
+    void addBlock (juce::int64 sampleNumberInSource, const juce::AudioBuffer<float>&,
+                   int startOffsetInBuffer, int numSamples) override;
+
+private:
+    Engine& engine;
+    HashCode hash = 0;
+    juce::int64 totalSamples = 0;
+    mutable std::shared_ptr<const PeakPyramidBase> pyramid;
+    mutable std::shared_ptr<const PeakPyramid> building;
+    std::shared_ptr<PeakPyramid> liveBlocks;
+    mutable std::mutex pyramidLock;
+
+    std::shared_ptr<const PeakPyramidBase> getCurrentPyramid() const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PeakPyramidThumbnail)
+};
+
+}} // namespace tracktion { inline namespace engine
@@ -0,0 +1,240 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_PEAK_PYRAMID
+
+//==============================================================================
+//==============================================================================
+class PeakPyramidTests  : public juce::UnitTest
+{
+public:
+    PeakPyramidTests()
+        : juce::UnitTest ("PeakPyramid", "tracktion_engine")
+    {
+    }
+
+    void runTest() override
+    {
+        // Enough samples to fill the first few levels with a partial bin at the end
+        const int numChannels = 2;
+        const double sampleRate = 44100.0;
+        const int numSamples = PeakPyramid::baseSamplesPerBin * 64 * 3 + 123;
+        auto source = createNoise (numChannels, numSamples);
+
+        runLevelTests (source, sampleRate);
+        runPartialBuildTests (source, sampleRate);
+        runRoundTripTests (source, sampleRate);
+        runCacheTests (source, sampleRate);
+    }
+
+private:
+    static constexpr float tolerance = 1.0f / 32767.0f;
+
+    static juce::AudioBuffer<float> createNoise (int numChannels, int numSamples)
+    {
+        juce::Random r (42);
+        juce::AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int c = 0; c < numChannels; ++c)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (c, i, (r.nextFloat() * 2.0f - 1.0f) * (0.2f + 0.1f * (float) c));
+
+        return buffer;
+    }
+
+    static void addInBlocks (PeakPyramid& pyramid, const juce::AudioBuffer<float>& source, int numSamples, int blockSize)
+    {
+        for (int pos = 0; pos < numSamples; pos += blockSize)
+            pyramid.addBlock (source, pos, std::min (blockSize, numSamples - pos));
+    }
+
+    static juce::Range<float> getSourceRange (const juce::AudioBuffer<float>& source, int channel, juce::Range<int64_t> r)
+    {
+        r = r.getIntersectionWith ({ 0, (int64_t) source.getNumSamples() });
+        return juce::FloatVectorOperations::findMinAndMax (source.getReadPointer (channel, (int) r.getStart()), (int) r.getLength());
+    }
+
+    void expectPeakMatches (const PeakPyramidBase& pyramid, const juce::AudioBuffer<float>& source,
+                            int channel, juce::Range<int64_t> range, double samplesPerPixel)
+    {
+        auto peak = pyramid.getPeak (channel, range, samplesPerPixel);
+        auto expected = getSourceRange (source, channel, range);
+
+        expectWithinAbsoluteError (peak.minValue, expected.getStart(), tolerance);
+        expectWithinAbsoluteError (peak.maxValue, expected.getEnd(), tolerance);
+    }
+
+    void runLevelTests (const juce::AudioBuffer<float>& source, double sampleRate)
+    {
+        beginTest ("Levels match the source min and max");
+
+        PeakPyramid pyramid (source.getNumChannels(), sampleRate);
+        addInBlocks (pyramid, source, source.getNumSamples(), 1000);
+        pyramid.finish();
+
+        expectEquals (pyramid.getNumSamples(), (int64_t) source.getNumSamples());
+
+        for (int channel = 0; channel < source.getNumChannels(); ++channel)
+        {
+            // Ranges aligned to each level's bins
+            for (int64_t samplesPerBin = PeakPyramid::baseSamplesPerBin; samplesPerBin <= PeakPyramid::baseSamplesPerBin * 64;
+                 samplesPerBin *= PeakPyramid::levelDecimation)
+            {
+                for (int64_t start = 0; start + samplesPerBin * 2 <= source.getNumSamples(); start += samplesPerBin * 3)
+                    expectPeakMatches (pyramid, source, channel, { start, start + samplesPerBin * 2 }, (double) samplesPerBin);
+            }
+
+            // The whole source, including the partial bins at the end
+            expectPeakMatches (pyramid, source, channel, { 0, (int64_t) source.getNumSamples() }, (double) source.getNumSamples());
+
+            const auto rms = source.getRMSLevel (channel, 0, source.getNumSamples());
+            expectWithinAbsoluteError (pyramid.getPeak (channel, { 0, (int64_t) source.getNumSamples() }, 1.0e9).rms, rms, 0.01f);
+        }
+
+        expectWithinAbsoluteError (pyramid.getApproximatePeak(), source.getMagnitude (0, source.getNumSamples()), tolerance);
+    }
+
+    void runPartialBuildTests (const juce::AudioBuffer<float>& source, double sampleRate)
+    {
+        beginTest ("Partially built pyramids cover everything that's been added");
+
+        // Put a spike after the last complete coarse bin but within the complete base bins
+        auto withSpike = source;
+        const int numAdded = PeakPyramid::baseSamplesPerBin * 64 * 2 + PeakPyramid::baseSamplesPerBin * 5;
+        withSpike.setSample (0, numAdded - 10, 0.95f);
+
+        PeakPyramid pyramid (withSpike.getNumChannels(), sampleRate);
+        addInBlocks (pyramid, withSpike, numAdded, 777);
+        expect (! pyramid.isFinished());
+
+        const juce::Range<int64_t> all (0, numAdded);
+        expectPeakMatches (pyramid, withSpike, 0, all, 1.0e9);
+        expectPeakMatches (pyramid, withSpike, 1, all, 1.0e9);
+        expectWithinAbsoluteError (pyramid.getApproximatePeak(), 0.95f, tolerance);
+    }
+
+    void runRoundTripTests (const juce::AudioBuffer<float>& source, double sampleRate)
+    {
+        beginTest ("On-disk round trip");
+
+        PeakPyramid pyramid (source.getNumChannels(), sampleRate);
+        addInBlocks (pyramid, source, source.getNumSamples(), 4096);
+        pyramid.finish();
+
+        juce::TemporaryFile pyramidFile (".tpk");
+        const auto sourceFile = pyramidFile.getFile().getSiblingFile ("source.wav");
+        expect (pyramid.writeToFile (pyramidFile.getFile(), sourceFile));
+
+        MappedPeakPyramid mapped (pyramidFile.getFile());
+        expect (mapped.isValid());
+
+        if (! mapped.isValid())
+            return;
+
+        expectEquals (mapped.getNumChannels(), pyramid.getNumChannels());
+        expectEquals (mapped.getSampleRate(), pyramid.getSampleRate());
+        expectEquals (mapped.getNumSamples(), pyramid.getNumSamples());
+        expect (mapped.getSourceFile() == sourceFile);
+
+        for (int channel = 0; channel < source.getNumChannels(); ++channel)
+        {
+            for (double samplesPerPixel : { 1.0, 300.0, 5000.0, 1.0e9 })
+            {
+                const juce::Range<int64_t> range (1234, source.getNumSamples() - 17);
+                auto original = pyramid.getPeak (channel, range, samplesPerPixel);
+                auto fromDisk = mapped.getPeak (channel, range, samplesPerPixel);
+
+                expectEquals (fromDisk.minValue, original.minValue);
+                expectEquals (fromDisk.maxValue, original.maxValue);
+                expectEquals (fromDisk.rms, original.rms);
+            }
+        }
+
+        // Truncated files are rejected rather than read past the end
+        juce::TemporaryFile truncated (".tpk");
+        juce::MemoryBlock data;
+        pyramidFile.getFile().loadFileAsData (data);
+        truncated.getFile().replaceWithData (data.getData(), data.getSize() / 2);
+        expect (! MappedPeakPyramid (truncated.getFile()).isValid());
+    }
+
+    void runCacheTests (const juce::AudioBuffer<float>& source, double sampleRate)
+    {
+        auto& engine = *Engine::getEngines().getFirst();
+        auto& cache = engine.getAudioFileManager().peakPyramids;
+
+        PeakPyramid pyramid (source.getNumChannels(), sampleRate);
+        addInBlocks (pyramid, source, source.getNumSamples(), 4096);
+        pyramid.finish();
+
+        juce::TemporaryFile sourceFile (".wav");
+        expect (sourceFile.getFile().replaceWithText ("source"));
+        const AudioFile audioFile (engine, sourceFile.getFile());
+
+        beginTest ("Pyramids are invalidated when their source changes");
+        {
+            expect (cache.store (audioFile, pyramid));
+            expect (cache.getPyramid (audioFile.getHash()) != nullptr);
+
+            // Pyramids written after the source was last modified are kept
+            cache.sourceChanged (audioFile);
+            expect (cache.getPyramid (audioFile.getHash()) != nullptr);
+
+            sourceFile.getFile().setLastModificationTime (juce::Time::getCurrentTime() + juce::RelativeTime::minutes (1.0));
+            cache.sourceChanged (audioFile);
+            expect (cache.getPyramid (audioFile.getHash()) == nullptr);
+            expect (! cache.getFileFor (audioFile.getHash()).existsAsFile());
+        }
+
+        beginTest ("Pyramids for deleted sources are purged");
+        {
+            expect (cache.store (audioFile, pyramid));
+            cache.purgeOrphanedPyramids();
+            expect (cache.getFileFor (audioFile.getHash()).existsAsFile());
+
+            expect (sourceFile.deleteTemporaryFile());
+            cache.purgeOrphanedPyramids();
+            expect (cache.getPyramid (audioFile.getHash()) == nullptr);
+            expect (! cache.getFileFor (audioFile.getHash()).existsAsFile());
+        }
+
+        beginTest ("Pyramids without a source are purged once unused");
+        {
+            const HashCode hash = juce::Random::getSystemRandom().nextInt64();
+            const auto pyramidFile = cache.getFileFor (hash);
+
+            expect (cache.store (hash, pyramid));
+            cache.purgeOrphanedPyramids();
+            expect (pyramidFile.existsAsFile());
+
+            // Mapping the pyramid counts as using it
+            pyramidFile.setLastAccessTime (juce::Time::getCurrentTime() - juce::RelativeTime::days (60));
+            expect (cache.getPyramid (hash) != nullptr);
+            cache.purgeOrphanedPyramids();
+            expect (pyramidFile.existsAsFile());
+
+            cache.remove (hash);
+            expect (cache.store (hash, pyramid));
+            pyramidFile.setLastAccessTime (juce::Time::getCurrentTime() - juce::RelativeTime::days (60));
+            cache.purgeOrphanedPyramids();
+            expect (cache.getPyramid (hash) == nullptr);
+            expect (! pyramidFile.existsAsFile());
+        }
+    }
+};
+
+static PeakPyramidTests peakPyramidTests;
+
+#endif
+
+}} // namespace tracktion { inline namespace engine
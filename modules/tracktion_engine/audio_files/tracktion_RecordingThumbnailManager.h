@@ -38,13 +38,26 @@ public:
         {
             TRACKTION_ASSERT_MESSAGE_THREAD
             engine.getRecordingThumbnailManager().thumbs.removeAllInstancesOf (this);
+
+            // Store the summary built whilst recording so the file never needs to be re-read to be drawn
+            if (auto p = getPeaks(); p != nullptr && p->getNumSamples() > 0 && file.existsAsFile())
+            {
+                p->finish();
+                engine.getAudioFileManager().peakPyramids.store (AudioFile (engine, file), *p);
+            }
         }
 
-        /** Destructor */
+        /** Clears the thumbnail ready for a new recording. */
         void reset (int numChannels, double sampleRate)
         {
             thumb->reset (numChannels, sampleRate, 0);
             nextSampleNum = 0;
+
+            auto newPeaks = engine.getEngineBehaviour().usePeakPyramidThumbnails() && numChannels > 0
+                              ? std::make_shared<PeakPyramid> (numChannels, sampleRate) : nullptr;
+
+            const juce::SpinLock::ScopedLockType sl (peaksLock);
+            peaks = std::move (newPeaks);
         }
 
         /** Adss a block of recorded data to the thumbnail.
@@ -54,11 +67,22 @@ public:
         {
             thumb->addBlock (nextSampleNum, incoming, startOffsetInBuffer, numSamples);
             nextSampleNum += numSamples;
+
+            if (auto p = getPeaks())
+                p->addBlock (incoming, startOffsetInBuffer, numSamples);
         }
 
     private:
         friend class RecordingThumbnailManager;
         std::atomic<int64_t> nextSampleNum { 0 };
+        std::shared_ptr<PeakPyramid> peaks;
+        juce::SpinLock peaksLock;
+
+        std::shared_ptr<PeakPyramid> getPeaks()
+        {
+            const juce::SpinLock::ScopedLockType sl (peaksLock);
+            return peaks;
+        }
 
         Thumbnail (Engine& e, const juce::File& f)
             : engine (e),
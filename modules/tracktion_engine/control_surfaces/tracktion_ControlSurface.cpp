@@ -41,6 +41,13 @@ void ParameterSetting::clear() noexcept
     value = 0.0f;
 }
 
+bool ParameterSetting::operator== (const ParameterSetting& other) const noexcept
+{
+    return value == other.value
+            && std::strcmp (label, other.label) == 0
+            && std::strcmp (valueDescription, other.valueDescription) == 0;
+}
+
 MarkerSetting::MarkerSetting() noexcept
 {
     clear();
@@ -154,6 +161,8 @@ void ControlSurface::userTouchedParameterControl (int parameter, bool touch)
 void ControlSurface::userMovedFader (int channelNum, float newSliderPos, bool delta)
 {
     RETURN_IF_SAFE_RECORDING
+    owner->invalidateSentFader (channelNum);
+
     if (delta || pickedUp (ctrlFader, channelNum, newSliderPos))
         externalControllerManager.userMovedFader (owner->channelStart + channelNum, newSliderPos, delta);
 }
@@ -161,6 +170,8 @@ void ControlSurface::userMovedFader (int channelNum, float newSliderPos, bool de
 void ControlSurface::userMovedMasterLevelFader (float newLevel, bool delta)
 {
     RETURN_IF_SAFE_RECORDING
+    owner->invalidateSentMasterFader();
+
     if (delta || pickedUp (ctrlMasterFader, newLevel))
         externalControllerManager.userMovedMasterFader (getEdit(), newLevel, delta);
 }
@@ -168,6 +179,8 @@ void ControlSurface::userMovedMasterLevelFader (float newLevel, bool delta)
 void ControlSurface::userMovedMasterPanPot (float newPan, bool delta)
 {
     RETURN_IF_SAFE_RECORDING
+    owner->invalidateSentMasterPanPot();
+
     if (delta || pickedUp (ctrlMasterPanPot, newPan))
         externalControllerManager.userMovedMasterPanPot (getEdit(), newPan, delta);
 }
@@ -181,6 +194,8 @@ void ControlSurface::userMovedQuickParam (float newLevel)
 void ControlSurface::userMovedPanPot (int channelNum, float newPan, bool delta)
 {
     RETURN_IF_SAFE_RECORDING
+    owner->invalidateSentPanPot (channelNum);
+
     if (delta || pickedUp (ctrlPan, channelNum, newPan))
         externalControllerManager.userMovedPanPot (owner->channelStart + channelNum, newPan, delta);
 }
@@ -16,6 +16,8 @@ struct ParameterSetting
     ParameterSetting() noexcept;
     void clear() noexcept;
 
+    bool operator== (const ParameterSetting&) const noexcept;
+
     char label[32] = "";
     char valueDescription[32] = "";
     float value = 0.0f;
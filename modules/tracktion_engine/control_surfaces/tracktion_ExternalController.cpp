@@ -469,18 +469,55 @@ void ExternalController::setShowClipSlotSelectionColour (bool b)
     }
 }
 
+//==============================================================================
+template<typename Type>
+static bool hasChanged (std::optional<Type>& lastSent, const Type& newValue)
+{
+    if (lastSent == newValue)
+        return false;
+
+    lastSent = newValue;
+    return true;
+}
+
+template<typename Type>
+static bool hasChanged (std::vector<std::optional<Type>>& lastSent, int index, const Type& newValue)
+{
+    if ((size_t) index >= lastSent.size())
+        lastSent.resize ((size_t) index + 1);
+
+    return hasChanged (lastSent[(size_t) index], newValue);
+}
+
+template<typename Type>
+static void invalidate (std::vector<std::optional<Type>>& lastSent, int index)
+{
+    if (juce::isPositiveAndBelow (index, (int) lastSent.size()))
+        lastSent[(size_t) index].reset();
+}
+
+void ExternalController::invalidateSentFader (int faderIndex)
+{
+    invalidate (sentValues.faders, faderIndex);
+}
+
+void ExternalController::invalidateSentPanPot (int faderIndex)
+{
+    invalidate (sentValues.pans, faderIndex);
+}
+
 void ExternalController::moveFader (int channelNum, float newSliderPos)
 {
     int i = getFaderIndexInActiveRegion (channelNum);
 
-    if (i >= 0)
+    if (i >= 0 && hasChanged (sentValues.faders, i, newSliderPos))
         getControlSurface().moveFader (i, newSliderPos);
 }
 
 void ExternalController::moveMasterFader (float newPos)
 {
     CRASH_TRACER
-    if (controlSurface != nullptr)
+    if (controlSurface != nullptr && hasChanged (sentValues.masterFader, newPos))
         getControlSurface().moveMasterLevelFader (newPos);
 }
 
@@ -488,26 +525,27 @@ void ExternalController::movePanPot (int channelNum, float newPan)
 {
     int i = getFaderIndexInActiveRegion (channelNum);
 
-    if (i >= 0)
+    if (i >= 0 && hasChanged (sentValues.pans, i, newPan))
         getControlSurface().movePanPot (i, newPan);
 }
 
 void ExternalController::moveMasterPanPot (float newPan)
 {
-    getControlSurface().moveMasterPanPot (newPan);
+    if (controlSurface != nullptr && hasChanged (sentValues.masterPan, newPan))
+        getControlSurface().moveMasterPanPot (newPan);
 }
 
 void ExternalController::updateSoloAndMute (int channelNum, Track::MuteAndSoloLightState state, bool isBright)
 {
     int i = getFaderIndexInActiveRegion (channelNum);
 
-    if (i >= 0)
+    if (i >= 0 && hasChanged (sentValues.muteAndSoloLights, i, std::make_pair (state, isBright)))
         getControlSurface().updateSoloAndMute (i, state, isBright);
 }
 
 void ExternalController::soloCountChanged (bool anySoloTracks)
 {
-    if (controlSurface != nullptr)
+    if (controlSurface != nullptr && hasChanged (sentValues.anySoloTracks, anySoloTracks))
         getControlSurface().soloCountChanged (anySoloTracks);
 }
 
@@ -554,13 +592,13 @@ void ExternalController::channelLevelChanged (int channelNum, float l, float r)
 {
     int i = getFaderIndexInActiveRegion (channelNum);
 
-    if (i >= 0)
+    if (i >= 0 && hasChanged (sentValues.levels, i, std::make_pair (l, r)))
         getControlSurface().channelLevelChanged (i, l, r);
 }
 
 void ExternalController::masterLevelsChanged (float leftLevel, float rightLevel)
 {
-    if (controlSurface != nullptr)
+    if (controlSurface != nullptr && hasChanged (sentValues.masterLevels, std::make_pair (leftLevel, rightLevel)))
         getControlSurface().masterLevelsChanged (leftLevel, rightLevel);
 }
 
@@ -707,6 +745,8 @@ void ExternalController::updateParamList()
     if (controlSurface != nullptr)
     {
         currentParams.clear();
+        sentValues.parameters.clear();
+        sentValues.clearedParameters.clear();
 
         if (auto plugin = getCurrentPlugin())
         {
@@ -854,7 +894,7 @@ void ExternalController::updateParameters()
 
                 s.copyToUTF8 (param.valueDescription, 6);
 
-                cs.parameterChanged (i, param);
+                sendParameter (i, param);
             }
             else
             {
@@ -873,7 +913,7 @@ void ExternalController::updateParameters()
                                 .copyToUTF8 (param.label, (size_t) std::min (cs.numCharactersForParameterLabels,
                                                                              (int) sizeof (param.label) - 1));
 
-                        cs.parameterChanged (i, param);
+                        sendParameter (i, param);
                     }
                     else if (startParamNumber + i == 1)
                     {
@@ -881,11 +921,11 @@ void ExternalController::updateParameters()
                             .copyToUTF8 (param.label, (size_t) std::min (cs.numCharactersForParameterLabels,
                                                                          (int) sizeof (param.label) - 1));
 
-                        cs.parameterChanged (i, param);
+                        sendParameter (i, param);
                     }
                     else
                     {
-                        cs.clearParameter(i);
+                        sendClearParameter (i);
                     }
                 }
             }
@@ -897,7 +937,34 @@ void ExternalController::updateParameters()
     }
 
     for (int i = numAvailableParams; i < cs.numParameterControls; ++i)
-        cs.clearParameter (i);
+        sendClearParameter (i);
+}
+
+void ExternalController::updateParametersIfNeeded()
+{
+    if (updateParams.exchange (false))
+        updateParameters();
+}
+
+void ExternalController::sendParameter (int paramNumber, const ParameterSetting& param)
+{
+    sentValues.clearedParameters.clearBit (paramNumber);
+
+    if (hasChanged (sentValues.parameters, paramNumber, param))
+        getControlSurface().parameterChanged (paramNumber, param);
+}
+
+void ExternalController::sendClearParameter (int paramNumber)
+{
+    if (sentValues.clearedParameters[paramNumber])
+        return;
+
+    sentValues.clearedParameters.setBit (paramNumber);
+
+    if ((size_t) paramNumber < sentValues.parameters.size())
+        sentValues.parameters[(size_t) paramNumber].reset();
+
+    getControlSurface().clearParameter (paramNumber);
 }
 
 void ExternalController::selectedPluginChanged()
@@ -957,14 +1024,13 @@ void ExternalController::selectableObjectAboutToBeDeleted (Selectable* s)
 
 void ExternalController::curveHasChanged (AutomatableParameter&)
 {
+    // These are sent with the manager's next batch of changes
     updateParams = true;
-    triggerAsyncUpdate();
 }
 
 void ExternalController::currentValueChanged (AutomatableParameter&)
 {
     updateParams = true;
-    triggerAsyncUpdate();
 }
 
 void ExternalController::updateTrackSelectLights()
@@ -1211,6 +1277,9 @@ void ExternalController::updateDeviceState()
 {
     if (controlSurface != nullptr)
     {
+        // Everything is sent again in case the surface has lost its state
+        sentValues = {};
+
         if (auto edit = getEdit())
         {
             auto& ecm = getExternalControllerManager();
@@ -1467,12 +1536,6 @@ void ExternalController::handleAsyncUpdate()
                 getControlSurface().acceptMidiMessage (m.first, m.second);
         }
     }
-
-    if (updateParams)
-    {
-        updateParams = false;
-        updateParameters();
-    }
 }
 
 juce::String ExternalController::getNoDeviceSelectedMessage()
@@ -98,6 +98,7 @@ public:
 
     void updateDeviceState();
     void updateParameters();
+    void updateParametersIfNeeded();
     void updateMarkers();
     void selectedPluginChanged();
     void selectableObjectChanged (Selectable*) override;
@@ -206,7 +207,32 @@ private:
     int startMarkerNumber = 0;
     int auxBank = 0;
     bool followsTrackSelection;
-    bool processMidi = false, updateParams = false;
+    bool processMidi = false;
+    std::atomic<bool> updateParams { false };
+
+    // The values last sent to the surface so that ones it's already showing aren't sent again.
+    // This is keyed by the surface's channel and parameter indexes and is cleared whenever the
+    // whole surface is refreshed.
+    struct SentValues
+    {
+        std::vector<std::optional<float>> faders, pans;
+        std::vector<std::optional<std::pair<float, float>>> levels;
+        std::vector<std::optional<std::pair<Track::MuteAndSoloLightState, bool>>> muteAndSoloLights;
+        std::vector<std::optional<ParameterSetting>> parameters;
+        juce::BigInteger clearedParameters;
+        std::optional<float> masterFader, masterPan;
+        std::optional<std::pair<float, float>> masterLevels;
+        std::optional<bool> anySoloTracks;
+    };
+
+    SentValues sentValues;
+
+    // The surface no longer shows what was last sent to a control the user has moved,
+    // so these make sure the next value is sent even if it hasn't changed
+    void invalidateSentFader (int faderIndex);
+    void invalidateSentPanPot (int faderIndex);
+    void invalidateSentMasterFader()      { sentValues.masterFader.reset(); }
+    void invalidateSentMasterPanPot()     { sentValues.masterPan.reset(); }
 
     std::vector<MidiInputDevice*> inputDevices;
     std::vector<MidiOutputDevice*> outputDevices;
@@ -233,6 +259,9 @@ private:
     void userMovedParameterControl (int parameter, bool touch);
     void userPressedGoToMarker (int marker);
 
+    void sendParameter (int paramNumber, const ParameterSetting&);
+    void sendClearParameter (int paramNumber);
+
     Plugin* getCurrentPlugin() const;
 
     bool wantsClock;
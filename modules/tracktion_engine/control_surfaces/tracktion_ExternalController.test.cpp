@@ -0,0 +1,175 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_EXTERNAL_CONTROLLER
+
+#include "../utilities/tracktion_TestUtilities.h"
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+//==============================================================================
+class ExternalControllerTests  : public juce::UnitTest
+{
+public:
+    ExternalControllerTests()
+        : juce::UnitTest ("ExternalController", "tracktion_engine")
+    {
+    }
+
+    void runTest() override
+    {
+        auto& engine = *Engine::getEngines()[0];
+        auto& ecm = engine.getExternalControllerManager();
+        auto edit = test_utilities::createTestEdit (engine);
+
+        auto surface = new RecordingControlSurface (ecm);
+        auto controller = ecm.addController (surface);
+        expect (controller != nullptr);
+
+        if (controller == nullptr)
+            return;
+
+        controller->setEnabled (true);
+        ecm.setCurrentEdit (edit.get(), nullptr);
+
+        const auto trackNum = getAudioTracks (*edit)[0]->getIndexInEditTrackList();
+        const auto channel = ecm.mapTrackNumToChannelNum (trackNum);
+        expect (juce::isPositiveAndBelow (channel, surface->numberOfFaderChannels));
+
+        // Anything sent when the Edit was set isn't part of these tests
+        ecm.sendPendingChanges();
+        surface->clear();
+
+        beginTest ("Changes between sends are coalesced");
+        {
+            ecm.moveFader (trackNum, 0.31f);
+            ecm.moveFader (trackNum, 0.42f);
+            ecm.moveFader (trackNum, 0.53f);
+            ecm.movePanPot (trackNum, -0.2f);
+            ecm.movePanPot (trackNum, 0.4f);
+            ecm.channelLevelChanged (trackNum, 0.1f, 0.2f);
+            ecm.channelLevelChanged (trackNum, 0.3f, 0.4f);
+            ecm.masterLevelsChanged (0.5f, 0.6f);
+            ecm.masterLevelsChanged (0.7f, 0.8f);
+            ecm.sendPendingChanges();
+
+            expect (surface->faders == Sent<float> { { channel, 0.53f } });
+            expect (surface->pans == Sent<float> { { channel, 0.4f } });
+            expect (surface->levels == Sent<std::pair<float, float>> { { channel, { 0.3f, 0.4f } } });
+            expect (surface->masterLevels == Sent<std::pair<float, float>> { { -1, { 0.7f, 0.8f } } });
+
+            surface->clear();
+            ecm.sendPendingChanges();
+            expect (surface->isEmpty());
+        }
+
+        beginTest ("Unchanged values aren't sent again");
+        {
+            ecm.moveFader (trackNum, 0.53f);
+            ecm.movePanPot (trackNum, 0.4f);
+            ecm.channelLevelChanged (trackNum, 0.3f, 0.4f);
+            ecm.masterLevelsChanged (0.7f, 0.8f);
+            ecm.sendPendingChanges();
+            expect (surface->isEmpty());
+
+            ecm.moveFader (trackNum, 0.64f);
+            ecm.movePanPot (trackNum, 0.4f);
+            ecm.sendPendingChanges();
+            expect (surface->faders == Sent<float> { { channel, 0.64f } });
+            expect (surface->pans.empty());
+
+            surface->clear();
+        }
+
+        beginTest ("Values are sent again after the user moves a control");
+        {
+            surface->userMovedFader (channel, 0.9f, false);
+            surface->userMovedPanPot (channel, -0.9f, false);
+
+            // The Edit's values haven't changed but the surface's controls no longer show them
+            ecm.moveFader (trackNum, 0.64f);
+            ecm.movePanPot (trackNum, 0.4f);
+            ecm.sendPendingChanges();
+            expect (surface->faders == Sent<float> { { channel, 0.64f } });
+            expect (surface->pans == Sent<float> { { channel, 0.4f } });
+
+            surface->clear();
+            ecm.moveFader (trackNum, 0.64f);
+            ecm.movePanPot (trackNum, 0.4f);
+            ecm.sendPendingChanges();
+            expect (surface->isEmpty());
+        }
+
+        controller->setEnabled (false);
+        ecm.deleteController (controller);
+        ecm.setCurrentEdit (nullptr, nullptr);
+    }
+
+private:
+    template<typename Type>
+    using Sent = std::vector<std::pair<int, Type>>;
+
+    /** Records the values the ExternalController sends to it. */
+    struct RecordingControlSurface  : public ControlSurface
+    {
+        RecordingControlSurface (ExternalControllerManager& ecm)
+            : ControlSurface (ecm)
+        {
+            deviceDescription = "ExternalControllerTests";
+            needsMidiChannel = false;
+            numberOfFaderChannels = 8;
+        }
+
+        void moveFader (int channelNum, float newSliderPos) override
+        {
+            ControlSurface::moveFader (channelNum, newSliderPos);
+            faders.emplace_back (channelNum, newSliderPos);
+        }
+
+        void movePanPot (int channelNum, float newPan) override
+        {
+            pans.emplace_back (channelNum, newPan);
+        }
+
+        void channelLevelChanged (int channel, float l, float r) override
+        {
+            levels.emplace_back (channel, std::make_pair (l, r));
+        }
+
+        void masterLevelsChanged (float leftLevel, float rightLevel) override
+        {
+            masterLevels.emplace_back (-1, std::make_pair (leftLevel, rightLevel));
+        }
+
+        bool isEmpty() const
+        {
+            return faders.empty() && pans.empty() && levels.empty() && masterLevels.empty();
+        }
+
+        void clear()
+        {
+            faders.clear();
+            pans.clear();
+            levels.clear();
+            masterLevels.clear();
+        }
+
+        Sent<float> faders, pans;
+        Sent<std::pair<float, float>> levels, masterLevels;
+    };
+};
+
+static ExternalControllerTests externalControllerTests;
+
+}} // namespace tracktion { inline namespace engine
+
+#endif
@@ -196,20 +196,77 @@ private:
 };
 
 //==============================================================================
-ExternalControllerManager::ExternalControllerManager (Engine& e) : engine (e)
+/** Holds the latest values of the controls that change continuously until the
+    next update sends them to the controllers.
+
+    Values can be set from any thread. Channels are stored by the track's index in
+    the Edit and only mapped to controller channels when they're sent, so however
+    many times a control changes between updates it's only mapped and sent once.
+*/
+struct ExternalControllerManager::PendingChanges
+{
+    struct Channel
+    {
+        std::optional<float> fader, pan;
+        std::optional<std::pair<float, float>> levels;
+    };
+
+    struct Timecode
+    {
+        int barsOrHours = 0, beatsOrMinutes = 0, ticksOrSeconds = 0, millisecs = 0;
+        bool isBarsBeats = false, isFrames = false;
+    };
+
+    struct Changes
+    {
+        std::map<int, Channel> channels;
+        std::optional<float> masterFader, masterPan;
+        std::optional<std::pair<float, float>> masterLevels;
+        std::optional<Timecode> timecode;
+        std::optional<bool> onlyUpdateFlashingLights;
+    };
+
+    template<typename Function>
+    void update (Function&& f)
+    {
+        const std::scoped_lock sl (mutex);
+        f (changes);
+    }
+
+    Changes take()
+    {
+        Changes taken;
+
+        {
+            const std::scoped_lock sl (mutex);
+            std::swap (taken, changes);
+        }
+
+        return taken;
+    }
+
+private:
+    std::mutex mutex;
+    Changes changes;
+};
+
+//==============================================================================
+ExternalControllerManager::ExternalControllerManager (Engine& e)
+    : engine (e), pendingChanges (std::make_unique<PendingChanges>())
 {
     blinkTimer = std::make_unique<BlinkTimer> (*this);
-    masterLevelsTimer.setCallback ([this]
+    updateTimer.setCallback ([this]
     {
         if (currentEdit == nullptr)
             return;
 
-        auto ctx = currentEdit->getCurrentPlaybackContext();
-        if (ctx == nullptr)
-            return;
+        if (auto ctx = currentEdit->getCurrentPlaybackContext())
+        {
+            auto l = ctx->masterLevels.getLevelCache();
+            masterLevelsChanged (dbToGain (l.first), dbToGain (l.second));
+        }
 
-        auto l = ctx->masterLevels.getLevelCache();
-        masterLevelsChanged (dbToGain (l.first), dbToGain (l.second));
+        sendPendingChanges();
     });
 }
 
@@ -224,6 +281,12 @@ ExternalControllerManager::~ExternalControllerManager()
 void ExternalControllerManager::initialise()
 {
     CRASH_TRACER
+
+    if (initialised)
+        return;
+
+    initialised = true;
+
     TRACKTION_LOG ("Creating Default Controllers...");
 
    #if TRACKTION_ENABLE_CONTROL_SURFACES
@@ -286,6 +349,7 @@ void ExternalControllerManager::shutdown()
     devices.clear();
     automap = nullptr;
     currentEdit = nullptr;
+    initialised = false;
 }
 
 ExternalController* ExternalControllerManager::addNewController (ControlSurface* cs)
@@ -310,15 +374,18 @@ void ExternalControllerManager::setCurrentEdit (Edit* newEdit, SelectionManager*
 
         currentEdit = newEdit;
 
+        // Anything pending was for the old Edit's tracks
+        pendingChanges->take();
+
         if (currentEdit != nullptr)
         {
-            masterLevelsTimer.startTimer (1000 / 50);
+            updateTimer.startTimerHz (updateRate);
             currentEdit->getTransport().addChangeListener (this);
             editTreeWatcher = std::make_unique<EditTreeWatcher> (*this, *currentEdit);
         }
         else
         {
-            masterLevelsTimer.stopTimer();
+            updateTimer.stopTimer();
         }
     }
 
@@ -537,6 +604,72 @@ void ExternalControllerManager::timerCallback()
     updateMarkers();
 }
 
+//==============================================================================
+void ExternalControllerManager::setUpdateRate (int updatesPerSecond)
+{
+    updateRate = juce::jlimit (1, 100, updatesPerSecond);
+
+    if (updateTimer.isTimerRunning())
+        updateTimer.startTimerHz (updateRate);
+}
+
+void ExternalControllerManager::sendPendingChanges()
+{
+    CRASH_TRACER
+    JUCE_ASSERT_MESSAGE_THREAD
+    auto changes = pendingChanges->take();
+
+    if (currentEdit == nullptr)
+        return;
+
+    const auto activeDevices = getActiveDevices();
+
+    if (activeDevices.isEmpty())
+        return;
+
+    for (auto& [trackNum, channel] : changes.channels)
+    {
+        auto chan = mapTrackNumToChannelNum (trackNum);
+
+        if (chan < 0)
+            continue;
+
+        for (auto d : activeDevices)
+        {
+            if (channel.fader)
+                d->moveFader (chan, *channel.fader);
+
+            if (channel.pan)
+                d->movePanPot (chan, *channel.pan);
+
+            if (channel.levels)
+                d->channelLevelChanged (chan, channel.levels->first, channel.levels->second);
+        }
+    }
+
+    for (auto d : activeDevices)
+    {
+        if (changes.masterFader)
+            d->moveMasterFader (*changes.masterFader);
+
+        if (changes.masterPan)
+            d->moveMasterPanPot (*changes.masterPan);
+
+        if (changes.masterLevels)
+            d->masterLevelsChanged (changes.masterLevels->first, changes.masterLevels->second);
+
+        if (auto& tc = changes.timecode)
+            d->timecodeChanged (tc->barsOrHours, tc->beatsOrMinutes, tc->ticksOrSeconds,
+                                tc->millisecs, tc->isBarsBeats, tc->isFrames);
+    }
+
+    if (changes.onlyUpdateFlashingLights)
+        sendMuteSoloLights (*changes.onlyUpdateFlashingLights);
+
+    for (auto d : activeDevices)
+        d->updateParametersIfNeeded();
+}
+
 //==============================================================================
 ExternalControllerManager::BlinkTimer::BlinkTimer (ExternalControllerManager& e) : ecm (e)
 {
@@ -566,6 +699,14 @@ void ExternalControllerManager::blinkNow()
 }
 
 void ExternalControllerManager::updateMuteSoloLights (bool onlyUpdateFlashingLights)
+{
+    pendingChanges->update ([onlyUpdateFlashingLights] (auto& c)
+    {
+        c.onlyUpdateFlashingLights = c.onlyUpdateFlashingLights.value_or (true) && onlyUpdateFlashingLights;
+    });
+}
+
+void ExternalControllerManager::sendMuteSoloLights (bool onlyUpdateFlashingLights)
 {
     if (currentEdit == nullptr)
         return;
@@ -609,16 +750,12 @@ void ExternalControllerManager::updateMuteSoloLights (bool onlyUpdateFlashingLig
 //==============================================================================
 void ExternalControllerManager::moveFader (int channelNum, float newSliderPos)
 {
-    auto chan = mapTrackNumToChannelNum (channelNum);
-
-    FOR_EACH_ACTIVE_DEVICE (moveFader (chan, newSliderPos));
+    pendingChanges->update ([&] (auto& c) { c.channels[channelNum].fader = newSliderPos; });
 }
 
 void ExternalControllerManager::movePanPot (int channelNum, float newPan)
 {
-    auto chan = mapTrackNumToChannelNum (channelNum);
-
-    FOR_EACH_ACTIVE_DEVICE (movePanPot (chan, newPan));
+    pendingChanges->update ([&] (auto& c) { c.channels[channelNum].pan = newPan; });
 }
 
 void ExternalControllerManager::updateVolumePlugin (VolumeAndPanPlugin& vp)
@@ -627,24 +764,17 @@ void ExternalControllerManager::updateVolumePlugin (VolumeAndPanPlugin& vp)
     {
         if (t->getVolumePlugin() == &vp)
         {
-            auto chan = mapTrackNumToChannelNum (t->getIndexInEditTrackList());
-
-            for (auto c : devices)
-            {
-                if (c->isEnabled())
-                {
-                    c->moveFader (chan, vp.getSliderPos());
-                    c->movePanPot (chan, vp.getPan());
-                }
-            }
+            auto trackNum = t->getIndexInEditTrackList();
+            moveFader (trackNum, vp.getSliderPos());
+            movePanPot (trackNum, vp.getPan());
         }
     }
     else
     {
         if (vp.edit.getMasterVolumePlugin().get() == &vp)
         {
-            FOR_EACH_ACTIVE_DEVICE (moveMasterFader (vp.getSliderPos()));
-            FOR_EACH_ACTIVE_DEVICE (moveMasterPanPot (vp.getPan()));
+            moveMasterFader (vp.getSliderPos());
+            moveMasterPanPot (vp.getPan());
         }
     }
 }
@@ -657,30 +787,21 @@ void ExternalControllerManager::updateVCAPlugin (VCAPlugin& vca)
     {
         if (t->getVCAPlugin() == &vca)
         {
-            auto chan = mapTrackNumToChannelNum (t->getIndexInEditTrackList());
-
-            for (auto c : devices)
-            {
-                if (c->isEnabled())
-                {
-                    c->moveFader (chan, vca.getSliderPos());
-                    c->movePanPot (chan, 0.0f);
-                }
-            }
+            auto trackNum = t->getIndexInEditTrackList();
+            moveFader (trackNum, vca.getSliderPos());
+            movePanPot (trackNum, 0.0f);
         }
     }
 }
 
 void ExternalControllerManager::moveMasterFader (float newPos)
 {
-    CRASH_TRACER
-    FOR_EACH_ACTIVE_DEVICE (moveMasterFader (newPos));
+    pendingChanges->update ([&] (auto& c) { c.masterFader = newPos; });
 }
 
 void ExternalControllerManager::moveMasterPanPot (float newPan)
 {
-    CRASH_TRACER
-    FOR_EACH_ACTIVE_DEVICE (moveMasterPanPot (newPan));
+    pendingChanges->update ([&] (auto& c) { c.masterPan = newPan; });
 }
 
 void ExternalControllerManager::soloCountChanged (bool anySoloTracks)
@@ -709,35 +830,24 @@ void ExternalControllerManager::automationModeChanged (bool isReading, bool isWr
 
 void ExternalControllerManager::channelLevelChanged (int channel, float l, float r)
 {
-    CRASH_TRACER
-    // This is an optimisation that avoids calling mapTrackNumToChannelNum if there are no enabled/active devices
-    std::optional<int> channelNum;
-
-    if (currentEdit == nullptr)
-        return;
-
-    auto getChannelNum = [&]
-    {
-        if (! channelNum)
-            channelNum = mapTrackNumToChannelNum (channel);
-
-        return *channelNum;
-    };
-
-    FOR_EACH_ACTIVE_DEVICE (channelLevelChanged (getChannelNum(), l, r));
+    // The channel is only mapped to the controllers' channels when it's sent, so
+    // meters updating between sends don't have to iterate the Edit's tracks
+    pendingChanges->update ([&] (auto& c) { c.channels[channel].levels = std::make_pair (l, r); });
 }
 
 void ExternalControllerManager::masterLevelsChanged (float leftLevel, float rightLevel)
 {
-    CRASH_TRACER
-    FOR_EACH_ACTIVE_DEVICE (masterLevelsChanged (leftLevel, rightLevel));
+    pendingChanges->update ([&] (auto& c) { c.masterLevels = std::make_pair (leftLevel, rightLevel); });
 }
 
 void ExternalControllerManager::timecodeChanged (int barsOrHours, int beatsOrMinutes, int ticksOrSeconds,
                                                  int millisecs, bool isBarsBeats, bool isFrames)
 {
-    CRASH_TRACER
-    FOR_EACH_ACTIVE_DEVICE (timecodeChanged (barsOrHours, beatsOrMinutes, ticksOrSeconds, millisecs, isBarsBeats, isFrames));
+    pendingChanges->update ([&] (auto& c)
+    {
+        c.timecode = PendingChanges::Timecode { barsOrHours, beatsOrMinutes, ticksOrSeconds,
+                                                millisecs, isBarsBeats, isFrames };
+    });
 }
 
 void ExternalControllerManager::snapChanged (bool isOn)
@@ -38,9 +38,15 @@ public:
     //==============================================================================
     ~ExternalControllerManager() override;
 
+    /** Creates the control surfaces. This does nothing if it's already been called.
+        @see EngineBehaviour::autoInitialiseExternalControllers
+    */
     void initialise();
     void shutdown();
 
+    /** Returns true if initialise has been called. */
+    bool isInitialised() const noexcept                 { return initialised; }
+
     //==============================================================================
     /** Callback that can be set to determine if a track is visible on a controller or not. */
     std::function<bool (const Track&)> isVisibleOnControlSurface;
@@ -100,11 +106,30 @@ public:
     ExternalController* addController (ControlSurface*);
     void deleteController (ExternalController*);
 
+    //==============================================================================
+    /** Sets how many times a second the faders, pan pots, meters, mute/solo lights,
+        timecode and plugin parameters that have changed are sent to the controllers.
+
+        Changes made between updates are coalesced so only the latest value of each
+        control is sent, and each controller is only sent the values that differ from
+        what it's already showing.
+    */
+    void setUpdateRate (int updatesPerSecond);
+
+    /** Returns the number of times a second changes are sent to the controllers. */
+    int getUpdateRate() const noexcept                  { return updateRate; }
+
+    /** Sends any changes waiting for the next update to the controllers now. */
+    void sendPendingChanges();
+
     //==============================================================================
     // these get called by stuff in the application to make the controllers react
     // appropriately..
 
-    // channels are virtual - i.e. not restricted to physical chans
+    // channels are virtual - i.e. not restricted to physical chans.
+    // moveFader, movePanPot, channelLevelChanged, the master level and pan methods,
+    // timecodeChanged and updateMuteSoloLights can be called from any thread, the
+    // changes are sent to the controllers on the message thread at the update rate.
     void moveFader (int channelNum, float newSliderPos);
     void moveMasterFader (float newPos);
     void movePanPot (int channelNum, float newPan);
@@ -204,6 +229,7 @@ private:
     juce::OwnedArray<ExternalController> devices;
 
     NovationAutomap* automap = nullptr;
+    bool initialised = false;
 
     uint32_t lastUpdate = 0;
     Edit* currentEdit = nullptr;
@@ -219,12 +245,16 @@ private:
 
     std::unique_ptr<BlinkTimer> blinkTimer;
 
-    LambdaTimer masterLevelsTimer;
+    struct PendingChanges;
+    std::unique_ptr<PendingChanges> pendingChanges;
+    LambdaTimer updateTimer;
+    int updateRate = 25;
 
     ExternalController* addNewController (ControlSurface*);
 
     juce::Array<ExternalController*> getActiveDevices() const;
     void blinkNow();
+    void sendMuteSoloLights (bool onlyUpdateFlashingLights);
     void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ExternalControllerManager)
@@ -1230,34 +1230,51 @@ const juce::Array<MidiSysexEvent*>& MidiList::getSysexEvents() const
 }
 
 //==============================================================================
-void MidiList::moveAllBeatPositions (BeatDuration delta, juce::UndoManager* um)
+// Bulk edits are recorded as a single compact undo transaction rather than
+// one full property change action per event
+static void setNoteStartAndLength (ValueTreeDeltaRecorder& recorder, MidiNote& note,
+                                   BeatPosition newStartBeat, BeatDuration newLengthInBeats)
+{
+    newStartBeat = std::max (BeatPosition(), newStartBeat);
+
+    if (newLengthInBeats <= BeatDuration())
+        newLengthInBeats = BeatDuration::fromBeats (1.0 / Edit::ticksPerQuarterNote);
+
+    recorder.setProperty (note.state, IDs::b, newStartBeat.inBeats());
+    recorder.setProperty (note.state, IDs::l, newLengthInBeats.inBeats());
+}
+
+void MidiList::moveAllBeatPositions (BeatDuration delta, juce::UndoManager* um, UndoJournal* journal)
 {
     if (delta != BeatDuration())
     {
+        ValueTreeDeltaRecorder recorder (um, journal);
+
         for (auto e : getNotes())
-            e->setStartAndLength (e->getStartBeat() + delta, e->getLengthBeats(), um);
+            setNoteStartAndLength (recorder, *e, e->getStartBeat() + delta, e->getLengthBeats());
 
         for (auto e : getControllerEvents())
-            e->setBeatPosition (e->getBeatPosition() + delta, um);
+            recorder.setProperty (e->state, IDs::b, std::max (BeatPosition(), e->getBeatPosition() + delta).inBeats());
 
         for (auto e : getSysexEvents())
-            e->setBeatPosition (e->getBeatPosition() + delta, um);
+            recorder.setProperty (e->state, IDs::time, std::max (0.0, (e->getBeatPosition() + delta).inBeats()));
     }
 }
 
-void MidiList::rescale (double factor, juce::UndoManager* um)
+void MidiList::rescale (double factor, juce::UndoManager* um, UndoJournal* journal)
 {
     if (factor != 1.0 && factor > 0.001 && factor < 1000.0)
     {
+        ValueTreeDeltaRecorder recorder (um, journal);
+
         for (auto e : getNotes())
-            e->setStartAndLength (e->getStartBeat() * factor,
-                                  e->getLengthBeats() * factor, um);
+            setNoteStartAndLength (recorder, *e, e->getStartBeat() * factor, e->getLengthBeats() * factor);
 
         for (auto e : getControllerEvents())
-            e->setBeatPosition (e->getBeatPosition() * factor, um);
+            recorder.setProperty (e->state, IDs::b, std::max (BeatPosition(), e->getBeatPosition() * factor).inBeats());
 
         for (auto e : getSysexEvents())
-            e->setBeatPosition (e->getBeatPosition() * factor, um);
+            recorder.setProperty (e->state, IDs::time, std::max (0.0, (e->getBeatPosition() * factor).inBeats()));
     }
 }
 
@@ -2003,4 +2020,60 @@ juce::MidiMessageSequence MidiList::createDefaultPlaybackMidiSequence (const Mid
     return destSequence;
 }
 
+bool MidiList::updateDefaultPlaybackMidiSequence (juce::MidiMessageSequence& seq, const MidiList& list, const MidiClip& clip,
+                                                  const MidiNote& note, int oldNoteNumber, BeatRange oldBeats)
+{
+    // Overlapping notes with the same number have their note-offs left out so if
+    // the note touches another one, either before or after, the sequence can't be patched
+    auto overlapsAnotherNote = [&list, &note] (int noteNumber, BeatRange beats)
+    {
+        for (auto n : list.getNotes())
+        {
+            if (n->getStartBeat() > beats.getEnd())
+                break;
+
+            if (n != &note && n->getNoteNumber() == noteNumber && n->getEndBeat() >= beats.getStart())
+                return true;
+        }
+
+        return false;
+    };
+
+    if (overlapsAnotherNote (oldNoteNumber, oldBeats) || overlapsAnotherNote (note.getNoteNumber(), note.getRangeBeats()))
+        return false;
+
+    const auto channelNumber = list.getMidiChannel().getChannelNumber();
+
+    auto findEvent = [&seq, channelNumber, oldNoteNumber] (bool isNoteOn, double time)
+    {
+        for (int i = seq.getNextIndexAtTime (time); i < seq.getNumEvents(); ++i)
+        {
+            auto& m = seq.getEventPointer (i)->message;
+
+            if (m.getTimeStamp() > time)
+                break;
+
+            if ((isNoteOn ? m.isNoteOn() : m.isNoteOff())
+                 && m.getChannel() == channelNumber && m.getNoteNumber() == oldNoteNumber)
+                return i;
+        }
+
+        return -1;
+    };
+
+    // These are the times addToSequence will have used
+    const auto noteOnIndex = findEvent (true, std::max (0.0, oldBeats.getStart().inBeats()));
+    const auto noteOffIndex = findEvent (false, oldBeats.getEnd().inBeats());
+
+    // If the note was muted or too short there won't be any events, these are rare enough to just start again
+    if (noteOnIndex < 0 || noteOffIndex < 0)
+        return false;
+
+    seq.deleteEvent (std::max (noteOnIndex, noteOffIndex), false);
+    seq.deleteEvent (std::min (noteOnIndex, noteOffIndex), false);
+
+    addToSequence (seq, clip, TimeBase::beatsRaw, note, channelNumber, true, nullptr);
+    return true;
+}
+
 }} // namespace tracktion { inline namespace engine
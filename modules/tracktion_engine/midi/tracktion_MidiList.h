@@ -65,8 +65,15 @@ public:
 
     void clear (juce::UndoManager*);
     void trimOutside (BeatPosition firstBeat, BeatPosition lastBeat, juce::UndoManager*);
-    void moveAllBeatPositions (BeatDuration deltaBeats, juce::UndoManager*);
-    void rescale (double factor, juce::UndoManager*);
+
+    /** Moves every event, recording the changes as one compact undo transaction.
+        If a journal is supplied, the transaction's data may be moved to disk once it's old.
+        @see ValueTreeDeltaRecorder
+    */
+    void moveAllBeatPositions (BeatDuration deltaBeats, juce::UndoManager*, UndoJournal* = nullptr);
+
+    /** Scales every event's position and length in the same way as moveAllBeatPositions. */
+    void rescale (double factor, juce::UndoManager*, UndoJournal* = nullptr);
 
     //==============================================================================
     int getNumNotes() const                                         { return getNotes().size(); }
@@ -152,6 +159,15 @@ public:
     /** Creates the default MIDI playback sequence. */
     static juce::MidiMessageSequence createDefaultPlaybackMidiSequence (const MidiList&, MidiClip&, TimeBase, bool generateMPE);
 
+    /** Updates a sequence created by createDefaultPlaybackMidiSequence with the beatsRaw
+        TimeBase and no MPE after a single note has changed, rather than creating it again.
+        oldNoteNumber and oldBeats are what the note was when its events were added.
+        Returns false, leaving the sequence untouched, if the note's old events can't be
+        found or it overlapped or now overlaps another note with the same number.
+    */
+    static bool updateDefaultPlaybackMidiSequence (juce::MidiMessageSequence&, const MidiList&, const MidiClip&,
+                                                   const MidiNote&, int oldNoteNumber, BeatRange oldBeats);
+
     //==============================================================================
     static bool looksLikeMPEData (const juce::File&);
 
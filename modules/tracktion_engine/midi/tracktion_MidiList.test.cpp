@@ -55,6 +55,70 @@ public:
             um->dispatchPendingMessages();
             expect (edit->hasChangedSinceSaved());
         }
+
+        beginTest ("Cached playback sequence");
+        {
+            auto& engine = *Engine::getEngines()[0];
+            auto edit = createTestEdit (engine);
+            auto track = getAudioTracks (*edit)[0];
+            auto mc = insertMIDIClip (*track, { 0_tp, 8_tp });
+
+            auto& list = mc->getSequence();
+            auto n1 = list.addNote (60, 0_bp, 1_bd, 100, 0, nullptr);
+            auto n2 = list.addNote (62, 1_bp, 1_bd, 100, 0, nullptr);
+            auto n3 = list.addNote (64, 2_bp, 1_bd, 100, 0, nullptr);
+
+            // Events at the same time can be in any order so compare them sorted
+            auto describe = [] (const juce::MidiMessageSequence& seq)
+            {
+                juce::StringArray events;
+
+                for (auto meh : seq)
+                    events.add (juce::String (meh->message.getTimeStamp()) + " " + meh->message.getDescription());
+
+                events.sort (false);
+                return events;
+            };
+
+            auto expectMatchesExport = [&] (MidiList::TimeBase timeBase)
+            {
+                auto& source = timeBase == MidiList::TimeBase::beatsRaw ? mc->getSequence() : mc->getSequenceLooped();
+                expect (describe (mc->getPlaybackMidiSequence (timeBase, false))
+                          == describe (source.exportToPlaybackMidiSequence (*mc, timeBase, false)));
+            };
+
+            for (auto timeBase : { MidiList::TimeBase::beatsRaw, MidiList::TimeBase::seconds })
+                expectMatchesExport (timeBase);
+
+            // Single note edits
+            n2->setStartAndLength (3_bp, 2_bd, nullptr);
+            expectMatchesExport (MidiList::TimeBase::beatsRaw);
+
+            n1->setNoteNumber (65, nullptr);
+            n1->setVelocity (50, nullptr);
+            expectMatchesExport (MidiList::TimeBase::beatsRaw);
+
+            // Overlapping notes with the same number
+            n3->setNoteNumber (65, nullptr);
+            n3->setStartAndLength (0.5_bp, 1_bd, nullptr);
+            expectMatchesExport (MidiList::TimeBase::beatsRaw);
+
+            // Muting and other events
+            n2->setMute (true, nullptr);
+            expectMatchesExport (MidiList::TimeBase::beatsRaw);
+
+            list.addControllerEvent (1_bp, 7, 64 << 7, nullptr);
+            n1->setStartAndLength (4_bp, 1_bd, nullptr);
+            expectMatchesExport (MidiList::TimeBase::beatsRaw);
+
+            // Clip and tempo changes
+            expectMatchesExport (MidiList::TimeBase::seconds);
+            mc->setStart (1_tp, false, true);
+            expectMatchesExport (MidiList::TimeBase::seconds);
+            edit->tempoSequence.getTempo (0)->setBpm (90.0);
+            expectMatchesExport (MidiList::TimeBase::seconds);
+            expectMatchesExport (MidiList::TimeBase::beatsRaw);
+        }
     }
 };
 
@@ -83,13 +83,9 @@ void AutomatableEditItem::deleteAutomatableParameters()
     parameterTree.clear();
 
     {
-        // N.B. swap under the lock here to minimise the time held
-        juce::ReferenceCountedArray<AutomatableParameter> nowActiveParams;
-
-        {
-            const std::scoped_lock sl (activeParameterLock);
-            std::swap (activeParameters, nowActiveParams);
-        }
+        // Wait for the audio thread here so the parameters are deleted along with the list
+        const std::scoped_lock sl (activeParameterWriteLock);
+        publishActiveParameters ({}, true);
     }
 
     sendListChangeMessage();
@@ -158,10 +154,15 @@ void AutomatableEditItem::updateAutomatableParamPosition (TimePosition time)
 
 void AutomatableEditItem::updateParameterStreams (TimePosition time)
 {
-    const std::scoped_lock sl (activeParameterLock);
+    // Registering as a reader stops the list being deleted whilst it's iterated.
+    // N.B. this must happen before the list is loaded, see publishActiveParameters
+    numActiveParameterReaders.fetch_add (1);
+
+    if (auto list = activeParameterList.load())
+        for (auto p : list->rawParameters)
+            p->updateFromAutomationSources (time);
 
-    for (auto p : activeParameters)
-        p->updateFromAutomationSources (time);
+    numActiveParameterReaders.fetch_sub (1);
 }
 
 void AutomatableEditItem::resetRecordingStatus()
@@ -180,30 +181,19 @@ void AutomatableEditItem::addActiveParameter (const AutomatableParameter& p)
 {
     if (auto param = automatableParams[automatableParams.indexOf (&p)])
     {
-        // This confusing order is to avoid allocating whilst the lock is held
+        const std::scoped_lock sl (activeParameterWriteLock);
         juce::ReferenceCountedArray<AutomatableParameter> newParams;
-        int numParams = 0;
 
-         {
-            const std::scoped_lock sl (activeParameterLock);
-
-            if (activeParameters.contains (param))
+        if (currentActiveParameterList != nullptr)
+        {
+            if (currentActiveParameterList->parameters.contains (param))
                 return;
 
-            numParams = activeParameters.size() + 1;
-        }
-
-        newParams.ensureStorageAllocated (numParams);
-
-        {
-            const std::scoped_lock sl (activeParameterLock);
-            newParams = activeParameters;
+            newParams = currentActiveParameterList->parameters;
         }
 
         newParams.add (param);
-
-        const std::scoped_lock sl (activeParameterLock);
-        std::swap (activeParameters, newParams);
+        publishActiveParameters (std::move (newParams), false);
     }
 
     lastTime = -1.0s;
@@ -213,34 +203,45 @@ void AutomatableEditItem::removeActiveParameter (const AutomatableParameter& p)
 {
     if (auto param = automatableParams[automatableParams.indexOf (&p)])
     {
-        // This confusing order is to avoid removing whilst the lock is held,
-        // juce::ReferenceCountedArray can free when that happens
-        juce::ReferenceCountedArray<AutomatableParameter> nowActiveParams;
-        int numParams = 0;
+        const std::scoped_lock sl (activeParameterWriteLock);
 
-        {
-            const std::scoped_lock sl (activeParameterLock);
+        if (currentActiveParameterList == nullptr
+            || ! currentActiveParameterList->parameters.contains (param))
+           return;
 
-            if (! activeParameters.contains (param))
-                return;
+        auto newParams = currentActiveParameterList->parameters;
+        newParams.removeObject (param);
+        publishActiveParameters (std::move (newParams), false);
+    }
 
-            numParams = activeParameters.size() - 1;
-        }
+    lastTime = -1.0s;
+}
 
-        nowActiveParams.ensureStorageAllocated (numParams);
+void AutomatableEditItem::publishActiveParameters (juce::ReferenceCountedArray<AutomatableParameter> newParams, bool waitForReaders)
+{
+    auto newList = std::make_unique<ActiveParameterList>();
+    newList->rawParameters.assign (newParams.begin(), newParams.end());
+    newList->parameters = std::move (newParams);
 
-        {
-            const std::scoped_lock sl (activeParameterLock);
-            nowActiveParams = activeParameters;
-        }
+    // Once the new list has been stored, any reader that registers afterwards will
+    // see it, so if there are no readers at this point the old lists can't be in use.
+    // Otherwise they're kept until the next time the list changes.
+    activeParameterList.store (newList.get());
 
-        nowActiveParams.removeObject (param);
+    if (currentActiveParameterList != nullptr)
+        retiredActiveParameterLists.push_back (std::move (currentActiveParameterList));
 
-        const std::scoped_lock sl (activeParameterLock);
-        std::swap (activeParameters, nowActiveParams);
-    }
+    currentActiveParameterList = std::move (newList);
 
-    lastTime = -1.0s;
+    if (retiredActiveParameterLists.empty())
+        return;
+
+    if (waitForReaders)
+        while (numActiveParameterReaders.load() != 0)
+            std::this_thread::yield();
+
+    if (numActiveParameterReaders.load() == 0)
+        retiredActiveParameterLists.clear();
 }
 
 //==============================================================================
@@ -295,8 +296,9 @@ juce::ReferenceCountedArray<AutomatableParameter> AutomatableEditItem::getFlatte
 
 bool AutomatableEditItem::isActiveParameter (AutomatableParameter& p)
 {
-    const std::scoped_lock sl (activeParameterLock);
-    return activeParameters.contains (p);
+    const std::scoped_lock sl (activeParameterWriteLock);
+    return currentActiveParameterList != nullptr
+            && currentActiveParameterList->parameters.contains (&p);
 }
 
 void AutomatableEditItem::saveChangedParametersToState()
@@ -101,8 +101,24 @@ protected:
     void restoreChangedParametersFromState();
 
 private:
-    RealTimeSpinLock activeParameterLock;
-    juce::ReferenceCountedArray<AutomatableParameter> automatableParams, activeParameters;
+    /** An immutable snapshot of the active parameters.
+        The audio thread iterates the raw pointers whilst the ref-counted array keeps them alive.
+    */
+    struct ActiveParameterList
+    {
+        juce::ReferenceCountedArray<AutomatableParameter> parameters;
+        std::vector<AutomatableParameter*> rawParameters;
+    };
+
+    juce::ReferenceCountedArray<AutomatableParameter> automatableParams;
+
+    std::mutex activeParameterWriteLock;
+    std::atomic<ActiveParameterList*> activeParameterList { nullptr };
+    std::atomic<int> numActiveParameterReaders { 0 };
+    std::unique_ptr<ActiveParameterList> currentActiveParameterList;
+    std::vector<std::unique_ptr<ActiveParameterList>> retiredActiveParameterLists;
+
+    void publishActiveParameters (juce::ReferenceCountedArray<AutomatableParameter>, bool waitForReaders);
     mutable AutomatableParameterTree parameterTree;
 
     mutable bool parameterTreeBuilt = false;
@@ -46,6 +46,10 @@ namespace AutomationScaleHelpers
 
     inline float mapValue (float inputVal, float offset, float value, float curve) noexcept
     {
+        // With no curve this is linear and symmetrical around the offset
+        if (curve == 0.0f)
+            return offset + inputVal * value;
+
         return inputVal < 0.0 ? offset - getCurvedValue (-inputVal, 0.0f, value, curve)
                               : offset + getCurvedValue (inputVal, 0.0f, value, curve);
     }
@@ -135,7 +139,7 @@ struct AutomationModifierSource : public AutomationSource
 };
 
 //==============================================================================
-struct ModifierAutomationSource : public AutomationModifierSource
+struct ModifierAutomationSource final : public AutomationModifierSource
 {
     ModifierAutomationSource (Modifier::Ptr mod, const juce::ValueTree& assignmentState)
         : AutomationModifierSource (mod->createAssignment (assignmentState)),
@@ -375,7 +379,7 @@ struct MacroSource : public AutomationModifierSource
     void setPosition (TimePosition time) override
     {
         const juce::ScopedLock sl (streamPositionLock);
-        macro->updateFromAutomationSources (time);
+        macro->updateFromAutomationSourcesIfNeeded (time);
         auto macroValue = macro->getCurrentValue();
 
         const auto range = juce::Range<float>::between (assignment->inputStart.get(), assignment->inputEnd.get());
@@ -690,6 +694,35 @@ struct AutomatableParameter::AutomationSourceList  : private ValueTreeObjectList
                 f (*as);
     }
 
+    /** Positions and applies all the enabled sources in order.
+        This is the per-block path so Modifier sources, which are by far the most
+        common, are dispatched directly rather than through the virtual interface.
+    */
+    void processSources (TimePosition time, float& baseValue, float& modValue)
+    {
+        if (auto cs = cachedSources)
+        {
+            for (auto& entry : cs->compiledSources)
+            {
+                if (auto ms = entry.modifierSource)
+                {
+                    ms->setPosition (time);
+
+                    if (ms->isEnabled())
+                        modValue += ms->getCurrentValue();
+                }
+                else
+                {
+                    auto& as = *entry.source;
+                    as.setPosition (time);
+
+                    if (as.isEnabled())
+                        as.processValue (baseValue, modValue);
+                }
+            }
+        }
+    }
+
     juce::ReferenceCountedObjectPtr<AutomationModifierSource> getSourceFor (ModifierAssignment& ass)
     {
         TRACKTION_ASSERT_MESSAGE_THREAD
@@ -721,7 +754,14 @@ private:
     // counted copy of the objects for the visit method to use in a lock free way
     struct CachedSources : public ReferenceCountedObject
     {
+        struct CompiledSource
+        {
+            AutomationModifierSource* source = nullptr;
+            ModifierAutomationSource* modifierSource = nullptr;
+        };
+
         juce::ReferenceCountedArray<AutomationModifierSource> sources;
+        std::vector<CompiledSource> compiledSources;
     };
 
     juce::ReferenceCountedObjectPtr<CachedSources> cachedSources;
@@ -735,9 +775,13 @@ private:
         else
         {
             auto cs = new CachedSources();
+            cs->compiledSources.reserve ((size_t) objects.size());
 
             for (auto o : objects)
+            {
                 cs->sources.add (o);
+                cs->compiledSources.push_back ({ o, dynamic_cast<ModifierAutomationSource*> (o) });
+            }
 
             cachedSources = cs;
         }
@@ -1185,14 +1229,7 @@ void AutomatableParameter::updateFromAutomationSources (TimePosition time)
                              return currentParameterValue.load();
                          }();
 
-    getAutomationSourceList()
-        .visitSources ([&newBaseValue, &newModifierValue, time] (AutomationSource& m) mutable
-                       {
-                           m.setPosition (time);
-
-                           if (m.isEnabled())
-                               m.processValue (newBaseValue, newModifierValue);
-                       });
+    getAutomationSourceList().processSources (time, newBaseValue, newModifierValue);
 
     if (newModifierValue != 0.0f)
     {
@@ -58,6 +58,25 @@ std::optional<float> MacroParameter::getDefaultValue() const
     return defaultValue;
 }
 
+void MacroParameter::updateFromAutomationSourcesIfNeeded (TimePosition time)
+{
+    // Updates from the message thread aren't part of a block so always need to be evaluated
+    if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        updateFromAutomationSources (time);
+        return;
+    }
+
+    const std::scoped_lock sl (sourceUpdateLock);
+    const auto thisUpdate = std::make_pair (edit.getModifierTimerUpdateCount(), time);
+
+    if (lastSourceUpdate == thisUpdate)
+        return;
+
+    updateFromAutomationSources (time);
+    lastSourceUpdate = thisUpdate;
+}
+
 void MacroParameter::parameterChanged (float, bool byAutomation)
 {
     // Update any non-active parameters
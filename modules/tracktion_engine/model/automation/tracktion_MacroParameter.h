@@ -47,12 +47,23 @@ public:
     juce::String getParameterName() const override         { return macroName; }
     std::optional<float> getDefaultValue() const override;
 
+    /** Updates the macro from its own automation sources, but only if it hasn't already
+        been updated at this time during the current block.
+        This is called by each of the parameters the macro is assigned to so a macro
+        with many assignments is only evaluated once per block.
+        @see Edit::getModifierTimerUpdateCount
+    */
+    void updateFromAutomationSourcesIfNeeded (TimePosition);
+
     Edit& edit;
     juce::ValueTree state;
     juce::CachedValue<float> value, defaultValue;
     juce::CachedValue<juce::String> macroName;
 
 private:
+    RealTimeSpinLock sourceUpdateLock;
+    std::optional<std::pair<uint64_t, TimePosition>> lastSourceUpdate;
+
     virtual void parameterChanged (float, bool byAutomation) override;
 };
 
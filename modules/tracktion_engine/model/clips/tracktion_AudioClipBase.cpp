@@ -32,48 +32,21 @@ public:
     bool isResultSensible()                             { return isSensible; }
 
     //==============================================================================
-    /** Performs the actual detection. */
+    /** Performs the actual detection.
+        This uses the AudioFileAnalyser so the result is cached along with the file's other analysis.
+    */
     JobStatus runJob() override
     {
-        std::unique_ptr<juce::AudioFormatReader> reader (AudioFileUtils::createReaderFor (engine, sourceFile));
+        auto analysis = engine.getAudioFileAnalyser().analyse (AudioFile (engine, sourceFile),
+                                                              [this] (float p)
+                                                              {
+                                                                  progress = p;
+                                                                  return ! shouldExit();
+                                                              });
 
-        if (reader == nullptr)
-            return jobHasFinished;
-
-        auto numChannels = (int) reader->numChannels;
-        auto numSamples = reader->lengthInSamples;
-        auto sampleRate = reader->sampleRate;
-
-        if (numSamples <= 0)
-            return jobHasFinished;
-
-        // main detection loop
+        if (analysis && analysis->lengthInSamples > 0)
         {
-            TempoDetect detector (numChannels, sampleRate);
-            const int blockSize = 65536;
-            const bool useRightChan = numChannels > 1;
-
-            // can't use an AudioScratchBuffer yet
-            juce::AudioBuffer<float> buffer (numChannels, blockSize);
-
-            auto numLeft = numSamples;
-            SampleCount startSample = 0;
-
-            while (numLeft > 0)
-            {
-                if (shouldExit())
-                    return jobHasFinished;
-
-                auto numThisTime = (int) std::min ((SampleCount) numLeft, (SampleCount) blockSize);
-                reader->read (&buffer, 0, numThisTime, startSample, true, useRightChan);
-                detector.processSection (buffer, numThisTime);
-
-                startSample += numThisTime;
-                numLeft -= numThisTime;
-                progress = numLeft / (float) numSamples;
-            }
-
-            bpm = detector.finishAndDetect();
+            bpm = analysis->bpm;
             isSensible = bpm > 0;
         }
 
@@ -201,7 +174,8 @@ AudioClipBase::AudioClipBase (const juce::ValueTree& v, EditItemID id, Type t, C
     : Clip (v, targetParent, id, t),
       loopInfo (edit.engine, state.getOrCreateChildWithName (IDs::LOOPINFO, getUndoManager()), getUndoManager()),
       pluginList (edit),
-      lastProxy (edit.engine)
+      lastProxy (edit.engine),
+      lastSourceRender (edit.engine)
 {
     auto um = getUndoManager();
 
@@ -293,7 +267,7 @@ void AudioClipBase::initialise()
 
     if (shouldAttemptRender())
     {
-        auto audioFile = RenderManager::getAudioFileForHash (edit.engine, edit.getTempDirectory (false), getHash());
+        auto audioFile = TemporaryFileManager::getFileForCachedSourceRender (*this, getHash());
 
         if (currentSourceFile != audioFile.getFile())
             setCurrentSourceFile (audioFile.getFile());
@@ -1677,7 +1651,7 @@ void AudioClipBase::updateSourceFile()
 
     // check to see if our source file already exists, it may have been created by another clip
     // if it does exist, we will just use that, otherwise we need to start our own render operation
-    const AudioFile audioFile (RenderManager::getAudioFileForHash (edit.engine, edit.getTempDirectory (false), getHash()));
+    const AudioFile audioFile (TemporaryFileManager::getFileForCachedSourceRender (*this, getHash()));
 
     if (getCurrentSourceFile() != audioFile.getFile())
         setCurrentSourceFile (audioFile.getFile());
@@ -1685,7 +1659,13 @@ void AudioClipBase::updateSourceFile()
     if (renderJob != nullptr && renderJob->proxy == audioFile && (! renderJob->shouldExit()))
         return;
 
-    if (! (audioFile.getFile().existsAsFile() || audioFile.isValid()))
+    // This is called repeatedly by the timer so only the first check for each render counts as a look-up
+    auto& renderCache = edit.engine.getRenderCache();
+    const bool renderChanged = lastSourceRender != audioFile;
+    lastSourceRender = audioFile;
+
+    if (! ((renderChanged ? renderCache.lookUpRender (audioFile) : renderCache.hasRender (audioFile))
+            || audioFile.isValid()))
     {
         renderSource();
     }
@@ -2310,9 +2290,13 @@ void AudioClipBase::timerCallback()
     const AudioFile newProxy (getPlaybackFile());
 
     const bool proxyChanged = lastProxy != newProxy;
+    auto& renderCache = edit.engine.getRenderCache();
+    const bool proxyExists = proxyChanged ? renderCache.lookUpRender (newProxy)
+                                          : renderCache.hasRender (newProxy);
 
-    if (proxyChanged || ! newProxy.getFile().exists())
+    if (proxyChanged || ! proxyExists)
     {
+        // Proxies in the RenderCache may be shared with other Edits so are left for it to evict
         if (proxyChanged
              && lastProxy != originalFile
              && lastProxy.getFile().isAChildOf (edit.getTempDirectory (false))
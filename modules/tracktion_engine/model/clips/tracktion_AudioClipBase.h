@@ -661,7 +661,7 @@ protected:
     bool lastRenderJobFailed = false;
 
     RenderManager::Job::Ptr renderJob;
-    AudioFile lastProxy;
+    AudioFile lastProxy, lastSourceRender;
 
     //==============================================================================
     /** Triggers a source or proxy render after a timeout. Call this if something changes that
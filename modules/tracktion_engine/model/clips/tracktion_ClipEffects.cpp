@@ -374,6 +374,17 @@ void ClipEffect::invalidateDestination()
     sourceChanged();
 }
 
+std::unique_ptr<tracktion::graph::Node> ClipEffect::createStreamingNode (std::unique_ptr<tracktion::graph::Node>, ProcessState&,
+                                                                         const AudioFile&, TimeDuration, int)
+{
+    return {};
+}
+
+int ClipEffect::getStreamingBlockSize() const
+{
+    return (int) ClipEffectRenderJob::defaultBlockSize;
+}
+
 //==============================================================================
 /** Takes an AudioNode and renders it to a file. */
 struct AudioNodeRenderJob  : public ClipEffect::ClipEffectRenderJob
@@ -716,19 +727,23 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> VolumeEffect::c
     auto timeRange = TimeRange (0s, sourceLength);
     jassert (! timeRange.isEmpty());
 
-    auto sourceInfo = sourceFile.getInfo();
-    const int blockSize = 128;
-
-    auto job = AudioNodeRenderJob::create (edit.engine, getDestinationFile(), sourceFile, blockSize);
+    auto job = AudioNodeRenderJob::create (edit.engine, getDestinationFile(), sourceFile, getStreamingBlockSize());
 
     auto waveNode = job->createWaveNodeForFile (sourceFile, timeRange);
 
-    job->initialise (std::make_unique<PluginNode> (std::move (waveNode), plugin,
-                                                   sourceInfo.sampleRate, (int) job->blockSize, nullptr,
-                                                   job->processState, true, false, -1));
+    job->initialise (createStreamingNode (std::move (waveNode), job->processState,
+                                          sourceFile, sourceLength, (int) job->blockSize));
     return job;
 }
 
+std::unique_ptr<tracktion::graph::Node> VolumeEffect::createStreamingNode (std::unique_ptr<tracktion::graph::Node> input, ProcessState& processState,
+                                                                           const AudioFile& sourceFile, TimeDuration, int blockSize)
+{
+    return std::make_unique<PluginNode> (std::move (input), plugin,
+                                         sourceFile.getInfo().sampleRate, blockSize, nullptr,
+                                         processState, true, false, -1);
+}
+
 bool VolumeEffect::hasProperties()
 {
     return true;
@@ -774,6 +789,15 @@ void VolumeEffect::timerCallback()
 }
 
 //==============================================================================
+static TimeRange getSpeedAdjustedEffectRange (const ClipEffects& clipEffects)
+{
+    auto speedRatio = clipEffects.getSpeedRatioEstimate();
+    auto effectRange = clipEffects.getEffectsRange();
+
+    return { effectRange.getStart() * speedRatio,
+             effectRange.getEnd() * speedRatio };
+}
+
 FadeInOutEffect::FadeInOutEffect (const juce::ValueTree& v, ClipEffects& o)
     : ClipEffect (v, o)
 {
@@ -827,29 +851,22 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> FadeInOutEffect
     TimeRange timeRange (0s, sourceLength);
     jassert (! timeRange.isEmpty());
 
-    auto job = AudioNodeRenderJob::create (edit.engine, destFile, sourceFile, 128);
+    auto job = AudioNodeRenderJob::create (edit.engine, destFile, sourceFile, getStreamingBlockSize());
     auto n = job->createWaveNodeForFile (sourceFile, timeRange);
 
-    auto speedRatio = clipEffects.getSpeedRatioEstimate();
-    auto effectRange = clipEffects.getEffectsRange();
-    effectRange = { effectRange.getStart() * speedRatio,
-                    effectRange.getEnd() * speedRatio };
+    if (getType() == EffectType::fadeInOut)
+    {
+        job->initialise (createStreamingNode (std::move (n), job->processState,
+                                              sourceFile, sourceLength, (int) job->blockSize));
+        return job;
+    }
 
+    auto effectRange = getSpeedAdjustedEffectRange (clipEffects);
     const TimeRange fadeInRange (effectRange.getStart(), effectRange.getStart() + fadeIn);
     const TimeRange fadeOutRange (effectRange.getEnd() - fadeOut, effectRange.getEnd());
 
     switch (getType())
     {
-        case EffectType::fadeInOut:
-            if (fadeIn.get() > TimeDuration() || fadeOut.get() > TimeDuration())
-                n = tracktion::graph::makeNode<FadeInOutNode> (std::move (n),
-                                                               job->processState,
-                                                               fadeInRange, fadeOutRange,
-                                                               fadeInType, fadeOutType,
-                                                               true);
-
-            break;
-
         case EffectType::tapeStartStop:
             if (fadeIn.get() > TimeDuration() || fadeOut.get() > TimeDuration())
                 n = tracktion::graph::makeNode<SpeedRampWaveNode> (sourceFile, timeRange, TimeDuration(), TimeRange(), LiveClipLevel(), 1.0,
@@ -862,6 +879,7 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> FadeInOutEffect
             break;
 
         case EffectType::none:
+        case EffectType::fadeInOut:
         case EffectType::volume:
         case EffectType::stepVolume:
         case EffectType::pitchShift:
@@ -885,6 +903,29 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> FadeInOutEffect
     return job;
 }
 
+std::unique_ptr<tracktion::graph::Node> FadeInOutEffect::createStreamingNode (std::unique_ptr<tracktion::graph::Node> input, ProcessState& processState,
+                                                                              const AudioFile&, TimeDuration sourceLength, int)
+{
+    // Tape start/stop changes the playback speed so has to read the source file itself
+    jassert (canRenderAsStream());
+
+    auto effectRange = getSpeedAdjustedEffectRange (clipEffects);
+    const TimeRange fadeInRange (effectRange.getStart(), effectRange.getStart() + fadeIn);
+    const TimeRange fadeOutRange (effectRange.getEnd() - fadeOut, effectRange.getEnd());
+
+    if (fadeIn.get() > TimeDuration() || fadeOut.get() > TimeDuration())
+        input = tracktion::graph::makeNode<FadeInOutNode> (std::move (input),
+                                                           processState,
+                                                           fadeInRange, fadeOutRange,
+                                                           fadeInType, fadeOutType,
+                                                           true);
+
+    return tracktion::graph::makeNode<TimedMutingNode> (std::move (input),
+                                                        juce::Array<TimeRange> { TimeRange (0s, effectRange.getStart()),
+                                                                                 TimeRange (effectRange.getEnd(), sourceLength) },
+                                                        processState.playHeadState);
+}
+
 HashCode FadeInOutEffect::getIndividualHash() const
 {
     auto effectRange = clipEffects.getEffectsRange();
@@ -943,6 +984,19 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> StepVolumeEffec
     TimeRange timeRange (0s, sourceLength);
     jassert (! timeRange.isEmpty());
 
+    auto job = AudioNodeRenderJob::create (edit.engine, destFile, sourceFile, getStreamingBlockSize());
+
+    auto node = job->createWaveNodeForFile (sourceFile, timeRange);
+
+    job->initialise (createStreamingNode (std::move (node), job->processState,
+                                          sourceFile, sourceLength, (int) job->blockSize));
+    return job;
+}
+
+std::unique_ptr<tracktion::graph::Node> StepVolumeEffect::createStreamingNode (std::unique_ptr<tracktion::graph::Node> node, ProcessState& processState,
+                                                                               const AudioFile&, TimeDuration, int)
+{
+    CRASH_TRACER
     auto speedRatio = clipEffects.getSpeedRatioEstimate();
     auto effectRange = clipEffects.getEffectsRange();
 
@@ -1004,15 +1058,11 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> StepVolumeEffec
             t = t.rescaled (TimePosition(), speedRatio);
     }
 
-    auto job = AudioNodeRenderJob::create (edit.engine, destFile, sourceFile, AudioNodeRenderJob::defaultBlockSize);
-
-    auto node = job->createWaveNodeForFile (sourceFile, timeRange);
-
     auto muteTimes = TrackCompManager::TrackComp::getMuteTimes (nonMuteTimes);
 
     if (! muteTimes.isEmpty())
     {
-        node = tracktion::graph::makeNode<TimedMutingNode> (std::move (node), muteTimes, job->playHeadState);
+        node = tracktion::graph::makeNode<TimedMutingNode> (std::move (node), muteTimes, processState.playHeadState);
 
         for (auto r : nonMuteTimes)
         {
@@ -1020,15 +1070,14 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> StepVolumeEffec
             auto fadeOut = fadeIn.movedToEndAt (r.getEnd() + 0.0001s);
 
             if (! (fadeIn.isEmpty() && fadeOut.isEmpty()))
-                node = tracktion::graph::makeNode<FadeInOutNode> (std::move (node), job->processState,
+                node = tracktion::graph::makeNode<FadeInOutNode> (std::move (node), processState,
                                                                   fadeIn, fadeOut,
                                                                   AudioFadeCurve::convex,
                                                                   AudioFadeCurve::convex, false);
         }
     }
 
-    job->initialise (std::move (node));
-    return job;
+    return node;
 }
 
 bool StepVolumeEffect::hasProperties()
@@ -1165,22 +1214,32 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> PitchShiftEffec
     TimeRange timeRange (0s, sourceLength);
     jassert (! timeRange.isEmpty());
 
-    const int blockSize = 512;
-
-    auto job = AudioNodeRenderJob::create (edit.engine, getDestinationFile(), sourceFile, blockSize);
+    auto job = AudioNodeRenderJob::create (edit.engine, getDestinationFile(), sourceFile, getStreamingBlockSize());
 
     auto node = job->createWaveNodeForFile (sourceFile, timeRange);
 
-    // Use 1.0 second of preroll to be safe. We can't ask the plugin since it
-    // may not be initialized yet
-    job->initialise (std::make_unique<PluginNode> (std::move (node), plugin,
-                                                   sourceFile.getInfo().sampleRate, (int) job->blockSize, nullptr,
-                                                   job->processState, true, false, -1),
-                     1.0);
+    job->initialise (createStreamingNode (std::move (node), job->processState,
+                                          sourceFile, sourceLength, (int) job->blockSize),
+                     getStreamingPrerollTime().inSeconds());
 
     return job;
 }
 
+std::unique_ptr<tracktion::graph::Node> PitchShiftEffect::createStreamingNode (std::unique_ptr<tracktion::graph::Node> input, ProcessState& processState,
+                                                                               const AudioFile& sourceFile, TimeDuration, int blockSize)
+{
+    return std::make_unique<PluginNode> (std::move (input), plugin,
+                                         sourceFile.getInfo().sampleRate, blockSize, nullptr,
+                                         processState, true, false, -1);
+}
+
+TimeDuration PitchShiftEffect::getStreamingPrerollTime() const
+{
+    // Use 1.0 second of preroll to be safe. We can't ask the plugin since it
+    // may not be initialized yet
+    return 1s;
+}
+
 bool PitchShiftEffect::hasProperties()
 {
     return true;
@@ -1389,30 +1448,39 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> PluginEffect::c
     TimeRange timeRange (0s, sourceLength);
     jassert (! timeRange.isEmpty());
 
-    const int blockSize = 512;
-    auto job = AudioNodeRenderJob::create (edit.engine, getDestinationFile(), sourceFile, blockSize);
+    auto job = AudioNodeRenderJob::create (edit.engine, getDestinationFile(), sourceFile, getStreamingBlockSize());
 
-    auto n = job->createWaveNodeForFile (sourceFile, timeRange);
-
-    if (plugin != nullptr)
-    {
-        plugin->setProcessingEnabled (true);
-
-        n = std::make_unique<PluginNode> (std::move (n), plugin,
-                                          job->processState.sampleRate, (int) job->blockSize, nullptr,
-                                          job->processState, true, false, -1);
-    }
+    auto n = createStreamingNode (job->createWaveNodeForFile (sourceFile, timeRange), job->processState,
+                                  sourceFile, sourceLength, (int) job->blockSize);
 
     if (pluginUnloadInhibitor != nullptr)
         pluginUnloadInhibitor->increaseForJob (30 * 1000, job);
 
-    // Use 1.0 second of preroll to be safe. We can't ask the plugin since it
-    // may not be initialized yet
-    job->initialise (std::move (n), 1.0);
+    job->initialise (std::move (n), getStreamingPrerollTime().inSeconds());
 
     return job;
 }
 
+std::unique_ptr<tracktion::graph::Node> PluginEffect::createStreamingNode (std::unique_ptr<tracktion::graph::Node> input, ProcessState& processState,
+                                                                           const AudioFile&, TimeDuration, int blockSize)
+{
+    if (plugin == nullptr)
+        return input;
+
+    plugin->setProcessingEnabled (true);
+
+    return std::make_unique<PluginNode> (std::move (input), plugin,
+                                         processState.sampleRate, blockSize, nullptr,
+                                         processState, true, false, -1);
+}
+
+TimeDuration PluginEffect::getStreamingPrerollTime() const
+{
+    // Use 1.0 second of preroll to be safe. We can't ask the plugin since it
+    // may not be initialized yet
+    return 1s;
+}
+
 void PluginEffect::flushStateToValueTree()
 {
     if (plugin != nullptr)
@@ -1745,6 +1813,48 @@ InvertEffect::InvertEffect (const juce::ValueTree& v, ClipEffects& o)
 {
 }
 
+/** Passes its input through with the polarity inverted. */
+class InvertNode final  : public tracktion::graph::Node
+{
+public:
+    InvertNode (std::unique_ptr<tracktion::graph::Node> inputNode)
+        : input (std::move (inputNode))
+    {
+        setOptimisations ({ tracktion::graph::ClearBuffers::no,
+                            tracktion::graph::AllocateAudioBuffer::yes });
+    }
+
+    tracktion::graph::NodeProperties getNodeProperties() override
+    {
+        auto props = input->getNodeProperties();
+        props.nodeID = 0;
+
+        return props;
+    }
+
+    std::vector<tracktion::graph::Node*> getDirectInputNodes() override
+    {
+        return { input.get() };
+    }
+
+    bool isReadyToProcess() override
+    {
+        return input->hasProcessed();
+    }
+
+    void process (ProcessContext& pc) override
+    {
+        auto sourceBuffers = input->getProcessedOutput();
+        jassert (sourceBuffers.audio.getSize() == pc.buffers.audio.getSize());
+
+        copy (pc.buffers.audio, sourceBuffers.audio);
+        choc::buffer::applyGain (pc.buffers.audio, -1.0f);
+    }
+
+private:
+    std::unique_ptr<tracktion::graph::Node> input;
+};
+
 juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> InvertEffect::createRenderJob (const AudioFile& sourceFile,
                                                                                                 TimeDuration sourceLength)
 {
@@ -1752,6 +1862,12 @@ juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> InvertEffect::c
     return new InvertRenderJob (edit.engine, getDestinationFile(), sourceFile, sourceLength);
 }
 
+std::unique_ptr<tracktion::graph::Node> InvertEffect::createStreamingNode (std::unique_ptr<tracktion::graph::Node> input, ProcessState&,
+                                                                           const AudioFile&, TimeDuration, int)
+{
+    return std::make_unique<InvertNode> (std::move (input));
+}
+
 //==============================================================================
 ClipEffect* ClipEffect::create (const juce::ValueTree& v, ClipEffects& ce)
 {
@@ -1850,6 +1966,48 @@ struct AggregateJob  : public RenderManager::Job
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateJob)
 };
 
+//==============================================================================
+/** Streams the source through a run of effects in a single pass, only writing the last effect's file. */
+static ClipEffect::ClipEffectRenderJob::Ptr createStreamingRenderJob (const juce::Array<ClipEffect*>& effects,
+                                                                     const AudioFile& sourceFile, TimeDuration sourceLength)
+{
+    CRASH_TRACER
+    jassert (effects.size() > 1);
+
+    // Use the smallest block size of the effects so automation is never applied at a coarser
+    // resolution than the effect would use on its own. The plugins process the same samples
+    // whatever the block size so only their automation gets finer.
+    int blockSize = effects.getFirst()->getStreamingBlockSize();
+
+    for (auto ce : effects)
+        blockSize = std::min (blockSize, ce->getStreamingBlockSize());
+
+    auto job = AudioNodeRenderJob::create (effects.getFirst()->edit.engine, effects.getLast()->getDestinationFile(),
+                                           sourceFile, blockSize);
+
+    auto node = job->createWaveNodeForFile (sourceFile, TimeRange (0s, sourceLength));
+    TimeDuration prerollTime;
+
+    for (auto ce : effects)
+    {
+        jassert (ce->canRenderAsStream());
+        std::unique_ptr<ScopedPluginUnloadInhibitor> scopedInhibitor;
+
+        if (auto pe = dynamic_cast<PluginEffect*> (ce); pe != nullptr && pe->pluginUnloadInhibitor != nullptr)
+        {
+            scopedInhibitor = std::make_unique<ScopedPluginUnloadInhibitor> (*pe->pluginUnloadInhibitor);
+            pe->pluginUnloadInhibitor->increaseForJob (30 * 1000, job);
+        }
+
+        node = ce->createStreamingNode (std::move (node), job->processState, sourceFile, sourceLength, (int) job->blockSize);
+        jassert (node != nullptr);
+        prerollTime = std::max (prerollTime, ce->getStreamingPrerollTime());
+    }
+
+    job->initialise (std::move (node), prerollTime.inSeconds());
+    return job;
+}
+
 //==============================================================================
 RenderManager::Job::Ptr ClipEffects::createRenderJob (const AudioFile& destFile, const AudioFile& sourceFile) const
 {
@@ -1860,21 +2018,64 @@ RenderManager::Job::Ptr ClipEffects::createRenderJob (const AudioFile& destFile,
     AudioFile inputFile (sourceFile);
     juce::ReferenceCountedArray<ClipEffect::ClipEffectRenderJob> jobs;
 
-    for (auto ce : objects)
+    // Effect hashes include all the preceding effects so only the effects after
+    // the last up-to-date destination file need rendering
+    int firstEffectToRender = 0;
+    auto& renderCache = clip.edit.engine.getRenderCache();
+
+    for (int i = objects.size(); --i >= 0;)
     {
-        const AudioFile af (ce->getDestinationFile());
+        const AudioFile af (objects.getUnchecked (i)->getDestinationFile());
+
+        // Only the final render counts as a look-up, the others just find where to start from
+        const bool exists = i == objects.size() - 1 ? renderCache.lookUpRender (af)
+                                                    : renderCache.hasRender (af);
 
-        if (af.getFile().existsAsFile() && af.isValid())
+        if (exists && af.isValid())
         {
             inputFile = af;
+            firstEffectToRender = i + 1;
+            break;
         }
-        else if (ClipEffect::ClipEffectRenderJob::Ptr j = ce->createRenderJob (inputFile, length))
+    }
+
+    juce::Array<ClipEffect*> streamingEffects;
+
+    auto addJob = [&] (ClipEffect::ClipEffectRenderJob::Ptr j)
+    {
+        if (j != nullptr)
         {
             inputFile = j->destination;
             jobs.add (j);
         }
+    };
+
+    auto addStreamingEffectsJob = [&]
+    {
+        if (streamingEffects.size() == 1)
+            addJob (streamingEffects.getFirst()->createRenderJob (inputFile, length));
+        else if (streamingEffects.size() > 1)
+            addJob (createStreamingRenderJob (streamingEffects, inputFile, length));
+
+        streamingEffects.clearQuick();
+    };
+
+    for (int i = firstEffectToRender; i < objects.size(); ++i)
+    {
+        auto ce = objects.getUnchecked (i);
+
+        if (ce->canRenderAsStream())
+        {
+            streamingEffects.add (ce);
+            continue;
+        }
+
+        addStreamingEffectsJob();
+        addJob (ce->createRenderJob (inputFile, length));
     }
 
+    addStreamingEffectsJob();
+
     AudioFile firstFile (jobs.isEmpty() ? inputFile : jobs.getFirst()->source);
 
     return new AggregateJob (clip.edit.engine, destFile, firstFile, std::move (jobs));
@@ -11,6 +11,8 @@
 namespace tracktion { inline namespace engine
 {
 
+struct ProcessState;
+
 //==============================================================================
 /**
 */
@@ -58,6 +60,28 @@ public:
     */
     virtual juce::ReferenceCountedObjectPtr<ClipEffectRenderJob> createRenderJob (const AudioFile& sourceFile, TimeDuration sourceLength) = 0;
 
+    /** Should return true if the effect can currently be rendered with createStreamingNode. */
+    virtual bool canRenderAsStream() const                      { return false; }
+
+    /** Effects that can process their source a block at a time should return a Node here
+        that applies the effect to the output of the input Node.
+        Runs of consecutive effects that support this are rendered by ClipEffects in a
+        single pass, writing only the last effect's destination file.
+        This is only called if canRenderAsStream returns true.
+    */
+    virtual std::unique_ptr<tracktion::graph::Node> createStreamingNode (std::unique_ptr<tracktion::graph::Node> input,
+                                                                         ProcessState&, const AudioFile& sourceFile,
+                                                                         TimeDuration sourceLength, int blockSize);
+
+    /** Returns the time a streaming Node needs to be run for before its output is valid. */
+    virtual TimeDuration getStreamingPrerollTime() const        { return {}; }
+
+    /** Returns the block size the effect is rendered with. When effects are streamed
+        together the smallest of their block sizes is used so none of them is rendered
+        with a coarser resolution than it would be on its own.
+    */
+    virtual int getStreamingBlockSize() const;
+
     /** Return true here to show a properties button in the editor and enable the propertiesButtonPressed callback. */
     virtual bool hasProperties()                                { return false; }
     virtual void propertiesButtonPressed (SelectionManager&)    {}
@@ -186,6 +210,10 @@ public:
         listeners.call (&Listener::renderComplete);
     }
 
+    /** Creates a job that renders all the effects that don't already have an up-to-date
+        destination file. Consecutive effects that support createStreamingNode are streamed
+        through in a single pass so only the last of them writes a file.
+    */
     RenderManager::Job::Ptr createRenderJob (const AudioFile& destFile, const AudioFile& sourceFile) const;
 
     bool isSuitableType (const juce::ValueTree& v) const override
@@ -345,6 +373,10 @@ struct VolumeEffect : public ClipEffect,
 {
     VolumeEffect (const juce::ValueTree&, ClipEffects&);
     juce::ReferenceCountedObjectPtr<ClipEffectRenderJob> createRenderJob (const AudioFile& sourceFile, TimeDuration sourceLength) override;
+    bool canRenderAsStream() const override                     { return true; }
+    std::unique_ptr<tracktion::graph::Node> createStreamingNode (std::unique_ptr<tracktion::graph::Node>, ProcessState&,
+                                                                 const AudioFile&, TimeDuration sourceLength, int blockSize) override;
+    int getStreamingBlockSize() const override                  { return 128; }
 
     void initialise() override
     {
@@ -378,6 +410,10 @@ struct FadeInOutEffect  : public ClipEffect
     void setFadeOut (TimeDuration);
 
     juce::ReferenceCountedObjectPtr<ClipEffectRenderJob> createRenderJob (const AudioFile& sourceFile, TimeDuration sourceLength) override;
+    bool canRenderAsStream() const override                     { return getType() == EffectType::fadeInOut; }
+    std::unique_ptr<tracktion::graph::Node> createStreamingNode (std::unique_ptr<tracktion::graph::Node>, ProcessState&,
+                                                                 const AudioFile&, TimeDuration sourceLength, int blockSize) override;
+    int getStreamingBlockSize() const override                  { return 128; }
 
     juce::CachedValue<TimeDuration> fadeIn, fadeOut;
     juce::CachedValue<AudioFadeCurve::Type> fadeInType, fadeOutType;
@@ -400,6 +436,9 @@ struct StepVolumeEffect  : public ClipEffect,
     int getMaxNumNotes();
 
     juce::ReferenceCountedObjectPtr<ClipEffectRenderJob> createRenderJob (const AudioFile& sourceFile, TimeDuration sourceLength) override;
+    bool canRenderAsStream() const override                     { return true; }
+    std::unique_ptr<tracktion::graph::Node> createStreamingNode (std::unique_ptr<tracktion::graph::Node>, ProcessState&,
+                                                                 const AudioFile&, TimeDuration sourceLength, int blockSize) override;
 
     bool hasProperties() override;
     void propertiesButtonPressed (SelectionManager&) override;
@@ -454,6 +493,11 @@ struct PitchShiftEffect  : public ClipEffect,
     void initialise() override;
 
     juce::ReferenceCountedObjectPtr<ClipEffectRenderJob> createRenderJob (const AudioFile& sourceFile, TimeDuration sourceLength) override;
+    bool canRenderAsStream() const override                     { return true; }
+    std::unique_ptr<tracktion::graph::Node> createStreamingNode (std::unique_ptr<tracktion::graph::Node>, ProcessState&,
+                                                                 const AudioFile&, TimeDuration sourceLength, int blockSize) override;
+    int getStreamingBlockSize() const override                  { return 512; }
+    TimeDuration getStreamingPrerollTime() const override;
 
     bool hasProperties() override;
     void propertiesButtonPressed (SelectionManager&) override;
@@ -499,6 +543,11 @@ struct PluginEffect  : public ClipEffect,
     PluginEffect (const juce::ValueTree&, ClipEffects&);
 
     juce::ReferenceCountedObjectPtr<ClipEffectRenderJob> createRenderJob (const AudioFile&, TimeDuration sourceLength) override;
+    bool canRenderAsStream() const override                     { return true; }
+    std::unique_ptr<tracktion::graph::Node> createStreamingNode (std::unique_ptr<tracktion::graph::Node>, ProcessState&,
+                                                                 const AudioFile&, TimeDuration sourceLength, int blockSize) override;
+    int getStreamingBlockSize() const override                  { return 512; }
+    TimeDuration getStreamingPrerollTime() const override;
 
     void initialise() override
     {
@@ -602,6 +651,9 @@ struct InvertEffect  : public ClipEffect
     InvertEffect (const juce::ValueTree&, ClipEffects&);
 
     juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> createRenderJob (const AudioFile&, TimeDuration sourceLength) override;
+    bool canRenderAsStream() const override                     { return true; }
+    std::unique_ptr<tracktion::graph::Node> createStreamingNode (std::unique_ptr<tracktion::graph::Node>, ProcessState&,
+                                                                 const AudioFile&, TimeDuration sourceLength, int blockSize) override;
 
     struct InvertRenderJob;
 
@@ -0,0 +1,168 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_CLIP_EFFECTS
+
+#include "../../../tracktion_graph/tracktion_graph/tracktion_TestUtilities.h"
+#include "../../utilities/tracktion_TestUtilities.h"
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+//==============================================================================
+class ClipEffectsTests  : public juce::UnitTest
+{
+public:
+    ClipEffectsTests()
+        : juce::UnitTest ("ClipEffects", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        using namespace tracktion::graph::test_utilities;
+        using namespace tracktion::engine::test_utilities;
+
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = createTestEdit (engine);
+        auto sourceFile = createFloatSineFile (44100.0, 2.0);
+
+        auto clip = insertWaveClip (*getAudioTracks (*edit)[0], {}, sourceFile->getFile(), {{ 0_tp, 2_tp }}, DeleteExistingClips::no);
+        expect (clip != nullptr);
+
+        if (clip == nullptr)
+            return;
+
+        clip->enableEffects (true, false);
+
+        // The effects are rendered directly here rather than by the clip's proxy
+        clip->setUsesProxy (false);
+
+        auto fadeInOut = ClipEffect::create (ClipEffect::EffectType::fadeInOut);
+        fadeInOut.setProperty (IDs::fadeIn, 0.5, nullptr);
+        fadeInOut.setProperty (IDs::fadeOut, 0.25, nullptr);
+        fadeInOut.setProperty (IDs::fadeOutType, (int) AudioFadeCurve::convex, nullptr);
+
+        clip->addEffect (ClipEffect::create (ClipEffect::EffectType::volume));
+        clip->addEffect (fadeInOut);
+        clip->addEffect (ClipEffect::create (ClipEffect::EffectType::stepVolume));
+        clip->addEffect (ClipEffect::create (ClipEffect::EffectType::invert));
+
+        auto clipEffects = clip->getClipEffects();
+        expect (clipEffects != nullptr);
+
+        if (clipEffects == nullptr)
+            return;
+
+        juce::Array<ClipEffect*> effects (clipEffects->objects);
+        expectEquals (effects.size(), 4);
+
+        for (auto ce : effects)
+            expect (ce->canRenderAsStream());
+
+        const AudioFile source (engine, sourceFile->getFile());
+        const auto sourceLength = TimeDuration::fromSeconds (source.getLength());
+
+        beginTest ("Streamed chain matches rendering each effect separately");
+        {
+            // Render each effect from the previous one's file, as they were before streaming
+            AudioFile input (source);
+
+            for (auto ce : effects)
+            {
+                auto job = ce->createRenderJob (input, sourceLength);
+                expect (render (engine, *job));
+                input = job->destination;
+            }
+
+            auto separate = loadFileInToBuffer (engine, input.getFile());
+            expect (separate.has_value());
+
+            for (auto ce : effects)
+                ce->getDestinationFile().deleteFile();
+
+            auto job = createStreamingRenderJob (effects, source, sourceLength);
+            expect (job->destination == effects.getLast()->getDestinationFile());
+            expectEquals ((int) job->blockSize, 128);
+            expect (render (engine, *job));
+
+            for (int i = 0; i < effects.size() - 1; ++i)
+                expect (! effects[i]->getDestinationFile().getFile().existsAsFile());
+
+            auto streamed = loadFileInToBuffer (engine, job->destination.getFile());
+            expect (streamed.has_value());
+
+            if (separate && streamed)
+            {
+                expectEquals (streamed->getNumChannels(), separate->getNumChannels());
+                expectEquals (streamed->getNumSamples(), separate->getNumSamples());
+                expectGreaterThan (separate->getMagnitude (0, separate->getNumSamples()), 0.1f);
+
+                float maxDifference = 0.0f;
+
+                for (int c = 0; c < std::min (streamed->getNumChannels(), separate->getNumChannels()); ++c)
+                    for (int i = 0; i < std::min (streamed->getNumSamples(), separate->getNumSamples()); ++i)
+                        maxDifference = std::max (maxDifference, std::abs (streamed->getSample (c, i) - separate->getSample (c, i)));
+
+                expectLessOrEqual (maxDifference, 1.0e-6f);
+            }
+
+            for (auto ce : effects)
+                ce->getDestinationFile().deleteFile();
+        }
+
+        beginTest ("Streamed block size");
+        {
+            // Without the 128 sample volume and fade effects the larger block sizes are kept
+            auto job = createStreamingRenderJob ({ effects[2], effects[3] }, source, sourceLength);
+            expectEquals ((int) job->blockSize, (int) ClipEffect::ClipEffectRenderJob::defaultBlockSize);
+        }
+    }
+
+private:
+    /** Writes a 32-bit file so the intermediate renders are lossless and can be compared exactly. */
+    static std::unique_ptr<juce::TemporaryFile> createFloatSineFile (double sampleRate, double durationSeconds)
+    {
+        auto buffer = graph::test_utilities::createSineBuffer (2, (int) (sampleRate * durationSeconds),
+                                                               graph::test_utilities::getPhaseIncrement (220.0f, sampleRate));
+        auto f = std::make_unique<juce::TemporaryFile> (".wav");
+
+        if (auto writer = std::unique_ptr<juce::AudioFormatWriter> (juce::WavAudioFormat().createWriterFor (f->getFile().createOutputStream().release(),
+                                                                                                            sampleRate, 2, 32, {}, 0)))
+            writer->writeFromAudioSampleBuffer (toAudioBuffer (buffer.getView()), 0, (int) buffer.getNumFrames());
+
+        return f;
+    }
+
+    /** Runs a job synchronously the same way the AggregateJob does. */
+    static bool render (Engine& engine, ClipEffect::ClipEffectRenderJob& job)
+    {
+        if (! job.setUpRender())
+            return false;
+
+        while (! job.renderNextBlock())
+        {}
+
+        if (! job.completeRender())
+            return false;
+
+        auto& afm = engine.getAudioFileManager();
+        afm.releaseFile (job.destination);
+        afm.validateFile (job.destination, true);
+
+        return job.destination.isValid();
+    }
+};
+
+static ClipEffectsTests clipEffectsTests;
+
+}} // namespace tracktion { inline namespace engine
+
+#endif
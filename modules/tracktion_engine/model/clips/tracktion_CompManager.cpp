@@ -1247,13 +1247,16 @@ void WaveCompManager::timerCallback()
            .deleteProxy (TemporaryFileManager::getFileForCachedCompRender (clip, lastHash));
     }
 
+    const bool hashChanged = hash != lastHash;
     lastRenderedTake = takeIndex;
     lastHash = hash;
 
     lastCompFile = TemporaryFileManager::getFileForCachedCompRender (clip, lastHash);
     const bool isComp = isTakeComp (lastRenderedTake);
+    auto& renderCache = clip.edit.engine.getRenderCache();
 
-    if (isComp && (! lastCompFile.isValid()))
+    if (isComp && ! ((hashChanged ? renderCache.lookUpRender (lastCompFile) : renderCache.hasRender (lastCompFile))
+                      && lastCompFile.isValid()))
     {
         auto takeTree = takesTree.getChild (lastRenderedTake);
         beginCompGeneration (clip, lastRenderedTake);
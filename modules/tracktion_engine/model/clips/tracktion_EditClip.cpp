@@ -229,7 +229,7 @@ bool EditClip::isUsingFile (const AudioFile& af)
     if (AudioClipBase::isUsingFile (af))
         return true;
 
-    auto audioFile = RenderManager::getAudioFileForHash (edit.engine, edit.getTempDirectory (false), getHash());
+    auto audioFile = TemporaryFileManager::getFileForCachedSourceRender (*this, getHash());
 
     if (audioFile == af)
         return true;
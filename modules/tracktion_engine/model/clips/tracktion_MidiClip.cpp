@@ -80,9 +80,153 @@ static std::unique_ptr<MidiList> createLoopRangeDefinesSubsequentRepetitionsSequ
     return createLoopRangeDefinesAllRepetitionsSequence (clip, sourceSequence);
 }
 
+//==============================================================================
+/**
+    The playback sequences that have been created for a clip.
+    Each sequence is kept until something it depends on changes. beatsRaw sequences
+    only depend on the MidiList so they're kept when the clip is moved or re-timed,
+    the others depend on the clip's position, looping, quantisation, groove and tempo.
+*/
+struct MidiClip::PlaybackSequenceCache
+{
+    struct Entry
+    {
+        MidiList::TimeBase timeBase;
+        bool generateMPE = false;
+        uint32_t tempoChangeCount = 0, grooveChangeCount = 0;
+        juce::MidiMessageSequence sequence;
+
+        bool canBeUpdatedIncrementally() const      { return timeBase == MidiList::TimeBase::beatsRaw && ! generateMPE; }
+    };
+
+    static constexpr size_t maxNumChangedNotes = 16;
+
+    std::vector<Entry> entries;
+
+    // The notes as they were when the incremental entry was last brought up to date
+    std::unordered_map<const MidiNote*, std::pair<int, BeatRange>> notes;
+    std::vector<juce::ValueTree> changedNotes;
+    BeatPosition firstBeat, lastBeat;
+    bool hasNoteSnapshot = false;
+
+    void clear()
+    {
+        entries.clear();
+        notes.clear();
+        changedNotes.clear();
+        hasNoteSnapshot = false;
+    }
+
+    void clipPropertyChanged (const juce::Identifier& id)
+    {
+        if (id == IDs::currentTake || id == IDs::sendBankChange)
+            clear();
+        else if (id != IDs::colour && id != IDs::name && id != IDs::volDb && id != IDs::mute)
+            std::erase_if (entries, [] (auto& e) { return e.timeBase != MidiList::TimeBase::beatsRaw; });
+    }
+
+    void noteChanged (const juce::ValueTree& note)
+    {
+        std::erase_if (entries, [] (auto& e) { return ! e.canBeUpdatedIncrementally(); });
+
+        if (entries.empty() || ! hasNoteSnapshot || changedNotes.size() >= maxNumChangedNotes)
+        {
+            clear();
+            return;
+        }
+
+        if (std::find (changedNotes.begin(), changedNotes.end(), note) == changedNotes.end())
+            changedNotes.push_back (note);
+    }
+
+    const juce::MidiMessageSequence& getSequence (MidiClip& clip, MidiList& list, MidiList::TimeBase timeBase, bool generateMPE)
+    {
+        const bool dependsOnTempo = timeBase != MidiList::TimeBase::beatsRaw;
+        const auto tempoChangeCount = dependsOnTempo ? clip.edit.tempoSequence.getChangeCount() : 0u;
+        const auto grooveChangeCount = dependsOnTempo ? clip.edit.engine.getGrooveTemplateManager().getChangeCount() : 0u;
+
+        applyChangedNotes (clip, list);
+
+        auto matches = [&] (const Entry& e) { return e.timeBase == timeBase && e.generateMPE == generateMPE; };
+
+        for (auto& e : entries)
+            if (matches (e) && e.tempoChangeCount == tempoChangeCount && e.grooveChangeCount == grooveChangeCount)
+                return e.sequence;
+
+        std::erase_if (entries, matches);
+        auto& e = entries.emplace_back (Entry { timeBase, generateMPE, tempoChangeCount, grooveChangeCount,
+                                                list.exportToPlaybackMidiSequence (clip, timeBase, generateMPE) });
+
+        if (e.canBeUpdatedIncrementally() && clip.edit.engine.getEngineBehaviour().canUpdatePlaybackMidiSequencesIncrementally())
+        {
+            notes.clear();
+
+            for (auto n : list.getNotes())
+                notes[n] = { n->getNoteNumber(), n->getRangeBeats() };
+
+            firstBeat = list.getFirstBeatNumber();
+            lastBeat = list.getLastBeatNumber();
+            hasNoteSnapshot = true;
+        }
+
+        return e.sequence;
+    }
+
+    void applyChangedNotes (MidiClip& clip, MidiList& list)
+    {
+        if (changedNotes.empty())
+            return;
+
+        auto entry = std::find_if (entries.begin(), entries.end(), [] (auto& e) { return e.canBeUpdatedIncrementally(); });
+
+        if (entry == entries.end())
+        {
+            clear();
+            return;
+        }
+
+        for (auto& state : changedNotes)
+        {
+            // Notes in the other takes aren't played
+            auto note = list.getNoteFor (state);
+
+            if (note == nullptr)
+                continue;
+
+            auto old = notes.find (note);
+
+            if (old == notes.end()
+                || ! MidiList::updateDefaultPlaybackMidiSequence (entry->sequence, list, clip, *note,
+                                                                 old->second.first, old->second.second))
+            {
+                clear();
+                return;
+            }
+
+            old->second = { note->getNoteNumber(), note->getRangeBeats() };
+        }
+
+        changedNotes.clear();
+
+        // The list's range determines which controllers and sysex are included
+        if (list.getFirstBeatNumber() != firstBeat || list.getLastBeatNumber() != lastBeat)
+        {
+            if (! list.getControllerEvents().isEmpty() || ! list.getSysexEvents().isEmpty())
+            {
+                clear();
+                return;
+            }
+
+            firstBeat = list.getFirstBeatNumber();
+            lastBeat = list.getLastBeatNumber();
+        }
+    }
+};
+
 //==============================================================================
 MidiClip::MidiClip (const juce::ValueTree& v, EditItemID id, ClipOwner& targetParent)
-    : Clip (v, targetParent, id, Type::midi)
+    : Clip (v, targetParent, id, Type::midi),
+      playbackSequenceCache (std::make_unique<PlaybackSequenceCache>())
 {
     auto um = getUndoManager();
 
@@ -186,7 +330,7 @@ void MidiClip::initialise()
 
 void MidiClip::rescale (TimePosition pivotTimeInEdit, double factor)
 {
-    getSequence().rescale (factor, getUndoManager());
+    getSequence().rescale (factor, getUndoManager(), edit.getUndoJournal());
     setLoopRangeBeats ({ loopStartBeats * factor, (loopStartBeats + loopLengthBeats) * factor });
     Clip::rescale (pivotTimeInEdit, factor);
 }
@@ -288,6 +432,29 @@ std::unique_ptr<MidiList> MidiClip::createSequenceLooped (MidiList& sourceSequen
     }
 }
 
+juce::MidiMessageSequence MidiClip::getPlaybackMidiSequence (MidiList::TimeBase timeBase, bool generateMPE)
+{
+    CRASH_TRACER
+    TRACKTION_ASSERT_MESSAGE_THREAD
+
+    auto& list = timeBase == MidiList::TimeBase::beatsRaw ? getSequence() : getSequenceLooped();
+
+    auto hasProgramChanges = [&list]
+    {
+        for (auto e : list.getControllerEvents())
+            if (e->getType() == MidiControllerEvent::programChangeType)
+                return true;
+
+        return false;
+    };
+
+    // The selected events and the track's bank IDs aren't part of the clip so these can't be cached
+    if (selectedEvents != nullptr || (sendBankChange && hasProgramChanges()))
+        return list.exportToPlaybackMidiSequence (*this, timeBase, generateMPE);
+
+    return playbackSequenceCache->getSequence (*this, list, timeBase, generateMPE);
+}
+
 MidiClip::ScopedEventsList::ScopedEventsList (MidiClip& c, SelectedMidiEvents* e)
     : clip (c)
 {
@@ -308,7 +475,7 @@ void MidiClip::extendStart (TimePosition newStartTime)
     setStart (newStartTime, false, false);
 
     if (offsetNeededInBeats > BeatDuration())
-        getSequence().moveAllBeatPositions (offsetNeededInBeats, getUndoManager());
+        getSequence().moveAllBeatPositions (offsetNeededInBeats, getUndoManager(), edit.getUndoJournal());
 }
 
 void MidiClip::trimBeyondEnds (bool beyondStart, bool beyondEnd, juce::UndoManager* um)
@@ -318,7 +485,8 @@ void MidiClip::trimBeyondEnds (bool beyondStart, bool beyondEnd, juce::UndoManag
         auto& sequence = getSequence();
         auto startBeats = getContentBeatAtTime (getPosition().getStart());
         sequence.trimOutside (startBeats, BeatPosition::fromBeats (Edit::maximumLength), um);
-        sequence.moveAllBeatPositions (-toDuration (getContentBeatAtTime (getPosition().getStart())), um);
+        sequence.moveAllBeatPositions (-toDuration (getContentBeatAtTime (getPosition().getStart())), um,
+                                       um == &edit.getUndoManager() ? edit.getUndoJournal() : nullptr);
         setOffset ({});
     }
 
@@ -777,6 +945,13 @@ LiveClipLevel MidiClip::getLiveClipLevel()
 
 void MidiClip::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier& id)
 {
+    if (tree == state)
+        playbackSequenceCache->clipPropertyChanged (id);
+    else if (tree.hasType (IDs::NOTE))
+        playbackSequenceCache->noteChanged (tree);
+    else
+        playbackSequenceCache->clear();
+
     if (tree == state)
     {
         if (id == IDs::mute)
@@ -835,6 +1010,8 @@ void MidiClip::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Iden
 
 void MidiClip::valueTreeChildAdded (juce::ValueTree& p, juce::ValueTree& c)
 {
+    playbackSequenceCache->clear();
+
     if (p.hasType (IDs::SEQUENCE))
         clearCachedLoopSequence();
     else if ((p == state || p.getParent() == state) && c.hasType (IDs::SEQUENCE))
@@ -846,6 +1023,8 @@ void MidiClip::valueTreeChildAdded (juce::ValueTree& p, juce::ValueTree& c)
 
 void MidiClip::valueTreeChildRemoved (juce::ValueTree& p, juce::ValueTree& c, int)
 {
+    playbackSequenceCache->clear();
+
     if (p.hasType (IDs::SEQUENCE))
     {
         clearCachedLoopSequence();
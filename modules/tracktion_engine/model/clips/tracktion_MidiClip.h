@@ -33,6 +33,16 @@ public:
     MidiList& getSequenceLooped();
     std::unique_ptr<MidiList> createSequenceLooped (MidiList& sourceSequence);
 
+    /** Returns the sequence to play this clip back with, as MidiList::exportToPlaybackMidiSequence
+        creates it. beatsRaw sequences are of the current take as the looping is applied during
+        playback, the other TimeBases use getSequenceLooped().
+
+        Sequences are cached and only created again when the clip's events, quantisation,
+        groove or the tempo change. Moving or changing a single note updates the cached
+        beatsRaw sequence in place.
+    */
+    juce::MidiMessageSequence getPlaybackMidiSequence (MidiList::TimeBase, bool generateMPE);
+
     const SelectedMidiEvents* getSelectedEvents() const             { return selectedEvents; }
 
     //==============================================================================
@@ -200,6 +210,9 @@ private:
     SelectedMidiEvents* selectedEvents = nullptr;
 
     mutable std::unique_ptr<MidiList> cachedLoopedSequence;
+
+    struct PlaybackSequenceCache;
+    std::unique_ptr<PlaybackSequenceCache> playbackSequenceCache;
     MidiCompManager::Ptr midiCompManager;
 
     //==============================================================================
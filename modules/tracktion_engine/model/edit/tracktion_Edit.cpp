@@ -639,7 +639,14 @@ Edit::Edit (Options options)
         trackCompManager            = std::make_unique<TrackCompManager> (*this);
         changedPluginsList          = std::make_unique<ChangedPluginsList>();
 
-        undoManager.setMaxNumberOfStoredUnits (1000 * options.numUndoLevelsToStore, options.numUndoLevelsToStore);
+        if (options.undoHistoryBudgetBytes > 0)
+            undoManager.setMaxNumberOfStoredUnits ((int) std::min (options.undoHistoryBudgetBytes, (size_t) std::numeric_limits<int>::max()), 1);
+        else
+            undoManager.setMaxNumberOfStoredUnits (1000 * options.numUndoLevelsToStore, options.numUndoLevelsToStore);
+
+        if (options.undoJournalMaxBytesInMemory > 0)
+            undoJournal = std::make_unique<UndoJournal> (getTempDirectory (true).getChildFile ("undo_journal.bin"),
+                                                         options.undoJournalMaxBytesInMemory);
 
         initialise (options);
 
@@ -2322,6 +2329,8 @@ void Edit::updateModifierTimers (TimePosition editTime, int numSamples) const
 
     for (auto mt : modifierTimers)
         mt->updateStreamTime (editTime, numSamples);
+
+    modifierTimerUpdateCount.fetch_add (1, std::memory_order_release);
 }
 
 //==============================================================================
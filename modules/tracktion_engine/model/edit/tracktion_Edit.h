@@ -120,6 +120,9 @@ public:
         uint32_t numAudioTracks = 1;                                 ///< If non-zero, will ensure the edit has this many audio tracks
 
         float defaultMasterVolumedB = -3.0f;                         ///< The initial level for the edit's master volume
+
+        size_t undoHistoryBudgetBytes = 0;                           ///< If non-zero, limits the undo history by its approximate size rather than numUndoLevelsToStore.
+        size_t undoJournalMaxBytesInMemory = 0;                      ///< If non-zero, older compact undo transactions beyond this size are moved to a file in the temp directory. @see UndoJournal
     };
 
     /** Creates an Edit from a set of Options.
@@ -331,6 +334,12 @@ public:
     /** Returns the juce::UndoManager used for this Edit. */
     juce::UndoManager& getUndoManager() noexcept                { return undoManager; }
 
+    /** Returns the UndoJournal used for compact undo transactions, if one was
+        enabled with Options::undoJournalMaxBytesInMemory.
+        @see ValueTreeDeltaRecorder
+    */
+    UndoJournal* getUndoJournal() const noexcept                { return undoJournal.get(); }
+
     /** Undoes the most recent changes made. */
     void undo();
 
@@ -509,6 +518,12 @@ public:
     /** Updates all the ModifierTimers with a given edit time and number of samples. */
     void updateModifierTimers (TimePosition editTime, int numSamples) const;
 
+    /** Returns a count of the number of times updateModifierTimers has been called.
+        This changes once per block so can be used to avoid evaluating a modulation
+        source more than once per block when it's assigned to many parameters.
+    */
+    uint64_t getModifierTimerUpdateCount() const noexcept   { return modifierTimerUpdateCount.load (std::memory_order_acquire); }
+
     /** Holds the global Macros for the Edit. */
     struct GlobalMacros : public MacroParameterElement
     {
@@ -895,6 +910,7 @@ private:
     std::unique_ptr<PluginCache> pluginCache;
     std::unique_ptr<TrackCompManager> trackCompManager;
     juce::Array<ModifierTimer*, juce::CriticalSection> modifierTimers;
+    mutable std::atomic<uint64_t> modifierTimerUpdateCount { 0 };
     std::unique_ptr<GlobalMacros> globalMacros;
 
     mutable std::optional<TimeDuration> totalEditLength;
@@ -907,6 +923,7 @@ private:
     bool hasChanged = false;
     bool ignoreLeftViewLimit;
     LoadContext* loadContext = nullptr;
+    std::unique_ptr<UndoJournal> undoJournal;
     juce::UndoManager undoManager;
     int numUndoTransactionInhibitors = 0;
     mutable juce::File tempDirectory;
@@ -225,6 +225,7 @@ GrooveTemplateManager::GrooveTemplateManager (Engine& e)
 void GrooveTemplateManager::useParameterizedGrooves (bool use)
 {
     activeGrooves.clear();
+    ++changeCount;
 
     useParameterized = use;
     if (useParameterized)
@@ -92,6 +92,9 @@ public:
     void updateTemplate (int index, const GrooveTemplate&);
     void deleteTemplate (int index);
 
+    /** Returns a number that changes each time any of the templates are changed, added or removed. */
+    uint32_t getChangeCount() const noexcept                    { return changeCount; }
+
     /** called when usersettings change, because that's where the grooves are kept. */
     void reload();
 
@@ -107,6 +110,7 @@ private:
     void reload (const juce::XmlElement*);
 
     bool useParameterized = false;
+    uint32_t changeCount = 0;
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveTemplateManager)
 };
@@ -549,6 +549,12 @@ const tempo::Sequence& TempoSequence::getInternalSequence() const
     return internalSequence;
 }
 
+uint32_t TempoSequence::getChangeCount() const
+{
+    updateTempoDataIfNeeded();
+    return changeCount;
+}
+
 void TempoSequence::updateTempoData()
 {
     tempos->cancelPendingUpdate();
@@ -593,6 +599,8 @@ void TempoSequence::updateTempoData()
         juce::ScopedLock sl (edit.engine.getDeviceManager().deviceManager.getAudioCallbackLock());
         internalSequence = std::move (newSeq);
     }
+
+    ++changeCount;
 }
 
 void TempoSequence::updateTempoDataIfNeeded() const
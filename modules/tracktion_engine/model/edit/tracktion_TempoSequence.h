@@ -192,6 +192,11 @@ public:
     */
     const tempo::Sequence& getInternalSequence() const;
 
+    /** Returns a number that changes each time the tempos, time signatures or key changes
+        are updated. This can be used to tell if anything calculated from them is out of date.
+    */
+    uint32_t getChangeCount() const;
+
     //==============================================================================
     Edit& edit; /**< The Edit this sequence belongs to. */
 
@@ -231,6 +236,7 @@ private:
     tempo::Sequence internalSequence { {{ BeatPosition(), 120.0, 0.0f }},
                                        {{ BeatPosition(), 4, 4, false }},
                                        tempo::LengthOfOneBeat::dependsOnTimeSignature };
+    uint32_t changeCount = 0;
 
     //==============================================================================
     void updateTempoDataIfNeeded() const;
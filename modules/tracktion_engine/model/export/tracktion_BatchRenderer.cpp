@@ -0,0 +1,360 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+namespace batch_render_utils
+{
+    static int getNumConcurrentRenders (const BatchRenderer::Options& o)
+    {
+        auto num = o.maxNumConcurrentRenders > 0 ? o.maxNumConcurrentRenders
+                                                 : juce::SystemStats::getNumCpus() - 1;
+
+        if (o.memoryPerRenderMB > 0)
+            num = std::min (num, juce::SystemStats::getMemorySizeInMegabytes() / 2 / o.memoryPerRenderMB);
+
+        return std::max (1, num);
+    }
+}
+
+//==============================================================================
+struct BatchRenderer::RenderJob  : public juce::ThreadPoolJob
+{
+    RenderJob (BatchRenderer& o, JobID i, Job j, std::shared_ptr<JobState> s)
+        : juce::ThreadPoolJob ("Batch Render"), owner (o), id (i), job (std::move (j)), state (std::move (s))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        CRASH_TRACER
+        juce::FloatVectorOperations::disableDenormalisedNumberSupport();
+
+        auto result = render();
+        state->progress = 1.0f;
+        owner.removeJobState (id);
+
+        if (job.finishedCallback)
+            juce::MessageManager::callAsync ([callback = std::move (job.finishedCallback), result = std::move (result)]
+                                             { callback (result); });
+
+        return jobHasFinished;
+    }
+
+private:
+    BatchRenderer& owner;
+    const JobID id;
+    Job job;
+    std::shared_ptr<JobState> state;
+
+    std::unique_ptr<Edit> edit;
+    std::unique_ptr<Edit::ScopedRenderStatus> renderStatus;
+    std::unique_ptr<Renderer::RenderTask> task;
+    bool editWasModified = false;
+
+    /** Notes whether an Edit's state is changed, e.g. by a job's prepareRender. */
+    struct StateChangeDetector  : private juce::ValueTree::Listener
+    {
+        StateChangeDetector (const juce::ValueTree& v)  : state (v)     { state.addListener (this); }
+        ~StateChangeDetector() override                                 { state.removeListener (this); }
+
+        bool changed = false;
+
+    private:
+        juce::ValueTree state;
+
+        void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override  { changed = true; }
+        void valueTreeChildAdded (juce::ValueTree&, juce::ValueTree&) override              { changed = true; }
+        void valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree&, int) override       { changed = true; }
+        void valueTreeChildOrderChanged (juce::ValueTree&, int, int) override               { changed = true; }
+    };
+
+    bool isCancelled() const
+    {
+        return state->cancelled || shouldExit();
+    }
+
+    tl::expected<juce::File, std::string> render()
+    {
+        if (isCancelled() || ! owner.acquireLoadSlot (*state))
+            return tl::unexpected (NEEDS_TRANS("Cancelled"));
+
+        juce::File destFile;
+        juce::String error;
+        bool finished = false;
+
+        // Loading the Edit and building the graph need the message thread
+        const bool started = callBlockingCatching ([&]
+        {
+            edit = owner.takeIdleEdit (job.editState);
+
+            if (edit == nullptr)
+                edit = Edit::createEdit ({ owner.engine, job.editState.createCopy(), job.editProjectItemID,
+                                           Edit::forRendering, nullptr, 1,
+                                           job.editFileRetriever, job.filePathResolver, 0 });
+
+            if (edit == nullptr)
+            {
+                error = TRANS("Couldn't load the Edit to render");
+                return;
+            }
+
+            renderStatus = std::make_unique<Edit::ScopedRenderStatus> (*edit, false);
+
+            Renderer::Parameters r (*edit);
+            r.time = { 0_tp, edit->getLength() };
+            r.audioFormat = owner.engine.getAudioFileFormatManager().getWavFormat();
+
+            if (job.prepareRender)
+            {
+                // An Edit that's been changed no longer matches the job's state so can't be reused
+                const StateChangeDetector detector (edit->state);
+                job.prepareRender (*edit, r);
+                editWasModified = detector.changed;
+            }
+
+            // Each job gets a single thread, the concurrency comes from running several jobs
+            if (r.numGraphThreads < 0)
+                r.numGraphThreads = 0;
+
+            destFile = r.destFile;
+            task = render_utils::createRenderTask (r, {}, &state->progress, nullptr);
+
+            if (task == nullptr)
+                error = TRANS("Couldn't render, as the selected region was empty");
+        });
+
+        owner.releaseLoadSlot();
+
+        // The first block initialises the plugins but posts that to the message thread
+        // itself, so all the blocks are run here to keep the message thread free
+        if (started && error.isEmpty())
+            while (! finished && ! isCancelled())
+                finished = task->runJob() == jobHasFinished;
+
+        if (task != nullptr && error.isEmpty())
+            error = task->errorMessage;
+
+        const bool canReuse = finished && error.isEmpty() && ! isCancelled() && ! editWasModified;
+        cleanUp (canReuse);
+
+        if (! started || (! finished && error.isEmpty()))
+            return tl::unexpected (NEEDS_TRANS("Cancelled"));
+
+        if (error.isNotEmpty())
+            return tl::unexpected (error.toStdString());
+
+        return destFile;
+    }
+
+    void cleanUp (bool canReuse)
+    {
+        task.reset();
+
+        const bool cleanedUp = callBlockingCatching ([this, canReuse]
+        {
+            renderStatus.reset();
+
+            if (edit == nullptr)
+                return;
+
+            if (canReuse)
+                owner.returnIdleEdit (std::move (edit), job.editState);
+            else
+                owner.deleteEditLater (std::move (edit));
+
+            owner.deletePendingEdits();
+        });
+
+        // Edits must be deleted on the message thread so leave it for the owner
+        if (! cleanedUp)
+        {
+            renderStatus.reset();
+            owner.deleteEditLater (std::move (edit));
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderJob)
+};
+
+//==============================================================================
+BatchRenderer::BatchRenderer (Engine& e, Options o)
+    : engine (e), options (o),
+      numConcurrentRenders (batch_render_utils::getNumConcurrentRenders (o)),
+      pool (numConcurrentRenders)
+{
+}
+
+BatchRenderer::~BatchRenderer()
+{
+    CRASH_TRACER
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    cancelAllJobs();
+    pool.removeAllJobs (true, 30000);
+
+    for (auto& idle : idleEdits)
+        deleteEditLater (std::move (idle.edit));
+
+    idleEdits.clear();
+    deletePendingEdits();
+}
+
+BatchRenderer::JobID BatchRenderer::addJob (Job job)
+{
+    jassert (job.editState.isValid());
+    jassert (job.editProjectItemID.isValid());
+
+    auto state = std::make_shared<JobState>();
+    JobID id;
+
+    {
+        const std::scoped_lock sl (jobStatesMutex);
+        id = nextJobID++;
+        jobStates[id] = state;
+    }
+
+    pool.addJob (new RenderJob (*this, id, std::move (job), std::move (state)), true);
+    return id;
+}
+
+void BatchRenderer::cancelJob (JobID id)
+{
+    const std::scoped_lock sl (jobStatesMutex);
+
+    if (auto found = jobStates.find (id); found != jobStates.end())
+        found->second->cancelled = true;
+}
+
+void BatchRenderer::cancelAllJobs()
+{
+    const std::scoped_lock sl (jobStatesMutex);
+
+    for (auto& [id, state] : jobStates)
+        state->cancelled = true;
+}
+
+int BatchRenderer::getNumJobs() const
+{
+    const std::scoped_lock sl (jobStatesMutex);
+    return (int) jobStates.size();
+}
+
+float BatchRenderer::getProgress (JobID id) const
+{
+    const std::scoped_lock sl (jobStatesMutex);
+
+    if (auto found = jobStates.find (id); found != jobStates.end())
+        return found->second->progress;
+
+    return 1.0f;
+}
+
+int BatchRenderer::getNumIdleEdits() const
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    return (int) idleEdits.size();
+}
+
+//==============================================================================
+bool BatchRenderer::acquireLoadSlot (const JobState& state)
+{
+    const auto maxNumLoads = std::max (1, options.maxNumConcurrentLoads);
+
+    for (;;)
+    {
+        auto num = numLoading.load();
+
+        if (num < maxNumLoads && numLoading.compare_exchange_weak (num, num + 1))
+            return true;
+
+        if (state.cancelled)
+            return false;
+
+        if (auto job = juce::ThreadPoolJob::getCurrentThreadPoolJob(); job != nullptr && job->shouldExit())
+            return false;
+
+        juce::Thread::sleep (10);
+    }
+}
+
+void BatchRenderer::releaseLoadSlot()
+{
+    --numLoading;
+}
+
+std::unique_ptr<Edit> BatchRenderer::takeIdleEdit (const juce::ValueTree& editState)
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+
+    for (auto idle = idleEdits.begin(); idle != idleEdits.end(); ++idle)
+    {
+        if (idle->state.isEquivalentTo (editState))
+        {
+            auto edit = std::move (idle->edit);
+            idleEdits.erase (idle);
+            return edit;
+        }
+    }
+
+    return {};
+}
+
+void BatchRenderer::returnIdleEdit (std::unique_ptr<Edit> edit, const juce::ValueTree& editState)
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    const auto maxNumIdle = options.maxNumIdleEdits < 0 ? numConcurrentRenders
+                                                        : options.maxNumIdleEdits;
+
+    if (maxNumIdle == 0)
+        return deleteEditLater (std::move (edit));
+
+    // Re-initialising a plugin that's still initialised doesn't clear its delay lines and
+    // reverb tails, so they're turned off to stop the end of one render leaking into the next
+    Renderer::turnOffAllPlugins (*edit);
+    idleEdits.push_back ({ editState, std::move (edit) });
+
+    while ((int) idleEdits.size() > maxNumIdle)
+    {
+        deleteEditLater (std::move (idleEdits.front().edit));
+        idleEdits.erase (idleEdits.begin());
+    }
+}
+
+void BatchRenderer::deleteEditLater (std::unique_ptr<Edit> edit)
+{
+    if (edit == nullptr)
+        return;
+
+    const std::scoped_lock sl (editsToDeleteMutex);
+    editsToDelete.push_back (std::move (edit));
+}
+
+void BatchRenderer::deletePendingEdits()
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    std::vector<std::unique_ptr<Edit>> edits;
+
+    {
+        const std::scoped_lock sl (editsToDeleteMutex);
+        std::swap (edits, editsToDelete);
+    }
+
+    for (auto& e : edits)
+        Renderer::turnOffAllPlugins (*e);
+}
+
+void BatchRenderer::removeJobState (JobID id)
+{
+    const std::scoped_lock sl (jobStatesMutex);
+    jobStates.erase (id);
+}
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,137 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+/**
+    A queue that renders many Edits concurrently on a bounded set of threads.
+
+    Each job loads its own Edit, so unlike EditRenderer the caller doesn't need
+    to keep an Edit alive per render. All the jobs use the same Engine so they
+    share its AudioFileManager and AudioFileCache, meaning source files used by
+    several Edits are only opened and mapped once while any job still needs them.
+
+    Rendered Edits are kept loaded for a while. If a later job has an identical
+    Edit state it reuses that Edit and its already created plugins instead of
+    loading a new one, which is the common case when rendering several ranges or
+    stems from the same Edit. The plugins are deinitialised between jobs so each
+    render starts from a clean state.
+
+    Loading an Edit reads most of its source material, so the number of Edits
+    that can be loading at the same time is limited separately from the number
+    of renders to stop them contending for disk I/O.
+
+    The message thread must be running for jobs to make progress.
+*/
+class BatchRenderer
+{
+public:
+    //==============================================================================
+    /** Options controlling how many renders are run at once. */
+    struct Options
+    {
+        int maxNumConcurrentRenders = 0;    ///< The number of renders to run at once, 0 uses one less than the number of CPUs
+        int memoryPerRenderMB = 512;        ///< An estimate of a single render's memory use, the number of renders is limited to fit in half the physical memory
+        int maxNumConcurrentLoads = 2;      ///< The number of Edits that can be loading at once
+        int maxNumIdleEdits = -1;           ///< The number of rendered Edits to keep loaded for reuse, -1 uses the number of concurrent renders
+    };
+
+    /** Describes a single render. */
+    struct Job
+    {
+        juce::ValueTree editState;                      ///< The Edit state to render. This is copied so can be shared between jobs
+        ProjectItemID editProjectItemID;                ///< The Edit's ProjectItemID
+        Edit::EditFileRetriever editFileRetriever;      ///< An optional editFileRetriever for the Edit
+        Edit::FilePathResolver filePathResolver;        ///< An optional filePathResolver for the Edit
+
+        /** Called on the message thread once the Edit has been loaded to fill in
+            the destination file, time range etc. If this modifies the Edit's state
+            the Edit is deleted after rendering rather than reused by later jobs.
+        */
+        std::function<void (Edit&, Renderer::Parameters&)> prepareRender;
+
+        /** Called on the message thread with the rendered file or an error once the job has finished. */
+        std::function<void (tl::expected<juce::File, std::string>)> finishedCallback;
+    };
+
+    /** Identifies a job that has been added. */
+    using JobID = int;
+
+    //==============================================================================
+    /** Creates a BatchRenderer for an Engine. */
+    BatchRenderer (Engine&, Options = {});
+
+    /** Destructor. Cancels any jobs that haven't finished. This must be called on the message thread. */
+    ~BatchRenderer();
+
+    //==============================================================================
+    /** Adds a job to the queue, it will be started once a thread is available. */
+    JobID addJob (Job);
+
+    /** Cancels a job if it hasn't finished yet. Its callback will be called with an error. */
+    void cancelJob (JobID);
+
+    /** Cancels all the jobs that haven't finished yet. */
+    void cancelAllJobs();
+
+    /** Returns the number of jobs that are waiting or rendering. */
+    int getNumJobs() const;
+
+    /** Returns the progress of a job or 1 if it has finished. */
+    float getProgress (JobID) const;
+
+    /** Returns the number of renders that will be run at once. */
+    int getMaxNumConcurrentRenders() const noexcept     { return numConcurrentRenders; }
+
+    /** Returns the number of Edits currently kept loaded for reuse. */
+    int getNumIdleEdits() const;
+
+private:
+    //==============================================================================
+    struct RenderJob;
+
+    struct JobState
+    {
+        std::atomic<float> progress { 0.0f };
+        std::atomic<bool> cancelled { false };
+    };
+
+    struct IdleEdit
+    {
+        juce::ValueTree state;
+        std::unique_ptr<Edit> edit;
+    };
+
+    Engine& engine;
+    const Options options;
+    const int numConcurrentRenders;
+    juce::ThreadPool pool;
+
+    std::map<JobID, std::shared_ptr<JobState>> jobStates;
+    std::vector<std::unique_ptr<Edit>> editsToDelete;
+    mutable std::mutex jobStatesMutex, editsToDeleteMutex;
+    std::vector<IdleEdit> idleEdits;
+    std::atomic<int> numLoading { 0 };
+    JobID nextJobID = 1;
+
+    bool acquireLoadSlot (const JobState&);
+    void releaseLoadSlot();
+    std::unique_ptr<Edit> takeIdleEdit (const juce::ValueTree&);
+    void returnIdleEdit (std::unique_ptr<Edit>, const juce::ValueTree&);
+    void deleteEditLater (std::unique_ptr<Edit>);
+    void deletePendingEdits();
+    void removeJobState (JobID);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BatchRenderer)
+};
+
+} // namespace tracktion::inline engine
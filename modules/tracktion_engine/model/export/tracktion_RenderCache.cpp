@@ -0,0 +1,212 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+static constexpr int64_t defaultRenderCacheSize = (int64_t) 2048 * 1024 * 1024;
+static constexpr int renderCacheKeyLength = 16;
+
+RenderCache::RenderCache (Engine& e)  : engine (e)
+{
+}
+
+RenderCache::~RenderCache()
+{
+    cancelPendingUpdate();
+}
+
+//==============================================================================
+HashCode RenderCache::createKey (const juce::String& type, HashCode inputHash)
+{
+    size_t seed = 0;
+    hash_combine (seed, type.toStdString());
+    hash_combine (seed, inputHash);
+
+    return static_cast<HashCode> (seed);
+}
+
+HashCode RenderCache::createKey (const Edit& edit, const juce::String& type, HashCode inputHash)
+{
+    // Edits without a project share a temp folder so this is the same scope
+    // the renders had when they were kept in the Edit's folder
+    size_t seed = static_cast<size_t> (createKey (type, inputHash));
+    hash_combine (seed, edit.getTempDirectory (false).getFullPathName().toStdString());
+
+    return static_cast<HashCode> (seed);
+}
+
+AudioFile RenderCache::getFile (HashCode key) const
+{
+    auto name = juce::String::toHexString ((juce::int64) key).paddedLeft ('0', renderCacheKeyLength);
+    return AudioFile (engine, getFolder().getChildFile (name + ".wav"));
+}
+
+bool RenderCache::hasRender (const AudioFile& af) const
+{
+    return af.getFile().existsAsFile();
+}
+
+bool RenderCache::lookUpRender (const AudioFile& af)
+{
+    auto f = af.getFile();
+    const bool exists = f.existsAsFile();
+
+    if (! isCachedRender (f))
+        return exists;
+
+    if (exists)
+    {
+        ++numHits;
+        f.setLastAccessTime (juce::Time::getCurrentTime());
+    }
+    else
+    {
+        ++numMisses;
+    }
+
+    return exists;
+}
+
+bool RenderCache::isCachedRender (const juce::File& f) const
+{
+    auto name = f.getFileNameWithoutExtension();
+
+    return f.hasFileExtension ("wav")
+            && name.length() == renderCacheKeyLength
+            && name.containsOnly ("0123456789abcdef")
+            && f.getParentDirectory() == getFolder();
+}
+
+juce::File RenderCache::getFolder() const
+{
+    return engine.getTemporaryFileManager().getRenderCacheFolder();
+}
+
+//==============================================================================
+int64_t RenderCache::getMaximumSize() const
+{
+    return static_cast<int64_t> (engine.getPropertyStorage().getProperty (SettingID::renderCacheSize,
+                                                                          (juce::int64) defaultRenderCacheSize));
+}
+
+void RenderCache::setMaximumSize (int64_t numBytes)
+{
+    engine.getPropertyStorage().setProperty (SettingID::renderCacheSize, (juce::int64) numBytes);
+    trim();
+}
+
+void RenderCache::renderCompleted()
+{
+    triggerAsyncUpdate();
+}
+
+void RenderCache::trim()
+{
+    trim (getMaximumSize());
+}
+
+void RenderCache::clear()
+{
+    trim (0);
+}
+
+void RenderCache::trim (int64_t maxSize)
+{
+    CRASH_TRACER
+    TRACKTION_ASSERT_MESSAGE_THREAD
+
+    auto renders = findRenders();
+    int64_t totalBytes = 0;
+
+    for (auto& f : renders)
+        totalBytes += f.getSize();
+
+    if (totalBytes <= maxSize)
+        return;
+
+    std::sort (renders.begin(), renders.end(),
+               [] (const juce::File& first, const juce::File& second)
+               {
+                   return first.getLastAccessTime() < second.getLastAccessTime();
+               });
+
+    for (auto& f : renders)
+    {
+        if (totalBytes <= maxSize)
+            break;
+
+        if (isInUse (f))
+            continue;
+
+        const auto size = f.getSize();
+
+        if (AudioFile (engine, f).deleteFile())
+        {
+            totalBytes -= size;
+            ++numEvictions;
+        }
+    }
+}
+
+//==============================================================================
+RenderCache::Statistics RenderCache::getStatistics() const
+{
+    Statistics stats;
+    stats.numHits = numHits;
+    stats.numMisses = numMisses;
+    stats.numEvictions = numEvictions;
+
+    for (auto& f : findRenders())
+    {
+        ++stats.numFiles;
+        stats.numBytes += f.getSize();
+    }
+
+    return stats;
+}
+
+void RenderCache::resetStatistics()
+{
+    numHits = 0;
+    numMisses = 0;
+    numEvictions = 0;
+}
+
+//==============================================================================
+juce::Array<juce::File> RenderCache::findRenders() const
+{
+    auto renders = getFolder().findChildFiles (juce::File::findFiles, false, "*.wav");
+    renders.removeIf ([this] (const juce::File& f) { return ! isCachedRender (f); });
+
+    return renders;
+}
+
+bool RenderCache::isInUse (const juce::File& f) const
+{
+    const AudioFile af (engine, f);
+
+    if (engine.getRenderManager().isProxyBeingGenerated (af)
+         || engine.getAudioFileManager().proxyGenerator.isProxyBeingGenerated (af))
+        return true;
+
+    for (auto edit : engine.getActiveEdits().getEdits())
+        if (edit->areAnyClipsUsingFile (af))
+            return true;
+
+    return false;
+}
+
+void RenderCache::handleAsyncUpdate()
+{
+    trim();
+}
+
+}} // namespace tracktion { inline namespace engine
@@ -0,0 +1,134 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+/**
+    A folder of rendered audio shared by all the open Edits, with each file named
+    by a hash of the inputs that produced it.
+
+    Clip renders, time-stretched proxies, comps, clip effects and edit clips all
+    get their files from here, so two clips or Edits that need the same render
+    share a single file and a render is only ever done again if its inputs change.
+
+    The total size is kept under a budget by deleting the least recently used
+    renders, skipping any that are being used by an open Edit or are still being
+    generated.
+
+    You shouldn't need to create one of these, use Engine::getRenderCache().
+*/
+class RenderCache  : private juce::AsyncUpdater
+{
+public:
+    //==============================================================================
+    /** Creates a cache. Use the Engine's rather than creating your own. */
+    RenderCache (Engine&);
+
+    /** Destructor. */
+    ~RenderCache() override;
+
+    //==============================================================================
+    /** Creates a key for a render from a hash of everything that affects its output.
+        The type separates different kinds of render that might have the same input hash.
+        Use this when the hash describes the content completely, e.g. it includes the
+        source file's hash, so that any Edit can share the render.
+    */
+    static HashCode createKey (const juce::String& type, HashCode inputHash);
+
+    /** Creates a key for a render that's only valid within a particular Edit.
+        Use this when the hash relies on things like clip IDs that only have a meaning
+        inside the Edit that created them.
+    */
+    static HashCode createKey (const Edit&, const juce::String& type, HashCode inputHash);
+
+    /** Returns the file a render with this key should be written to or read from.
+        This doesn't check whether it exists.
+    */
+    AudioFile getFile (HashCode key) const;
+
+    /** Returns true if a render has already been done.
+        This doesn't change the statistics or the file so can be called as often as needed.
+    */
+    bool hasRender (const AudioFile&) const;
+
+    /** Checks whether a render has already been done, counting a hit or a miss
+        in the statistics. Call this once when deciding whether a render needs starting,
+        e.g. when the render a clip needs changes, and hasRender for any checks after that.
+        A hit marks the file as recently used so it's the last to be evicted.
+    */
+    bool lookUpRender (const AudioFile&);
+
+    /** Returns true if this file is one of the cache's renders. */
+    bool isCachedRender (const juce::File&) const;
+
+    /** Returns the folder the renders are kept in. */
+    juce::File getFolder() const;
+
+    //==============================================================================
+    /** Returns the number of bytes the renders are allowed to take up. */
+    int64_t getMaximumSize() const;
+
+    /** Sets the number of bytes the renders are allowed to take up.
+        This is saved in the PropertyStorage and the cache is trimmed to fit it.
+    */
+    void setMaximumSize (int64_t numBytes);
+
+    /** Should be called when a render has been added to the cache.
+        This trims the cache asynchronously on the message thread.
+    */
+    void renderCompleted();
+
+    /** Deletes the least recently used renders until the cache fits its budget.
+        Renders that are in use or being generated are never deleted.
+    */
+    void trim();
+
+    /** Deletes the least recently used renders until the cache fits in a given number
+        of bytes, without changing the saved budget.
+    */
+    void trim (int64_t maxSize);
+
+    /** Deletes all the renders that aren't in use or being generated. */
+    void clear();
+
+    //==============================================================================
+    /** Some statistics about how well the cache is working. */
+    struct Statistics
+    {
+        int numHits = 0;        ///< The number of times lookUpRender found a render
+        int numMisses = 0;      ///< The number of times lookUpRender found a render needed doing
+        int numEvictions = 0;   ///< The number of renders deleted to keep the cache within its budget
+        int numFiles = 0;       ///< The number of renders currently in the cache
+        int64_t numBytes = 0;   ///< The total size of the renders currently in the cache
+    };
+
+    /** Returns the current statistics. This scans the folder so isn't free to call. */
+    Statistics getStatistics() const;
+
+    /** Sets the hit, miss and eviction counts back to zero. */
+    void resetStatistics();
+
+    Engine& engine;
+
+private:
+    //==============================================================================
+    std::atomic<int> numHits { 0 }, numMisses { 0 }, numEvictions { 0 };
+
+    juce::Array<juce::File> findRenders() const;
+    bool isInUse (const juce::File&) const;
+
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderCache)
+};
+
+}} // namespace tracktion { inline namespace engine
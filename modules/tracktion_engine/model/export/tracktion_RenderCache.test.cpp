@@ -0,0 +1,112 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_RENDER_CACHE
+
+//==============================================================================
+//==============================================================================
+class RenderCacheTests  : public juce::UnitTest
+{
+public:
+    RenderCacheTests()
+        : juce::UnitTest ("RenderCache", "tracktion_engine")
+    {
+    }
+
+    void runTest() override
+    {
+        auto& engine = *Engine::getEngines().getFirst();
+        auto& cache = engine.getRenderCache();
+        const auto inputHash = (HashCode) juce::Random::getSystemRandom().nextInt64();
+
+        beginTest ("Keys and files");
+        {
+            expectEquals (RenderCache::createKey ("clip_", inputHash), RenderCache::createKey ("clip_", inputHash));
+            expect (RenderCache::createKey ("clip_", inputHash) != RenderCache::createKey ("comp_", inputHash));
+
+            auto file = cache.getFile (RenderCache::createKey ("clip_", inputHash)).getFile();
+            expect (file.getParentDirectory() == cache.getFolder());
+            expect (cache.isCachedRender (file));
+            expect (! cache.isCachedRender (cache.getFolder().getChildFile ("temp_proxy_" + file.getFileName())));
+        }
+
+        beginTest ("Hits and misses");
+        {
+            cache.resetStatistics();
+            auto af = cache.getFile (RenderCache::createKey ("render_", inputHash));
+
+            expect (! cache.lookUpRender (af));
+            expectEquals (cache.getStatistics().numMisses, 1);
+
+            writeFile (af.getFile(), 1000);
+            expect (cache.lookUpRender (af));
+            expectEquals (cache.getStatistics().numHits, 1);
+
+            // Repeated checks don't count towards the statistics or touch the file
+            const auto accessTime = juce::Time (2000, 0, 1, 0, 0);
+            af.getFile().setLastAccessTime (accessTime);
+
+            for (int i = 0; i < 3; ++i)
+                expect (cache.hasRender (af));
+
+            expectEquals (cache.getStatistics().numHits, 1);
+            expectEquals (cache.getStatistics().numMisses, 1);
+            expect (af.getFile().getLastAccessTime() == accessTime);
+
+            af.deleteFile();
+        }
+
+        beginTest ("Least recently used renders are evicted");
+        {
+            // Make these older than any real renders so they're evicted first
+            const int fileSize = 1000;
+            juce::Array<juce::File> files;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                auto f = cache.getFile (RenderCache::createKey ("proxy_", inputHash + i)).getFile();
+                writeFile (f, fileSize);
+                f.setLastAccessTime (juce::Time (2000, 0, i + 1, 0, 0));
+                files.add (f);
+            }
+
+            // Trim to a budget just one file under the current size so the saved budget and
+            // any real renders are left alone
+            const auto oldMaximumSize = cache.getMaximumSize();
+            cache.resetStatistics();
+            cache.trim (cache.getStatistics().numBytes - fileSize);
+
+            expectEquals (cache.getStatistics().numEvictions, 1);
+            expect (! files[0].existsAsFile());
+            expect (files[1].existsAsFile());
+            expect (files[2].existsAsFile());
+            expectEquals (cache.getMaximumSize(), oldMaximumSize);
+
+            for (auto& f : files)
+                f.deleteFile();
+        }
+    }
+
+    static void writeFile (const juce::File& f, int numBytes)
+    {
+        f.getParentDirectory().createDirectory();
+        juce::MemoryBlock data ((size_t) numBytes, true);
+        f.replaceWithData (data.getData(), data.getSize());
+    }
+};
+
+static RenderCacheTests renderCacheTests;
+
+#endif
+
+}} // namespace tracktion { inline namespace engine
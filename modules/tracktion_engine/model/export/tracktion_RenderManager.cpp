@@ -48,6 +48,9 @@ juce::ThreadPoolJob::JobStatus RenderManager::Job::runJob()
             proxy.deleteFile();
             isInitialised = true;
 
+            if (! proxy.isNull())
+                proxy.getFile().getParentDirectory().createDirectory();
+
             if (setUpRender())
                 return jobNeedsRunningAgain;
         }
@@ -146,6 +149,9 @@ void RenderManager::Job::handleMessage (const juce::Message& message)
             }
             else
             {
+                if (type == UpdateMessage::succeded)
+                    engine.getRenderCache().renderCompleted();
+
                 listeners.call (&Listener::jobFinished, *this, type == UpdateMessage::succeded);
                 jassert (listeners.isEmpty());
                 selfReference = nullptr;
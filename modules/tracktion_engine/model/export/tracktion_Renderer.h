@@ -80,6 +80,8 @@ public:
         bool realTimeRender = false;                            ///< If true, there will be a pause between each rendered block to simulate real-time
         bool ditheringEnabled = false;                          ///< If true, low-level noise will be added to the output for non-float formats
         bool checkNodesForAudio = true;                         ///< If true, attempting to render an Edit that doesn't produce audio will fail
+        int numGraphThreads = -1;                               /**< The number of additional threads to process the graph with.
+                                                                     -1 uses one less than EngineBehaviour::getNumberOfCPUsToUseForAudio. */
 
         int quality = 0;                                        ///< For audio formats that support it, the desired quality index @see juce::AudioFormat::createWriterFor
         juce::StringPairArray metadata;                         ///< A map of meta data to add to the file
@@ -65,6 +65,270 @@ TEST_SUITE("tracktion_engine")
         CHECK (thumbnail->getNumSamplesFinished() >= toSamples (fileLength, 44100.0));
         CHECK (thumbnail->getTotalLength() >= fileLength.inSeconds());
     }
+
+    TEST_CASE ("Segmented render matches a single render")
+    {
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = test_utilities::createTestEdit (engine);
+
+        auto fileLength = 2_td;
+        auto sinFile = graph::test_utilities::getSinFile<juce::WavAudioFormat> (44100.0, fileLength.inSeconds());
+
+        auto track = getAudioTracks (*edit)[0];
+        insertWaveClip (*track, {}, sinFile->getFile(), { .time = { 0_tp, fileLength } },
+                        DeleteExistingClips::no);
+        insertWaveClip (*track, {}, sinFile->getFile(), { .time = { 5_tp, fileLength } },
+                        DeleteExistingClips::no);
+
+        Renderer::Parameters params (*edit);
+        params.time = { 0_tp, 7_tp };
+        params.audioFormat = engine.getAudioFileFormatManager().getWavFormat();
+        params.bitDepth = 32;
+
+        SegmentedRenderer::Options options;
+        options.minimumSegmentLength = 1s;
+        CHECK_EQ (SegmentedRenderer::findSegments (params, options).size(), 2);
+
+        juce::TemporaryFile singleFile (".wav"), segmentedFile (".wav");
+
+        // The jobs are run and deleted on a background thread as the render contexts
+        // need the message thread when they're destroyed, so that has to keep dispatching
+        auto runAndDeleteOnBackgroundThread = [] (auto job, auto onFinished)
+        {
+            std::atomic<bool> finished { false };
+
+            std::thread thread ([&job, &onFinished, &finished]
+                                {
+                                    while (job->runJob() == juce::ThreadPoolJob::jobNeedsRunningAgain)
+                                    {}
+
+                                    onFinished (*job);
+                                    job.reset();
+                                    finished = true;
+                                });
+
+            test_utilities::runDispatchLoopUntilTrue (finished);
+            thread.join();
+        };
+
+        {
+            auto r = params;
+            r.destFile = singleFile.getFile();
+            auto task = render_utils::createRenderTask (r, {}, nullptr, nullptr);
+            REQUIRE (task);
+
+            runAndDeleteOnBackgroundThread (std::move (task), [] (auto&) {});
+        }
+
+        {
+            auto r = params;
+            r.destFile = segmentedFile.getFile();
+            juce::String errorMessage;
+
+            runAndDeleteOnBackgroundThread (std::make_unique<SegmentedRenderer::RenderTask> (juce::String(), r, options),
+                                            [&errorMessage] (auto& task) { errorMessage = task.errorMessage; });
+            CHECK (errorMessage.isEmpty());
+        }
+
+        auto single = test_utilities::loadFileInToBuffer (engine, singleFile.getFile());
+        auto segmented = test_utilities::loadFileInToBuffer (engine, segmentedFile.getFile());
+        REQUIRE_EQ (segmented->getNumSamples(), single->getNumSamples());
+        REQUIRE_EQ (segmented->getNumChannels(), single->getNumChannels());
+
+        for (int c = 0; c < single->getNumChannels(); ++c)
+            for (int i = 0; i < single->getNumSamples(); ++i)
+                REQUIRE_EQ (segmented->getSample (c, i), doctest::Approx (single->getSample (c, i)).epsilon (1.0e-6));
+    }
+
+    TEST_CASE ("BatchRenderer reuses Edits with the same state")
+    {
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = test_utilities::createTestEdit (engine);
+
+        auto fileLength = 2_td;
+        auto sinFile = graph::test_utilities::getSinFile<juce::WavAudioFormat> (44100.0, fileLength.inSeconds());
+
+        auto track = getAudioTracks (*edit)[0];
+        insertWaveClip (*track, {}, sinFile->getFile(), { .time = { 0_tp, fileLength } },
+                        DeleteExistingClips::no);
+        edit->flushState();
+
+        BatchRenderer::Options options;
+        options.maxNumConcurrentRenders = 1;
+        BatchRenderer batchRenderer (engine, options);
+        CHECK_EQ (batchRenderer.getMaxNumConcurrentRenders(), 1);
+
+        juce::TemporaryFile firstFile (".wav"), secondFile (".wav");
+        std::atomic<int> numFinished { 0 };
+        std::atomic<bool> allFinished { false };
+        std::vector<Edit*> renderedEdits;
+
+        for (auto& f : { firstFile.getFile(), secondFile.getFile() })
+        {
+            BatchRenderer::Job job;
+            job.editState = edit->state;
+            job.editProjectItemID = edit->getProjectItemID();
+            job.prepareRender = [f, &renderedEdits] (Edit& e, Renderer::Parameters& r)
+            {
+                renderedEdits.push_back (&e);
+                r.destFile = f;
+            };
+            job.finishedCallback = [f, &numFinished, &allFinished] (auto res)
+            {
+                CHECK (res);
+                CHECK (*res == f);
+
+                if (++numFinished == 2)
+                    allFinished = true;
+            };
+
+            batchRenderer.addJob (std::move (job));
+        }
+
+        test_utilities::runDispatchLoopUntilTrue (allFinished);
+
+        CHECK_EQ (batchRenderer.getNumJobs(), 0);
+        REQUIRE_EQ (renderedEdits.size(), 2u);
+        CHECK_EQ (renderedEdits[0], renderedEdits[1]);
+        CHECK_EQ (batchRenderer.getNumIdleEdits(), 1);
+
+        for (auto& f : { firstFile.getFile(), secondFile.getFile() })
+        {
+            auto buffer = test_utilities::loadFileInToBuffer (engine, f);
+            CHECK_EQ (buffer->getNumSamples(), toSamples (fileLength, 44100.0));
+        }
+    }
+
+    TEST_CASE ("BatchRenderer reused Edits don't carry over plugin tails")
+    {
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = test_utilities::createTestEdit (engine);
+
+        auto fileLength = 2_td;
+        auto sinFile = graph::test_utilities::getSinFile<juce::WavAudioFormat> (44100.0, fileLength.inSeconds());
+
+        auto track = getAudioTracks (*edit)[0];
+        insertWaveClip (*track, {}, sinFile->getFile(), { .time = { 0_tp, fileLength } },
+                        DeleteExistingClips::no);
+        REQUIRE (insertNewPlugin<DelayPlugin> (*track));
+        edit->flushState();
+
+        BatchRenderer::Options options;
+        options.maxNumConcurrentRenders = 1;
+        BatchRenderer batchRenderer (engine, options);
+
+        // The render stops while the clip is still playing so the delay line is full at the end
+        juce::TemporaryFile firstFile (".wav"), secondFile (".wav");
+        std::atomic<int> numFinished { 0 };
+        std::atomic<bool> allFinished { false };
+        std::vector<Edit*> renderedEdits;
+
+        for (auto& f : { firstFile.getFile(), secondFile.getFile() })
+        {
+            BatchRenderer::Job job;
+            job.editState = edit->state;
+            job.editProjectItemID = edit->getProjectItemID();
+            job.prepareRender = [f, &renderedEdits] (Edit& e, Renderer::Parameters& r)
+            {
+                renderedEdits.push_back (&e);
+                r.destFile = f;
+                r.time = { 0_tp, 1_tp };
+                r.bitDepth = 32;
+            };
+            job.finishedCallback = [&numFinished, &allFinished] (auto res)
+            {
+                CHECK (res);
+
+                if (++numFinished == 2)
+                    allFinished = true;
+            };
+
+            batchRenderer.addJob (std::move (job));
+        }
+
+        test_utilities::runDispatchLoopUntilTrue (allFinished);
+
+        REQUIRE_EQ (renderedEdits.size(), 2u);
+        CHECK_EQ (renderedEdits[0], renderedEdits[1]);
+
+        auto first = test_utilities::loadFileInToBuffer (engine, firstFile.getFile());
+        auto second = test_utilities::loadFileInToBuffer (engine, secondFile.getFile());
+        REQUIRE (first);
+        REQUIRE (second);
+        REQUIRE_EQ (second->getNumSamples(), first->getNumSamples());
+        REQUIRE_EQ (second->getNumChannels(), first->getNumChannels());
+        CHECK (first->getMagnitude (0, first->getNumSamples()) > 0.1f);
+
+        int numDifferent = 0;
+
+        for (int c = 0; c < first->getNumChannels(); ++c)
+            for (int i = 0; i < first->getNumSamples(); ++i)
+                if (second->getSample (c, i) != first->getSample (c, i))
+                    ++numDifferent;
+
+        CHECK_EQ (numDifferent, 0);
+    }
+
+    TEST_CASE ("BatchRenderer doesn't reuse Edits modified by a job")
+    {
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = test_utilities::createTestEdit (engine);
+
+        auto fileLength = 2_td;
+        auto sinFile = graph::test_utilities::getSinFile<juce::WavAudioFormat> (44100.0, fileLength.inSeconds());
+
+        auto track = getAudioTracks (*edit)[0];
+        insertWaveClip (*track, {}, sinFile->getFile(), { .time = { 0_tp, fileLength } },
+                        DeleteExistingClips::no);
+        edit->flushState();
+
+        BatchRenderer::Options options;
+        options.maxNumConcurrentRenders = 1;
+        BatchRenderer batchRenderer (engine, options);
+
+        // The first job mutes the track so the second must load a fresh, unmuted Edit
+        juce::TemporaryFile mutedFile (".wav"), unmutedFile (".wav");
+        std::atomic<int> numFinished { 0 };
+        std::atomic<bool> allFinished { false };
+        std::vector<Edit*> renderedEdits;
+
+        for (auto& f : { mutedFile.getFile(), unmutedFile.getFile() })
+        {
+            BatchRenderer::Job job;
+            job.editState = edit->state;
+            job.editProjectItemID = edit->getProjectItemID();
+            job.prepareRender = [f, mute = f == mutedFile.getFile(), &renderedEdits] (Edit& e, Renderer::Parameters& r)
+            {
+                renderedEdits.push_back (&e);
+                r.destFile = f;
+
+                if (mute)
+                    getAudioTracks (e)[0]->setMute (true);
+            };
+            job.finishedCallback = [&numFinished, &allFinished] (auto res)
+            {
+                CHECK (res);
+
+                if (++numFinished == 2)
+                    allFinished = true;
+            };
+
+            batchRenderer.addJob (std::move (job));
+        }
+
+        test_utilities::runDispatchLoopUntilTrue (allFinished);
+
+        REQUIRE_EQ (renderedEdits.size(), 2u);
+        CHECK_NE (renderedEdits[0], renderedEdits[1]);
+        CHECK_EQ (batchRenderer.getNumIdleEdits(), 1);
+
+        auto muted = test_utilities::loadFileInToBuffer (engine, mutedFile.getFile());
+        auto unmuted = test_utilities::loadFileInToBuffer (engine, unmutedFile.getFile());
+        REQUIRE (muted);
+        REQUIRE (unmuted);
+        CHECK (muted->getMagnitude (0, muted->getNumSamples()) < 0.001f);
+        CHECK (unmuted->getMagnitude (0, unmuted->getNumSamples()) > 0.1f);
+    }
 }
 
 #endif
@@ -0,0 +1,532 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+namespace segmented_render_utils
+{
+    /** Returns the time it takes for every plugin to settle once its input has
+        gone silent, or nothing if some plugins might never be silent.
+        This is deliberately pessimistic as it assumes all the plugins are in series.
+    */
+    static std::optional<TimeDuration> findTimeForAllPluginsToReset (const Edit& edit)
+    {
+        TimeDuration total;
+
+        for (auto p : getAllPlugins (edit, false))
+        {
+            if (! p->isEnabled())
+                continue;
+
+            if (dynamic_cast<ToneGeneratorPlugin*> (p) != nullptr
+                || dynamic_cast<ReWirePlugin*> (p) != nullptr)
+               return {};
+
+            auto tailLength = p->getTailLength();
+
+            if (! std::isfinite (tailLength))
+                return {};
+
+            total = total + TimeDuration::fromSeconds (tailLength + p->getLatencySeconds());
+        }
+
+        return total;
+    }
+
+    /** Finds the middle of every gap between clips which is long enough for all
+        the plugins to have reset.
+    */
+    static juce::Array<TimePosition> findSilentGapSplitPoints (const Renderer::Parameters& r)
+    {
+        auto& edit = *r.edit;
+
+        // Slots can be launched at any time so there's no way to know when they're silent
+        if (edit.engine.getEngineBehaviour().areClipSlotsEnabled())
+            return {};
+
+        auto resetTime = findTimeForAllPluginsToReset (edit);
+
+        if (! resetTime)
+            return {};
+
+        // Allow for the graph being processed in whole blocks
+        const auto margin = *resetTime + TimeDuration::fromSamples (r.blockSizeForAudio * 2, r.sampleRateForAudio);
+
+        // All clips are considered, not just the ones being rendered, as they might be routed to the tracks that are
+        juce::Array<TimeRange> busyRanges;
+
+        for (auto ct : getClipTracks (edit))
+        {
+            for (auto c : ct->getClips())
+            {
+                auto time = c->getEditTimeRange();
+                busyRanges.add ({ time.getStart() - margin, time.getEnd() + margin });
+            }
+        }
+
+        std::sort (busyRanges.begin(), busyRanges.end(),
+                   [] (const auto& a, const auto& b) { return a.getStart() < b.getStart(); });
+
+        juce::Array<TimePosition> points;
+        std::optional<TimePosition> busyUntil;
+
+        for (auto& range : busyRanges)
+        {
+            if (busyUntil && range.getStart() > *busyUntil)
+                points.add (TimePosition::fromSeconds ((busyUntil->inSeconds() + range.getStart().inSeconds()) * 0.5));
+
+            busyUntil = busyUntil ? std::max (*busyUntil, range.getEnd()) : range.getEnd();
+        }
+
+        return points;
+    }
+
+    static int getNumThreadsToUse (const SegmentedRenderer::Options& o, int numSegments)
+    {
+        auto numThreads = o.maxNumThreads > 0 ? o.maxNumThreads
+                                              : juce::SystemStats::getNumCpus() - 1;
+        return juce::jlimit (1, std::max (1, numSegments), numThreads);
+    }
+}
+
+//==============================================================================
+bool SegmentedRenderer::canRenderInSegments (const Renderer::Parameters& r)
+{
+    return r.edit != nullptr
+        && r.audioFormat != nullptr
+        && ! r.createMidiFile
+        && ! r.trimSilenceAtEnds
+        && ! r.realTimeRender;
+}
+
+juce::Array<TimeRange> SegmentedRenderer::findSegments (const Renderer::Parameters& r, const Options& o)
+{
+    CRASH_TRACER
+
+    if (! canRenderInSegments (r))
+        return { r.time };
+
+    const auto sampleRate = r.sampleRateForAudio;
+    auto alignToSample = [sampleRate] (TimePosition t)
+    {
+        return TimePosition::fromSamples (toSamples (t, sampleRate), sampleRate);
+    };
+
+    const auto start = alignToSample (r.time.getStart());
+    const auto end = alignToSample (r.time.getEnd());
+
+    auto points = o.splitPoints;
+
+    if (o.splitAtSilentGaps)
+        points.addArray (segmented_render_utils::findSilentGapSplitPoints (r));
+
+    for (auto& p : points)
+        p = alignToSample (p);
+
+    std::sort (points.begin(), points.end());
+
+    juce::Array<TimeRange> segments;
+    auto segmentStart = start;
+
+    for (auto p : points)
+    {
+        if (p <= segmentStart || p >= end
+            || p - segmentStart < o.minimumSegmentLength
+            || end - p < o.minimumSegmentLength)
+           continue;
+
+        segments.add ({ segmentStart, p });
+        segmentStart = p;
+    }
+
+    if (segments.isEmpty())
+        return { r.time };
+
+    segments.add ({ segmentStart, end });
+    return segments;
+}
+
+//==============================================================================
+struct SegmentedRenderer::RenderTask::Segment
+{
+    TimeRange time;
+    SampleCount numSamples = 0;
+    bool isLast = false;
+
+    std::unique_ptr<juce::TemporaryFile> file;
+    std::unique_ptr<Edit> edit;
+    std::unique_ptr<Renderer::RenderTask> task;
+
+    std::atomic<float> progress { 0.0f };
+    std::atomic<bool> finished { false };
+    bool started = false, cleanedUp = false;
+
+    float magnitude = 0.0f, rms = 0.0f;
+    juce::String error;
+};
+
+SegmentedRenderer::RenderTask::RenderTask (const juce::String& taskDescription,
+                                           const Renderer::Parameters& r,
+                                           const Options& o,
+                                           std::atomic<float>* progressToUpdate)
+    : ThreadPoolJobWithProgress (taskDescription),
+      params (r),
+      segments (findSegments (r, o)),
+      pool (segmented_render_utils::getNumThreadsToUse (o, segments.size())),
+      progress (progressToUpdate == nullptr ? progressInternal : *progressToUpdate)
+{
+    CRASH_TRACER
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    jassert (params.edit != nullptr);
+    jassert (canRenderInSegments (params));
+
+    numThreads = pool.getNumThreads();
+
+    // Each section is rendered on its own copy of the Edit so no plugin is ever processed by two graphs at once
+    params.edit->flushState();
+    editStateToCopy = params.edit->state.createCopy();
+
+    for (auto c : params.allowedClips)
+        allowedClipIDs.add (c->itemID);
+
+    for (int i = 0; i < segments.size(); ++i)
+    {
+        auto s = std::make_unique<Segment>();
+        s->time = segments[i];
+        s->numSamples = toSamples (s->time.getEnd(), params.sampleRateForAudio)
+                          - toSamples (s->time.getStart(), params.sampleRateForAudio);
+        s->isLast = i == segments.size() - 1;
+        segmentStates.push_back (std::move (s));
+    }
+}
+
+SegmentedRenderer::RenderTask::~RenderTask()
+{
+    CRASH_TRACER
+    pool.removeAllJobs (true, 30000);
+
+    for (auto& s : segmentStates)
+        if (s->started && ! s->cleanedUp)
+            finishSegment (*s);
+}
+
+juce::ThreadPoolJob::JobStatus SegmentedRenderer::RenderTask::runJob()
+{
+    CRASH_TRACER
+    juce::FloatVectorOperations::disableDenormalisedNumberSupport();
+
+    if (shouldExit())
+        return jobHasFinished;
+
+    int numActive = 0;
+
+    for (auto& s : segmentStates)
+    {
+        if (s->started && s->finished && ! s->cleanedUp)
+            finishSegment (*s);
+
+        if (s->error.isNotEmpty())
+        {
+            errorMessage = s->error;
+            return jobHasFinished;
+        }
+
+        if (s->started && ! s->cleanedUp)
+            ++numActive;
+    }
+
+    while (numActive < numThreads && nextSegmentToStart < (int) segmentStates.size())
+    {
+        auto& s = *segmentStates[(size_t) nextSegmentToStart++];
+
+        if (! startSegment (s))
+        {
+            errorMessage = s.error;
+            return jobHasFinished;
+        }
+
+        ++numActive;
+    }
+
+    updateProgress();
+
+    if (numActive > 0 || nextSegmentToStart < (int) segmentStates.size())
+    {
+        segmentFinishedEvent.wait (50);
+        return jobNeedsRunningAgain;
+    }
+
+    if (joinSegments())
+        progress = 1.0f;
+    else
+        params.destFile.deleteFile();
+
+    return jobHasFinished;
+}
+
+bool SegmentedRenderer::RenderTask::startSegment (Segment& s)
+{
+    CRASH_TRACER
+    auto& engine = *params.engine;
+    s.started = true;
+
+    callBlocking ([this, &s, &engine]
+                  {
+                      s.edit = Edit::createEdit ({ engine, editStateToCopy.createCopy(), params.edit->getProjectItemID(),
+                                                   Edit::forRendering, nullptr, 1,
+                                                   params.edit->editFileRetriever, params.edit->filePathResolver, 0 });
+                  });
+
+    if (s.edit == nullptr)
+    {
+        s.error = TRANS("Couldn't create a copy of the Edit to render");
+        return false;
+    }
+
+    auto r = params;
+    r.edit = s.edit.get();
+    r.time = s.time;
+    r.endAllowance = s.isLast ? params.endAllowance : TimeDuration();
+    r.allowedClips.clearQuick();
+
+    for (auto id : allowedClipIDs)
+        if (auto c = findClipForID (*s.edit, id))
+            r.allowedClips.add (c);
+
+    if (r.allowedClips.size() != allowedClipIDs.size())
+    {
+        s.error = TRANS("Couldn't find the clips to render");
+        return false;
+    }
+
+    // Sections are written as floats and only dithered/normalised once they're joined
+    r.audioFormat = engine.getAudioFileFormatManager().getFrozenFileFormat();
+    r.bitDepth = 32;
+    r.metadata = {};
+    r.shouldNormalise = false;
+    r.shouldNormaliseByRMS = false;
+    r.ditheringEnabled = false;
+    r.numGraphThreads = 0;
+
+    s.file = std::make_unique<juce::TemporaryFile> (params.destFile.withFileExtension (r.audioFormat->getFileExtensions()[0]));
+    r.destFile = s.file->getFile();
+
+    s.task = render_utils::createRenderTask (r, getJobName(), &s.progress, nullptr);
+
+    if (s.task == nullptr)
+    {
+        s.error = TRANS("Couldn't render, as the selected region was empty");
+        return false;
+    }
+
+    // The first block creates the render context which needs the message thread
+    // so do that here, then leave the rest to the pool
+    if (s.task->runJob() == jobHasFinished)
+    {
+        s.finished = true;
+        return true;
+    }
+
+    pool.addJob ([this, &s]
+                 {
+                     auto job = juce::ThreadPoolJob::getCurrentThreadPoolJob();
+
+                     while (! shouldExit() && (job == nullptr || ! job->shouldExit()))
+                         if (s.task->runJob() == jobHasFinished)
+                             break;
+
+                     s.finished = true;
+                     segmentFinishedEvent.signal();
+                 });
+
+    return true;
+}
+
+void SegmentedRenderer::RenderTask::finishSegment (Segment& s)
+{
+    CRASH_TRACER
+    s.cleanedUp = true;
+
+    if (s.task != nullptr)
+    {
+        s.magnitude = s.task->params.resultMagnitude;
+        s.rms = s.task->params.resultRMS;
+
+        if (s.error.isEmpty())
+            s.error = s.task->errorMessage;
+
+        s.task.reset();
+    }
+
+    if (s.edit != nullptr)
+        callBlockingCatching ([&s]
+                              {
+                                  Renderer::turnOffAllPlugins (*s.edit);
+                                  s.edit.reset();
+                              });
+}
+
+void SegmentedRenderer::RenderTask::updateProgress()
+{
+    double total = 0.0, done = 0.0;
+
+    for (auto& s : segmentStates)
+    {
+        total += (double) s->numSamples;
+        done += (double) s->numSamples * (s->cleanedUp ? 1.0 : (double) s->progress.load());
+    }
+
+    progress = juce::jlimit (0.0f, 0.95f, (float) (0.95 * done / std::max (1.0, total)));
+}
+
+bool SegmentedRenderer::RenderTask::joinSegments()
+{
+    CRASH_TRACER
+    setJobName (TRANS("Joining sections") + "...");
+    auto& engine = *params.engine;
+
+    std::vector<std::unique_ptr<juce::AudioFormatReader>> readers;
+    int numChannels = 1;
+    float peak = 0.0f;
+    double rmsTotal = 0.0;
+    SampleCount totalNumSamples = 0;
+
+    for (auto& s : segmentStates)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader (AudioFileUtils::createReaderFor (engine, s->file->getFile()));
+
+        if (reader == nullptr)
+        {
+            errorMessage = TRANS("Couldn't read intermediate file");
+            return false;
+        }
+
+        numChannels = std::max (numChannels, (int) reader->numChannels);
+        readers.push_back (std::move (reader));
+
+        peak = std::max (peak, s->magnitude);
+        rmsTotal += s->rms * (double) s->numSamples;
+        totalNumSamples += s->numSamples;
+    }
+
+    params.resultMagnitude = peak;
+    params.resultRMS = totalNumSamples > 0 ? (float) (rmsTotal / (double) totalNumSamples) : 0.0f;
+
+    float gain = 1.0f;
+
+    if (params.shouldNormaliseByRMS)
+        gain = juce::jlimit (0.0f, 100.0f, dbToGain (params.normaliseToLevelDb) / (params.resultRMS + 2.0f / 32768.0f));
+    else if (params.shouldNormalise)
+        gain = juce::jlimit (0.0f, 100.0f, dbToGain (params.normaliseToLevelDb) * (1.0f / (params.resultMagnitude * 1.005f + 2.0f / 32768.0f)));
+
+    auto metadata = params.metadata;
+    AudioFileUtils::addBWAVStartToMetadata (metadata, toSamples (params.time.getStart(), params.sampleRateForAudio));
+
+    AudioFileWriter writer (AudioFile (engine, params.destFile),
+                            params.audioFormat, numChannels, params.sampleRateForAudio,
+                            params.bitDepth, metadata, params.quality);
+
+    if (! writer.isOpen())
+    {
+        errorMessage = TRANS("Couldn't write to target file");
+        return false;
+    }
+
+    Ditherers ditherers (numChannels, params.bitDepth);
+
+    const int blockSize = 16384;
+    juce::AudioBuffer<float> buffer (numChannels, blockSize);
+    SampleCount numSamplesWritten = 0;
+
+    for (size_t i = 0; i < segmentStates.size(); ++i)
+    {
+        auto& s = *segmentStates[i];
+        auto& reader = *readers[i];
+
+        // Each section is latency compensated so can be used as it is, apart from
+        // padding or truncating it by any sample lost to rounding. The last one
+        // is kept whole as it may contain the end allowance
+        auto numToWrite = s.isLast ? std::max (s.numSamples, reader.lengthInSamples)
+                                   : s.numSamples;
+
+        for (SampleCount pos = 0; pos < numToWrite;)
+        {
+            if (shouldExit())
+                return false;
+
+            auto numThisTime = (int) std::min ((SampleCount) blockSize, numToWrite - pos);
+            auto numToRead = (int) juce::jlimit ((SampleCount) 0, (SampleCount) numThisTime, reader.lengthInSamples - pos);
+
+            buffer.clear();
+
+            if (numToRead > 0)
+                reader.read (&buffer, 0, numToRead, pos, true, numChannels > 1);
+
+            if (gain != 1.0f)
+                buffer.applyGain (0, numThisTime, gain);
+
+            if (params.ditheringEnabled && params.bitDepth < 32)
+                ditherers.apply (buffer, numThisTime);
+
+            if (! writer.appendBuffer (buffer, numThisTime))
+            {
+                errorMessage = TRANS("Couldn't write to target file");
+                return false;
+            }
+
+            pos += numThisTime;
+            numSamplesWritten += numThisTime;
+        }
+
+        progress = 0.95f + 0.05f * (float) (i + 1) / (float) segmentStates.size();
+    }
+
+    params.resultAudioDuration = float (numSamplesWritten / params.sampleRateForAudio);
+
+    return true;
+}
+
+//==============================================================================
+juce::File SegmentedRenderer::renderToFile (const juce::String& taskDescription, const Renderer::Parameters& r, const Options& o)
+{
+    CRASH_TRACER
+    jassert (r.sampleRateForAudio > 7000);
+    jassert (r.edit != nullptr);
+    jassert (r.engine != nullptr);
+
+    if (findSegments (r, o).size() < 2)
+        return Renderer::renderToFile (taskDescription, r);
+
+    TransportControl::stopAllTransports (*r.engine, false, true);
+
+    if (r.tracksToDo.countNumberOfSetBits() == 0
+         || ! r.destFile.hasWriteAccess()
+         || r.destFile.isDirectory())
+        return {};
+
+    auto& ui = r.engine->getUIBehaviour();
+    RenderTask task (taskDescription, r, o);
+    ui.runTaskWithProgressBar (task);
+
+    if (task.errorMessage.isNotEmpty())
+    {
+        r.destFile.deleteFile();
+        ui.showWarningMessage (task.errorMessage);
+        return {};
+    }
+
+    if (r.destFile.existsAsFile())
+        return r.destFile;
+
+    return {};
+}
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,115 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+/**
+    Renders long Edits faster by splitting them into sections that can be rendered
+    independently of each other and rendering each section on its own copy of the
+    Edit in parallel. The sections are then joined sample-exactly into the
+    destination file.
+
+    A section can only start where the state of every plugin is known to have
+    been reset, otherwise the result would differ from a normal render. These are
+    found either from gaps between clips that are longer than the sum of all the
+    plugin tails and latencies, or from split points supplied by the caller.
+    Plugins with free-running modulation (e.g. an LFO that isn't synced to the
+    Edit) won't be reset by silence, if you use these you should disable
+    splitAtSilentGaps and supply your own split points.
+*/
+class SegmentedRenderer
+{
+public:
+    //==============================================================================
+    /** Options controlling how an Edit is split up. */
+    struct Options
+    {
+        int maxNumThreads = 0;                          ///< The number of sections to render at once, 0 uses one less than the number of CPUs
+        juce::Array<TimePosition> splitPoints;          ///< Points the caller guarantees all plugins can be reset at
+        bool splitAtSilentGaps = true;                  ///< If true, gaps between clips long enough for all plugins to have decayed are used
+        TimeDuration minimumSegmentLength = 10s;        ///< Sections shorter than this are merged with the previous one
+    };
+
+    //==============================================================================
+    /** Returns true if the Parameters describe a render that can be split up.
+        MIDI, real-time and trimmed renders must be done in one go.
+    */
+    static bool canRenderInSegments (const Renderer::Parameters&);
+
+    /** Returns the sample-aligned sections the Parameters' time range can be split into.
+        If the render can't be split this will just contain the whole time range.
+    */
+    static juce::Array<TimeRange> findSegments (const Renderer::Parameters&, const Options&);
+
+    //==============================================================================
+    /** Task that renders the sections and joins them.
+        Like Renderer::RenderTask, call runJob until it returns jobHasFinished.
+        Any work that needs the message thread is done by runJob so it can be
+        called from either the message thread or a background thread.
+    */
+    class RenderTask    : public ThreadPoolJobWithProgress
+    {
+    public:
+        /// Constructs a RenderTask for a set of parameters. This must be called on the message thread.
+        RenderTask (const juce::String& taskDescription,
+                    const Renderer::Parameters&,
+                    const Options&,
+                    std::atomic<float>* progressToUpdate = nullptr);
+
+        /// Destructor
+        ~RenderTask() override;
+
+        /// Call until this returns jobHasFinished to perform the render
+        JobStatus runJob() override;
+
+        /// Returns the current progress of the render
+        float getCurrentTaskProgress() override   { return progress; }
+
+        /// The sections being rendered
+        const juce::Array<TimeRange>& getSegments() const noexcept     { return segments; }
+
+        /// The Parameters being used, the result fields are updated once the render has finished
+        Renderer::Parameters params;
+
+        /// An error message if the render failed
+        juce::String errorMessage;
+
+    private:
+        struct Segment;
+
+        juce::Array<TimeRange> segments;
+        std::vector<std::unique_ptr<Segment>> segmentStates;
+        juce::ValueTree editStateToCopy;
+        juce::Array<EditItemID> allowedClipIDs;
+        juce::ThreadPool pool;
+        juce::WaitableEvent segmentFinishedEvent;
+        int numThreads = 1, nextSegmentToStart = 0;
+
+        std::atomic<float> progressInternal { 0.0f };
+        std::atomic<float>& progress;
+
+        bool startSegment (Segment&);
+        void finishSegment (Segment&);
+        void updateProgress();
+        bool joinSegments();
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderTask)
+    };
+
+    //==============================================================================
+    /** Renders an Edit to the file given by the Parameters, splitting it up if possible.
+        Falls back to Renderer::renderToFile if the render can't be split.
+    */
+    static juce::File renderToFile (const juce::String& taskDescription, const Renderer::Parameters&, const Options&);
+};
+
+} // namespace tracktion::inline engine
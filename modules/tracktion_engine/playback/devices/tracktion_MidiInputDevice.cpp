@@ -1630,6 +1630,7 @@ void MidiInputDevice::masterTimeUpdate (double time)
 void MidiInputDevice::sendMessageToInstances (const juce::MidiMessage& message, MPESourceID sourceID)
 {
     bool messageUnused = true;
+    inputRing.push (message, sourceID);
 
     {
         const juce::ScopedLock sl (instanceLock);
@@ -99,6 +99,11 @@ public:
     void handleIncomingMidiMessage (juce::MidiInput*, const juce::MidiMessage&) override;
     virtual void handleIncomingMidiMessage (const juce::MidiMessage&, MPESourceID) = 0;
 
+    /** Returns the ring every incoming message is written to.
+        Consumers on the audio thread should read from this rather than take a lock.
+    */
+    const MidiInputRing& getInputRing() const noexcept              { return inputRing; }
+
     RetrospectiveMidiBuffer* getRetrospectiveMidiBuffer() const     { return retrospectiveBuffer.get(); }
     void updateRetrospectiveBufferLength (double length) override;
     double getAdjustSecs() const                                    { return adjustSecs; }
@@ -151,6 +156,8 @@ protected:
     uint8_t keyDownVelocities[128];
     juce::SharedResourcePointer<MidiKeyChangeDispatcher> midiKeyChangeDispatcher;
 
+    MidiInputRing inputRing;
+
     juce::CriticalSection instanceLock;
     juce::Array<MidiInputDeviceInstanceBase*> instances;
     std::unique_ptr<RetrospectiveMidiBuffer> retrospectiveBuffer;
@@ -0,0 +1,149 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+/**
+    A fixed-size ring of timestamped MIDI messages that a MidiInputDevice writes
+    every incoming message to and any number of consumers can read from.
+
+    Each reader keeps its own position so readers don't affect each other or the
+    writer. Reading is wait-free so this can be drained from the audio thread.
+    If a reader falls more than the capacity behind, the oldest messages are skipped.
+
+    Writing is serialised by a spin lock as messages can arrive from the MIDI
+    thread and the message thread (e.g. the on-screen keyboard). Messages longer
+    than maxMessageSize bytes (i.e. large SysEx dumps) can't be stored and are dropped.
+*/
+class MidiInputRing
+{
+public:
+    static constexpr uint64_t capacity = 512;
+    static constexpr size_t maxMessageSize = 128;
+
+    /** Creates an empty ring. */
+    MidiInputRing() = default;
+
+    /** Adds a message to the ring.
+        Returns false if the message was too big to be stored.
+    */
+    bool push (const juce::MidiMessage& message, MPESourceID sourceID)
+    {
+        const auto size = message.getRawDataSize();
+
+        if (size <= 0 || (size_t) size > maxMessageSize)
+        {
+            numDropped.fetch_add (1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const std::scoped_lock sl (writeLock);
+        const auto pos = writePosition.load (std::memory_order_relaxed);
+        auto& slot = slots[pos % capacity];
+
+        slot.sequence.store (pos * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        slot.timeStamp = message.getTimeStamp();
+        slot.sourceID = sourceID;
+        slot.size = (uint32_t) size;
+        std::memcpy (slot.data, message.getRawData(), (size_t) size);
+
+        slot.sequence.store (pos * 2 + 2, std::memory_order_release);
+        writePosition.store (pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Returns the position the next message will be written to.
+        Readers can start from here to ignore any messages already in the ring.
+    */
+    uint64_t getWritePosition() const noexcept
+    {
+        return writePosition.load (std::memory_order_acquire);
+    }
+
+    /** Reads all the messages written since a reader's position, updating it.
+        The callback is called with (const juce::MidiMessage&, MPESourceID) for each one
+        and the message's time stamp will be the time it was received.
+        Returns the number of messages that had been overwritten and were skipped.
+    */
+    template<typename Callback>
+    uint64_t read (uint64_t& readPosition, Callback&& callback) const
+    {
+        const auto end = getWritePosition();
+        uint64_t numSkipped = 0;
+
+        if (readPosition > end)
+            readPosition = end;
+
+        if (end - readPosition > capacity)
+        {
+            numSkipped = end - capacity - readPosition;
+            readPosition = end - capacity;
+        }
+
+        for (; readPosition < end; ++readPosition)
+        {
+            auto& slot = slots[readPosition % capacity];
+            const auto expectedSequence = readPosition * 2 + 2;
+
+            if (slot.sequence.load (std::memory_order_acquire) != expectedSequence)
+            {
+                ++numSkipped;
+                continue;
+            }
+
+            uint8_t data[maxMessageSize];
+            const auto size = std::min ((size_t) slot.size, maxMessageSize);
+            const auto timeStamp = slot.timeStamp;
+            const auto sourceID = slot.sourceID;
+            std::memcpy (data, slot.data, size);
+
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            // The writer lapped us whilst copying
+            if (slot.sequence.load (std::memory_order_relaxed) != expectedSequence)
+            {
+                ++numSkipped;
+                continue;
+            }
+
+            callback (juce::MidiMessage (data, (int) size, timeStamp), sourceID);
+        }
+
+        return numSkipped;
+    }
+
+    /** Returns the number of messages that were too big to be added. */
+    uint64_t getNumDropped() const noexcept
+    {
+        return numDropped.load (std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence { 0 };
+        double timeStamp = 0.0;
+        MPESourceID sourceID;
+        uint32_t size = 0;
+        uint8_t data[maxMessageSize] = {};
+    };
+
+    Slot slots[capacity];
+    std::atomic<uint64_t> writePosition { 0 }, numDropped { 0 };
+    RealTimeSpinLock writeLock;
+
+    JUCE_DECLARE_NON_COPYABLE (MidiInputRing)
+};
+
+}} // namespace tracktion { inline namespace engine
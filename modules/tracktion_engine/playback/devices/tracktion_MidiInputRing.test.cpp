@@ -0,0 +1,96 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_MIDI_INPUT_RING
+
+#include <tracktion_engine/../3rd_party/doctest/tracktion_doctest.hpp>
+
+namespace tracktion::inline engine
+{
+
+TEST_SUITE ("tracktion_engine")
+{
+    TEST_CASE ("MidiInputRing")
+    {
+        auto ring = std::make_unique<MidiInputRing>();
+        const auto sourceID = createUniqueMPESourceID();
+
+        SUBCASE ("Readers are independent")
+        {
+            uint64_t reader1 = ring->getWritePosition(), reader2 = reader1;
+
+            for (int i = 0; i < 10; ++i)
+                CHECK (ring->push (juce::MidiMessage::noteOn (1, 60 + i, (juce::uint8) 100, i * 0.001), sourceID));
+
+            std::vector<int> notes1, notes2;
+            CHECK_EQ (ring->read (reader1, [&] (auto& m, auto) { notes1.push_back (m.getNoteNumber()); }), 0);
+            CHECK_EQ (notes1.size(), 10);
+            CHECK_EQ (notes1.front(), 60);
+            CHECK_EQ (notes1.back(), 69);
+
+            ring->push (juce::MidiMessage::noteOff (1, 60, 0.02), sourceID);
+            CHECK_EQ (ring->read (reader2, [&] (auto& m, auto source)
+                                           {
+                                               CHECK (source == sourceID);
+                                               notes2.push_back (m.getNoteNumber());
+                                           }), 0);
+            CHECK_EQ (notes2.size(), 11);
+
+            int numRead = 0;
+            ring->read (reader1, [&] (auto& m, auto)
+                                 {
+                                     CHECK (m.isNoteOff());
+                                     CHECK_EQ (m.getTimeStamp(), doctest::Approx (0.02));
+                                     ++numRead;
+                                 });
+            CHECK_EQ (numRead, 1);
+        }
+
+        SUBCASE ("Slow readers skip overwritten messages")
+        {
+            uint64_t reader = ring->getWritePosition();
+            const int numToPush = (int) MidiInputRing::capacity + 10;
+
+            for (int i = 0; i < numToPush; ++i)
+                ring->push (juce::MidiMessage::controllerEvent (1, 1, i % 128), sourceID);
+
+            int numRead = 0, firstValue = -1;
+            CHECK_EQ (ring->read (reader, [&] (auto& m, auto)
+                                          {
+                                              if (firstValue < 0)
+                                                  firstValue = m.getControllerValue();
+
+                                              ++numRead;
+                                          }), 10);
+            CHECK_EQ (numRead, (int) MidiInputRing::capacity);
+            CHECK_EQ (firstValue, 10);
+        }
+
+        SUBCASE ("Large SysEx is dropped")
+        {
+            uint64_t reader = ring->getWritePosition();
+            std::vector<uint8_t> sysex (MidiInputRing::maxMessageSize * 2, 0x01);
+
+            CHECK (! ring->push (juce::MidiMessage::createSysExMessage (sysex.data(), (int) sysex.size()), sourceID));
+            CHECK_EQ (ring->getNumDropped(), 1);
+
+            const uint8_t smallSysex[] = { 0x01, 0x02, 0x03 };
+            CHECK (ring->push (juce::MidiMessage::createSysExMessage (smallSysex, 3), sourceID));
+
+            int numRead = 0;
+            ring->read (reader, [&] (auto& m, auto) { CHECK (m.isSysEx()); ++numRead; });
+            CHECK_EQ (numRead, 1);
+        }
+    }
+}
+
+} // namespace tracktion::inline engine
+
+#endif
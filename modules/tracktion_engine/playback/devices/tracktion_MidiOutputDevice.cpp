@@ -518,6 +518,42 @@ void MidiOutputDevice::fireMessage (const juce::MidiMessage& message)
     }
 }
 
+MidiOutputDevice::DispatchTiming MidiOutputDevice::getDispatchTiming() const
+{
+    DispatchTiming timing;
+    timing.numMessages = numDispatchedMessages.load (std::memory_order_relaxed);
+
+    if (timing.numMessages > 0)
+    {
+        const auto n = (double) timing.numMessages;
+        timing.meanLatenessMs = totalDispatchLatenessMs.load (std::memory_order_relaxed) / n;
+        timing.maxLatenessMs = maxDispatchLatenessMs.load (std::memory_order_relaxed);
+
+        const auto variance = totalDispatchLatenessSquared.load (std::memory_order_relaxed) / n
+                                - timing.meanLatenessMs * timing.meanLatenessMs;
+        timing.jitterMs = std::sqrt (std::max (0.0, variance));
+    }
+
+    return timing;
+}
+
+void MidiOutputDevice::resetDispatchTiming()
+{
+    totalDispatchLatenessMs = 0.0;
+    totalDispatchLatenessSquared = 0.0;
+    maxDispatchLatenessMs = std::numeric_limits<double>::lowest();
+    numDispatchedMessages = 0;
+}
+
+void MidiOutputDevice::addDispatchTiming (double latenessMs)
+{
+    // Only called from the dispatch thread so there's a single writer
+    totalDispatchLatenessMs.store (totalDispatchLatenessMs.load (std::memory_order_relaxed) + latenessMs, std::memory_order_relaxed);
+    totalDispatchLatenessSquared.store (totalDispatchLatenessSquared.load (std::memory_order_relaxed) + latenessMs * latenessMs, std::memory_order_relaxed);
+    maxDispatchLatenessMs.store (std::max (maxDispatchLatenessMs.load (std::memory_order_relaxed), latenessMs), std::memory_order_relaxed);
+    numDispatchedMessages.fetch_add (1, std::memory_order_relaxed);
+}
+
 TimeDuration MidiOutputDevice::getDeviceDelay() const noexcept
 {
     return TimeDuration::fromSeconds ((preDelayMillisecs + audioAdjustmentDelay) * 0.001);
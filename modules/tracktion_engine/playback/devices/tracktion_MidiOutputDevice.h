@@ -65,6 +65,27 @@ public:
     int getPreDelayMs() const noexcept                  { return preDelayMillisecs; }
     void setPreDelayMs (int);
 
+    //==============================================================================
+    /** How late messages have been sent relative to the time they were scheduled for. */
+    struct DispatchTiming
+    {
+        double meanLatenessMs = 0.0;    ///< The mean lateness in milliseconds, negative if sent early
+        double maxLatenessMs = 0.0;     ///< The largest lateness in milliseconds
+        double jitterMs = 0.0;          ///< The standard deviation of the lateness in milliseconds
+        uint64_t numMessages = 0;       ///< The number of messages measured
+    };
+
+    /** Returns the timing of the messages sent by the MidiNoteDispatcher since the last reset. */
+    DispatchTiming getDispatchTiming() const;
+
+    /** Resets the timing returned by getDispatchTiming. */
+    void resetDispatchTiming();
+
+    /** Called by the MidiNoteDispatcher with the lateness of each message it sends.
+        This can be negative for messages sent just before their deadline.
+    */
+    void addDispatchTiming (double latenessMs);
+
     //==============================================================================
     juce::StringArray getProgramSets() const;
     int getCurrentSetIndex() const;
@@ -111,6 +132,10 @@ protected:
     MidiMessageArray midiMessages;
 
     juce::CriticalSection noteOnLock;
+
+    std::atomic<double> totalDispatchLatenessMs { 0.0 }, totalDispatchLatenessSquared { 0.0 },
+                        maxDispatchLatenessMs { std::numeric_limits<double>::lowest() };
+    std::atomic<uint64_t> numDispatchedMessages { 0 };
 };
 
 //==============================================================================
@@ -59,6 +59,12 @@ void DynamicOffsetNode::setDynamicOffsetBeats (BeatDuration newOffset)
     (*dynamicOffsetBeats) = newOffset;
 }
 
+void DynamicOffsetNode::prefetchStart()
+{
+    for (auto n : dynamicOffsetNodes)
+        n->prefetchStart();
+}
+
 //==============================================================================
 tracktion::graph::NodeProperties DynamicOffsetNode::getNodeProperties()
 {
@@ -33,6 +33,9 @@ public:
     */
     void setDynamicOffsetBeats (BeatDuration) override;
 
+    /** Passes the call on to any offsettable input Nodes. */
+    void prefetchStart() override;
+
     //==============================================================================
     tracktion::graph::NodeProperties getNodeProperties() override;
     std::vector<Node*> getDirectInputNodes() override;
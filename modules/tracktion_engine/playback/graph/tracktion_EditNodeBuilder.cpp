@@ -670,7 +670,7 @@ std::unique_ptr<tracktion::graph::Node> createNodeForMidiClip (MidiClip& clip, c
     if (timeBase == MidiList::TimeBase::beatsRaw)
     {
         std::vector<juce::MidiMessageSequence> sequences;
-        sequences.emplace_back (clip.getSequence().exportToPlaybackMidiSequence (clip, timeBase, generateMPE));
+        sequences.emplace_back (clip.getPlaybackMidiSequence (timeBase, generateMPE));
         const auto clipBeatRange = role == ClipRole::launcher ? BeatRange (0_bp, BeatPosition::fromBeats (std::numeric_limits<double>::max()))
                                                               : BeatRange (clip.getStartBeat(), clip.getEndBeat());
 
@@ -701,7 +701,7 @@ std::unique_ptr<tracktion::graph::Node> createNodeForMidiClip (MidiClip& clip, c
     const juce::Range<double> editTimeRange { clipTimeRange.getStart().inSeconds(), clipTimeRange.getEnd().inSeconds() };
 
     std::vector<juce::MidiMessageSequence> sequences;
-    sequences.emplace_back (clip.getSequenceLooped().exportToPlaybackMidiSequence (clip, timeBase, generateMPE));
+    sequences.emplace_back (clip.getPlaybackMidiSequence (timeBase, generateMPE));
 
     return graph::makeNode<MidiNode> (std::move (sequences),
                                       timeBase,
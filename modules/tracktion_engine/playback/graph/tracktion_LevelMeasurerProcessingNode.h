@@ -55,6 +55,7 @@ public:
     void prepareToPlay (const tracktion::graph::PlaybackInitialisationInfo& info) override
     {
         initialisePlugin();
+        meterPlugin.measurer.setSampleRate (info.sampleRate);
 
         const auto inputProps = input->getNodeProperties();
         const auto nodeProps = getNodeProperties();
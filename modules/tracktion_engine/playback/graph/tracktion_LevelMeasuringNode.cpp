@@ -29,6 +29,10 @@ tracktion::graph::NodeProperties LevelMeasuringNode::getNodeProperties()
     return props;
 }
 
+void LevelMeasuringNode::prepareToPlay (const tracktion::graph::PlaybackInitialisationInfo& info)
+{
+    levelMeasurer.setSampleRate (info.sampleRate);
+}
 
 void LevelMeasuringNode::process (tracktion::graph::Node::ProcessContext& pc)
 {
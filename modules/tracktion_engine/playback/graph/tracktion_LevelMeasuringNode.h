@@ -21,6 +21,7 @@ public:
 
     tracktion::graph::NodeProperties getNodeProperties() override;
     std::vector<tracktion::graph::Node*> getDirectInputNodes() override  { return { input.get() }; }
+    void prepareToPlay (const tracktion::graph::PlaybackInitialisationInfo&) override;
     bool isReadyToProcess() override                                    { return input->hasProcessed(); }
     void process (tracktion::graph::Node::ProcessContext&) override;
 
@@ -84,23 +84,9 @@ void MidiInputDeviceNode::handleIncomingMidiMessage (const juce::MidiMessage& me
     if (state->activeNode.load (std::memory_order_acquire) != this)
         return;
 
+    // Messages to play are read from the device's MidiInputRing in processSection,
+    // this just adds them to the loop overdub buffer
     auto channelToUse = midiInputDevice.getChannelToUse().getChannelNumber();
-
-    {
-        const std::lock_guard sl (state->incomingMessagesMutex);
-
-        if (state->numIncomingMessages < state->incomingMessages.size())
-        {
-            auto& m = *state->incomingMessages[state->numIncomingMessages];
-            m = { message, sourceID };
-
-            if (channelToUse > 0)
-                m.setChannel (channelToUse);
-
-            ++(state->numIncomingMessages);
-        }
-    }
-
     auto& playHead = playHeadState.playHead;
 
     if (playHead.isPlaying() && isLivePlayOverActive())
@@ -135,44 +121,12 @@ void MidiInputDeviceNode::processSection (ProcessContext& pc, juce::Range<int64_
     state->activeNode.store (this, std::memory_order_release);
 
     const auto editTime = tracktion::graph::sampleToTime (timelineRange, sampleRate);
-    const auto timeNow = juce::Time::getApproximateMillisecondCounter();
     auto& destMidi = pc.buffers.midi;
 
     if (! playHeadState.isContiguousWithPreviousBlock())
         createProgramChanges (destMidi);
 
-    {
-        const std::lock_guard sl (state->incomingMessagesMutex);
-
-        // if it's been a long time since the last block, clear the buffer because
-        // it means we were muted or glitching
-        if (timeNow > state->lastReadTime + maxExpectedMsPerBuffer)
-        {
-            //jassertfalse;
-            state->numIncomingMessages = 0;
-        }
-
-        state->lastReadTime = timeNow;
-
-        jassert (state->numIncomingMessages <= state->incomingMessages.size());
-
-        if (auto num = juce::jmin ((size_t) state->numIncomingMessages, state->incomingMessages.size()))
-        {
-            // not quite right as the first event won't be at the start of the buffer, but near enough for live stuff
-            const auto timeAdjust = state->incomingMessages.front()->getTimeStamp();
-
-            for (size_t i = 0; i < num; ++i)
-            {
-                auto& m = *state->incomingMessages[i];
-
-                destMidi.addMidiMessage (m,
-                                         juce::jlimit (0.0, juce::jmax (0.0, editTime.getLength()), m.getTimeStamp() - timeAdjust),
-                                         m.mpeSourceID);
-            }
-        }
-
-        state->numIncomingMessages = 0;
-    }
+    readInputRing (destMidi, pc.numSamples);
 
     const std::lock_guard sl (state->liveMessagesMutex);
 
@@ -200,6 +154,41 @@ void MidiInputDeviceNode::processSection (ProcessContext& pc, juce::Range<int64_
     }
 }
 
+void MidiInputDeviceNode::readInputRing (MidiMessageArray& destMidi, choc::buffer::FrameCount numSamples)
+{
+    const auto timeNow = juce::Time::getApproximateMillisecondCounter();
+    auto& ring = midiInputDevice.getInputRing();
+
+    // If it's been a long time since the last block it means we were muted
+    // or glitching so skip anything that arrived in the meantime
+    if (! state->inputRingPositionValid || timeNow > state->lastReadTime + maxExpectedMsPerBuffer)
+    {
+        state->inputRingPosition = ring.getWritePosition();
+        state->inputRingPositionValid = true;
+    }
+
+    state->lastReadTime = timeNow;
+
+    // Messages are stamped with the device's stream time when they arrive so each one
+    // is placed at its offset within the last block's worth of time. This delays live
+    // input by one block but keeps the spacing between events sample accurate.
+    const auto blockLength = numSamples / sampleRate;
+    const auto blockStartTime = juce::Time::getMillisecondCounterHiRes() * 0.001
+                                  + midiInputDevice.getAdjustSecs() - blockLength;
+    const auto channelToUse = midiInputDevice.getChannelToUse().getChannelNumber();
+    const auto lastSampleTime = juce::jmax (0.0, blockLength - 1.0 / sampleRate);
+
+    ring.read (state->inputRingPosition,
+               [&] (const juce::MidiMessage& message, MPESourceID sourceID)
+               {
+                   const auto offset = juce::jlimit (0.0, lastSampleTime, message.getTimeStamp() - blockStartTime);
+                   destMidi.addMidiMessage (message, offset, sourceID);
+
+                   if (channelToUse > 0)
+                       destMidi[destMidi.size() - 1].setChannel (channelToUse);
+               });
+}
+
 void MidiInputDeviceNode::createProgramChanges (MidiMessageArray& bufferForMidiMessages)
 {
     auto channelToUse = midiInputDevice.getChannelToUse();
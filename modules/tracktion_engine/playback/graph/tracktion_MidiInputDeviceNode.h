@@ -48,17 +48,11 @@ private:
 
     struct NodeState
     {
-        NodeState()
-        {
-            for (int i = 256; --i >= 0;)
-                incomingMessages.push_back (std::make_unique<MidiMessageWithSource> (juce::MidiMessage (0x80, 0, 0), MPESourceID()));
-        }
-
         std::atomic<MidiInputDeviceNode*> activeNode { nullptr };
 
-        std::mutex incomingMessagesMutex;
-        std::vector<std::unique_ptr<MidiMessageWithSource>> incomingMessages;
-        uint32_t numIncomingMessages = 0;
+        // Only accessed by the audio thread
+        uint64_t inputRingPosition = 0;
+        bool inputRingPositionValid = false;
 
         std::mutex liveMessagesMutex;
         MidiMessageArray liveRecordedMessages;
@@ -73,6 +67,7 @@ private:
 
     //==============================================================================
     void processSection (ProcessContext&, juce::Range<int64_t> timelineRange);
+    void readInputRing (MidiMessageArray&, choc::buffer::FrameCount numSamples);
     void createProgramChanges (MidiMessageArray&);
     bool isLivePlayOverActive();
     void updateLoopOverdubs();
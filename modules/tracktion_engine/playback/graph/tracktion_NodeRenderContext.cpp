@@ -59,7 +59,8 @@ NodeRenderContext::NodeRenderContext (Renderer::RenderTask& owner_, Renderer::Pa
 
     nodePlayer = std::make_unique<TracktionNodePlayer> (std::move (n), *processState, r.sampleRateForAudio, r.blockSizeForAudio,
                                                         getPoolCreatorFunction (static_cast<tracktion::graph::ThreadPoolStrategy> (EditPlaybackContext::getThreadPoolStrategy())));
-    nodePlayer->setNumThreads ((size_t) p.engine->getEngineBehaviour().getNumberOfCPUsToUseForAudio() - 1);
+    nodePlayer->setNumThreads (p.numGraphThreads >= 0 ? (size_t) p.numGraphThreads
+                                                      : (size_t) p.engine->getEngineBehaviour().getNumberOfCPUsToUseForAudio() - 1);
 
     numLatencySamplesToDrop = nodePlayer->getNode()->getNodeProperties().latencyNumSamples;
     r.time = r.time.withEnd (r.time.getEnd() + TimeDuration::fromSamples (numLatencySamplesToDrop, r.sampleRateForAudio));
@@ -148,6 +149,11 @@ NodeRenderContext::NodeRenderContext (Renderer::RenderTask& owner_, Renderer::Pa
 
     if (sourceToUpdate != nullptr)
         sourceToUpdate->reset (numOutputChans, r.sampleRateForAudio, samplesToWrite);
+
+    // Normalised or trimmed renders are re-written so their pyramids are built from the final file
+    if (r.engine->getEngineBehaviour().usePeakPyramidThumbnails()
+         && ! needsToNormaliseAndTrim && r.destFile != juce::File())
+        peakPyramid = std::make_unique<PeakPyramid> (numOutputChans, r.sampleRateForAudio);
 }
 
 NodeRenderContext::~NodeRenderContext()
@@ -163,6 +169,13 @@ NodeRenderContext::~NodeRenderContext()
     if (writer != nullptr)
         writer->closeForWriting();
 
+    if (peakPyramid != nullptr && peakPyramid->getNumSamples() > 0
+         && ! owner.shouldExit() && r.destFile.existsAsFile())
+    {
+        peakPyramid->finish();
+        r.engine->getAudioFileManager().peakPyramids.store (AudioFile (*r.engine, r.destFile), *peakPyramid);
+    }
+
     try
     {
         callBlocking ([this] { nodePlayer.reset(); });
@@ -356,6 +369,9 @@ NodeRenderContext::WriteResult NodeRenderContext::writeAudioBlock (choc::buffer:
     if (sourceToUpdate != nullptr && blockSizeSamples > 0)
         sourceToUpdate->addBlock (numSamplesWrittenToSource, buffer, 0, blockSizeSamples);
 
+    if (peakPyramid != nullptr && hasStartedSavingToFile && blockSizeSamples > 0)
+        peakPyramid->addBlock (buffer, 0, blockSizeSamples);
+
     numSamplesWrittenToSource += blockSizeSamples;
 
     // And finally write to the file
@@ -115,6 +115,7 @@ private:
 
     std::unique_ptr<juce::TemporaryFile> intermediateFile;
     juce::AudioFormatWriter::ThreadedWriter::IncomingDataReceiver* sourceToUpdate;
+    std::unique_ptr<PeakPyramid> peakPyramid;
 
     //==============================================================================
     enum class WriteResult
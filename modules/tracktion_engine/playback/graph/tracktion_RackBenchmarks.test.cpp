@@ -42,6 +42,7 @@ public:
 
         runRackMixBusTest (engine, ts);
         runMultipleSerialRacksBenchmark (engine);
+        runParallelRackChainsBenchmark (engine, ts);
     }
 
     void runRackMixBusTest (Engine& engine, graph::test_utilities::TestSetup ts)
@@ -358,6 +359,85 @@ public:
             }
         }
     }
+
+    void runParallelRackChainsBenchmark (Engine& engine, graph::test_utilities::TestSetup ts)
+    {
+        using namespace benchmark_utilities;
+        using namespace tracktion::graph;
+
+        // A rack of 8 parallel lowpass -> chorus -> reverb chains, as you'd get with
+        // multiband processing or layered instruments.
+        // These should scale with the number of threads as each chain is its own set of Nodes
+        constexpr int numChains = 8;
+        const double fileLength = 10.0;
+        const auto editName = juce::String ("Parallel Rack Chains");
+
+        auto edit = test_utilities::createTestEdit (engine);
+        auto at = getAudioTracks (*edit)[0];
+        at->insertMIDIClip (TimeRange (0.0s, TimeDuration::fromSeconds (fileLength)), nullptr);
+
+        auto rack = edit->getRackList().addNewRack();
+
+        for (int chain = 0; chain < numChains; ++chain)
+        {
+            EditItemID lastID;
+
+            for (auto type : { LowPassPlugin::xmlTypeName, ChorusPlugin::xmlTypeName, ReverbPlugin::xmlTypeName })
+            {
+                auto plugin = edit->getPluginCache().createNewPlugin (type, {});
+                rack->addPlugin (plugin, {}, false);
+
+                for (int pin : { 1, 2 })
+                    rack->addConnection (lastID, pin, plugin->itemID, pin);
+
+                lastID = plugin->itemID;
+            }
+
+            for (int pin : { 1, 2 })
+                rack->addConnection (lastID, pin, {}, pin);
+        }
+
+        at->pluginList.insertPlugin (RackInstance::create (*rack), 0);
+
+        // Rendered as part of an Edit, where the rack's Nodes are scheduled by the Edit's player
+        for (int blockSize : { 128, 512 })
+        {
+            ts.blockSize = blockSize;
+            renderEdit (*this, { edit.get(), editName, ts, MultiThreaded::no, LockFree::yes, ThreadPoolStrategy::lightweightSemaphore });
+            renderEdit (*this, { edit.get(), editName, ts, MultiThreaded::yes, LockFree::yes, ThreadPoolStrategy::lightweightSemaphore });
+        }
+
+        // Processed on its own with a RackNodePlayer.
+        // The plugins are initialised again for each player so both should produce the same output
+        auto processRack = [&] (auto rackPlayer, juce::String description)
+        {
+            beginTest (editName + " - RackNodePlayer: " + description);
+            const ScopedBenchmark sb (createBenchmarkDescription ("Node", (editName + ": RackNodePlayer").toStdString(),
+                                                                  description.toStdString()));
+            return test_utilities::createTestContext (std::move (rackPlayer), ts, 2, fileLength);
+        };
+
+        {
+            PlayHead playHead;
+            PlayHeadState playHeadState { playHead };
+            ProcessState processState { playHeadState, edit->tempoSequence };
+
+            auto createRackNode = [&]
+            {
+                return RackNodeBuilder::createRackNode (*rack, ts.sampleRate, ts.blockSize, makeNode<SinNode> (220.0f, 2), processState, true);
+            };
+
+            auto stContext = processRack (std::make_unique<RackNodePlayer<NodePlayer>> (createRackNode(), ts.sampleRate, ts.blockSize),
+                                          "ST");
+            auto mtContext = processRack (std::make_unique<RackNodePlayer<LockFreeMultiThreadedNodePlayer>> (createRackNode(), ts.sampleRate, ts.blockSize,
+                                                                                                             getPoolCreatorFunction (ThreadPoolStrategy::lightweightSemaphore)),
+                                          "MT, lock-free, " + test_utilities::getName (ThreadPoolStrategy::lightweightSemaphore));
+
+            expectEquals (stContext->buffer.getNumSamples(), juce::roundToInt (fileLength * ts.sampleRate));
+            expect (stContext->buffer.getMagnitude (0, stContext->buffer.getNumSamples()) > 0.0f);
+            expect (test_utilities::buffersAreEqual (stContext->buffer, mtContext->buffer, 0.0001f));
+        }
+    }
 };
 
 static RackBenchmarks rackBenchmarks;
@@ -62,7 +62,17 @@ struct InputProvider
 //==============================================================================
 /**
     Simple processor for a Node which uses an InputProvider to pass input in to the graph.
-    This simply iterate all the nodes attempting to process them in a single thread.
+
+    The nodes are processed by the NodePlayerType so with a tracktion::graph::NodePlayer
+    they're processed one at a time on the calling thread, and with a
+    LockFreeMultiThreadedNodePlayer any parallel chains in the rack are spread across
+    its worker threads.
+
+    N.B. This is for processing a rack on its own. Racks in an Edit don't use this,
+    their nodes are built in to the Edit's graph by createNodeForRackType so they're
+    scheduled by the Edit's player along with everything else. If you do use a
+    multi-threaded player here from inside another multi-threaded player, call
+    getNodePlayer().setNumThreads (0) so the rack doesn't oversubscribe the CPU.
 */
 template<typename NodePlayerType>
 class RackNodePlayer
@@ -74,13 +84,25 @@ public:
         nodePlayer.setNode (std::move (nodeToProcess));
     }
 
-    /** Creates an RackNodePlayer to process an Node with input, sample rate and block size. */
+    /** Creates an RackNodePlayer to process an Node with input, sample rate and block size.
+        Any additional arguments are passed to the NodePlayerType's constructor e.g. the
+        ThreadPoolCreator for a LockFreeMultiThreadedNodePlayer.
+    */
+    template<typename... NodePlayerArgs>
     RackNodePlayer (std::unique_ptr<tracktion::graph::Node> nodeToProcess,
-                    double sampleRateToUse, int blockSizeToUse)
+                    double sampleRateToUse, int blockSizeToUse,
+                    NodePlayerArgs&&... nodePlayerArgs)
+        : nodePlayer (std::forward<NodePlayerArgs> (nodePlayerArgs)...)
     {
         nodePlayer.setNode (std::move (nodeToProcess), sampleRateToUse, blockSizeToUse);
     }
 
+    /** Returns the player being used e.g. to set the number of threads it uses. */
+    NodePlayerType& getNodePlayer()
+    {
+        return nodePlayer;
+    }
+
     /** Preapres the processor to be played. */
     void prepareToPlay (double sampleRate, int blockSize)
     {
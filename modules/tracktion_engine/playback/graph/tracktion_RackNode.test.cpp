@@ -34,6 +34,7 @@ public:
 
         runAllTests<tracktion::graph::NodePlayer>();
         runAllTests<tracktion::graph::LockFreeMultiThreadedNodePlayer>();
+        runRackGraphTests();
     }
 
     template<typename NodePlayerType>
@@ -647,6 +648,88 @@ private:
             edit->getTempDirectory (false).deleteRecursively();
         }
     }
+
+    void runRackGraphTests()
+    {
+        auto& engine = *Engine::getEngines()[0];
+
+        beginTest ("Parallel Rack chains are separate Nodes in the Edit graph");
+        {
+            // Racks in an Edit should be built in to the Edit's graph rather than processed
+            // inside a single Node, so each parallel chain can be processed on its own thread
+            auto edit = Edit::createSingleTrackEdit (engine);
+            auto track = getFirstAudioTrack (*edit);
+            auto rack = edit->getRackList().addNewRack();
+            std::vector<std::vector<EditItemID>> chains;
+
+            for (int chain = 0; chain < 4; ++chain)
+            {
+                auto& chainIDs = chains.emplace_back();
+                EditItemID lastID;
+
+                for (int i = 0; i < 2; ++i)
+                {
+                    auto plugin = edit->getPluginCache().createNewPlugin (VolumeAndPanPlugin::xmlTypeName, {});
+                    expect (rack->addPlugin (plugin, {}, false));
+
+                    for (int pin : { 1, 2 })
+                        rack->addConnection (lastID, pin, plugin->itemID, pin);
+
+                    lastID = plugin->itemID;
+                    chainIDs.push_back (lastID);
+                }
+
+                for (int pin : { 1, 2 })
+                    rack->addConnection (lastID, pin, {}, pin);
+            }
+
+            track->pluginList.insertPlugin (RackInstance::create (*rack), 0);
+
+            graph::PlayHead ph;
+            PlayHeadState phs (ph);
+            ProcessState ps (phs, edit->tempoSequence);
+            CreateNodeParams params { ps };
+            auto editNode = createNodeForEdit (*edit, params);
+            const auto nodes = getNodes (*editNode, VertexOrdering::postordering);
+
+            auto findPluginNode = [&nodes] (EditItemID pluginID) -> Node*
+            {
+                for (auto n : nodes)
+                    if (auto pluginNode = dynamic_cast<PluginNode*> (n))
+                        if (pluginNode->getPlugin().itemID == pluginID)
+                            return n;
+
+                return nullptr;
+            };
+
+            for (auto& chain : chains)
+            {
+                auto lastNode = findPluginNode (chain.back());
+                expect (lastNode != nullptr);
+
+                if (lastNode == nullptr)
+                    continue;
+
+                // Each chain should only depend on its own plugins
+                const auto chainNodes = getNodes (*lastNode, VertexOrdering::postordering);
+
+                for (auto& otherChain : chains)
+                {
+                    for (auto pluginID : otherChain)
+                    {
+                        auto pluginNode = findPluginNode (pluginID);
+                        expect (pluginNode != nullptr);
+
+                        const bool isInChain = std::find (chainNodes.begin(), chainNodes.end(), pluginNode) != chainNodes.end();
+                        expect (isInChain == (&otherChain == &chain));
+                    }
+                }
+            }
+
+            engine.getAudioFileManager().releaseAllFiles();
+            edit->getTempDirectory (false).deleteRecursively();
+        }
+    }
 };
 
 static RackNodeTests rackNodeTests;
@@ -109,6 +109,11 @@ bool SlotControlNode::isReadyToProcess()
 
 void SlotControlNode::prefetchBlock (juce::Range<int64_t> referenceSampleRange)
 {
+    // Give the Nodes a chance to read ahead before a queued launch starts
+    if (launchHandle->getQueuedStatus() == LaunchHandle::QueueState::playQueued)
+        for (auto n : offsetNodes)
+            n->prefetchStart();
+
     for (auto& node : orderedNodes)
         node->prepareForNextBlock (referenceSampleRange);
 }
@@ -175,6 +175,13 @@ public:
         it forwards or backwards in time.
     */
     virtual void setDynamicOffsetTime (TimeDuration) {}
+
+    /** Called each block whilst the node is queued to start playing from its
+        beginning, e.g. a launched clip. This can be used to prefetch the data
+        that will be needed first. It's called before the node's prepareForNextBlock
+        so should take priority over any prefetching done there.
+    */
+    virtual void prefetchStart() {}
 };
 
 
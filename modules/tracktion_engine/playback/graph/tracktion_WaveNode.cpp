@@ -67,6 +67,34 @@ namespace utils
     {
         return isRendering ? m: replaceElastiqueWithDirectMode (m);
     }
+
+    /** Returns a timeline position the playhead is about to read from that won't
+        be in the file cache's normal read-ahead. That's the position whilst stopped
+        e.g. after a seek, the loop start as the loop end approaches or the start of
+        a clip the playhead is about to reach.
+    */
+    inline std::optional<int64_t> getTimelinePositionToPrefetch (const graph::PlayHead& playHead,
+                                                                 juce::Range<int64_t> referenceSampleRange,
+                                                                 int64_t clipStart, int64_t numLookaheadSamples)
+    {
+        if (playHead.isStopped())
+            return playHead.getPosition();
+
+        const auto position = playHead.referenceSamplePositionToTimelinePosition (referenceSampleRange.getEnd());
+
+        if (playHead.isLooping() && ! playHead.isRollingIntoLoop())
+        {
+            const auto loopRange = playHead.getLoopRange();
+
+            if (loopRange.getEnd() - position < numLookaheadSamples)
+                return loopRange.getStart();
+        }
+
+        if (clipStart > position && clipStart - position < numLookaheadSamples)
+            return clipStart;
+
+        return {};
+    }
 }
 
 //==============================================================================
@@ -1599,6 +1627,26 @@ bool WaveNode::isReadyToProcess()
     return true;
 }
 
+void WaveNode::prefetchBlock (juce::Range<int64_t> referenceSampleRange)
+{
+    if (reader == nullptr || audioFileSampleRate == 0.0)
+        return;
+
+    const auto clipStart = toSamples (editPosition.getStart(), outputSampleRate);
+
+    if (auto position = utils::getTimelinePositionToPrefetch (getPlayHead(), referenceSampleRange,
+                                                             clipStart, (int64_t) outputSampleRate))
+    {
+        const auto editTime = TimePosition::fromSamples (*position, outputSampleRate);
+
+        if (editPosition.contains (editTime))
+        {
+            const auto fileStart = editTimeToFileSample (editTime);
+            reader->prefetch ({ fileStart, fileStart + (SampleCount) audioFileSampleRate });
+        }
+    }
+}
+
 void WaveNode::process (ProcessContext& pc)
 {
     SCOPED_REALTIME_CHECK
@@ -2021,6 +2069,16 @@ void WaveNodeRealTime::setDynamicOffsetBeats (BeatDuration newOffset)
     isFirstBlock = true;
 }
 
+void WaveNodeRealTime::prefetchStart()
+{
+    if (prefetchReader == nullptr || editReader == nullptr)
+        return;
+
+    prefetchFrom (editReader->isBeatBased() ? clipBeatToFileTime (0_bd)
+                                            : toPosition (offsetTime * speedRatio));
+    startWasPrefetched = true;
+}
+
 //==============================================================================
 tracktion::graph::NodeProperties WaveNodeRealTime::getNodeProperties()
 {
@@ -2056,6 +2114,27 @@ bool WaveNodeRealTime::isReadyToProcess()
     return buildAudioReaderGraph();
 }
 
+void WaveNodeRealTime::prefetchBlock (juce::Range<int64_t> referenceSampleRange)
+{
+    if (prefetchReader == nullptr || editReader == nullptr)
+        return;
+
+    // The reader only keeps one range so don't replace the start of a queued launch
+    if (std::exchange (startWasPrefetched, false))
+        return;
+
+    auto clipStart = editPositionTime.getStart();
+
+    if (editReader->isBeatBased())
+        if (auto tempoSequence = getProcessState().getTempoSequence())
+            clipStart = tempoSequence->toTime (editPositionBeats.getStart() + *dynamicOffsetBeats);
+
+    if (auto position = utils::getTimelinePositionToPrefetch (getPlayHead(), referenceSampleRange,
+                                                             toSamples (clipStart, outputSampleRate), (int64_t) outputSampleRate))
+        if (auto fileTime = editTimeToFileTime (TimePosition::fromSamples (*position, outputSampleRate)))
+            prefetchFrom (*fileTime);
+}
+
 void WaveNodeRealTime::process (ProcessContext& pc)
 {
     SCOPED_REALTIME_CHECK
@@ -2091,6 +2170,7 @@ bool WaveNodeRealTime::buildAudioReaderGraph()
     if (fileCacheReader == nullptr || fileCacheReader->getSampleRate() == 0.0)
         return false;
 
+    prefetchReader = fileCacheReader;
     auto audioFileCacheReader = std::make_unique<AudioFileCacheReader> (std::move (fileCacheReader), isOfflineRender ? 5s : 0ms,
                                                                         destChannels, channelsToUse);
     std::unique_ptr<AudioReader> loopReader;
@@ -2220,6 +2300,7 @@ void WaveNodeRealTime::replaceStateIfPossible (WaveNodeRealTime& other)
 
     fileTempoSequence = other.fileTempoSequence;
     fileTempoPosition = other.fileTempoPosition;
+    prefetchReader = other.prefetchReader;
     resamplerReader = other.resamplerReader;
     editReader = other.editReader;
     pitchAdjustReader = other.pitchAdjustReader;
@@ -2330,6 +2411,49 @@ void WaveNodeRealTime::processSection (ProcessContext& pc)
     }
 }
 
+std::optional<TimePosition> WaveNodeRealTime::editTimeToFileTime (TimePosition editTime)
+{
+    if (editReader->isBeatBased())
+    {
+        auto tempoSequence = getProcessState().getTempoSequence();
+
+        if (tempoSequence == nullptr || fileTempoSequence == nullptr)
+            return {};
+
+        const auto clipPosition = editPositionBeats + *dynamicOffsetBeats;
+        const auto editBeat = tempoSequence->toBeats (editTime);
+
+        if (! clipPosition.contains (editBeat))
+            return {};
+
+        return clipBeatToFileTime (editBeat - clipPosition.getStart());
+    }
+
+    if (! editPositionTime.contains (editTime))
+        return {};
+
+    return toPosition ((editTime - editPositionTime.getStart() + offsetTime) * speedRatio);
+}
+
+TimePosition WaveNodeRealTime::clipBeatToFileTime (BeatDuration beatsFromClipStart) const
+{
+    // This matches the BeatRangeReader's offset and looping but ignores any warping
+    // so will only be approximate for warped clips
+    auto fileBeat = toPosition (beatsFromClipStart + offsetBeats);
+
+    if (! loopSectionBeats.isEmpty())
+        fileBeat = loopSectionBeats.getStart() + BeatDuration::fromBeats (std::fmod (fileBeat.inBeats(), loopSectionBeats.getLength().inBeats()));
+
+    return fileTempoSequence->toTime (fileBeat);
+}
+
+void WaveNodeRealTime::prefetchFrom (TimePosition fileTime)
+{
+    const auto sampleRate = prefetchReader->getSampleRate();
+    const auto start = toSamples (fileTime, sampleRate);
+    prefetchReader->prefetch ({ start, start + (SampleCount) sampleRate });
+}
+
 tempo::Key WaveNodeRealTime::getKeyToSyncTo (TimePosition editPosition) const
 {
     if (chordPitchPosition)
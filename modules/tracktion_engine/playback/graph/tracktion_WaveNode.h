@@ -60,6 +60,7 @@ public:
     tracktion::graph::NodeProperties getNodeProperties() override;
     void prepareToPlay (const tracktion::graph::PlaybackInitialisationInfo&) override;
     bool isReadyToProcess() override;
+    void prefetchBlock (juce::Range<int64_t>) override;
     void process (ProcessContext&) override;
 
 private:
@@ -204,10 +205,17 @@ public:
     */
     void setDynamicOffsetBeats (BeatDuration) override;
 
+    /** Prefetches the start of the file section this node will play.
+        The node won't make its own prefetch hint in the next prefetchBlock call
+        so this should be called before the node's prepareForNextBlock.
+    */
+    void prefetchStart() override;
+
     //==============================================================================
     graph::NodeProperties getNodeProperties() override;
     void prepareToPlay (const graph::PlaybackInitialisationInfo&) override;
     bool isReadyToProcess() override;
+    void prefetchBlock (juce::Range<int64_t>) override;
     void process (ProcessContext&) override;
 
 private:
@@ -232,10 +240,11 @@ private:
     float pitchChangeSemitones = 0.0;
     double outputSampleRate = 44100.0;
     int outputBlockSize = 0;
-    bool isFirstBlock = false;
+    bool isFirstBlock = false, startWasPrefetched = false;
     const ReadAhead readAhead;
 
     size_t stateHash = 0;
+    AudioFileCache::Reader::Ptr prefetchReader;
     ResamplerReader* resamplerReader = nullptr;
     PitchAdjustReader* pitchAdjustReader = nullptr;
     std::shared_ptr<SpeedFadeEditReader> editReader;
@@ -253,6 +262,9 @@ private:
     void replaceStateIfPossible (NodeGraph*);
     void replaceStateIfPossible (WaveNodeRealTime&);
     void processSection (ProcessContext&);
+    std::optional<TimePosition> editTimeToFileTime (TimePosition);
+    TimePosition clipBeatToFileTime (BeatDuration) const;
+    void prefetchFrom (TimePosition fileTime);
     tempo::Key getKeyToSyncTo (TimePosition) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveNodeRealTime)
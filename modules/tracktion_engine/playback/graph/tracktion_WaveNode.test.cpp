@@ -46,6 +46,8 @@ public:
             runDynamicOffsetTests (ts);
             runTimestretchedTests (ts);
         }
+
+        runPrefetchTests();
     }
 
 private:
@@ -172,6 +174,104 @@ private:
         }
     }
 
+    void runPrefetchTests()
+    {
+        using namespace tracktion::graph::test_utilities;
+        auto& engine = *Engine::getEngines()[0];
+        auto& cache = engine.getAudioFileManager().cache;
+
+        const double sampleRate = 44100.0;
+        const int blockSize = 512;
+        const auto oneSecond = (SampleCount) sampleRate;
+
+        tempo::Sequence tempoSequence ({{ 0_bp, 60.0, 0.0f }},
+                                       {{ 0_bp, 4, 4, false }},
+                                       tempo::LengthOfOneBeat::dependsOnTimeSignature);
+
+        tracktion::graph::PlayHead playHead;
+        tracktion::graph::PlayHeadState playHeadState (playHead);
+        ProcessState processState (playHeadState, tempoSequence);
+
+        // Loop 1s to 3s with the next block ending 0.5s before the loop end
+        const juce::Range<int64_t> referenceSampleRange (0, blockSize);
+        playHead.setReferenceSampleRange (referenceSampleRange);
+        playHead.play ({ oneSecond, oneSecond * 3 }, true);
+        playHead.setPosition (oneSecond * 5 / 2 - blockSize);
+
+        // Each test uses its own file so hints from the others don't show up
+        auto createFile = [&] { return getSinFile<juce::WavAudioFormat> (sampleRate, 5.0); };
+
+        beginTest ("WaveNode prefetches the loop start as the loop end approaches");
+        {
+            auto sinFile = createFile();
+            AudioFile sinAudioFile (engine, sinFile->getFile());
+
+            auto graph = node_player_utils::prepareToPlay (makeNode<WaveNode> (sinAudioFile,
+                                                                               TimeRange (0.0s, TimePosition (5.0s)),
+                                                                               TimeDuration(),
+                                                                               TimeRange(),
+                                                                               LiveClipLevel(),
+                                                                               1.0,
+                                                                               juce::AudioChannelSet::canonicalChannelSet (sinAudioFile.getNumChannels()),
+                                                                               juce::AudioChannelSet::canonicalChannelSet (1),
+                                                                               processState,
+                                                                               EditItemID(),
+                                                                               false),
+                                                           nullptr, sampleRate, blockSize);
+            graph->rootNode->prepareForNextBlock (referenceSampleRange);
+
+            expect (cache.getPrefetchRanges (sinAudioFile) == std::vector<SampleRange> { { oneSecond, oneSecond * 2 } });
+        }
+
+        // The clip starts 2s in to the file so the start of a launch is at 2s and the loop start at 3s
+        auto createSlotNode = [&] (const AudioFile& audioFile, std::shared_ptr<LaunchHandle> launchHandle)
+        {
+            auto waveNode = std::make_unique<WaveNodeRealTime> (audioFile,
+                                                                TimeRange (0.0s, TimePosition (3.0s)),
+                                                                2_td,
+                                                                TimeRange(),
+                                                                LiveClipLevel(),
+                                                                1.0,
+                                                                juce::AudioChannelSet::canonicalChannelSet (audioFile.getNumChannels()),
+                                                                juce::AudioChannelSet::canonicalChannelSet (1),
+                                                                processState,
+                                                                EditItemID(),
+                                                                false,
+                                                                ResamplingQuality::lagrange,
+                                                                SpeedFadeDescription(),
+                                                                std::nullopt,
+                                                                TimeStretcher::Mode::disabled);
+
+            auto graph = node_player_utils::prepareToPlay (std::make_unique<SlotControlNode> (processState, std::move (launchHandle), std::nullopt,
+                                                                                              nullptr, EditItemID::fromRawID (1), std::move (waveNode)),
+                                                           nullptr, sampleRate, blockSize);
+            graph->rootNode->prepareForNextBlock (referenceSampleRange);
+            return graph;
+        };
+
+        beginTest ("SlotControlNode lets WaveNodeRealTime prefetch the loop start when nothing's queued");
+        {
+            auto sinFile = createFile();
+            AudioFile sinAudioFile (engine, sinFile->getFile());
+            auto graph = createSlotNode (sinAudioFile, std::make_shared<LaunchHandle>());
+
+            expect (cache.getPrefetchRanges (sinAudioFile) == std::vector<SampleRange> { { oneSecond * 3, oneSecond * 4 } });
+        }
+
+        beginTest ("SlotControlNode prefetches the start of a queued launch");
+        {
+            auto sinFile = createFile();
+            AudioFile sinAudioFile (engine, sinFile->getFile());
+
+            auto launchHandle = std::make_shared<LaunchHandle>();
+            launchHandle->play (MonotonicBeat { 100_bp });
+            auto graph = createSlotNode (sinAudioFile, launchHandle);
+
+            // The node's own loop start hint mustn't replace the launch's
+            expect (cache.getPrefetchRanges (sinAudioFile) == std::vector<SampleRange> { { oneSecond * 2, oneSecond * 3 } });
+        }
+    }
+
     template<typename NodeType>
     void runLoopedTimelineTests (juce::String nodeTypeName, graph::test_utilities::TestSetup ts)
     {
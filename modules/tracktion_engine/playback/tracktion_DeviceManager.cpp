@@ -170,6 +170,67 @@ struct DeviceManager::PrepareToStartCaller  : public juce::AsyncUpdater
     DeviceManager& deviceManager;
 };
 
+//==============================================================================
+/** Applies the EngineBehaviour's ThreadSchedulingOptions to the audio thread on the
+    first callback after the device starts and logs if they couldn't be applied.
+    The result is polled from the message thread so nothing is posted from the audio thread.
+    This also marks the audio thread as real-time so its allocations are counted.
+*/
+struct DeviceManager::AudioThreadScheduler  : private juce::Timer
+{
+    AudioThreadScheduler (DeviceManager& owner) : deviceManager (owner) {}
+
+    /** Called on the message thread before the callbacks are resumed. */
+    void prepare()
+    {
+        options = deviceManager.engine.getEngineBehaviour().getThreadSchedulingOptions();
+        failed = false;
+
+        hasOptions = options.policy != tracktion::graph::ThreadSchedulingOptions::Policy::roundRobin
+                       || options.nativePriority.has_value()
+                       || ! options.audioThreadCores.empty();
+        pending = true;
+
+        if (hasOptions)
+            startTimer (100);
+    }
+
+    /** Called on the audio thread. */
+    void applyIfPending()
+    {
+        if (! pending.load (std::memory_order_acquire))
+            return;
+
+        tracktion::graph::allocation::markCurrentThreadAsRealTime();
+
+        if (hasOptions)
+            failed = ! tracktion::graph::applyAudioThreadSchedulingOptions (options);
+
+        pending.store (false, std::memory_order_release);
+    }
+
+    void timerCallback() override
+    {
+        if (pending)
+            return;
+
+        stopTimer();
+
+        if (failed)
+        {
+            if (options.onFailure)
+                options.onFailure ("Unable to apply the scheduling options to the audio thread");
+            else
+                TRACKTION_LOG_ERROR ("Unable to apply the scheduling options to the audio thread");
+        }
+    }
+
+    DeviceManager& deviceManager;
+    tracktion::graph::ThreadSchedulingOptions options;
+    bool hasOptions = false;
+    std::atomic<bool> pending { false }, failed { false };
+};
+
 //==============================================================================
 static constexpr const char* allMidiInsName = "All MIDI Ins";
 static constexpr const char* allMidiInsID = "all_midi_in";
@@ -389,6 +450,7 @@ DeviceManager::DeviceManager (Engine& e) : engine (e)
     CRASH_TRACER
 
     prepareToStartCaller = std::make_unique<PrepareToStartCaller> (*this);
+    audioThreadScheduler = std::make_unique<AudioThreadScheduler> (*this);
 
     deviceManager.addChangeListener (this);
 
@@ -859,6 +921,7 @@ void DeviceManager::handleAsyncUpdate()
     for (auto& d : lastAvailableWaveDeviceList->inputs)
     {
         auto wi = new WaveInputDevice (engine, TRANS("Wave Audio Input"), d, InputDevice::waveDevice);
+        wi->levelMeasurer.setSampleRate (getSampleRate());
         newWaveInputs.add (wi);
 
         TRACKTION_LOG_DEVICE ("Wave In: " + wi->getName() + (wi->isEnabled() ? " (enabled): " : ": ")
@@ -1476,6 +1539,8 @@ void DeviceManager::audioDeviceIOCallbackWithContext (const float* const* inputC
         return;
     }
 
+    audioThreadScheduler->applyIfPending();
+
     // Some interfaces ask for blocks larger than the current buffer size so in
     // these cases we need to render the buffer in chunks
     if (numSamples <= maxBlockSize)
@@ -1661,6 +1726,10 @@ void DeviceManager::prepareToStart()
             }
         }
 
+        for (auto wi : waveInputs)
+            wi->levelMeasurer.setSampleRate (currentSampleRate);
+
+        audioThreadScheduler->prepare();
         isSuspended = false;
     }
 }
@@ -265,6 +265,9 @@ private:
     struct PrepareToStartCaller;
     std::unique_ptr<PrepareToStartCaller> prepareToStartCaller;
 
+    struct AudioThreadScheduler;
+    std::unique_ptr<AudioThreadScheduler> audioThreadScheduler;
+
     std::shared_mutex contextLock;
     juce::Array<EditPlaybackContext*> activeContexts;
     std::unique_ptr<juce::AudioProcessor> globalOutputAudioProcessor;
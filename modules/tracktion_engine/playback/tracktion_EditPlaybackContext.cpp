@@ -47,6 +47,16 @@ namespace EditPlaybackContextInternal
         return e.getDeviceManager().deviceManager.getDeviceAudioWorkgroup();
     }
 
+    inline tracktion::graph::ThreadSchedulingOptions getWorkerThreadSchedulingOptions (Engine& e)
+    {
+        auto options = e.getEngineBehaviour().getThreadSchedulingOptions();
+
+        if (! options.onFailure)
+            options.onFailure = [] (const std::string& message) { TRACKTION_LOG_ERROR (juce::String (message)); };
+
+        return options;
+    }
+
     inline size_t getMaxNumThreadsToUse (Edit& edit)
     {
         if (edit.getIsPreviewEdit())
@@ -171,7 +181,8 @@ struct EditPlaybackContext::NodePlaybackContext
     NodePlaybackContext (EditPlaybackContext& epc, size_t numThreads, size_t maxNumThreadsToUse)
         : editPlaybackContext (epc),
           player (processState,
-                  getPoolCreatorFunction (static_cast<tracktion::graph::ThreadPoolStrategy> (getThreadPoolStrategy())),
+                  getPoolCreatorFunction (static_cast<tracktion::graph::ThreadPoolStrategy> (getThreadPoolStrategy()),
+                                          EditPlaybackContextInternal::getWorkerThreadSchedulingOptions (tempoSequence.edit.engine)),
                   EditPlaybackContextInternal::getAudioWorkgroupIfEnabled (tempoSequence.edit.engine)),
           maxNumThreads (maxNumThreadsToUse)
     {
@@ -668,9 +679,16 @@ void EditPlaybackContext::createNode()
     cnp.includeBypassedPlugins = ! engineBehaviour.shouldBypassedPluginsBeRemovedFromPlaybackGraph();
     cnp.allowClipSlots = engineBehaviour.areClipSlotsEnabled();
     cnp.readAheadTimeStretchNodes = engineBehaviour.enableReadAheadForTimeStretchNodes();
-    auto editNode = createNodeForEdit (*this, audiblePlaybackTime, cnp);
 
-    nodePlaybackContext->setNode (std::move (editNode), cnp.sampleRate, cnp.blockSize);
+    {
+        // Any Nodes added whilst the graph is prepared come from the same arena
+        const tracktion::graph::ScopedNodeArena scopedArena (engineBehaviour.shouldAllocatePlaybackGraphsFromArena()
+                                                                ? tracktion::graph::NodeArena::create() : tracktion::graph::NodeArena::Ptr());
+        auto editNode = createNodeForEdit (*this, audiblePlaybackTime, cnp);
+
+        nodePlaybackContext->setNode (std::move (editNode), cnp.sampleRate, cnp.blockSize);
+    }
+
     updateNumCPUs();
 }
 
@@ -11,6 +11,255 @@
 namespace tracktion { inline namespace engine
 {
 
+//==============================================================================
+namespace level_kernels
+{
+    static float getPeak (const float* data, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return 0.0f;
+
+        auto r = juce::FloatVectorOperations::findMinAndMax (data, numSamples);
+        return juce::jmax (-r.getStart(), r.getEnd());
+    }
+
+    static double getSumOfSquares (const float* data, int numSamples) noexcept
+    {
+        // Independent accumulators so the compiler can vectorise this
+        float sums[4] = {};
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            for (int j = 0; j < 4; ++j)
+                sums[j] += data[i + j] * data[i + j];
+
+        double total = (double) sums[0] + sums[1] + sums[2] + sums[3];
+
+        for (; i < numSamples; ++i)
+            total += data[i] * data[i];
+
+        return total;
+    }
+
+    static float getRMS (const float* data, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return 0.0f;
+
+        return (float) std::sqrt (getSumOfSquares (data, numSamples) / numSamples);
+    }
+
+    //==============================================================================
+    /** The 4x oversampling FIR from ITU-R BS.1770-4 Annex 2. */
+    static constexpr int truePeakNumTaps = 12;
+    static constexpr float truePeakCoefficients[4][truePeakNumTaps] =
+    {
+        {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f, -0.0594482421875f,  0.1373291015625f,
+           0.9721679687500f, -0.1022949218750f,  0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+        { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f, -0.1665039062500f,  0.4650878906250f,
+           0.7797851562500f, -0.2003173828125f,  0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+        { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f, -0.2003173828125f,  0.7797851562500f,
+           0.4650878906250f, -0.1665039062500f,  0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+        { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f, -0.1022949218750f,  0.9721679687500f,
+           0.1373291015625f, -0.0594482421875f,  0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+    };
+
+    /** Returns the true-peak of a block, using and updating the history of the previous samples. */
+    static float getTruePeak (const float* data, int numSamples, float* history) noexcept
+    {
+        float peak = 0.0f;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            std::memmove (history + 1, history, (truePeakNumTaps - 1) * sizeof (float));
+            history[0] = data[i];
+
+            for (auto& phase : truePeakCoefficients)
+            {
+                float sum = 0.0f;
+
+                for (int t = 0; t < truePeakNumTaps; ++t)
+                    sum += phase[t] * history[t];
+
+                peak = juce::jmax (peak, std::abs (sum));
+            }
+        }
+
+        return peak;
+    }
+
+    //==============================================================================
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    /** Returns the two K-weighting filter stages from ITU-R BS.1770 for a sample rate. */
+    static std::array<Biquad, 2> getKWeightingFilters (double sampleRate)
+    {
+        std::array<Biquad, 2> filters;
+
+        {
+            const double f0 = 1681.974450955533, gain = 3.999843853973347, q = 0.7071752369554196;
+            const double k = std::tan (juce::MathConstants<double>::pi * f0 / sampleRate);
+            const double vh = std::pow (10.0, gain / 20.0);
+            const double vb = std::pow (vh, 0.4996667741545416);
+            const double a0 = 1.0 + k / q + k * k;
+
+            filters[0] = { (vh + vb * k / q + k * k) / a0,
+                           2.0 * (k * k - vh) / a0,
+                           (vh - vb * k / q + k * k) / a0,
+                           2.0 * (k * k - 1.0) / a0,
+                           (1.0 - k / q + k * k) / a0 };
+        }
+
+        {
+            const double f0 = 38.13547087602444, q = 0.5003270373238773;
+            const double k = std::tan (juce::MathConstants<double>::pi * f0 / sampleRate);
+            const double a0 = 1.0 + k / q + k * k;
+
+            filters[1] = { 1.0, -2.0, 1.0,
+                           2.0 * (k * k - 1.0) / a0,
+                           (1.0 - k / q + k * k) / a0 };
+        }
+
+        return filters;
+    }
+
+    /** Applies the K-weighting to a block and returns the sum of squares of the weighted signal. */
+    static double getKWeightedSumOfSquares (const float* data, int numSamples,
+                                            const std::array<Biquad, 2>& filters, double* state) noexcept
+    {
+        double sum = 0.0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            double x = data[i];
+
+            for (size_t f = 0; f < filters.size(); ++f)
+            {
+                auto& c = filters[f];
+                auto s = state + f * 2;
+
+                // Transposed direct form II
+                const double y = c.b0 * x + s[0];
+                s[0] = c.b1 * x - c.a1 * y + s[1];
+                s[1] = c.b2 * x - c.a2 * y;
+                x = y;
+            }
+
+            sum += x * x;
+        }
+
+        return sum;
+    }
+
+    static uint64_t pack (DbTimePair p) noexcept
+    {
+        uint32_t dBBits;
+        std::memcpy (&dBBits, &p.dB, sizeof (dBBits));
+        return (uint64_t (p.time) << 32) | dBBits;
+    }
+
+    static DbTimePair unpack (uint64_t v) noexcept
+    {
+        DbTimePair p;
+        p.time = uint32_t (v >> 32);
+        const auto dBBits = uint32_t (v & 0xffffffff);
+        std::memcpy (&p.dB, &dBBits, sizeof (dBBits));
+        return p;
+    }
+}
+
+//==============================================================================
+/** The filter and history state needed by the loudness and true-peak modes.
+    This is only allocated when one of those modes is first used.
+*/
+struct LevelMeasurer::MeasurementState
+{
+    static constexpr int maxNumChannels = Client::maxNumChannels;
+    static constexpr double binLengthSeconds = 0.01, momentaryWindowSeconds = 0.4;
+    static constexpr int numBins = 64;
+
+    void reset() noexcept
+    {
+        for (auto& h : truePeakHistory)
+            std::fill (std::begin (h), std::end (h), 0.0f);
+
+        for (auto& s : filterState)
+            std::fill (std::begin (s), std::end (s), 0.0);
+
+        std::fill (std::begin (binSums), std::end (binSums), 0.0);
+        std::fill (std::begin (binNumSamples), std::end (binNumSamples), 0);
+        currentBin = 0;
+        oldestBin = 0;
+        windowSum = 0.0;
+        windowNumSamples = 0;
+    }
+
+    /** Returns the momentary loudness in LUFS after adding the next block. */
+    float addBlockForLoudness (const juce::AudioBuffer<float>& buffer, int start, int numSamples, int numChans, double newSampleRate) noexcept
+    {
+        if (newSampleRate != filterSampleRate)
+        {
+            filterSampleRate = newSampleRate;
+            kWeighting = level_kernels::getKWeightingFilters (newSampleRate);
+            reset();
+        }
+
+        double blockSum = 0.0;
+
+        for (int i = 0; i < numChans; ++i)
+            blockSum += level_kernels::getKWeightedSumOfSquares (buffer.getReadPointer (i, start), numSamples,
+                                                                 kWeighting, filterState[i]);
+
+        // Blocks are accumulated in to short bins so the 400ms window can slide
+        // without keeping every sample
+        if (binNumSamples[currentBin] >= (int64_t) (binLengthSeconds * filterSampleRate))
+        {
+            currentBin = (currentBin + 1) % numBins;
+
+            if (currentBin == oldestBin)
+                dropOldestBin();
+        }
+
+        binSums[currentBin] += blockSum;
+        binNumSamples[currentBin] += numSamples;
+        windowSum += blockSum;
+        windowNumSamples += numSamples;
+
+        const auto maxWindowSamples = (int64_t) (momentaryWindowSeconds * filterSampleRate);
+
+        while (oldestBin != currentBin && windowNumSamples - binNumSamples[oldestBin] >= maxWindowSamples)
+            dropOldestBin();
+
+        if (windowNumSamples <= 0 || windowSum <= 0.0)
+            return -100.0f;
+
+        return juce::jmax (-100.0f, (float) (-0.691 + 10.0 * std::log10 (juce::jmax (1.0e-20, windowSum / (double) windowNumSamples))));
+    }
+
+    void dropOldestBin() noexcept
+    {
+        windowSum -= binSums[oldestBin];
+        windowNumSamples -= binNumSamples[oldestBin];
+        binSums[oldestBin] = 0.0;
+        binNumSamples[oldestBin] = 0;
+        oldestBin = (oldestBin + 1) % numBins;
+    }
+
+    float truePeakHistory[maxNumChannels][level_kernels::truePeakNumTaps] = {};
+
+    std::array<level_kernels::Biquad, 2> kWeighting;
+    double filterSampleRate = 0.0;
+    double filterState[maxNumChannels][4] = {};
+    double binSums[numBins] = {};
+    int64_t binNumSamples[numBins] = {};
+    int currentBin = 0, oldestBin = 0;
+    double windowSum = 0.0;
+    int64_t windowNumSamples = 0;
+};
+
 //==============================================================================
 template <typename FloatType>
 static void getSumAndDiff (const juce::AudioBuffer<FloatType>& buffer,
@@ -30,7 +279,7 @@ static void getSumAndDiff (const juce::AudioBuffer<FloatType>& buffer,
 
         for (int i = buffer.getNumChannels(); --i >= 0;)
         {
-            auto mag = buffer.getMagnitude (i, startIndex, numSamples);
+            auto mag = level_kernels::getPeak (buffer.getReadPointer (i, startIndex), numSamples);
             s += mag;
             lo = juce::jmin (lo, mag);
             hi = juce::jmax (hi, mag);
@@ -53,6 +302,12 @@ LevelMeasurer::~LevelMeasurer()
 }
 
 //==============================================================================
+LevelMeasurer::Client::Client() noexcept
+{
+    reset();
+    clearPeak = true;
+}
+
 int LevelMeasurer::Client::getNumChannelsUsed() const noexcept
 {
     return numChannelsUsed;
@@ -60,172 +315,198 @@ int LevelMeasurer::Client::getNumChannelsUsed() const noexcept
 
 void LevelMeasurer::Client::reset() noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
     for (auto& l : audioLevels)
-        l = {};
+        l.store (level_kernels::pack ({}), std::memory_order_relaxed);
 
     for (auto& o : overload)
-        o = false;
+        o.store (false, std::memory_order_relaxed);
 
-    midiLevels = {};
+    midiLevels.store (level_kernels::pack ({}), std::memory_order_relaxed);
     clearOverload = true;
 }
 
 bool LevelMeasurer::Client::getAndClearOverload() noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
-    auto result = clearOverload;
-    clearOverload = false;
-    return result;
+    return clearOverload.exchange (false);
 }
 
 bool LevelMeasurer::Client::getAndClearPeak() noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
-    auto result = clearPeak;
-    clearPeak = false;
-    return result;
+    return clearPeak.exchange (false);
+}
+
+static DbTimePair getAndClearLevel (std::atomic<uint64_t>& level) noexcept
+{
+    auto current = level.load (std::memory_order_relaxed);
+
+    while (! level.compare_exchange_weak (current, level_kernels::pack ({ level_kernels::unpack (current).time, -100.0f }),
+                                          std::memory_order_acq_rel, std::memory_order_relaxed))
+    {}
+
+    return level_kernels::unpack (current);
+}
+
+static void updateLevelIfHigher (std::atomic<uint64_t>& level, DbTimePair newLevel) noexcept
+{
+    auto current = level.load (std::memory_order_relaxed);
+
+    while (newLevel.dB >= level_kernels::unpack (current).dB
+           && ! level.compare_exchange_weak (current, level_kernels::pack (newLevel),
+                                             std::memory_order_release, std::memory_order_relaxed))
+    {}
 }
 
 DbTimePair LevelMeasurer::Client::getAndClearMidiLevel() noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
-    auto result = midiLevels;
-    midiLevels.dB = -100.0f;
-    return result;
+    return getAndClearLevel (midiLevels);
 }
 
 DbTimePair LevelMeasurer::Client::getAndClearAudioLevel (int chan) noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
     jassert (chan >= 0 && chan < maxNumChannels);
-    auto result = audioLevels[chan];
-    audioLevels[chan].dB = -100.0f;
-    return result;
+    return getAndClearLevel (audioLevels[chan]);
 }
 
 void LevelMeasurer::Client::setNumChannelsUsed (int numChannels) noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
     numChannelsUsed = numChannels;
 }
 
 void LevelMeasurer::Client::setOverload (int channel, bool hasOverloaded) noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
     overload[channel] = hasOverloaded;
 }
 
 void LevelMeasurer::Client::setClearOverload (bool clear) noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
     clearOverload = clear;
 }
 
 void LevelMeasurer::Client::setClearPeak (bool clear) noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
     clearPeak = clear;
 }
 
 void LevelMeasurer::Client::updateAudioLevel (int channel, DbTimePair newAudioLevel) noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
-
-    if (newAudioLevel.dB >= audioLevels[channel].dB)
-        audioLevels[channel] = newAudioLevel;
+    updateLevelIfHigher (audioLevels[channel], newAudioLevel);
 }
 
 void LevelMeasurer::Client::updateMidiLevel (DbTimePair newMidiLevel) noexcept
 {
-    juce::SpinLock::ScopedLockType sl (mutex);
-
-    if (newMidiLevel.dB >= midiLevels.dB)
-        midiLevels = newMidiLevel;
+    updateLevelIfHigher (midiLevels, newMidiLevel);
 }
 
 
 //==============================================================================
-void LevelMeasurer::processBuffer (juce::AudioBuffer<float>& buffer, int start, int numSamples)
+template<typename Function>
+void LevelMeasurer::forEachClient (Function&& f)
 {
-    const std::scoped_lock sl (clientsMutex);
+    // removeClient waits for this count to reach zero so a
+    // Client can't be deleted whilst it's being updated
+    numClientIterations.fetch_add (1);
+
+    for (auto& slot : clients)
+        if (auto c = slot.load())
+            f (*c);
+
+    numClientIterations.fetch_sub (1);
 
-    if (clients.isEmpty())
+    if (hasExtraClients.load())
+    {
+        // Adding or removing extra clients is rare so this just skips them if it can't get the lock
+        const juce::SpinLock::ScopedTryLockType sl (extraClientLock);
+
+        if (sl.isLocked())
+            for (auto c : extraClients)
+                f (*c);
+    }
+}
+
+void LevelMeasurer::processBuffer (juce::AudioBuffer<float>& buffer, int start, int numSamples)
+{
+    if (numClients.load (std::memory_order_relaxed) == 0)
         return;
 
     auto numChans = std::min ((int) Client::maxNumChannels, buffer.getNumChannels());
     numActiveChannels = numChans;
     auto now = juce::Time::getApproximateMillisecondCounter();
 
-    if (mode == LevelMeasurer::peakMode)
-    {
-        // peak mode
-        for (int i = numChans; --i >= 0;)
-        {
-            auto gain = buffer.getMagnitude (i, start, numSamples);
-            bool overloaded = gain > 0.999f;
-            auto newDB = gainToDb (gain);
-
-            for (auto c : clients)
-            {
-                c->updateAudioLevel (i, { now, newDB });
+    // Calculate the levels once and then publish them to all the clients
+    float levels[Client::maxNumChannels] = {};
+    int numLevels = numChans;
+    auto currentMode = mode.load();
+    auto state = measurementState.load (std::memory_order_acquire);
 
-                if (overloaded)
-                    c->setOverload (i, true);
+    if ((currentMode == loudnessMode || currentMode == truePeakMode) && state == nullptr)
+        currentMode = peakMode;
 
-                c->setNumChannelsUsed (numChans);
-            }
-        }
+    if (currentMode == peakMode)
+    {
+        for (int i = numChans; --i >= 0;)
+            levels[i] = level_kernels::getPeak (buffer.getReadPointer (i, start), numSamples);
     }
-    else if (mode == LevelMeasurer::RMSMode)
+    else if (currentMode == RMSMode)
     {
-        // rms mode
         for (int i = numChans; --i >= 0;)
-        {
-            auto gain = buffer.getRMSLevel (i, start, numSamples);
-            bool overloaded = gain > 0.999f;
-            auto newDB = gainToDb (gain);
-
-            for (auto c : clients)
-            {
-                c->updateAudioLevel (i, { now, newDB });
+            levels[i] = level_kernels::getRMS (buffer.getReadPointer (i, start), numSamples);
+    }
+    else if (currentMode == truePeakMode)
+    {
+        for (int i = numChans; --i >= 0;)
+            levels[i] = level_kernels::getTruePeak (buffer.getReadPointer (i, start), numSamples,
+                                                    state->truePeakHistory[i]);
+    }
+    else if (currentMode == loudnessMode)
+    {
+        const auto lufs = state->addBlockForLoudness (buffer, start, numSamples, numChans, sampleRate);
 
-                if (overloaded)
-                    c->setOverload (i, true);
+        forEachClient ([&] (Client& c)
+        {
+            c.updateAudioLevel (0, { now, lufs });
+            c.setNumChannelsUsed (1);
+        });
 
-                c->setNumChannelsUsed (numChans);
-            }
-        }
+        numActiveChannels = 1;
+        return;
     }
     else
     {
         // sum + diff
         float sum, diff;
         getSumAndDiff (buffer, sum, diff, start, numSamples);
+        levels[0] = sum;
+        levels[1] = diff;
+        numLevels = 2;
+        numActiveChannels = 2;
+    }
 
-        auto sumDB  = gainToDb (sum);
-        auto diffDB = gainToDb (diff);
+    DbTimePair dBLevels[Client::maxNumChannels];
+    bool overloaded[Client::maxNumChannels] = {};
 
-        for (auto c : clients)
-        {
-            c->updateAudioLevel (0, { now, sumDB });
-            c->updateAudioLevel (1, { now, diffDB });
+    for (int i = 0; i < numLevels; ++i)
+    {
+        dBLevels[i] = { now, gainToDb (levels[i]) };
+        overloaded[i] = levels[i] > 0.999f;
+    }
 
-            if (sum  > 0.999f) c->setOverload (0, true);
-            if (diff > 0.999f) c->setOverload (1, true);
+    forEachClient ([&] (Client& c)
+    {
+        for (int i = 0; i < numLevels; ++i)
+        {
+            c.updateAudioLevel (i, dBLevels[i]);
 
-            c->setNumChannelsUsed (2);
+            if (overloaded[i])
+                c.setOverload (i, true);
         }
 
-        numActiveChannels = 2;
-    }
+        c.setNumChannelsUsed (numLevels);
+    });
 }
 
 void LevelMeasurer::processMidi (MidiMessageArray& midiBuffer, const float*)
 {
-    const std::scoped_lock sl (clientsMutex);
-
-    if (clients.isEmpty() || ! showMidi)
+    if (numClients.load (std::memory_order_relaxed) == 0 || ! showMidi)
         return;
 
     float max = 0.0f;
@@ -234,47 +515,32 @@ void LevelMeasurer::processMidi (MidiMessageArray& midiBuffer, const float*)
         if (m.isNoteOn())
             max = juce::jmax (max, m.getFloatVelocity());
 
-    auto now = juce::Time::getApproximateMillisecondCounter();
-
-    for (auto c : clients)
-        c->updateMidiLevel ({ now, gainToDb (max) });
+    const DbTimePair level { juce::Time::getApproximateMillisecondCounter(), gainToDb (max) };
+    forEachClient ([&] (Client& c) { c.updateMidiLevel (level); });
 }
 
 void LevelMeasurer::processMidiLevel (float level)
 {
-    const std::scoped_lock sl (clientsMutex);
-
-    if (clients.isEmpty() || ! showMidi)
+    if (numClients.load (std::memory_order_relaxed) == 0 || ! showMidi)
         return;
 
-    auto now = juce::Time::getApproximateMillisecondCounter();
-
-    for (auto c : clients)
-        c->updateMidiLevel ({ now, gainToDb (level) });
+    const DbTimePair dbLevel { juce::Time::getApproximateMillisecondCounter(), gainToDb (level) };
+    forEachClient ([&] (Client& c) { c.updateMidiLevel (dbLevel); });
 }
 
 void LevelMeasurer::clearOverload()
 {
-    const std::scoped_lock sl (clientsMutex);
-
-    for (auto c : clients)
-        c->setClearOverload (true);
+    forEachClient ([] (Client& c) { c.setClearOverload (true); });
 }
 
 void LevelMeasurer::clearPeak()
 {
-    const std::scoped_lock sl (clientsMutex);
-
-    for (auto c : clients)
-        c->setClearPeak (true);
+    forEachClient ([] (Client& c) { c.setClearPeak (true); });
 }
 
 void LevelMeasurer::clear()
 {
-    const std::scoped_lock sl (clientsMutex);
-
-    for (auto c : clients)
-        c->reset();
+    forEachClient ([] (Client& c) { c.reset(); });
 
     levelCacheL = -100.0f;
     levelCacheR = -100.0f;
@@ -284,20 +550,80 @@ void LevelMeasurer::clear()
 void LevelMeasurer::setMode (LevelMeasurer::Mode m)
 {
     clear();
+
+    // This state is never replaced or deleted until the measurer is, so once the audio
+    // thread has loaded the pointer it stays valid
+    if ((m == loudnessMode || m == truePeakMode) && measurementStateStorage == nullptr)
+    {
+        measurementStateStorage = std::make_unique<MeasurementState>();
+        measurementState.store (measurementStateStorage.get(), std::memory_order_release);
+    }
+
     mode = m;
 }
 
+void LevelMeasurer::setSampleRate (double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+}
+
 void LevelMeasurer::addClient (Client& c)
 {
-    const std::scoped_lock sl (clientsMutex);
-    jassert (! clients.contains (&c));
-    clients.add (&c);
+    for (auto& slot : clients)
+        jassert (slot.load() != &c);
+
+    for (auto& slot : clients)
+    {
+        Client* expected = nullptr;
+
+        if (slot.compare_exchange_strong (expected, &c))
+        {
+            ++numClients;
+            return;
+        }
+    }
+
+    // All the lock-free slots are in use so this goes in the locked list
+    {
+        const juce::SpinLock::ScopedLockType sl (extraClientLock);
+        jassert (! extraClients.contains (&c));
+        extraClients.add (&c);
+        hasExtraClients = true;
+    }
+
+    ++numClients;
 }
 
 void LevelMeasurer::removeClient (Client& c)
 {
-    const std::scoped_lock sl (clientsMutex);
-    clients.removeFirstMatchingValue (&c);
+    for (auto& slot : clients)
+    {
+        Client* expected = &c;
+
+        if (slot.compare_exchange_strong (expected, nullptr))
+        {
+            --numClients;
+            break;
+        }
+    }
+
+    if (hasExtraClients.load())
+    {
+        // The audio thread only uses these with the lock held so they're safe to delete after this
+        const juce::SpinLock::ScopedLockType sl (extraClientLock);
+
+        if (auto index = extraClients.indexOf (&c); index >= 0)
+        {
+            extraClients.remove (index);
+            --numClients;
+        }
+
+        hasExtraClients = ! extraClients.isEmpty();
+    }
+
+    // Wait for any audio threads that might have already loaded the pointer
+    while (numClientIterations.load() > 0)
+        std::this_thread::yield();
 }
 
 void LevelMeasurer::setShowMidi (bool show)
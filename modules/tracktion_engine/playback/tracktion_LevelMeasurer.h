@@ -21,6 +21,10 @@ struct DbTimePair
 /**
     Monitors the levels of buffers that are passed in, and keeps peak values,
     overloads, etc., for display in a level meter component.
+
+    The levels are calculated once per block regardless of the number of clients
+    and published to each Client without taking any locks on the audio thread.
+    Clients can be read from any thread.
 */
 class LevelMeasurer
 {
@@ -43,11 +47,18 @@ public:
     {
         peakMode     = 0,
         RMSMode      = 1,
-        sumDiffMode  = 2
+        sumDiffMode  = 2,
+        loudnessMode = 3,   /**< ITU-R BS.1770 momentary loudness of all the channels in LUFS, reported on channel 0. */
+        truePeakMode = 4    /**< ITU-R BS.1770 4x oversampled true-peak of each channel in dBTP. */
     };
 
     void setMode (Mode);
-    Mode getMode() const noexcept                       { return mode; }
+    Mode getMode() const noexcept                       { return mode.load(); }
+
+    /** Sets the sample rate of the buffers being measured.
+        This is only needed for the loudnessMode as it uses sample rate dependent filters.
+    */
+    void setSampleRate (double) noexcept;
 
     void setShowMidi (bool showMidi);
 
@@ -56,7 +67,7 @@ public:
     //==============================================================================
     struct Client
     {
-        Client() = default;
+        Client() noexcept;
 
         int getNumChannelsUsed() const noexcept;
         void reset() noexcept;
@@ -77,32 +88,57 @@ public:
         void updateMidiLevel (DbTimePair) noexcept;
 
     private:
-        DbTimePair audioLevels[maxNumChannels];
-        bool overload[maxNumChannels] = {};
-        DbTimePair midiLevels;
+        // DbTimePairs are packed in to 64 bits so they can be updated atomically
+        std::atomic<uint64_t> audioLevels[maxNumChannels];
+        std::atomic<bool> overload[maxNumChannels];
+        std::atomic<uint64_t> midiLevels;
         std::atomic<int> numChannelsUsed { 0 };
-        bool clearOverload = true;
-        bool clearPeak = true;
-
-        juce::SpinLock mutex;
+        std::atomic<bool> clearOverload { true };
+        std::atomic<bool> clearPeak { true };
     };
 
     //==============================================================================
+    /** Adds a Client to be updated.
+        The first numLockFreeClients are updated without any locking. Any more are
+        kept in a list guarded by a SpinLock that the audio thread only tries to take,
+        so they may miss a block whilst a client is being added or removed.
+    */
     void addClient (Client&);
+
+    /** Removes a Client.
+        Once this returns the Client won't be updated again so can be deleted.
+    */
     void removeClient (Client&);
 
+    static constexpr int numLockFreeClients = 32;
+
     void setLevelCache (float dBL, float dBR) noexcept      { levelCacheL = dBL; levelCacheR = dBR; }
     std::pair<float, float> getLevelCache() const           { return { levelCacheL, levelCacheR }; }
 
 private:
-    Mode mode = peakMode;
+    struct MeasurementState;
+
+    std::atomic<Mode> mode { peakMode };
     std::atomic<int> numActiveChannels { 1 };
     bool showMidi = false;
     float levelCacheL = -100.0f;
     float levelCacheR = -100.0f;
+    std::atomic<double> sampleRate { 44100.0 };
+
+    std::atomic<Client*> clients[numLockFreeClients] = {};
+    std::atomic<int> numClients { 0 }, numClientIterations { 0 };
+
+    juce::SpinLock extraClientLock;
+    juce::Array<Client*> extraClients;
+    std::atomic<bool> hasExtraClients { false };
+
+    // The state is created on the message thread and published to the audio thread
+    // through the atomic pointer. It's only deleted along with the measurer.
+    std::unique_ptr<MeasurementState> measurementStateStorage;
+    std::atomic<MeasurementState*> measurementState { nullptr };
 
-    juce::Array<Client*> clients;
-    RealTimeSpinLock clientsMutex;
+    template<typename Function>
+    void forEachClient (Function&&);
 
     JUCE_DECLARE_WEAK_REFERENCEABLE(LevelMeasurer)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeasurer)
@@ -0,0 +1,137 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_LEVEL_MEASURER
+
+#include <tracktion_engine/../3rd_party/doctest/tracktion_doctest.hpp>
+
+namespace tracktion::inline engine
+{
+
+TEST_SUITE ("tracktion_engine")
+{
+    static juce::AudioBuffer<float> createSinBuffer (int numChannels, int numSamples, double frequency, double sampleRate, float gain)
+    {
+        juce::AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int c = 0; c < numChannels; ++c)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (c, i, gain * (float) std::sin (juce::MathConstants<double>::twoPi * frequency * i / sampleRate));
+
+        return buffer;
+    }
+
+    static float measure (LevelMeasurer::Mode mode, const juce::AudioBuffer<float>& source, double sampleRate, int channel = 0)
+    {
+        LevelMeasurer measurer;
+        measurer.setMode (mode);
+        measurer.setSampleRate (sampleRate);
+
+        LevelMeasurer::Client client;
+        measurer.addClient (client);
+
+        auto buffer = source;
+        const int blockSize = 512;
+
+        for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+        {
+            client.getAndClearAudioLevel (channel);
+            measurer.processBuffer (buffer, start, std::min (blockSize, buffer.getNumSamples() - start));
+        }
+
+        const auto result = client.getAndClearAudioLevel (channel).dB;
+        measurer.removeClient (client);
+        return result;
+    }
+
+    TEST_CASE ("LevelMeasurer")
+    {
+        const double sampleRate = 48000.0;
+
+        SUBCASE ("Peak and RMS")
+        {
+            auto buffer = createSinBuffer (2, 48000, 1000.0, sampleRate, 0.5f);
+            CHECK_EQ (measure (LevelMeasurer::peakMode, buffer, sampleRate), doctest::Approx (gainToDb (0.5f)).epsilon (0.01));
+            CHECK_EQ (measure (LevelMeasurer::RMSMode, buffer, sampleRate, 1), doctest::Approx (gainToDb (0.5f / std::sqrt (2.0f))).epsilon (0.01));
+        }
+
+        SUBCASE ("Loudness of a full scale 997Hz sine is -3.01 LUFS")
+        {
+            auto buffer = createSinBuffer (1, 48000, 997.0, sampleRate, 1.0f);
+            CHECK_EQ (measure (LevelMeasurer::loudnessMode, buffer, sampleRate), doctest::Approx (-3.01f).epsilon (0.02));
+        }
+
+        SUBCASE ("True-peak finds inter-sample peaks")
+        {
+            // A quarter sample rate sine sampled at 45 degrees never hits its peak
+            juce::AudioBuffer<float> buffer (1, 4800);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (0, i, (float) std::sin (juce::MathConstants<double>::halfPi * i + juce::MathConstants<double>::pi / 4.0));
+
+            const auto samplePeak = measure (LevelMeasurer::peakMode, buffer, sampleRate);
+            const auto truePeak = measure (LevelMeasurer::truePeakMode, buffer, sampleRate);
+            CHECK_EQ (samplePeak, doctest::Approx (-3.01f).epsilon (0.01));
+            CHECK (truePeak > -0.5f);
+        }
+
+        SUBCASE ("Removed clients aren't updated")
+        {
+            LevelMeasurer measurer;
+            LevelMeasurer::Client client1, client2;
+            measurer.addClient (client1);
+            measurer.addClient (client2);
+            measurer.removeClient (client1);
+
+            auto buffer = createSinBuffer (2, 512, 1000.0, sampleRate, 1.0f);
+            measurer.processBuffer (buffer, 0, buffer.getNumSamples());
+
+            CHECK_EQ (client1.getAndClearAudioLevel (0).dB, -100.0f);
+            CHECK (client2.getAndClearAudioLevel (0).dB > -1.0f);
+            CHECK_EQ (client2.getNumChannelsUsed(), 2);
+            measurer.removeClient (client2);
+        }
+
+        SUBCASE ("Clients beyond the lock-free slots are still updated")
+        {
+            LevelMeasurer measurer;
+            std::vector<LevelMeasurer::Client> clients ((size_t) LevelMeasurer::numLockFreeClients + 8);
+
+            for (auto& c : clients)
+                measurer.addClient (c);
+
+            auto buffer = createSinBuffer (2, 512, 1000.0, sampleRate, 1.0f);
+            measurer.processBuffer (buffer, 0, buffer.getNumSamples());
+
+            for (auto& c : clients)
+                CHECK (c.getAndClearAudioLevel (0).dB > -1.0f);
+
+            // Removing one of the extra clients stops it being updated but not the others
+            measurer.removeClient (clients.back());
+            measurer.processBuffer (buffer, 0, buffer.getNumSamples());
+
+            CHECK_EQ (clients.back().getAndClearAudioLevel (0).dB, -100.0f);
+            CHECK (clients[clients.size() - 2].getAndClearAudioLevel (0).dB > -1.0f);
+
+            for (size_t i = 0; i < clients.size() - 1; ++i)
+            {
+                clients[i].getAndClearAudioLevel (0);
+                measurer.removeClient (clients[i]);
+            }
+
+            measurer.processBuffer (buffer, 0, buffer.getNumSamples());
+            CHECK_EQ (clients.front().getAndClearAudioLevel (0).dB, -100.0f);
+        }
+    }
+}
+
+} // namespace tracktion::inline engine
+
+#endif
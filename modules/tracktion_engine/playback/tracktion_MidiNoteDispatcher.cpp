@@ -12,52 +12,74 @@ namespace tracktion { inline namespace engine
 {
 
 MidiNoteDispatcher::MidiNoteDispatcher()
+    : juce::Thread ("MIDI Dispatch")
 {
+    messagesToSend.ensureStorageAllocated (32);
 }
 
 MidiNoteDispatcher::~MidiNoteDispatcher()
 {
-    stopTimer();
+    stopDispatchThread();
 }
 
 void MidiNoteDispatcher::dispatchPendingMessagesForDevices (TimePosition editTime)
 {
-    const std::shared_lock sl (deviceMutex);
+    bool messagesQueued = false;
+
+    {
+        const std::shared_lock sl (deviceMutex);
+
+        for (auto state : devices)
+            messagesQueued = dispatchPendingMessages (*state, editTime) || messagesQueued;
+    }
 
-    for (auto state : devices)
-        dispatchPendingMessages (*state, editTime);
+    if (messagesQueued)
+        wakeEvent.signal();
 }
 
 void MidiNoteDispatcher::masterTimeUpdate (TimePosition editTime)
 {
     const std::scoped_lock s (timeLock);
-    masterTime = editTime;
-    hiResClockOfMasterTime = juce::Time::getMillisecondCounterHiRes();
+    timeReference = { editTime, Clock::now() };
 }
 
 void MidiNoteDispatcher::prepareToPlay (TimePosition editTime)
 {
     masterTimeUpdate (editTime);
+
+    // Any deadlines the thread is waiting for will have moved
+    wakeEvent.signal();
 }
 
-TimePosition MidiNoteDispatcher::getCurrentTime() const
+MidiNoteDispatcher::TimeReference MidiNoteDispatcher::getTimeReference() const
 {
     const std::scoped_lock s (timeLock);
-    return masterTime + TimeDuration::fromSeconds ((juce::Time::getMillisecondCounterHiRes() - hiResClockOfMasterTime) * 0.001);
+    return timeReference;
+}
+
+TimePosition MidiNoteDispatcher::TimeReference::getCurrentTime() const
+{
+    return editTime + TimeDuration::fromSeconds (std::chrono::duration<double> (Clock::now() - clockTime).count());
 }
 
-void MidiNoteDispatcher::dispatchPendingMessages (DeviceState& state, TimePosition editTime)
+MidiNoteDispatcher::Clock::time_point MidiNoteDispatcher::TimeReference::getDeadline (TimePosition t) const
+{
+    return clockTime + std::chrono::duration_cast<Clock::duration> (std::chrono::duration<double> ((t - editTime).inSeconds()));
+}
+
+bool MidiNoteDispatcher::dispatchPendingMessages (DeviceState& state, TimePosition editTime)
 {
     // N.B. This should only be called under a deviceLock (which is separate to the bufferMutex)
     auto& pendingBuffer = state.device.getPendingMessages();
     state.device.context.masterLevels.processMidi (pendingBuffer, nullptr);
     const auto delay = state.device.getMidiOutput().getDeviceDelay();
 
-    if (! state.device.sendMessages (pendingBuffer, editTime - delay))
-    {
-        const std::scoped_lock sl (state.bufferMutex);
-        state.buffer.mergeFromAndClear (pendingBuffer);
-    }
+    if (state.device.sendMessages (pendingBuffer, editTime - delay))
+        return false;
+
+    const std::scoped_lock sl (state.bufferMutex);
+    state.buffer.mergeFromAndClear (pendingBuffer);
+    return true;
 }
 
 void MidiNoteDispatcher::setMidiDeviceList (const juce::OwnedArray<MidiOutputDeviceInstance>& newList)
@@ -69,33 +91,39 @@ void MidiNoteDispatcher::setMidiDeviceList (const juce::OwnedArray<MidiOutputDev
         newDevices.add (new DeviceState (*d));
 
     if (newList.isEmpty())
-        stopTimer();
+        stopDispatchThread();
 
-    bool startTimerFlag = false;
+    bool startThreadFlag = false;
 
     {
         const std::unique_lock sl (deviceMutex);
         newDevices.swapWith (devices);
-        startTimerFlag = ! devices.isEmpty();
+        startThreadFlag = ! devices.isEmpty();
     }
 
-    if (startTimerFlag)
-        startTimer (1);
+    if (startThreadFlag && ! isThreadRunning())
+        if (! startRealtimeThread ({}))
+            startThread (juce::Thread::Priority::highest);
 }
 
-void MidiNoteDispatcher::hiResTimerCallback()
+void MidiNoteDispatcher::stopDispatchThread()
 {
-    struct MessageToSend
-    {
-        MidiOutputDeviceInstance* device;
-        juce::MidiMessage message;
-    };
+    signalThreadShouldExit();
+    wakeEvent.signal();
+    stopThread (1000);
+}
 
-    juce::Array<MessageToSend> messagesToSend;
-    messagesToSend.ensureStorageAllocated (32);
+std::optional<MidiNoteDispatcher::Clock::time_point> MidiNoteDispatcher::sendDueMessages()
+{
+    // Messages this close to their deadline are sent now rather than waiting again
+    constexpr auto tolerance = std::chrono::microseconds (50);
+    std::optional<Clock::time_point> nextDeadline;
+    messagesToSend.clearQuick();
 
     {
         const std::shared_lock sl (deviceMutex);
+        const auto reference = getTimeReference();
+        const auto currentTime = reference.getCurrentTime();
 
         for (auto d : devices)
         {
@@ -107,33 +135,53 @@ void MidiNoteDispatcher::hiResTimerCallback()
 
             if (buffer.isAllNotesOff)
                 midiOut.sendNoteOffMessages();
-            
+
             while (buffer.isNotEmpty())
             {
                 auto& message = buffer[0];
-
                 auto noteTime = TimePosition::fromSeconds (message.getTimeStamp());
-                auto currentTime = getCurrentTime();
 
                 if (noteTime > currentTime + TimeDuration::fromSeconds (0.25))
                 {
                     buffer.remove (0);
+                    continue;
                 }
-                else if (noteTime <= currentTime)
-                {
-                    messagesToSend.add ({ &device, message });
-                    buffer.remove (0);
-                }
-                else
+
+                const auto deadline = reference.getDeadline (noteTime);
+
+                if (deadline > Clock::now() + tolerance)
                 {
+                    nextDeadline = nextDeadline ? std::min (*nextDeadline, deadline) : deadline;
                     break;
                 }
+
+                messagesToSend.add ({ &device, message, deadline });
+                buffer.remove (0);
             }
         }
     }
 
     for (auto& m : messagesToSend)
-        m.device->getMidiOutput().fireMessage (m.message);
+    {
+        auto& midiOut = m.device->getMidiOutput();
+        midiOut.fireMessage (m.message);
+        midiOut.addDispatchTiming (std::chrono::duration<double, std::milli> (Clock::now() - m.deadline).count());
+    }
+
+    return nextDeadline;
+}
+
+void MidiNoteDispatcher::run()
+{
+    // The audio callback wakes the thread when it queues messages so this is only a fallback
+    constexpr auto idleTimeout = std::chrono::milliseconds (100);
+    const graph::ScopedHighResolutionTimerPeriod timerPeriod;
+
+    while (! threadShouldExit())
+    {
+        const auto nextDeadline = sendDueMessages();
+        wakeEvent.waitUntil (nextDeadline.value_or (Clock::now() + idleTimeout));
+    }
 }
 
 }} // namespace tracktion { inline namespace engine
@@ -11,7 +11,16 @@
 namespace tracktion { inline namespace engine
 {
 
-class MidiNoteDispatcher   : private juce::HighResolutionTimer
+/**
+    Sends the MIDI messages rendered by the audio callback to the MIDI output devices.
+
+    Messages are time-stamped with their edit time in the audio callback. A dedicated
+    real-time thread then waits until each message's absolute deadline and sends it,
+    so timing isn't limited by a polling period. The thread is woken whenever the audio
+    callback queues new messages. The lateness of each message is recorded by its
+    device and can be read with MidiOutputDevice::getDispatchTiming().
+*/
+class MidiNoteDispatcher   : private juce::Thread
 {
 public:
     MidiNoteDispatcher();
@@ -25,8 +34,6 @@ public:
     void masterTimeUpdate (TimePosition editTime);
     void prepareToPlay (TimePosition editTime);
 
-    void hiResTimerCallback() override;
-
 private:
     //==============================================================================
     struct DeviceState
@@ -38,15 +45,39 @@ private:
         MidiMessageArray buffer;
     };
 
+    using Clock = graph::DeadlineEvent::Clock;
+
+    struct MessageToSend
+    {
+        MidiOutputDeviceInstance* device;
+        juce::MidiMessage message;
+        Clock::time_point deadline;
+    };
+
+    /** The clock time of an edit time, used to convert message time-stamps to deadlines. */
+    struct TimeReference
+    {
+        TimePosition editTime;
+        Clock::time_point clockTime;
+
+        TimePosition getCurrentTime() const;
+        Clock::time_point getDeadline (TimePosition) const;
+    };
+
     //==============================================================================
     juce::OwnedArray<DeviceState> devices;
     mutable RealTimeSpinLock timeLock;
     std::shared_mutex deviceMutex;
-    TimePosition masterTime;
-    double hiResClockOfMasterTime = 0;
+    TimeReference timeReference { {}, Clock::now() };
+    graph::DeadlineEvent wakeEvent;
+    juce::Array<MessageToSend> messagesToSend;
+
+    TimeReference getTimeReference() const;
+    bool dispatchPendingMessages (DeviceState&, TimePosition editTime);
+    std::optional<Clock::time_point> sendDueMessages();
+    void stopDispatchThread();
 
-    TimePosition getCurrentTime() const;
-    void dispatchPendingMessages (DeviceState&, TimePosition editTime);
+    void run() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiNoteDispatcher)
 };
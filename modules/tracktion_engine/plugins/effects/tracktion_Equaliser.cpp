@@ -68,6 +68,8 @@ EqualiserPlugin::EqualiserPlugin (PluginCreationInfo info) : Plugin (info)
     for (int i = 4; --i >= 0;)
         needToUpdateFilters[i] = true;
 
+    filters.prepare (EQ_CHANS, numBands);
+
     addAutomatableParameter (loFreq = new EQAutomatableParameter (*this, "Low-pass freq", TRANS("Low-shelf freq"), *this, { minFreq, maxFreq }, 0, false, true, false));
     addAutomatableParameter (loGain = new EQAutomatableParameter (*this, "Low-pass gain", TRANS("Low-shelf gain"), *this, { minGain, maxGain }, 0, true, false, false));
     addAutomatableParameter (loQ    = new EQAutomatableParameter (*this, "Low-pass Q", TRANS("Low-shelf Q"), *this, { minQ, maxQ }, 0, false, false, true));
@@ -200,8 +202,7 @@ void EqualiserPlugin::updateIIRFilters()
         auto c = juce::IIRCoefficients::makeLowShelf (lastSampleRate, loFreq->getCurrentValue(), loQ->getCurrentValue(),
                                                       convertEQLevelToGain (loGain->getCurrentValue()));
 
-        for (int i = EQ_CHANS; --i >= 0;)
-            low[i].setCoefficients (c);
+        setBandCoefficients (0, c, loGain->getCurrentValue());
     }
 
     if (needToUpdateFilters[1])
@@ -211,8 +212,7 @@ void EqualiserPlugin::updateIIRFilters()
         auto c = juce::IIRCoefficients::makePeakFilter (lastSampleRate, midFreq1->getCurrentValue(), midQ1->getCurrentValue(),
                                                         convertEQLevelToGain (midGain1->getCurrentValue()));
 
-        for (int i = EQ_CHANS; --i >= 0;)
-            mid1[i].setCoefficients (c);
+        setBandCoefficients (1, c, midGain1->getCurrentValue());
     }
 
     if (needToUpdateFilters[2])
@@ -222,8 +222,7 @@ void EqualiserPlugin::updateIIRFilters()
         auto c = juce::IIRCoefficients::makePeakFilter (lastSampleRate, midFreq2->getCurrentValue(), midQ2->getCurrentValue(),
                                                         convertEQLevelToGain (midGain2->getCurrentValue()));
 
-        for (int i = EQ_CHANS; --i >= 0;)
-            mid2[i].setCoefficients (c);
+        setBandCoefficients (2, c, midGain2->getCurrentValue());
     }
 
     if (needToUpdateFilters[3])
@@ -233,20 +232,22 @@ void EqualiserPlugin::updateIIRFilters()
         auto c = juce::IIRCoefficients::makeHighShelf (lastSampleRate, hiFreq->getCurrentValue(), hiQ->getCurrentValue(),
                                                        convertEQLevelToGain (hiGain->getCurrentValue()));
 
-        for (int i = EQ_CHANS; --i >= 0;)
-            high[i].setCoefficients (c);
+        setBandCoefficients (3, c, hiGain->getCurrentValue());
     }
 }
 
+void EqualiserPlugin::setBandCoefficients (int band, const juce::IIRCoefficients& c, float gainDb)
+{
+    bandCoefficients[band] = c;
+
+    // Bands with no gain are left as pass-throughs
+    filters.setCoefficients (band, gainDb != 0 ? BiquadCascade::Coefficients::from (c)
+                                               : BiquadCascade::Coefficients());
+}
+
 void EqualiserPlugin::initialise (const PluginInitialisationInfo&)
 {
-    for (int i = EQ_CHANS; --i >= 0;)
-    {
-        low[i].reset();
-        mid1[i].reset();
-        mid2[i].reset();
-        high[i].reset();
-    }
+    const juce::ScopedLock sl (filterLock);
 
     if (lastSampleRate != sampleRate)
         curveNeedsUpdating = true;
@@ -257,6 +258,7 @@ void EqualiserPlugin::initialise (const PluginInitialisationInfo&)
         needToUpdateFilters[i] = true;
 
     updateIIRFilters();
+    filters.reset();
 }
 
 void EqualiserPlugin::deinitialise()
@@ -279,15 +281,7 @@ void EqualiserPlugin::applyToBuffer (const PluginRenderContext& fc)
 
         addAntiDenormalisationNoise (*fc.destBuffer, fc.bufferStartSample, fc.bufferNumSamples);
 
-        for (int i = std::min ((int) EQ_CHANS, fc.destBuffer->getNumChannels()); --i >= 0;)
-        {
-            auto data = fc.destBuffer->getWritePointer (i, fc.bufferStartSample);
-
-            if (loGain->getCurrentValue() != 0)       low[i] .processSamples (data, fc.bufferNumSamples);
-            if (midGain1->getCurrentValue() != 0)     mid1[i].processSamples (data, fc.bufferNumSamples);
-            if (midGain2->getCurrentValue() != 0)     mid2[i].processSamples (data, fc.bufferNumSamples);
-            if (hiGain->getCurrentValue() != 0)       high[i].processSamples (data, fc.bufferNumSamples);
-        }
+        filters.process (*fc.destBuffer, fc.bufferStartSample, fc.bufferNumSamples);
 
         if (phaseInvert)
             fc.destBuffer->applyGain (fc.bufferStartSample, fc.bufferNumSamples, -1.0f);
@@ -298,7 +292,14 @@ float EqualiserPlugin::getDBGainAtFrequency (float f)
 {
     if (curveNeedsUpdating)
     {
-        updateIIRFilters();
+        // The curve is calculated from a copy so the audio thread isn't held up while it's drawn
+        juce::IIRCoefficients coefficients[numBands];
+
+        {
+            const juce::ScopedLock sl (filterLock);
+            updateIIRFilters();
+            std::copy (std::begin (bandCoefficients), std::end (bandCoefficients), std::begin (coefficients));
+        }
 
         curve.clear();
 
@@ -311,10 +312,17 @@ float EqualiserPlugin::getDBGainAtFrequency (float f)
         float samps[sampSize * 2 + 8] = {};
         samps[0] = 1.0f;
 
-        if (loGain->getCurrentValue() != 0)     juce::IIRFilter (low[0]) .processSamples (samps, sampSize);
-        if (midGain1->getCurrentValue() != 0)   juce::IIRFilter (mid1[0]).processSamples (samps, sampSize);
-        if (midGain2->getCurrentValue() != 0)   juce::IIRFilter (mid2[0]).processSamples (samps, sampSize);
-        if (hiGain->getCurrentValue() != 0)     juce::IIRFilter (high[0]).processSamples (samps, sampSize);
+        auto processBand = [&] (int band)
+        {
+            juce::IIRFilter filter;
+            filter.setCoefficients (coefficients[band]);
+            filter.processSamples (samps, sampSize);
+        };
+
+        if (loGain->getCurrentValue() != 0)     processBand (0);
+        if (midGain1->getCurrentValue() != 0)   processBand (1);
+        if (midGain2->getCurrentValue() != 0)   processBand (2);
+        if (hiGain->getCurrentValue() != 0)     processBand (3);
 
         fft.performRealOnlyForwardTransform (samps);
 
@@ -80,13 +80,15 @@ private:
     float lastSampleRate = 44100.0f;
     bool curveNeedsUpdating = true;
 
-    enum { EQ_CHANS = 2 };
-    juce::IIRFilter low[EQ_CHANS], mid1[EQ_CHANS], mid2[EQ_CHANS], high[EQ_CHANS];
+    enum { EQ_CHANS = 2, numBands = 4 };
+    BiquadCascade filters;
+    juce::IIRCoefficients bandCoefficients[numBands];
 
     enum { fftOrder = 10 };
     juce::dsp::FFT fft { fftOrder };
 
     void updateIIRFilters();
+    void setBandCoefficients (int band, const juce::IIRCoefficients&, float gainDb);
     std::atomic<bool> needToUpdateFilters[4];
     juce::CriticalSection filterLock;
 
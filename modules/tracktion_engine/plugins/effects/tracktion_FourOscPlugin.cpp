@@ -34,15 +34,6 @@ namespace Distortion
     }
 }
 
-inline void clip (float* data, int numSamples)
-{
-    while (--numSamples >= 0)
-    {
-        *data = juce::jlimit (-1.0f, 1.0f, *data);
-        data++;
-    }
-}
-
 //==============================================================================
 class FODelayLine
 {
@@ -278,6 +269,146 @@ private:
     float phase = 0, speedHz = 1.0f, depthMs = 3.0f, width = 0.5f, mix = 0;
 };
 
+//==============================================================================
+/** One channel of a voice's filter. This does the same as a juce::IIRFilter but
+    keeps its state separate so several voices can be run together by an FOFilterBank.
+*/
+struct FOFilterState
+{
+    void setCoefficients (const juce::IIRCoefficients& c) noexcept
+    {
+        std::copy (std::begin (c.coefficients), std::end (c.coefficients), std::begin (coefficients));
+    }
+
+    void reset() noexcept
+    {
+        v1 = v2 = 0.0f;
+    }
+
+    float coefficients[5] = {};
+    float v1 = 0.0f, v2 = 0.0f;
+};
+
+//==============================================================================
+/** Runs the filters of several voices at once.
+    Each channel of each voice is put in its own lane and the samples are
+    interleaved so a single loop can update all the lanes' filters together.
+*/
+struct FOFilterBank
+{
+    static constexpr int numLanes = 8;
+
+    struct Lane
+    {
+        float* data = nullptr;
+        FOFilterState* stage1 = nullptr;
+        FOFilterState* stage2 = nullptr;
+    };
+
+    /** Filters the lanes in place. If useSecondStage is true the output is clipped
+        and then run through the second filter, as for a 24dB slope.
+    */
+    static void process (const Lane* lanes, int numLanesToProcess, int numSamples, bool useSecondStage) noexcept
+    {
+        for (int i = 0; i < numLanesToProcess; i += numLanes)
+            processGroup (lanes + i, std::min (numLanes, numLanesToProcess - i), numSamples, useSecondStage);
+    }
+
+private:
+    static constexpr int maxBlockSize = 32;
+
+    struct Stage
+    {
+        alignas (32) float c0[numLanes] = {}, c1[numLanes] = {}, c2[numLanes] = {}, c3[numLanes] = {}, c4[numLanes] = {};
+        alignas (32) float v1[numLanes] = {}, v2[numLanes] = {};
+
+        void load (int lane, const FOFilterState& f) noexcept
+        {
+            c0[lane] = f.coefficients[0];
+            c1[lane] = f.coefficients[1];
+            c2[lane] = f.coefficients[2];
+            c3[lane] = f.coefficients[3];
+            c4[lane] = f.coefficients[4];
+            v1[lane] = f.v1;
+            v2[lane] = f.v2;
+        }
+
+        void store (int lane, FOFilterState& f) noexcept
+        {
+            auto lv1 = v1[lane], lv2 = v2[lane];
+            JUCE_SNAP_TO_ZERO (lv1);
+            JUCE_SNAP_TO_ZERO (lv2);
+            f.v1 = lv1;
+            f.v2 = lv2;
+        }
+
+        void process (float (*block)[numLanes], int numSamples) noexcept
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto samples = block[i];
+
+                for (int l = 0; l < numLanes; ++l)
+                {
+                    const auto in = samples[l];
+                    const auto out = c0[l] * in + v1[l];
+                    samples[l] = out;
+                    v1[l] = c1[l] * in - c3[l] * out + v2[l];
+                    v2[l] = c2[l] * in - c4[l] * out;
+                }
+            }
+        }
+    };
+
+    static void processGroup (const Lane* lanes, int num, int numSamples, bool useSecondStage) noexcept
+    {
+        Stage stage1, stage2;
+
+        for (int l = 0; l < num; ++l)
+        {
+            stage1.load (l, *lanes[l].stage1);
+
+            if (useSecondStage)
+                stage2.load (l, *lanes[l].stage2);
+        }
+
+        // Unused lanes have zero coefficients and data so stay silent
+        alignas (32) float block[maxBlockSize][numLanes] = {};
+
+        for (int start = 0; start < numSamples; start += maxBlockSize)
+        {
+            const int numThisTime = std::min (maxBlockSize, numSamples - start);
+
+            for (int l = 0; l < num; ++l)
+                for (int i = 0; i < numThisTime; ++i)
+                    block[i][l] = lanes[l].data[start + i];
+
+            stage1.process (block, numThisTime);
+
+            if (useSecondStage)
+            {
+                for (int i = 0; i < numThisTime; ++i)
+                    for (int l = 0; l < numLanes; ++l)
+                        block[i][l] = juce::jlimit (-1.0f, 1.0f, block[i][l]);
+
+                stage2.process (block, numThisTime);
+            }
+
+            for (int l = 0; l < num; ++l)
+                for (int i = 0; i < numThisTime; ++i)
+                    lanes[l].data[start + i] = block[i][l];
+        }
+
+        for (int l = 0; l < num; ++l)
+        {
+            stage1.store (l, *lanes[l].stage1);
+
+            if (useSecondStage)
+                stage2.store (l, *lanes[l].stage2);
+        }
+    }
+};
+
 //==============================================================================
 class FourOscVoice : public juce::MPESynthesiserVoice
 {
@@ -401,6 +532,20 @@ public:
 
     using MPESynthesiserVoice::renderNextBlock;
     void renderNextBlock (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override
+    {
+        FOFilterBank::Lane lanes[2];
+        renderOscillators (numSamples, lanes);
+
+        if (synth.filterTypeValue != 0)
+            FOFilterBank::process (lanes, 2, numSamples, synth.filterSlopeValue == 24);
+
+        finishBlock (outputBuffer, startSample, numSamples);
+    }
+
+    /** Renders the oscillators with the velocity applied, ready to be filtered.
+        This fills in the two lanes the voice's channels need to be filtered.
+    */
+    void renderOscillators (int numSamples, FOFilterBank::Lane* lanes)
     {
         juce::ScopedValueSetter<bool> svs (snapAllValues, firstBlock || snapAllValues);
 
@@ -426,22 +571,13 @@ public:
         velocityGain = juce::jlimit (0.0f, 1.0f, velocityGain);
         renderBuffer.applyGain (velocityGain);
 
-        // Apply filter
-        if (synth.filterTypeValue != 0)
-        {
-            filterL1.processSamples (renderBuffer.getWritePointer (0), numSamples);
-            filterR1.processSamples (renderBuffer.getWritePointer (1), numSamples);
-
-            if (synth.filterSlopeValue == 24)
-            {
-                clip (renderBuffer.getWritePointer (0), numSamples);
-                clip (renderBuffer.getWritePointer (1), numSamples);
-
-                filterL2.processSamples (renderBuffer.getWritePointer (0), numSamples);
-                filterR2.processSamples (renderBuffer.getWritePointer (1), numSamples);
-            }
-        }
+        lanes[0] = { renderBuffer.getWritePointer (0), &filterL1, &filterL2 };
+        lanes[1] = { renderBuffer.getWritePointer (1), &filterR1, &filterR2 };
+    }
 
+    /** Applies the amp envelope to the filtered samples and adds them to the output. */
+    void finishBlock (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+    {
         // Apply ADSR
         ampAdsr.applyEnvelopeToBuffer (renderBuffer, 0, numSamples);
 
@@ -743,7 +879,7 @@ private:
     ExpEnvelope ampAdsr;
     LinEnvelope filterAdsr, modAdsr1, modAdsr2;
     SimpleLFO lfo1, lfo2;
-    juce::IIRFilter filterL1, filterR1, filterL2, filterR2;
+    FOFilterState filterL1, filterR1, filterL2, filterR2;
 
     ValueSmoother<float> filterFrequencySmoother;
 
@@ -1435,6 +1571,8 @@ void FourOscPlugin::initialise (const PluginInitialisationInfo& info)
     delay->reset();
     chorus->reset();
 
+    levelMeasurer.setSampleRate (info.sampleRate);
+
     for (auto& itr : smoothers)
         itr.second.reset (info.sampleRate, 0.01f);
 }
@@ -1526,6 +1664,46 @@ void FourOscPlugin::applyToBuffer (juce::AudioBuffer<float>& buffer, juce::MidiB
         itr.second.process (buffer.getNumSamples());
 }
 
+void FourOscPlugin::renderNextSubBlock (juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const juce::ScopedLock sl (voicesLock);
+
+    // Voices are rendered in groups so their filters can be run together
+    constexpr int maxVoicesPerGroup = FOFilterBank::numLanes / 2;
+    FourOscVoice* group[maxVoicesPerGroup];
+    int numInGroup = 0;
+
+    auto renderGroup = [&]
+    {
+        FOFilterBank::Lane lanes[FOFilterBank::numLanes];
+
+        for (int i = 0; i < numInGroup; ++i)
+            group[i]->renderOscillators (numSamples, lanes + i * 2);
+
+        if (filterTypeValue != 0)
+            FOFilterBank::process (lanes, numInGroup * 2, numSamples, filterSlopeValue == 24);
+
+        for (int i = 0; i < numInGroup; ++i)
+            group[i]->finishBlock (buffer, startSample, numSamples);
+
+        numInGroup = 0;
+    };
+
+    for (auto v : voices)
+    {
+        if (v->isActive())
+        {
+            group[numInGroup++] = static_cast<FourOscVoice*> (v);
+
+            if (numInGroup == maxVoicesPerGroup)
+                renderGroup();
+        }
+    }
+
+    if (numInGroup > 0)
+        renderGroup();
+}
+
 void FourOscPlugin::applyEffects (juce::AudioBuffer<float>& buffer)
 {
     int numSamples = buffer.getNumSamples();
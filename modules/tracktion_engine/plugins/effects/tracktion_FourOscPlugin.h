@@ -373,6 +373,8 @@ private:
     AutomatableParameter* addParam (const juce::String& paramID, const juce::String& name, juce::NormalisableRange<float> valueRange, juce::String label = {});
 
     void applyToBuffer (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi);
+    using juce::MPESynthesiser::renderNextSubBlock;
+    void renderNextSubBlock (juce::AudioBuffer<float>&, int startSample, int numSamples) override;
     void updateParams (juce::AudioBuffer<float>& buffer);
     void applyEffects (juce::AudioBuffer<float>& buffer);
     float paramValue (AutomatableParameter::Ptr param);
@@ -60,6 +60,7 @@ ImpulseResponsePlugin::ImpulseResponsePlugin (PluginCreationInfo info)
                              [] (const juce::String& s)   { return s.getFloatValue(); });
     filterQParam->attachToCurrentValue (qValue);
 
+    filters.prepare (2, 2);
     loadImpulseResponseFromState();
 }
 
@@ -145,7 +146,13 @@ void ImpulseResponsePlugin::initialise (const PluginInitialisationInfo& info)
     processSpec.sampleRate = info.sampleRate;
     processSpec.maximumBlockSize = (uint32_t) info.blockSizeSamples;
     processSpec.numChannels = 2;
-    processorChain.prepare (processSpec);
+
+    {
+        const juce::ScopedLock sl (convolutionLock);
+        processorChain.prepare (processSpec);
+    }
+
+    loadImpulseResponseFromState();
 
     // Update smoothers
     lowFreqSmoother.setTargetValue (midiNoteToFrequency (lowPassCutoffParam->getCurrentValue()));
@@ -164,6 +171,9 @@ void ImpulseResponsePlugin::initialise (const PluginInitialisationInfo& info)
     qSmoother.reset (info.sampleRate, smoothTime);
     wetGainSmoother.reset (info.sampleRate, smoothTime);
     dryGainSmoother.reset (info.sampleRate, smoothTime);
+
+    updateFilters (highFreqSmoother.getCurrentValue(), lowFreqSmoother.getCurrentValue(), qSmoother.getCurrentValue(), false);
+    filters.reset();
 }
 
 void ImpulseResponsePlugin::deinitialise()
@@ -172,6 +182,7 @@ void ImpulseResponsePlugin::deinitialise()
 void ImpulseResponsePlugin::reset()
 {
     processorChain.reset();
+    filters.reset();
 }
 
 void ImpulseResponsePlugin::applyToBuffer (const PluginRenderContext& fc)
@@ -187,8 +198,6 @@ void ImpulseResponsePlugin::applyToBuffer (const PluginRenderContext& fc)
     dryGainSmoother.setTargetValue (wetDryGain.dry);
 
     // Update gains and filter params
-    auto hpf = processorChain.get<HPFIndex>().state;
-    auto& lpf = processorChain.get<LPFIndex>().state;
     auto& gain = processorChain.get<gainIndex>();
 
     AudioScratchBuffer dryBuffer (*fc.destBuffer);
@@ -208,11 +217,11 @@ void ImpulseResponsePlugin::applyToBuffer (const PluginRenderContext& fc)
                                                                                          size_t (numThisTime));
             juce::dsp::ProcessContextReplacing <float> context (inOutBlock);
             processorChain.process (context);
+            filters.process (inOutBlock);
 
-            // Update params
+            // Update params, the filters interpolate to these over the next sub-block
             const auto qFactor = qSmoother.skip (numThisTime);
-            *hpf = juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass (sampleRate, highFreqSmoother.skip (numThisTime), qFactor);
-            *lpf = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass (sampleRate, lowFreqSmoother.skip (numThisTime), qFactor);
+            updateFilters (highFreqSmoother.skip (numThisTime), lowFreqSmoother.skip (numThisTime), qFactor, true);
             gain.setGainLinear (juce::Decibels::decibelsToGain (gainSmoother.skip (numThisTime)));
 
             numSamplesDone += numThisTime;
@@ -225,14 +234,13 @@ void ImpulseResponsePlugin::applyToBuffer (const PluginRenderContext& fc)
     else
     {
         // Update params
-        const auto qFactor = qSmoother.getCurrentValue();
-        *hpf = juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass (sampleRate, highFreqSmoother.getCurrentValue(), qFactor);
-        *lpf = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass (sampleRate, lowFreqSmoother.getCurrentValue(), qFactor);
+        updateFilters (highFreqSmoother.getCurrentValue(), lowFreqSmoother.getCurrentValue(), qSmoother.getCurrentValue(), true);
         gain.setGainLinear (juce::Decibels::decibelsToGain (gainSmoother.getCurrentValue()));
 
         juce::dsp::AudioBlock<float> inOutBlock (*fc.destBuffer);
         juce::dsp::ProcessContextReplacing <float> context (inOutBlock);
         processorChain.process (context);
+        filters.process (inOutBlock);
     }
 
     const bool isMixed = wetGainSmoother.getCurrentValue() < 1.0f;
@@ -266,29 +274,61 @@ void ImpulseResponsePlugin::restorePluginStateFromValueTree (const juce::ValueTr
 //==============================================================================
 void ImpulseResponsePlugin::loadImpulseResponseFromState()
 {
+    // The IR is partitioned for the sample rate and block size so can't be loaded until initialise
+    if (baseClassNeedsInitialising())
+        return;
+
     if (auto irFileData = state.getProperty (IDs::irFileData).getBinaryData())
     {
-        auto is = std::make_unique<juce::MemoryInputStream> (*irFileData, false);
+        PartitionedImpulseResponse::Options options;
 
-        if (auto reader = std::unique_ptr<juce::AudioFormatReader> (juce::FlacAudioFormat()
-                                                                        .createReaderFor (is.release(), true)))
         {
-            juce::AudioBuffer<float> loadIRBuffer ((int) reader->numChannels, (int) reader->lengthInSamples);
-            reader->read (&loadIRBuffer, 0, (int) reader->lengthInSamples, 0, true, true);
-
-            jassert (reader->numChannels > 0);
-            processorChain.get<convolutionIndex>().loadImpulseResponse (std::move (loadIRBuffer),
-                                                                        reader->sampleRate,
-                                                                        reader->numChannels > 1 ? juce::dsp::Convolution::Stereo::yes
-                                                                                                : juce::dsp::Convolution::Stereo::no,
-                                                                        trimSilence.get() ? juce::dsp::Convolution::Trim::yes
-                                                                                          : juce::dsp::Convolution::Trim::no,
-                                                                        normalise.get() ? juce::dsp::Convolution::Normalise::yes
-                                                                                        : juce::dsp::Convolution::Normalise::no);
+            const juce::ScopedLock sl (convolutionLock);
+            options = processorChain.get<convolutionIndex>().getImpulseResponseOptions (normalise.get(), trimSilence.get());
         }
+
+        const auto loadID = ++irLoadID;
+
+        // Renders need the IR from the first block so load it here
+        if (edit.isRendering())
+            return impulseResponseLoaded (loadID, ImpulseResponseCache::getInstance().getImpulseResponse (*irFileData, options));
+
+        // Otherwise decoding and partitioning a long IR can take a while so it's done on a
+        // background thread. Other instances using the same IR will share its partitions
+        engine.getBackgroundJobs().getPool().addJob ([ref = makeSafeRef (*this), loadID, data = *irFileData, options]() mutable
+        {
+            auto ir = ImpulseResponseCache::getInstance().getImpulseResponse (data, options);
+
+            juce::MessageManager::callAsync ([ref, loadID, ir = std::move (ir)]() mutable
+            {
+                if (auto plugin = ref.get())
+                    plugin->impulseResponseLoaded (loadID, std::move (ir));
+            });
+        });
     }
 }
 
+void ImpulseResponsePlugin::impulseResponseLoaded (int loadID, std::shared_ptr<const PartitionedImpulseResponse> ir)
+{
+    const juce::ScopedLock sl (convolutionLock);
+    auto& convolution = processorChain.get<convolutionIndex>();
+
+    // Ignore IRs that have been superseded, are already in use or were created
+    // for a sample rate or block size the convolution is no longer prepared for
+    if (ir == nullptr || loadID != irLoadID || ir == convolution.getImpulseResponse()
+         || ir->options != convolution.getImpulseResponseOptions (ir->options.normalise, ir->options.trimSilence))
+        return;
+
+    convolution.setImpulseResponse (std::move (ir));
+}
+
+void ImpulseResponsePlugin::updateFilters (float highPassFrequency, float lowPassFrequency, float q, bool interpolate)
+{
+    using Coefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+    filters.setCoefficients (highPassStage, BiquadCascade::Coefficients::from (Coefficients::makeHighPass (sampleRate, highPassFrequency, q)), interpolate);
+    filters.setCoefficients (lowPassStage, BiquadCascade::Coefficients::from (Coefficients::makeLowPass (sampleRate, lowPassFrequency, q)), interpolate);
+}
+
 void ImpulseResponsePlugin::valueTreePropertyChanged (juce::ValueTree& v, const juce::Identifier& id)
 {
     if (v == state)
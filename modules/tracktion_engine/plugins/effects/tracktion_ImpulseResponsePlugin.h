@@ -89,19 +89,24 @@ private:
     enum
     {
         convolutionIndex,
-        HPFIndex,
-        LPFIndex,
         gainIndex,
     };
 
+    enum
+    {
+        highPassStage,
+        lowPassStage,
+    };
+
     juce::CachedValue<float> gainValue, mixValue;
     juce::CachedValue<float> highPassCutoffValue, lowPassCutoffValue;
     juce::CachedValue<float> qValue;
 
-    juce::dsp::ProcessorChain<juce::dsp::Convolution,
-                              juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>>,
-                              juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>>,
+    juce::dsp::ProcessorChain<PartitionedConvolution,
                               juce::dsp::Gain<float>> processorChain;
+    juce::CriticalSection convolutionLock;
+    std::atomic<int> irLoadID { 0 };
+    BiquadCascade filters;
     juce::SmoothedValue<float> highFreqSmoother, lowFreqSmoother, gainSmoother, wetGainSmoother, dryGainSmoother, qSmoother;
 
     struct WetDryGain { float wet, dry; };
@@ -114,6 +119,8 @@ private:
         return { wet, dry };
     }
     void loadImpulseResponseFromState();
+    void impulseResponseLoaded (int loadID, std::shared_ptr<const PartitionedImpulseResponse>);
+    void updateFilters (float highPassFrequency, float lowPassFrequency, float q, bool interpolate);
 
     void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override;
 
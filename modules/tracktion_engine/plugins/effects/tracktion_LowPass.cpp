@@ -23,6 +23,8 @@ LowPassPlugin::LowPassPlugin (PluginCreationInfo info) : Plugin (info)
                           [] (const juce::String& s)    { return s.getFloatValue(); });
 
     frequency->attachToCurrentValue (frequencyValue);
+
+    filter.prepare (2, 1);
 }
 
 LowPassPlugin::~LowPassPlugin()
@@ -47,8 +49,7 @@ void LowPassPlugin::updateFilters()
         auto c = nowLowPass ? juce::IIRCoefficients::makeLowPass  (sampleRate, newFreq)
                             : juce::IIRCoefficients::makeHighPass (sampleRate, newFreq);
 
-        filter[0].setCoefficients (c);
-        filter[1].setCoefficients (c);
+        filter.setCoefficients (0, BiquadCascade::Coefficients::from (c));
     }
 }
 
@@ -56,11 +57,9 @@ void LowPassPlugin::initialise (const PluginInitialisationInfo& info)
 {
     sampleRate = info.sampleRate;
 
-    for (int i = 0; i < numElementsInArray (filter); ++i)
-        filter[i].reset();
-
     currentFilterFreq = 0;
     updateFilters();
+    filter.reset();
 }
 
 void LowPassPlugin::deinitialise()
@@ -77,8 +76,7 @@ void LowPassPlugin::applyToBuffer (const PluginRenderContext& fc)
 
         clearChannels (*fc.destBuffer, 2, -1, fc.bufferStartSample, fc.bufferNumSamples);
 
-        for (int i = std::min (2, fc.destBuffer->getNumChannels()); --i >= 0;)
-            filter[i].processSamples (fc.destBuffer->getWritePointer (i, fc.bufferStartSample), fc.bufferNumSamples);
+        filter.process (*fc.destBuffer, fc.bufferStartSample, fc.bufferNumSamples);
 
         sanitiseValues (*fc.destBuffer, fc.bufferStartSample, fc.bufferNumSamples, 3.0f);
     }
@@ -39,7 +39,7 @@ public:
     AutomatableParameter::Ptr frequency;
 
 private:
-    juce::IIRFilter filter[2];
+    BiquadCascade filter;
     float currentFilterFreq = 0;
     bool isCurrentlyLowPass = false;
 
@@ -35,6 +35,10 @@ const char* LevelMeterPlugin::xmlTypeName = "level";
 void LevelMeterPlugin::initialise (const PluginInitialisationInfo& info)
 {
     measurer.clear();
+
+    if (info.sampleRate > 0.0)
+        measurer.setSampleRate (info.sampleRate);
+
     initialiseWithoutStopping (info);
 }
 
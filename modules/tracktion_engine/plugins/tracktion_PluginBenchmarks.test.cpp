@@ -0,0 +1,107 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_EQUALISER
+
+#include <tracktion_core/utilities/tracktion_Benchmark.h>
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+//==============================================================================
+class EqualiserBenchmarks  : public juce::UnitTest
+{
+public:
+    EqualiserBenchmarks()
+        : juce::UnitTest ("Equaliser", "tracktion_benchmarks")
+    {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 44100.0;
+        constexpr int blockSize = 256, numBlocks = 10'000;
+
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = Edit::createSingleTrackEdit (engine);
+        auto plugin = edit->getPluginCache().createNewPlugin (EqualiserPlugin::xmlTypeName, {});
+        auto eq = dynamic_cast<EqualiserPlugin*> (plugin.get());
+        expect (eq != nullptr);
+
+        if (eq == nullptr)
+            return;
+
+        eq->setLowGain (3.0f);
+        eq->setMidGain1 (-6.0f);
+        eq->setMidGain2 (4.0f);
+        eq->setHighGain (-2.0f);
+        eq->baseClassInitialise ({ 0_tp, sampleRate, blockSize });
+
+        auto processBlocks = [eq] (Benchmark& bm)
+        {
+            juce::Random r (42);
+            juce::AudioBuffer<float> buffer (2, blockSize);
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                for (int c = 0; c < buffer.getNumChannels(); ++c)
+                    for (int s = 0; s < blockSize; ++s)
+                        buffer.setSample (c, s, r.nextFloat() * 2.0f - 1.0f);
+
+                const PluginRenderContext rc (&buffer, juce::AudioChannelSet::stereo(), 0, blockSize,
+                                              nullptr, 0.0, {}, true, false, false, false);
+
+                const ScopedMeasurement sm (bm);
+                eq->applyToBuffer (rc);
+            }
+        };
+
+        beginTest ("Benchmark: EqualiserPlugin");
+        {
+            {
+                auto bm = Benchmark (createBenchmarkDescription ("Plugins", "Equaliser",
+                                                                 "Process 10'000 256 sample stereo blocks with four active bands"));
+                processBlocks (bm);
+                BenchmarkList::getInstance().addResult (bm.getResult());
+            }
+
+            {
+                // The response curve is drawn from a copy of the coefficients so
+                // recalculating it shouldn't hold up the audio thread
+                auto bm = Benchmark (createBenchmarkDescription ("Plugins", "Equaliser",
+                                                                 "Process 10'000 256 sample stereo blocks while the response curve is recalculated"));
+                std::atomic<bool> finished { false };
+
+                std::thread audioThread ([&]
+                                         {
+                                             processBlocks (bm);
+                                             finished = true;
+                                         });
+
+                for (int i = 0; ! finished; ++i)
+                {
+                    eq->setLowGain ((i % 2) == 0 ? 6.0f : 3.0f);
+                    [[maybe_unused]] volatile float gain = eq->getDBGainAtFrequency (1000.0f);
+                }
+
+                audioThread.join();
+                BenchmarkList::getInstance().addResult (bm.getResult());
+            }
+        }
+
+        eq->baseClassDeinitialise();
+    }
+};
+
+static EqualiserBenchmarks equaliserBenchmarks;
+
+} // namespace tracktion::inline engine
+
+#endif //TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_EQUALISER
@@ -506,6 +506,45 @@ TEST_SUITE ("tracktion_engine")
             CHECK(! volPlugin->isActiveParameter (*volParam));
         }
     }
+
+    TEST_CASE ("Macro assigned to several parameters")
+    {
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = engine::test_utilities::createTestEdit (engine, 1);
+        auto volPlugin = getAudioTracks(*edit)[0]->getVolumePlugin();
+        auto volParam = volPlugin->volParam;
+        auto panParam = volPlugin->panParam;
+        auto macroParam = volPlugin->getMacroParameterListForWriting().createMacroParameter();
+
+        auto& macroCurve = macroParam->getCurve();
+        macroCurve.addPoint (0_tp, 0.0f, 0.0f, nullptr);
+        macroCurve.addPoint (10_tp, 1.0f, 0.0f, nullptr);
+        macroParam->updateStream();
+
+        volParam->addModifier (*macroParam, 0.5f, 0.2f, 0.0f);
+        panParam->addModifier (*macroParam, -0.5f, 0.8f, 0.0f);
+
+        // Update the destinations from a background thread as the audio graph would,
+        // more than once per block to check the macro value isn't stale
+        for (auto t : { 2.5_tp, 5_tp, 7.5_tp })
+        {
+            edit->updateModifierTimers (t, 512);
+
+            std::thread ([&, t]
+                         {
+                             for (int i = 0; i < 2; ++i)
+                             {
+                                 volParam->updateFromAutomationSources (t);
+                                 panParam->updateFromAutomationSources (t);
+                             }
+                         }).join();
+
+            const auto macroValue = (float) (t.inSeconds() / 10.0);
+            CHECK_EQ (macroParam->getCurrentValue(), doctest::Approx (macroValue));
+            CHECK_EQ (volParam->valueRange.convertTo0to1 (volParam->getCurrentValue()), doctest::Approx (0.2f + 0.5f * macroValue));
+            CHECK_EQ (panParam->valueRange.convertTo0to1 (panParam->getCurrentValue()), doctest::Approx (0.8f - 0.5f * macroValue));
+        }
+    }
 }
 #endif
 
@@ -537,6 +576,206 @@ TEST_SUITE ("tracktion_engine")
 }
 #endif
 
+#if ENGINE_UNIT_TESTS_FOUR_OSC
+TEST_SUITE ("tracktion_engine")
+{
+    TEST_CASE ("FourOsc unison voices match separate oscillators")
+    {
+        constexpr double sampleRate = 44100.0;
+        constexpr int numSamples = 1024;
+        constexpr float note = 57.3f, detune = 0.4f, spread = 0.7f, pan = -0.2f, gain = 0.8f;
+
+        // This is how each unison voice used to be rendered, with an Oscillator per channel
+        auto renderSeparately = [] (Oscillator::Waves wave, int numVoices)
+        {
+            juce::AudioBuffer<float> buffer (2, numSamples);
+            buffer.clear();
+
+            for (int i = 0; i < numVoices * 2; ++i)
+            {
+                const int voiceIndex = i / 2;
+                const bool left = (i % 2) == 0;
+                const float localPan = numVoices == 1 ? pan : juce::jlimit (-1.0f, 1.0f, ((voiceIndex % 2 == 0) ? 1 : -1) * spread);
+                const float voiceNote = numVoices == 1 ? note : (note - detune / 2) + detune / (numVoices - 1) * voiceIndex;
+
+                Oscillator o;
+                o.setSampleRate (sampleRate);
+                o.setWave (wave);
+                o.setPulseWidth (0.3f);
+                o.setGain (gain * (left ? 1.0f - localPan : 1.0f + localPan) / numVoices);
+                o.setNote (voiceNote);
+
+                float* channels[] = { buffer.getWritePointer (left ? 0 : 1) };
+                juce::AudioBuffer<float> channelBuffer (channels, 1, numSamples);
+                o.process (channelBuffer, 0, numSamples);
+            }
+
+            return buffer;
+        };
+
+        for (auto wave : { Oscillator::sine, Oscillator::square, Oscillator::saw, Oscillator::triangle })
+        {
+            for (int numVoices : { 1, 2, 5, 8 })
+            {
+                MultiVoiceOscillator o;
+                o.setSampleRate (sampleRate);
+                o.setWave (wave);
+                o.setPulseWidth (0.3f);
+                o.setNote (note);
+                o.setGain (gain);
+                o.setPan (pan);
+                o.setNumVoices (numVoices);
+                o.setDetune (detune);
+                o.setSpread (spread);
+
+                juce::AudioBuffer<float> buffer (2, numSamples);
+                buffer.clear();
+
+                // Render in a few blocks to check the phases carry on
+                for (int start = 0; start < numSamples; start += 256)
+                    o.process (buffer, start, 256);
+
+                CHECK (graph::test_utilities::buffersAreEqual (buffer, renderSeparately (wave, numVoices), 1.0e-5f));
+            }
+        }
+    }
+
+    TEST_CASE ("FourOsc filter bank matches IIRFilter")
+    {
+        constexpr double sampleRate = 44100.0;
+        constexpr int numLanes = 11, numSamples = 100;
+        juce::Random r (42);
+
+        for (bool useSecondStage : { false, true })
+        {
+            juce::AudioBuffer<float> bankBuffer (numLanes, numSamples), referenceBuffer (numLanes, numSamples);
+            std::vector<FOFilterState> stage1 ((size_t) numLanes), stage2 ((size_t) numLanes);
+            std::vector<juce::IIRFilter> filter1 ((size_t) numLanes), filter2 ((size_t) numLanes);
+
+            for (int l = 0; l < numLanes; ++l)
+            {
+                const auto freq = 100.0 + r.nextDouble() * 10000.0;
+                const auto coefs1 = juce::IIRCoefficients::makeLowPass (sampleRate, freq, 0.5 + r.nextDouble() * 10.0);
+                const auto coefs2 = juce::IIRCoefficients::makeLowPass (sampleRate, freq, 0.70710678118655);
+
+                stage1[(size_t) l].setCoefficients (coefs1);
+                stage2[(size_t) l].setCoefficients (coefs2);
+                filter1[(size_t) l].setCoefficients (coefs1);
+                filter2[(size_t) l].setCoefficients (coefs2);
+
+                for (int i = 0; i < numSamples; ++i)
+                    bankBuffer.setSample (l, i, r.nextFloat() * 2.0f - 1.0f);
+            }
+
+            referenceBuffer.makeCopyOf (bankBuffer);
+
+            // Process two blocks to check the state is kept
+            for (int start : { 0, numSamples / 2 })
+            {
+                std::vector<FOFilterBank::Lane> lanes;
+
+                for (int l = 0; l < numLanes; ++l)
+                    lanes.push_back ({ bankBuffer.getWritePointer (l, start), &stage1[(size_t) l], &stage2[(size_t) l] });
+
+                FOFilterBank::process (lanes.data(), numLanes, numSamples / 2, useSecondStage);
+
+                for (int l = 0; l < numLanes; ++l)
+                {
+                    auto data = referenceBuffer.getWritePointer (l, start);
+                    filter1[(size_t) l].processSamples (data, numSamples / 2);
+
+                    if (useSecondStage)
+                    {
+                        for (int i = 0; i < numSamples / 2; ++i)
+                            data[i] = juce::jlimit (-1.0f, 1.0f, data[i]);
+
+                        filter2[(size_t) l].processSamples (data, numSamples / 2);
+                    }
+                }
+            }
+
+            CHECK (graph::test_utilities::buffersAreEqual (bankBuffer, referenceBuffer, 1.0e-5f));
+        }
+    }
+}
+#endif
+
+#if ENGINE_UNIT_TESTS_BIQUAD_CASCADE
+TEST_SUITE ("tracktion_engine")
+{
+    TEST_CASE ("BiquadCascade matches IIRFilters in series")
+    {
+        constexpr double sampleRate = 44100.0;
+        constexpr int numChannels = 2, numSamples = 2000;
+        juce::Random r (42);
+
+        for (int numStages : { 1, 2, 4, 5 })
+        {
+            BiquadCascade cascade;
+            cascade.prepare (numChannels, numStages);
+            std::vector<juce::IIRFilter> filters ((size_t) (numChannels * numStages));
+
+            for (int s = 0; s < numStages; ++s)
+            {
+                const auto freq = 50.0 + r.nextDouble() * 15000.0;
+                const auto coefs = (s % 2) == 0 ? juce::IIRCoefficients::makePeakFilter (sampleRate, freq, 0.5 + r.nextDouble(), 0.2f + r.nextFloat() * 4.0f)
+                                                : juce::IIRCoefficients::makeLowPass (sampleRate, freq);
+                cascade.setCoefficients (s, BiquadCascade::Coefficients::from (coefs), false);
+
+                for (int c = 0; c < numChannels; ++c)
+                    filters[(size_t) (s * numChannels + c)].setCoefficients (coefs);
+            }
+
+            juce::AudioBuffer<float> buffer (numChannels, numSamples), reference (numChannels, numSamples);
+
+            for (int c = 0; c < numChannels; ++c)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample (c, i, r.nextFloat() * 2.0f - 1.0f);
+
+            reference.makeCopyOf (buffer);
+
+            // Use some blocks shorter than the pipeline to check it fills and drains correctly
+            for (int start = 0; start < numSamples;)
+            {
+                const auto num = std::min (numSamples - start, r.nextBool() ? r.nextInt ({ 1, 4 }) : r.nextInt ({ 1, 300 }));
+                cascade.process (buffer, start, num);
+
+                for (int s = 0; s < numStages; ++s)
+                    for (int c = 0; c < numChannels; ++c)
+                        filters[(size_t) (s * numChannels + c)].processSamples (reference.getWritePointer (c, start), num);
+
+                start += num;
+            }
+
+            CHECK (graph::test_utilities::buffersAreEqual (buffer, reference, 1.0e-4f));
+        }
+    }
+
+    TEST_CASE ("BiquadCascade interpolates coefficients")
+    {
+        BiquadCascade cascade;
+        cascade.prepare (1, 1);
+
+        // A gain of 0.5 ramped to 1.5 over a block of DC should pass the ramp through
+        cascade.setCoefficients (0, { 0.5f, 0.0f, 0.0f, 0.0f, 0.0f }, false);
+        cascade.setCoefficients (0, { 1.5f, 0.0f, 0.0f, 0.0f, 0.0f });
+
+        juce::AudioBuffer<float> buffer (1, 100);
+        juce::FloatVectorOperations::fill (buffer.getWritePointer (0), 1.0f, 100);
+        cascade.process (buffer, 0, 100);
+
+        CHECK_EQ (buffer.getSample (0, 0), doctest::Approx (0.5f));
+        CHECK_EQ (buffer.getSample (0, 50), doctest::Approx (1.0f));
+        CHECK (buffer.getSample (0, 99) < 1.5f);
+
+        juce::FloatVectorOperations::fill (buffer.getWritePointer (0), 1.0f, 100);
+        cascade.process (buffer, 0, 100);
+        CHECK_EQ (buffer.getSample (0, 0), doctest::Approx (1.5f));
+        CHECK_EQ (buffer.getSample (0, 99), doctest::Approx (1.5f));
+    }
+}
+#endif
+
 } // namespace tracktion::inline engine
 
-#endif //TRACKTION_UNIT_TESTS
\ No newline at end of file
+#endif //TRACKTION_UNIT_TESTS
@@ -692,17 +692,34 @@ void Project::searchFor (juce::Array<ProjectItemID>& results, SearchOperation& s
     {
         ProjectSearchIndex psi (*this);
 
+        const juce::ScopedLock sl (objectLock);
+
+        // The index is the last section of the file, so map it directly and let
+        // the index decode only the posting lists the search actually touches
+        juce::MemoryMappedFile mappedIndex (file, { (juce::int64) indexOffset, file.getSize() },
+                                            juce::MemoryMappedFile::readOnly);
+
+        if (auto data = static_cast<const char*> (mappedIndex.getData()))
         {
-            const juce::ScopedLock sl (objectLock);
+            auto offsetInMap = (size_t) (indexOffset - mappedIndex.getRange().getStart());
 
-            if (auto in = getInputStream())
+            if (offsetInMap < mappedIndex.getSize()
+                 && psi.readFromMemory (data + offsetInMap, mappedIndex.getSize() - offsetInMap))
             {
-                in->setPosition (indexOffset);
-                psi.readFromStream (*in);
+                psi.findMatches (searchOp, results);
+                return;
             }
         }
 
-        psi.findMatches (searchOp, results);
+        if (auto in = getInputStream())
+        {
+            in->setPosition (indexOffset);
+
+            if (psi.readFromStream (*in))
+                psi.findMatches (searchOp, results);
+            else
+                TRACKTION_LOG_ERROR ("Couldn't read the search index of project: " + getName());
+        }
     }
 }
 
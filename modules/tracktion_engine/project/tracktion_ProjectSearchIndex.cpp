@@ -11,42 +11,234 @@
 namespace tracktion { inline namespace engine
 {
 
-struct IndexedWord
+namespace SearchIndexHelpers
 {
-    juce::String word;
-    std::vector<int> ids;
+    /** A negative first value distinguishes the versioned format from the legacy word count. */
+    static constexpr int formatVersion2 = -2;
+
+    static void writeVarInt (juce::MemoryOutputStream& out, uint32_t v)
+    {
+        while (v >= 0x80)
+        {
+            out.writeByte ((char) ((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+
+        out.writeByte ((char) v);
+    }
+
+    static bool readVarInt (const uint8_t*& data, const uint8_t* end, uint32_t& result)
+    {
+        result = 0;
+
+        for (int shift = 0; shift < 35 && data < end; shift += 7)
+        {
+            auto b = *data++;
+            result |= (uint32_t) (b & 0x7f) << shift;
+
+            if ((b & 0x80) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    /** Checks a posting list holds exactly numIDs well-formed varints, without decoding it. */
+    static bool isValidPostingList (const uint8_t* data, size_t numBytes, int numIDs)
+    {
+        int numFound = 0, runLength = 0;
+
+        for (size_t i = 0; i < numBytes; ++i)
+        {
+            if ((data[i] & 0x80) == 0)
+            {
+                ++numFound;
+                runLength = 0;
+            }
+            else if (++runLength >= 5)
+            {
+                return false;
+            }
+        }
+
+        return runLength == 0 && numFound == numIDs;
+    }
+
+    static int32_t readInt (const uint8_t*& data)
+    {
+        auto v = (int32_t) juce::ByteOrder::littleEndianInt (data);
+        data += sizeof (int32_t);
+        return v;
+    }
+
+    static void unionInto (std::vector<int>& dest, const std::vector<int>& other)
+    {
+        if (other.empty())
+            return;
+
+        if (dest.empty())
+        {
+            dest = other;
+            return;
+        }
+
+        std::vector<int> result;
+        result.reserve (dest.size() + other.size());
+        std::set_union (dest.begin(), dest.end(), other.begin(), other.end(), std::back_inserter (result));
+        dest = std::move (result);
+    }
+
+    /** Intersects two sorted lists. When one list is much shorter than the
+        other, the longer one is galloped through rather than walked linearly.
+    */
+    static std::vector<int> intersect (const std::vector<int>& a, const std::vector<int>& b)
+    {
+        auto& small = a.size() <= b.size() ? a : b;
+        auto& large = a.size() <= b.size() ? b : a;
+
+        std::vector<int> result;
+
+        if (small.empty())
+            return result;
+
+        result.reserve (small.size());
+
+        if (large.size() < small.size() * 16)
+        {
+            std::set_intersection (small.begin(), small.end(), large.begin(), large.end(), std::back_inserter (result));
+            return result;
+        }
+
+        auto pos = large.begin();
+
+        for (auto id : small)
+        {
+            size_t step = 1;
+            auto lo = pos;
+
+            // Compare against the distance left so the iterators never go past the end
+            while (step < (size_t) std::distance (lo, large.end()) && *(lo + (std::ptrdiff_t) step) < id)
+            {
+                lo += (std::ptrdiff_t) step;
+                step *= 2;
+            }
+
+            auto hi = lo + (std::ptrdiff_t) std::min (step + 1, (size_t) std::distance (lo, large.end()));
+            pos = std::lower_bound (lo, hi, id);
+
+            if (pos == large.end())
+                break;
+
+            if (*pos == id)
+                result.push_back (id);
+        }
+
+        return result;
+    }
 
-    IndexedWord (juce::InputStream& in)  : word (in.readString())
+    static std::vector<int> subtract (const std::vector<int>& a, const std::vector<int>& b)
     {
-        auto numIDs = in.readShort();
-        ids.resize ((size_t) numIDs);
-        in.read (ids.data(), (int) sizeof (int) * numIDs);
+        std::vector<int> result;
+        result.reserve (a.size());
+        std::set_difference (a.begin(), a.end(), b.begin(), b.end(), std::back_inserter (result));
+        return result;
     }
+}
+
+//==============================================================================
+struct IndexedWord
+{
+    juce::String word;
 
     IndexedWord (const juce::String& w, int id) : word (w)
     {
         ids.push_back (id);
     }
 
+    IndexedWord (const juce::String& w, std::vector<int> sortedIDs)
+        : word (w), ids (std::move (sortedIDs))
+    {
+    }
+
+    IndexedWord (const juce::String& w, const uint8_t* encoded, size_t encodedSize, int numIDs)
+        : word (w), encodedData (encoded), encodedNumBytes (encodedSize), numEncodedIDs (numIDs)
+    {
+    }
+
+    /** Returns the sorted posting list, decoding it first if it was read from memory. */
+    const std::vector<int>& getIDs()
+    {
+        if (encodedData != nullptr)
+        {
+            ids.clear();
+            ids.reserve ((size_t) numEncodedIDs);
+
+            auto d = encodedData;
+            auto end = encodedData + encodedNumBytes;
+            uint32_t last = 0;
+
+            for (int i = 0; i < numEncodedIDs; ++i)
+            {
+                uint32_t delta = 0;
+
+                if (! SearchIndexHelpers::readVarInt (d, end, delta))
+                {
+                    // readFromMemory should have rejected a malformed list
+                    jassertfalse;
+                    break;
+                }
+
+                last += delta;
+                ids.push_back ((int) last);
+            }
+
+            encodedData = nullptr;
+        }
+
+        return ids;
+    }
+
     void writeToStream (juce::OutputStream& out)
     {
+        auto& sortedIDs = getIDs();
+
+        juce::MemoryOutputStream encoded;
+        uint32_t last = 0;
+
+        for (auto id : sortedIDs)
+        {
+            SearchIndexHelpers::writeVarInt (encoded, (uint32_t) id - last);
+            last = (uint32_t) id;
+        }
+
         out.writeString (word);
-        out.writeShort ((short) ids.size());
-        out.write (ids.data(), ids.size() * sizeof (int));
+        out.writeInt ((int) sortedIDs.size());
+        out.writeInt ((int) encoded.getDataSize());
+        out.write (encoded.getData(), encoded.getDataSize());
     }
 
     void addID (int id)
     {
-        for (auto i : ids)
-            if (i == id)
-                return;
+        getIDs();
 
-        if (ids.size() > 32766)
+        if (ids.empty() || id > ids.back())
+        {
+            ids.push_back (id);
             return;
+        }
 
-        ids.push_back (id);
+        auto pos = std::lower_bound (ids.begin(), ids.end(), id);
+
+        if (*pos != id)
+            ids.insert (pos, id);
     }
 
+private:
+    std::vector<int> ids;
+    const uint8_t* encodedData = nullptr;
+    size_t encodedNumBytes = 0;
+    int numEncodedIDs = 0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IndexedWord)
 };
 
@@ -55,6 +247,10 @@ ProjectSearchIndex::ProjectSearchIndex (Project& p) : project (p)
 {
 }
 
+ProjectSearchIndex::~ProjectSearchIndex()
+{
+}
+
 static bool isNoiseWord (const juce::String& word)
 {
     return     word == "a"
@@ -86,6 +282,13 @@ static bool isNoiseWord (const juce::String& word)
             || word == "but";
 }
 
+int ProjectSearchIndex::findInsertIndex (const juce::String& word) const
+{
+    return (int) std::distance (index.begin(),
+                                std::lower_bound (index.begin(), index.end(), word,
+                                                  [] (IndexedWord* w, const juce::String& s) { return w->word < s; }));
+}
+
 void ProjectSearchIndex::addClip (const ProjectItem::Ptr& item)
 {
     if (item != nullptr)
@@ -96,17 +299,12 @@ void ProjectSearchIndex::addClip (const ProjectItem::Ptr& item)
 
             if (! (word.isEmpty() || isNoiseWord (word)))
             {
-                if (auto w = findWordMatch (word))
-                {
+                auto insertIndex = findInsertIndex (word);
+
+                if (auto w = index[insertIndex]; w != nullptr && w->word == word)
                     w->addID (item->getID().getItemID());
-                }
                 else
-                {
-                    index.add (new IndexedWord (word, item->getID().getItemID()));
-
-                    std::sort (index.begin(), index.end(),
-                               [] (IndexedWord* a, IndexedWord* b) { return a->word < b->word; });
-                }
+                    index.insert (insertIndex, new IndexedWord (word, item->getID().getItemID()));
             }
         }
     }
@@ -114,52 +312,159 @@ void ProjectSearchIndex::addClip (const ProjectItem::Ptr& item)
 
 void ProjectSearchIndex::writeToStream (juce::OutputStream& out)
 {
+    out.writeInt (SearchIndexHelpers::formatVersion2);
     out.writeInt (index.size());
 
     for (auto&& i : index)
         i->writeToStream (out);
 }
 
-void ProjectSearchIndex::readFromStream (juce::InputStream& in)
+bool ProjectSearchIndex::readFromStream (juce::InputStream& in)
 {
     index.clear();
+    ownedData.reset();
+
+    auto numWords = in.readInt();
+
+    if (numWords == SearchIndexHelpers::formatVersion2)
+    {
+        // Keep the format header so the memory reader can validate it
+        juce::MemoryOutputStream mo (ownedData, false);
+        mo.writeInt (numWords);
+        mo.writeFromInputStream (in, -1);
+        mo.flush();
+
+        if (readFromMemory (ownedData.getData(), ownedData.getSize()))
+            return true;
+
+        ownedData.reset();
+        return false;
+    }
+
+    if (numWords < 0)
+        return false;
 
-    for (int i = in.readInt(); --i >= 0;)
-        index.add (new IndexedWord (in));
+    // Legacy format: unsorted IDs stored as raw ints with a 16-bit count
+    for (int i = numWords; --i >= 0;)
+    {
+        if (in.isExhausted())
+        {
+            index.clear();
+            return false;
+        }
+
+        auto word = in.readString();
+        auto numIDs = (int) (uint16_t) in.readShort();
+
+        std::vector<int> ids ((size_t) numIDs);
+        const auto numBytes = (int) sizeof (int) * numIDs;
+
+        if (in.read (ids.data(), numBytes) != numBytes)
+        {
+            index.clear();
+            return false;
+        }
+
+        for (auto& id : ids)
+            id = (int) juce::ByteOrder::swapIfBigEndian ((uint32_t) id);
+
+        std::sort (ids.begin(), ids.end());
+        ids.erase (std::unique (ids.begin(), ids.end()), ids.end());
+
+        index.insert (findInsertIndex (word), new IndexedWord (word, std::move (ids)));
+    }
+
+    return true;
 }
 
-IndexedWord* ProjectSearchIndex::findWordMatch (const juce::String& word) const
+bool ProjectSearchIndex::readFromMemory (const void* data, size_t numBytes)
 {
-    int start = 0;
-    int end = index.size();
+    index.clear();
+
+    auto d = static_cast<const uint8_t*> (data);
+    auto end = d + numBytes;
+
+    if (numBytes < 2 * sizeof (int32_t)
+         || SearchIndexHelpers::readInt (d) != SearchIndexHelpers::formatVersion2)
+        return false;
+
+    auto numWords = SearchIndexHelpers::readInt (d);
+
+    if (numWords < 0)
+        return false;
 
-    for (;;)
+    index.ensureStorageAllocated (numWords);
+
+    for (int i = 0; i < numWords; ++i)
     {
-        if (start >= end)
-            break;
+        auto terminator = std::find (d, end, (uint8_t) 0);
 
-        auto w = index.getUnchecked (start);
+        if (terminator == end || (size_t) (end - terminator) < 1 + 2 * sizeof (int32_t))
+        {
+            index.clear();
+            return false;
+        }
 
-        if (word == w->word)
-            return w;
+        auto word = juce::String::fromUTF8 (reinterpret_cast<const char*> (d), (int) (terminator - d));
+        d = terminator + 1;
 
-        const int halfway = (start + end) >> 1;
+        auto numIDs = SearchIndexHelpers::readInt (d);
+        auto encodedSize = SearchIndexHelpers::readInt (d);
 
-        if (halfway == start)
-            break;
+        if (numIDs < 0 || encodedSize < 0 || encodedSize > end - d
+             || ! SearchIndexHelpers::isValidPostingList (d, (size_t) encodedSize, numIDs))
+        {
+            index.clear();
+            return false;
+        }
 
-        if (word.compare (index[halfway]->word) >= 0)
-            start = halfway;
-        else
-            end = halfway;
+        // Words are written in sorted order so can simply be appended
+        index.add (new IndexedWord (word, d, (size_t) encodedSize, numIDs));
+        d += encodedSize;
     }
 
+    return true;
+}
+
+IndexedWord* ProjectSearchIndex::findWordMatch (const juce::String& word) const
+{
+    if (auto w = index[findInsertIndex (word)]; w != nullptr && w->word == word)
+        return w;
+
     return {};
 }
 
+std::vector<int> ProjectSearchIndex::getIDsForWord (const juce::String& word) const
+{
+    if (auto w = findWordMatch (word))
+        return w->getIDs();
+
+    return {};
+}
+
+std::vector<int> ProjectSearchIndex::getIDsForPrefix (const juce::String& prefix) const
+{
+    std::vector<int> found;
+
+    for (int i = findInsertIndex (prefix); i < index.size(); ++i)
+    {
+        auto w = index.getUnchecked (i);
+
+        if (! w->word.startsWith (prefix))
+            break;
+
+        SearchIndexHelpers::unionInto (found, w->getIDs());
+    }
+
+    return found;
+}
+
 void ProjectSearchIndex::findMatches (SearchOperation& search, juce::Array<ProjectItemID>& results)
 {
-    for (auto& res : search.getMatches (*this))
+    auto matches = search.getMatches (*this);
+    results.ensureStorageAllocated (results.size() + (int) matches.size());
+
+    for (auto res : matches)
         results.add (ProjectItemID (res, project.getProjectID()));
 }
 
@@ -178,38 +483,34 @@ struct WordMatchOperation : public SearchOperation
 {
     WordMatchOperation (const juce::String& w) : word (w.toLowerCase().trim()) {}
 
-    juce::Array<int> getMatches (ProjectSearchIndex& psi) override
+    std::vector<int> getMatches (ProjectSearchIndex& psi) override
     {
-        juce::Array<int> found;
+        return psi.getIDsForWord (word);
+    }
+
+    juce::String word;
+};
 
-        if (auto w = psi.findWordMatch (word))
-            for (auto id : w->ids)
-                found.add (id);
+struct PrefixMatchOperation : public SearchOperation
+{
+    PrefixMatchOperation (const juce::String& p) : prefix (p.toLowerCase().trim()) {}
 
-        return found;
+    std::vector<int> getMatches (ProjectSearchIndex& psi) override
+    {
+        return psi.getIDsForPrefix (prefix);
     }
 
-    juce::String word;
+    juce::String prefix;
 };
 
 struct OrOperation : public SearchOperation
 {
     OrOperation (SearchOperation* a, SearchOperation* b)  : SearchOperation (a, b) {}
 
-    juce::Array<int> getMatches (ProjectSearchIndex& psi) override
+    std::vector<int> getMatches (ProjectSearchIndex& psi) override
     {
         auto i1 = in1->getMatches (psi);
-        auto i2 = in2->getMatches (psi);
-
-        if (i1.isEmpty())
-            return i2;
-
-        if (i2.isEmpty())
-            return i1;
-
-        for (int i = i2.size(); --i >= 0;)
-            i1.addIfNotAlreadyThere (i2[i]);
-
+        SearchIndexHelpers::unionInto (i1, in2->getMatches (psi));
         return i1;
     }
 };
@@ -218,20 +519,14 @@ struct AndOperation : public SearchOperation
 {
     AndOperation (SearchOperation* a, SearchOperation* b) : SearchOperation (a, b) {}
 
-    juce::Array<int> getMatches (ProjectSearchIndex& psi) override
+    std::vector<int> getMatches (ProjectSearchIndex& psi) override
     {
         auto i1 = in1->getMatches (psi);
 
-        if (i1.isEmpty())
+        if (i1.empty())
             return i1;
 
-        auto i2 = in2->getMatches (psi);
-
-        if (i2.isEmpty())
-            return i2;
-
-        i1.removeValuesNotIn (i2);
-        return i1;
+        return SearchIndexHelpers::intersect (i1, in2->getMatches (psi));
     }
 };
 
@@ -239,20 +534,20 @@ struct NotOperation : public SearchOperation
 {
     NotOperation (SearchOperation* in) : SearchOperation (in, nullptr) {}
 
-    juce::Array<int> getMatches (ProjectSearchIndex& psi)
+    std::vector<int> getMatches (ProjectSearchIndex& psi) override
     {
-        juce::Array<int> i1;
-
-        i1 = psi.project.getAllItemIDs();
-        i1.removeValuesIn (in1->getMatches (psi));
+        auto all = psi.project.getAllItemIDs();
+        std::vector<int> allIDs (all.begin(), all.end());
+        std::sort (allIDs.begin(), allIDs.end());
+        allIDs.erase (std::unique (allIDs.begin(), allIDs.end()), allIDs.end());
 
-        return i1;
+        return SearchIndexHelpers::subtract (allIDs, in1->getMatches (psi));
     }
 };
 
 struct FalseOperation  : public SearchOperation
 {
-    juce::Array<int> getMatches (ProjectSearchIndex&) override
+    std::vector<int> getMatches (ProjectSearchIndex&) override
     {
         return {};
     }
@@ -356,6 +651,16 @@ inline SearchOperation* createCondition (const juce::StringArray& words, int sta
         if (words[start] == TRANS("All"))
             return new NotOperation (new FalseOperation());
 
+        if (words[start].endsWithChar ('*'))
+        {
+            auto prefix = words[start].trimCharactersAtEnd ("*");
+
+            if (prefix.isEmpty())
+                return new NotOperation (new FalseOperation());
+
+            return new PrefixMatchOperation (prefix);
+        }
+
         return createPluralOptions (words[start]);
     }
 
@@ -391,7 +696,7 @@ SearchOperation* createSearchForKeywords (const juce::String& keywords)
     auto k = keywords.toLowerCase()
                 .replace ("-", " " + TRANS("Not") + " ")
                 .replace ("+", " " + TRANS("And") + " ")
-                .retainCharacters (juce::CharPointer_UTF8 ("abcdefghijklmnopqrstuvwxyz0123456789\xc3\xa0\xc3\xa1\xc3\xa2\xc3\xa3\xc3\xa4\xc3\xa5\xc3\xa6\xc3\xa7\xc3\xa8\xc3\xa9\xc3\xaa\xc3\xab\xc3\xac\xc3\xad\xc3\xae\xc3\xaf\xc3\xb0\xc3\xb1\xc3\xb2\xc3\xb3\xc3\xb4\xc3\xb5\xc3\xb6\xc3\xb8\xc3\xb9\xc3\xba\xc3\xbb\xc3\xbc\xc3\xbd\xc3\xbf\xc3\x9f"))
+                .retainCharacters (juce::CharPointer_UTF8 ("abcdefghijklmnopqrstuvwxyz0123456789*\xc3\xa0\xc3\xa1\xc3\xa2\xc3\xa3\xc3\xa4\xc3\xa5\xc3\xa6\xc3\xa7\xc3\xa8\xc3\xa9\xc3\xaa\xc3\xab\xc3\xac\xc3\xad\xc3\xae\xc3\xaf\xc3\xb0\xc3\xb1\xc3\xb2\xc3\xb3\xc3\xb4\xc3\xb5\xc3\xb6\xc3\xb8\xc3\xb9\xc3\xba\xc3\xbb\xc3\xbc\xc3\xbd\xc3\xbf\xc3\x9f"))
                 .trim();
 
     juce::StringArray words;
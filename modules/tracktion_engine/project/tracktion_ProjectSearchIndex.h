@@ -15,27 +15,62 @@ struct IndexedWord;
 class SearchOperation;
 
 //==============================================================================
+/**
+    An inverted index of the search tokens of the items in a Project.
+
+    Words are kept in a sorted dictionary so exact and prefix lookups are both
+    binary searches. Each word has a sorted, duplicate-free posting list of item
+    IDs which is stored on disk as delta-encoded varints.
+
+    An index can be read back from a stream or directly from a block of memory
+    (e.g. a memory-mapped project file). When read from memory, posting lists
+    are only decoded for words that are actually queried.
+*/
 class ProjectSearchIndex
 {
 public:
     ProjectSearchIndex (Project&);
+    ~ProjectSearchIndex();
 
     void addClip (const ProjectItem::Ptr&);
     void findMatches (SearchOperation&, juce::Array<ProjectItemID>& results);
 
     void writeToStream (juce::OutputStream&);
-    void readFromStream (juce::InputStream&);
+
+    /** Reads an index written by writeToStream, or by older versions.
+        Returns false if the data isn't a valid index, in which case the index is left empty.
+    */
+    bool readFromStream (juce::InputStream&);
+
+    /** Reads an index from a block of memory.
+        The data must stay valid for as long as this index is in use, as posting
+        lists are decoded from it lazily. Returns false if the data isn't a valid index.
+    */
+    bool readFromMemory (const void* data, size_t numBytes);
 
     IndexedWord* findWordMatch (const juce::String& word) const;
 
+    /** Returns the sorted IDs of items containing the given word. */
+    std::vector<int> getIDsForWord (const juce::String& word) const;
+
+    /** Returns the sorted IDs of items containing any word starting with the given prefix. */
+    std::vector<int> getIDsForPrefix (const juce::String& prefix) const;
+
     Project& project;
     juce::OwnedArray<IndexedWord> index;
 
+private:
+    juce::MemoryBlock ownedData;
+
+    int findInsertIndex (const juce::String& word) const;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProjectSearchIndex)
 };
 
 //==============================================================================
-/** Turns a keyword string into a search condition tree. */
+/** Turns a keyword string into a search condition tree.
+    A word ending in '*' matches any indexed word starting with that prefix.
+*/
 SearchOperation* createSearchForKeywords (const juce::String& keywords);
 
 //==============================================================================
@@ -46,7 +81,8 @@ public:
                      SearchOperation* in2 = nullptr);
     virtual ~SearchOperation();
 
-    virtual juce::Array<int> getMatches (ProjectSearchIndex&) = 0;
+    /** Returns the sorted, duplicate-free IDs of the items matching this operation. */
+    virtual std::vector<int> getMatches (ProjectSearchIndex&) = 0;
 
 protected:
     const std::unique_ptr<SearchOperation> in1, in2;
@@ -0,0 +1,194 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_PROJECT_SEARCH_INDEX
+
+//==============================================================================
+//==============================================================================
+class ProjectSearchIndexTests   : public juce::UnitTest
+{
+public:
+    ProjectSearchIndexTests()
+        : juce::UnitTest ("ProjectSearchIndex", "tracktion_engine")
+    {
+    }
+
+    void runTest() override
+    {
+        auto& engine = *Engine::getEngines().getFirst();
+        juce::TemporaryFile tempProjectFile (projectFileSuffix);
+        ProjectManager::TempProject tempProject (engine.getProjectManager(), tempProjectFile.getFile(), true);
+        expect (tempProject.project != nullptr);
+
+        if (tempProject.project == nullptr)
+            return;
+
+        auto& project = *tempProject.project;
+
+        auto addItem = [&] (const juce::String& name)
+        {
+            auto file = tempProjectFile.getFile().getSiblingFile (name + ".wav");
+            return project.createNewItem (file, ProjectItem::waveItemType(), name, {},
+                                          ProjectItem::Category::imported, false)->getID().getItemID();
+        };
+
+        const auto kick = addItem ("Kick Drum Loop");
+        const auto snare = addItem ("Snare Drum");
+        const auto bass = addItem ("Bass Guitar");
+        const auto piano = addItem ("Electric Piano");
+
+        ProjectSearchIndex index (project);
+
+        for (int i = 0; i < project.getNumProjectItems(); ++i)
+            index.addClip (project.getProjectItemAt (i));
+
+        beginTest ("Word and prefix matches");
+        {
+            expect (search (index, "drum") == sorted ({ kick, snare }));
+            expect (search (index, "drums") == sorted ({ kick, snare }));
+            expect (search (index, "guitar") == sorted ({ bass }));
+            expect (search (index, "violin").empty());
+            expect (search (index, "dru*") == sorted ({ kick, snare }));
+            expect (search (index, "el*") == sorted ({ piano }));
+            expect (search (index, "*") == sorted ({ kick, snare, bass, piano }));
+        }
+
+        beginTest ("AND, OR and NOT");
+        {
+            expect (search (index, "kick+drum") == sorted ({ kick }));
+            expect (search (index, "drum -snare") == sorted ({ kick }));
+            expect (search (index, "-drum") == sorted ({ bass, piano }));
+
+            expect (matches (index, OrOperation (new WordMatchOperation ("bass"), new WordMatchOperation ("snare")))
+                     == sorted ({ snare, bass }));
+            expect (matches (index, AndOperation (new WordMatchOperation ("drum"), new WordMatchOperation ("loop")))
+                     == sorted ({ kick }));
+            expect (matches (index, NotOperation (new OrOperation (new WordMatchOperation ("drum"), new WordMatchOperation ("bass"))))
+                     == sorted ({ piano }));
+        }
+
+        beginTest ("Round trip");
+        {
+            juce::MemoryOutputStream out;
+            index.writeToStream (out);
+
+            ProjectSearchIndex fromStream (project);
+            juce::MemoryInputStream in (out.getData(), out.getDataSize(), false);
+            expect (fromStream.readFromStream (in));
+
+            ProjectSearchIndex fromMemory (project);
+            expect (fromMemory.readFromMemory (out.getData(), out.getDataSize()));
+
+            for (auto keywords : { "drum", "dru*", "kick+drum", "drum -snare", "guitar" })
+            {
+                expect (search (fromStream, keywords) == search (index, keywords));
+                expect (search (fromMemory, keywords) == search (index, keywords));
+            }
+        }
+
+        beginTest ("Legacy format");
+        {
+            juce::MemoryOutputStream out;
+            out.writeInt (2);
+
+            out.writeString ("drum");
+            out.writeShort (3);
+            out.writeInt (snare);
+            out.writeInt (kick);
+            out.writeInt (snare);
+
+            out.writeString ("bass");
+            out.writeShort (1);
+            out.writeInt (bass);
+
+            ProjectSearchIndex legacy (project);
+            juce::MemoryInputStream in (out.getData(), out.getDataSize(), false);
+            expect (legacy.readFromStream (in));
+            expect (legacy.getIDsForWord ("drum") == sorted ({ kick, snare }));
+            expect (search (legacy, "bass") == sorted ({ bass }));
+        }
+
+        beginTest ("Malformed data is rejected");
+        {
+            juce::MemoryOutputStream out;
+            index.writeToStream (out);
+
+            ProjectSearchIndex truncated (project);
+            juce::MemoryInputStream in (out.getData(), out.getDataSize() - 3, false);
+            expect (! truncated.readFromStream (in));
+            expect (truncated.index.isEmpty());
+
+            auto createSingleWord = [] (int numIDs, std::initializer_list<uint8_t> encoded)
+            {
+                juce::MemoryBlock block;
+                juce::MemoryOutputStream mo (block, false);
+                mo.writeInt (-2);
+                mo.writeInt (1);
+                mo.writeString ("drum");
+                mo.writeInt (numIDs);
+                mo.writeInt ((int) encoded.size());
+
+                for (auto b : encoded)
+                    mo.writeByte ((char) b);
+
+                mo.flush();
+                return block;
+            };
+
+            ProjectSearchIndex badIndex (project);
+            auto valid = createSingleWord (2, { 0x81, 0x01, 0x02 });
+            expect (badIndex.readFromMemory (valid.getData(), valid.getSize()));
+            expect (badIndex.getIDsForWord ("drum") == std::vector<int> { 129, 131 });
+
+            auto overlong = createSingleWord (1, { 0xff, 0xff, 0xff, 0xff, 0xff, 0x01 });
+            expect (! badIndex.readFromMemory (overlong.getData(), overlong.getSize()));
+
+            auto unterminated = createSingleWord (1, { 0x81 });
+            expect (! badIndex.readFromMemory (unterminated.getData(), unterminated.getSize()));
+
+            auto wrongCount = createSingleWord (2, { 0x01 });
+            expect (! badIndex.readFromMemory (wrongCount.getData(), wrongCount.getSize()));
+        }
+    }
+
+    static std::vector<int> sorted (std::vector<int> ids)
+    {
+        std::sort (ids.begin(), ids.end());
+        return ids;
+    }
+
+    static std::vector<int> matches (ProjectSearchIndex& index, SearchOperation&& op)
+    {
+        juce::Array<ProjectItemID> results;
+        index.findMatches (op, results);
+
+        std::vector<int> ids;
+
+        for (auto& r : results)
+            ids.push_back (r.getItemID());
+
+        return sorted (std::move (ids));
+    }
+
+    static std::vector<int> search (ProjectSearchIndex& index, const juce::String& keywords)
+    {
+        std::unique_ptr<SearchOperation> op (createSearchForKeywords (keywords));
+        return matches (index, std::move (*op));
+    }
+};
+
+static ProjectSearchIndexTests projectSearchIndexTests;
+
+#endif
+
+}} // namespace tracktion { inline namespace engine
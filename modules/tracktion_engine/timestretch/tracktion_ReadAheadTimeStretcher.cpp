@@ -13,82 +13,122 @@ namespace tracktion::inline engine
 
 //==============================================================================
 //==============================================================================
-ReadAheadTimeStretcher::ProcessThread::ProcessThread()
+ReadAheadTimeStretcher::ProcessThreadPool::ProcessThreadPool()
 {
-    thread = std::thread ([this] { process(); });
+    // Leave some cores free for the audio and graph threads
+    const auto numThreads = juce::jlimit (1, 8, juce::SystemStats::getNumCpus() / 2);
+
+    for (int i = 0; i < numThreads; ++i)
+        threads.emplace_back ([this] { process(); });
 }
 
-ReadAheadTimeStretcher::ProcessThread::~ProcessThread()
+ReadAheadTimeStretcher::ProcessThreadPool::~ProcessThreadPool()
 {
     waitingToExitFlag.test_and_set();
     event.signal();
-    thread.join();
+
+    for (auto& t : threads)
+        t.join();
 }
 
-void ReadAheadTimeStretcher::ProcessThread::addInstance (ReadAheadTimeStretcher* instance)
+void ReadAheadTimeStretcher::ProcessThreadPool::addInstance (ReadAheadTimeStretcher* instance)
 {
-    breakForAddRemoveInstance.test_and_set();
-
     const std::unique_lock sl (instancesMutex);
     instances.emplace_back (instance);
-
-    breakForAddRemoveInstance.clear();
 }
 
-void ReadAheadTimeStretcher::ProcessThread::removeInstance (ReadAheadTimeStretcher* instance)
+void ReadAheadTimeStretcher::ProcessThreadPool::removeInstance (ReadAheadTimeStretcher* instance)
 {
-    breakForAddRemoveInstance.test_and_set();
-
-    const std::unique_lock sl (instancesMutex);
-    std::erase_if (instances, [&] (auto& i) { return i == instance; });
+    {
+        const std::unique_lock sl (instancesMutex);
+        std::erase_if (instances, [&] (auto& i) { return i == instance; });
+    }
 
-    breakForAddRemoveInstance.clear();
+    // Instances can only be claimed whilst in the list so wait for any in-flight processing to finish
+    while (instance->isClaimedForProcessing.test (std::memory_order_acquire))
+        std::this_thread::yield();
 }
 
-void ReadAheadTimeStretcher::ProcessThread::flagForProcessing (std::atomic<std::uint64_t>& epoch)
+void ReadAheadTimeStretcher::ProcessThreadPool::flagForProcessing (ReadAheadTimeStretcher& instance)
 {
-    epoch = processEpoch.load (std::memory_order_acquire);
+    instance.needsProcessing.store (true, std::memory_order_release);
     event.signal();
 }
 
+ReadAheadTimeStretcher::PoolStats ReadAheadTimeStretcher::ProcessThreadPool::getStats() const
+{
+    return { (int) threads.size(), maxNumProcessingAtOnce.load (std::memory_order_relaxed) };
+}
+
 //==============================================================================
-void ReadAheadTimeStretcher::ProcessThread::process()
+ReadAheadTimeStretcher* ReadAheadTimeStretcher::ProcessThreadPool::claimMostUrgentInstance()
+{
+    const std::unique_lock sl (instancesMutex);
+
+    ReadAheadTimeStretcher* mostUrgent = nullptr;
+    float lowestNumBlocksReady = std::numeric_limits<float>::max();
+
+    for (auto instance : instances)
+    {
+        if (! instance->needsProcessing.load (std::memory_order_acquire)
+            || instance->isClaimedForProcessing.test (std::memory_order_acquire))
+            continue;
+
+        const auto numBlocksReady = instance->outputFifo.getNumReady() / (float) std::max (1, instance->numSamplesPerOutputBlock);
+
+        if (numBlocksReady < lowestNumBlocksReady)
+        {
+            lowestNumBlocksReady = numBlocksReady;
+            mostUrgent = instance;
+        }
+    }
+
+    if (mostUrgent != nullptr)
+    {
+        mostUrgent->isClaimedForProcessing.test_and_set (std::memory_order_acq_rel);
+        mostUrgent->needsProcessing.store (false, std::memory_order_release);
+    }
+
+    return mostUrgent;
+}
+
+void ReadAheadTimeStretcher::ProcessThreadPool::process()
 {
     for (;;)
     {
         if (waitingToExitFlag.test (std::memory_order_acquire))
+        {
+            // Pass the wake-up on so the other threads can exit too
+            event.signal();
             return;
+        }
 
-        bool anyInstancesProcessed = false;
-
+        if (auto instance = claimMostUrgentInstance())
         {
-            const std::unique_lock sl (instancesMutex);
-            const auto currentEpoch = processEpoch.load (std::memory_order_acquire);
+            // Wake another thread in case there are more instances waiting
+            event.signal();
 
-            for (auto instance : instances)
-            {
-                if (waitingToExitFlag.test (std::memory_order_acquire))
-                    return;
+            const auto numNowProcessing = numProcessing.fetch_add (1, std::memory_order_acq_rel) + 1;
+            auto maxNum = maxNumProcessingAtOnce.load (std::memory_order_relaxed);
 
-                if (breakForAddRemoveInstance.test (std::memory_order_acquire))
-                {
-                    anyInstancesProcessed = false; // Run again asap
-                    break;
-                }
+            while (numNowProcessing > maxNum
+                   && ! maxNumProcessingAtOnce.compare_exchange_weak (maxNum, numNowProcessing, std::memory_order_relaxed))
+            {}
 
-                // Skip unflagged instances
-                if (instance->getEpoch() > currentEpoch)
-                    continue;
+            if (instance->processNextBlock (false) > 0)
+            {
+                instance->numBlocksProcessedInBackground.fetch_add (1, std::memory_order_relaxed);
 
-                if (instance->processNextBlock (false))
-                     anyInstancesProcessed = true;
+                // There may be space for more so check this one again
+                instance->needsProcessing.store (true, std::memory_order_release);
             }
-        }
 
-        processEpoch.fetch_add (1, std::memory_order_release);
+            numProcessing.fetch_sub (1, std::memory_order_acq_rel);
+            instance->isClaimedForProcessing.clear (std::memory_order_release);
+            continue;
+        }
 
-        if (! anyInstancesProcessed)
-            event.wait (-1);
+        event.wait (-1);
     }
 }
 
@@ -102,7 +142,7 @@ ReadAheadTimeStretcher::ReadAheadTimeStretcher (int numBlocksToReadAhead_)
 
 ReadAheadTimeStretcher::~ReadAheadTimeStretcher()
 {
-    processThread->removeInstance (this);
+    processThreadPool->removeInstance (this);
 }
 
 void ReadAheadTimeStretcher::initialise (double sourceSampleRate, int samplesPerBlock,
@@ -121,7 +161,7 @@ void ReadAheadTimeStretcher::initialise (double sourceSampleRate, int samplesPer
     if (! isInitialised())
         return;
 
-    processThread->addInstance (this);
+    processThreadPool->addInstance (this);
     inputFifo.setSize (numChannels, getMaxFramesNeeded() + 1);
     assert (inputFifo.getFreeSpace() >= getMaxFramesNeeded());
     outputFifo.setSize (numChannels, samplesPerBlock * numBlocksToReadAhead);
@@ -195,12 +235,24 @@ int ReadAheadTimeStretcher::pushData (const float* const* inChannels, int numSam
 {
     assert (inputFifo.getFreeSpace() >= numSamples);
     inputFifo.write (inChannels, numSamples);
-    processThread->flagForProcessing (epoch);
+    processThreadPool->flagForProcessing (*this);
     hasBeenReset.store (false, std::memory_order_release);
 
     return numSamples;
 }
 
+ReadAheadTimeStretcher::Stats ReadAheadTimeStretcher::getStats() const
+{
+    return { numBlocksPopped.load (std::memory_order_relaxed),
+             numBlocksStarved.load (std::memory_order_relaxed),
+             numBlocksProcessedInBackground.load (std::memory_order_relaxed) };
+}
+
+ReadAheadTimeStretcher::PoolStats ReadAheadTimeStretcher::getPoolStats() const
+{
+    return processThreadPool->getStats();
+}
+
 int ReadAheadTimeStretcher::getNumReady() const
 {
     return outputFifo.getNumReady();
@@ -209,9 +261,13 @@ int ReadAheadTimeStretcher::getNumReady() const
 int ReadAheadTimeStretcher::popData (float* const* outChannels, int numSamples)
 {
     assert (numSamples <= numSamplesPerOutputBlock || numSamples <= getNumReady());
+    numBlocksPopped.fetch_add (1, std::memory_order_relaxed);
 
     if (outputFifo.getNumReady() <= numSamples)
     {
+        if (outputFifo.getNumReady() < numSamples)
+            numBlocksStarved.fetch_add (1, std::memory_order_relaxed);
+
         [[ maybe_unused ]] const int numPopped = processNextBlock (true);
         assert (numPopped > 0 && "Not enough input frames pushed");
     }
@@ -15,8 +15,8 @@ namespace tracktion::inline engine
 //==============================================================================
 /**
     Wraps a TimeStretcher but keeps a larger internal input and output buffer
-    and uses a background thread to try and process frames, reducing CPU cost on
-    real-time threads.
+    and uses a pool of background threads to try and process frames, reducing CPU
+    cost on real-time threads.
  */
 class ReadAheadTimeStretcher
 {
@@ -104,31 +104,60 @@ public:
     */
     int flush (float* const* outChannels);
 
+    //==============================================================================
+    /** Counters that can be used to monitor how well the background threads are keeping up. */
+    struct Stats
+    {
+        std::uint64_t numBlocksPopped = 0;          /**< The number of popData calls made. */
+        std::uint64_t numBlocksStarved = 0;         /**< The number of popData calls that had to process on the calling thread. */
+        std::uint64_t numBlocksProcessedInBackground = 0;   /**< The number of blocks processed by the background threads. */
+    };
+
+    /** Returns the current counters for this instance. Thread safe. */
+    Stats getStats() const;
+
+    /** Counters for the pool of background threads shared by all the instances. */
+    struct PoolStats
+    {
+        int numThreads = 0;                 /**< The number of background threads in the pool. */
+        int maxNumProcessingAtOnce = 0;     /**< The most instances that have been processed concurrently. */
+    };
+
+    /** Returns the current counters for the shared thread pool. Thread safe. */
+    PoolStats getPoolStats() const;
+
 private:
     //==============================================================================
-    class ProcessThread
+    /**
+        A pool of threads shared by all the ReadAheadTimeStretchers in the process.
+        Whenever a thread is free it picks the flagged instance with the fewest
+        output samples ready i.e. the one closest to running dry.
+    */
+    class ProcessThreadPool
     {
     public:
-        ProcessThread();
-        ~ProcessThread();
+        ProcessThreadPool();
+        ~ProcessThreadPool();
 
         void addInstance (ReadAheadTimeStretcher*);
         void removeInstance (ReadAheadTimeStretcher*);
 
-        void flagForProcessing (std::atomic<std::uint64_t>&);
+        void flagForProcessing (ReadAheadTimeStretcher&);
+
+        PoolStats getStats() const;
 
     private:
         //==============================================================================
         std::vector<ReadAheadTimeStretcher*> instances;
         std::mutex instancesMutex;
 
-        std::thread thread;
+        std::vector<std::thread> threads;
         juce::WaitableEvent event;
         std::atomic_flag waitingToExitFlag = ATOMIC_FLAG_INIT;
-        std::atomic_flag breakForAddRemoveInstance = ATOMIC_FLAG_INIT;
-        std::atomic<std::uint64_t> processEpoch { 0 };
+        std::atomic<int> numProcessing { 0 }, maxNumProcessingAtOnce { 0 };
 
         //==============================================================================
+        ReadAheadTimeStretcher* claimMostUrgentInstance();
         void process();
     };
 
@@ -137,17 +166,18 @@ private:
     const int numBlocksToReadAhead;
     int numChannels = 0, numSamplesPerOutputBlock = 0;
     mutable std::mutex processMutex;
-    std::atomic<std::uint64_t> epoch { std::numeric_limits<std::uint64_t>::max() };
 
     mutable std::atomic<float> pendingSpeedRatio { 1.0f }, pendingSemitonesUp { 0.0f };
     mutable std::atomic<bool> newSpeedAndPitchPending { false }, hasBeenReset { true };
 
-    juce::SharedResourcePointer<ProcessThread> processThread;
+    std::atomic<bool> needsProcessing { false };
+    std::atomic_flag isClaimedForProcessing = ATOMIC_FLAG_INIT;
+    std::atomic<std::uint64_t> numBlocksPopped { 0 }, numBlocksStarved { 0 }, numBlocksProcessedInBackground { 0 };
+
+    juce::SharedResourcePointer<ProcessThreadPool> processThreadPool;
 
     void tryToSetNewSpeedAndPitch() const;
     int processNextBlock (bool shouldBlock);
-    bool canProcessNextBlock();
-    std::uint64_t getEpoch() const { return epoch.load (std::memory_order_acquire); }
 };
 
 }
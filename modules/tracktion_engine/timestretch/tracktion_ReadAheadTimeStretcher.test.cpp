@@ -0,0 +1,183 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_TIMESTRETCHER
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+//==============================================================================
+class ReadAheadTimeStretcherTests  : public juce::UnitTest
+{
+public:
+    ReadAheadTimeStretcherTests()
+        : juce::UnitTest ("ReadAheadTimeStretcher", "tracktion_engine")
+    {
+    }
+
+    void runTest() override
+    {
+       #if TRACKTION_ENABLE_TIMESTRETCH_SOUNDTOUCH
+        runResetTests (TimeStretcher::soundtouchBetter);
+        runPoolTests (TimeStretcher::soundtouchBetter);
+       #endif
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int numChannels = 2, blockSize = 512;
+
+    //==============================================================================
+    struct SineSource
+    {
+        int64_t position = 0;
+
+        void push (ReadAheadTimeStretcher& stretcher, int numFrames)
+        {
+            juce::AudioBuffer<float> buffer (numChannels, numFrames);
+
+            for (int i = 0; i < numFrames; ++i)
+            {
+                const auto value = (float) std::sin ((double) (position + i) * 440.0 * juce::MathConstants<double>::twoPi / sampleRate);
+
+                for (int c = 0; c < numChannels; ++c)
+                    buffer.setSample (c, i, value);
+            }
+
+            position += stretcher.pushData (buffer.getArrayOfReadPointers(), numFrames);
+        }
+    };
+
+    static std::unique_ptr<ReadAheadTimeStretcher> createStretcher (TimeStretcher::Mode mode)
+    {
+        auto stretcher = std::make_unique<ReadAheadTimeStretcher> (3);
+        stretcher->initialise (sampleRate, blockSize, numChannels, mode, {}, true);
+        stretcher->setSpeedAndPitch (1.5f, 2.0f);
+
+        return stretcher;
+    }
+
+    /** Pulls blocks from the stretcher the same way WaveNode does. */
+    static juce::AudioBuffer<float> process (ReadAheadTimeStretcher& stretcher, SineSource& source, int numBlocks)
+    {
+        juce::AudioBuffer<float> output (numChannels, numBlocks * blockSize);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            if (const auto numToPush = stretcher.getFramesRecomended(); numToPush > 0)
+                source.push (stretcher, numToPush);
+
+            for (int numDone = 0; numDone < blockSize;)
+            {
+                juce::AudioBuffer<float> dest (output.getArrayOfWritePointers(), numChannels,
+                                               block * blockSize + numDone, blockSize - numDone);
+
+                const auto numRead = stretcher.popData (dest.getArrayOfWritePointers(), blockSize - numDone);
+
+                if (numRead == 0)
+                    return {};
+
+                numDone += numRead;
+
+                if (numDone < blockSize && stretcher.requiresMoreFrames())
+                    if (const auto numToPush = stretcher.getFramesRecomended(); numToPush > 0)
+                        source.push (stretcher, numToPush);
+            }
+        }
+
+        return output;
+    }
+
+    //==============================================================================
+    void runResetTests (TimeStretcher::Mode mode)
+    {
+        beginTest ("Reset instances give the same output as new ones: " + TimeStretcher::getNameOfMode (mode));
+
+        const int numBlocks = 40;
+
+        auto reference = createStretcher (mode);
+        SineSource referenceSource;
+        auto expected = process (*reference, referenceSource, numBlocks);
+        expectEquals (expected.getNumSamples(), numBlocks * blockSize);
+
+        // Leave some input and output in the FIFOs and the stretcher mid-stream before resetting
+        auto reused = createStretcher (mode);
+        SineSource firstSource;
+        process (*reused, firstSource, numBlocks / 2);
+        firstSource.push (*reused, std::min (100, reused->getFreeSpace()));
+
+        reused->reset();
+        expectEquals (reused->getNumReady(), 0);
+
+        SineSource secondSource;
+        auto actual = process (*reused, secondSource, numBlocks);
+        expectEquals (actual.getNumSamples(), expected.getNumSamples());
+        expectEquals (secondSource.position, referenceSource.position);
+
+        if (actual.getNumSamples() != expected.getNumSamples())
+            return;
+
+        int numDifferent = 0;
+
+        for (int c = 0; c < numChannels; ++c)
+            for (int i = 0; i < expected.getNumSamples(); ++i)
+                if (! juce::approximatelyEqual (actual.getSample (c, i), expected.getSample (c, i)))
+                    ++numDifferent;
+
+        expectEquals (numDifferent, 0);
+    }
+
+    void runPoolTests (TimeStretcher::Mode mode)
+    {
+        beginTest ("Thread pool stays within its limit: " + TimeStretcher::getNameOfMode (mode));
+
+        std::vector<std::unique_ptr<ReadAheadTimeStretcher>> stretchers;
+        std::vector<SineSource> sources (32);
+
+        for (size_t i = 0; i < sources.size(); ++i)
+            stretchers.push_back (createStretcher (mode));
+
+        const auto poolStats = stretchers.front()->getPoolStats();
+        expectGreaterOrEqual (poolStats.numThreads, 1);
+        expectLessOrEqual (poolStats.numThreads, 8);
+        expectEquals (poolStats.numThreads, juce::jlimit (1, 8, juce::SystemStats::getNumCpus() / 2));
+
+        for (int block = 0; block < 20; ++block)
+        {
+            for (size_t i = 0; i < stretchers.size(); ++i)
+                process (*stretchers[i], sources[i], 1);
+
+            // Give the background threads a chance to catch up
+            juce::Thread::sleep (1);
+        }
+
+        std::uint64_t numProcessedInBackground = 0;
+
+        for (auto& s : stretchers)
+            numProcessedInBackground += s->getStats().numBlocksProcessedInBackground;
+
+        expectGreaterThan (numProcessedInBackground, (std::uint64_t) 0);
+        expectLessOrEqual (stretchers.front()->getPoolStats().maxNumProcessingAtOnce, poolStats.numThreads);
+
+        // Instances removed from the pool mid-stream shouldn't be touched again
+        for (size_t i = 0; i < stretchers.size(); i += 2)
+            stretchers[i].reset();
+
+        for (size_t i = 1; i < stretchers.size(); i += 2)
+            expectEquals (process (*stretchers[i], sources[i], 4).getNumSamples(), 4 * blockSize);
+    }
+};
+
+static ReadAheadTimeStretcherTests readAheadTimeStretcherTests;
+
+}
+
+#endif
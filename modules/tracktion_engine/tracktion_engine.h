@@ -47,6 +47,7 @@
 #include <variant>
 #include <any>
 #include <shared_mutex>
+#include <future>
 #include <span>
 
 #include <juce_audio_basics/juce_audio_basics.h>
@@ -327,6 +328,7 @@ namespace tracktion { inline namespace engine
     class ParameterChangeHandler;
     class AutomationRecordManager;
     class RenderManager;
+    class RenderCache;
     class EditPlaybackContext;
     class EditInputDevices;
     class InputDeviceInstance;
@@ -339,6 +341,7 @@ namespace tracktion { inline namespace engine
     class ExternalController;
     class EditInsertPoint;
     class AudioFileManager;
+    class AudioFileAnalyser;
     class AudioClipBase;
     class AudioTrack;
     class PluginList;
@@ -396,6 +399,7 @@ namespace tracktion { inline namespace engine
 #include "utilities/tracktion_AtomicWrapper.h"
 #include "utilities/tracktion_Identifiers.h"
 #include "utilities/tracktion_ValueTreeUtilities.h"
+#include "utilities/tracktion_UndoDelta.h"
 #include "utilities/tracktion_CrashTracer.h"
 #include "utilities/tracktion_AsyncFunctionUtils.h"
 #include "utilities/tracktion_CpuMeasurement.h"
@@ -425,6 +429,8 @@ namespace tracktion { inline namespace engine
 #include "utilities/tracktion_CurveEditor.h"
 #include "utilities/tracktion_Envelope.h"
 #include "utilities/tracktion_Oscillators.h"
+#include "utilities/tracktion_BiquadCascade.h"
+#include "utilities/tracktion_PartitionedConvolution.h"
 #include "utilities/tracktion_ScreenSaverDefeater.h"
 
 #include "project/tracktion_ProjectItemID.h"
@@ -528,6 +534,7 @@ namespace tracktion { inline namespace engine
 
 #include "audio_files/tracktion_AudioFileCache.h"
 #include "audio_files/tracktion_SmartThumbnail.h"
+#include "audio_files/tracktion_PeakPyramid.h"
 #include "audio_files/tracktion_AudioProxyGenerator.h"
 #include "audio_files/tracktion_AudioFileManager.h"
 #include "audio_files/tracktion_AudioFileWriter.h"
@@ -537,6 +544,7 @@ namespace tracktion { inline namespace engine
 
 #include "audio_files/tracktion_AudioFormatManager.h"
 #include "audio_files/tracktion_AudioFileUtils.h"
+#include "audio_files/tracktion_AudioFileAnalyser.h"
 #include "audio_files/tracktion_AudioFifo.h"
 #include "audio_files/tracktion_RecordingThumbnailManager.h"
 #include "audio_files/formats/tracktion_FFmpegEncoderAudioFormat.h"
@@ -566,7 +574,10 @@ namespace tracktion { inline namespace engine
 #include "model/export/tracktion_ExportJob.h"
 #include "model/export/tracktion_ReferencedMaterialList.h"
 #include "model/export/tracktion_Renderer.h"
+#include "model/export/tracktion_SegmentedRenderer.h"
+#include "model/export/tracktion_BatchRenderer.h"
 #include "model/export/tracktion_RenderManager.h"
+#include "model/export/tracktion_RenderCache.h"
 
 #include "model/edit/tracktion_QuantisationType.h"
 
@@ -606,6 +617,7 @@ namespace tracktion { inline namespace engine
 #include "selection/tracktion_Clipboard.h"
 
 #include "playback/devices/tracktion_InputDevice.h"
+#include "playback/devices/tracktion_MidiInputRing.h"
 #include "playback/devices/tracktion_MidiInputDevice.h"
 #include "playback/devices/tracktion_PhysicalMidiInputDevice.h"
 #include "playback/devices/tracktion_VirtualMidiInputDevice.h"
@@ -40,6 +40,8 @@ extern "C"
  #pragma GCC diagnostic ignored "-Wfloat-equal"
 #endif
 
+#include "timestretch/tracktion_TempoDetect.h"
+
 #include "audio_files/formats/tracktion_FFmpegEncoderAudioFormat.cpp"
 #include "audio_files/formats/tracktion_FloatAudioFileFormat.cpp"
 #include "audio_files/formats/tracktion_RexFileFormat.cpp"
@@ -52,9 +54,13 @@ extern "C"
 #include "audio_files/tracktion_AudioFileCache.test.cpp"
 #include "audio_files/tracktion_AudioFile.cpp"
 #include "audio_files/tracktion_AudioFile.test.cpp"
+#include "audio_files/tracktion_PeakPyramid.cpp"
+#include "audio_files/tracktion_PeakPyramid.test.cpp"
 #include "audio_files/tracktion_AudioFileUtils.cpp"
 #include "audio_files/tracktion_AudioFormatManager.cpp"
 #include "audio_files/tracktion_BufferedAudioReader.cpp"
+#include "audio_files/tracktion_AudioFileAnalyser.cpp"
+#include "audio_files/tracktion_AudioFileAnalyser.test.cpp"
 
 #include "midi/tracktion_MidiList.cpp"
 #include "midi/tracktion_MidiProgramManager.cpp"
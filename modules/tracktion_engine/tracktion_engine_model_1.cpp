@@ -30,7 +30,6 @@ using namespace std::literals;
 
 #include "../../modules/tracktion_graph/tracktion_graph/tracktion_TestUtilities.h"
 
-#include "timestretch/tracktion_TempoDetect.h"
 #include "model/automation/modifiers/tracktion_ModifierInternal.h"
 
 #include "model/edit/tracktion_OldEditConversion.h"
@@ -86,6 +85,7 @@ using namespace std::literals;
 #include "model/clips/tracktion_StepClipPattern.cpp"
 #include "model/clips/tracktion_StepClip.cpp"
 #include "model/clips/tracktion_ClipEffects.cpp"
+#include "model/clips/tracktion_ClipEffects.test.cpp"
 #include "model/clips/tracktion_ClipOwner.cpp"
 #include "model/clips/tracktion_WarpTimeManager.cpp"
 
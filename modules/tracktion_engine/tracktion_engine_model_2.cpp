@@ -71,8 +71,12 @@ using namespace std::literals;
 #include "model/export/tracktion_Exportable.cpp"
 #include "model/export/tracktion_ExportJob.cpp"
 #include "model/export/tracktion_Renderer.cpp"
+#include "model/export/tracktion_SegmentedRenderer.cpp"
+#include "model/export/tracktion_BatchRenderer.cpp"
 #include "model/export/tracktion_Renderer.test.cpp"
 #include "model/export/tracktion_RenderManager.cpp"
+#include "model/export/tracktion_RenderCache.cpp"
+#include "model/export/tracktion_RenderCache.test.cpp"
 #include "model/export/tracktion_ArchiveFile.cpp"
 #include "model/export/tracktion_RenderOptions.cpp"
 #include "model/clips/tracktion_EditClipRenderJob.cpp"
@@ -85,6 +89,7 @@ using namespace std::literals;
 #include "project/tracktion_Project.cpp"
 #include "project/tracktion_ProjectManager.cpp"
 #include "project/tracktion_ProjectSearchIndex.cpp"
+#include "project/tracktion_ProjectSearchIndex.test.cpp"
 
 #ifdef __GNUC__
  #pragma GCC diagnostic pop
@@ -270,6 +270,7 @@ using namespace std::literals;
 #include "playback/tracktion_EditPlaybackContext.cpp"
 #include "playback/tracktion_EditInputDevices.cpp"
 #include "playback/tracktion_LevelMeasurer.cpp"
+#include "playback/tracktion_LevelMeasurer.test.cpp"
 #include "playback/tracktion_MidiNoteDispatcher.cpp"
 #include "playback/tracktion_TransportControl.test.cpp"
 #include "playback/tracktion_TransportControl.cpp"
@@ -277,6 +278,7 @@ using namespace std::literals;
 
 #include "playback/devices/tracktion_InputDevice.cpp"
 #include "playback/devices/tracktion_MidiInputDevice.cpp"
+#include "playback/devices/tracktion_MidiInputRing.test.cpp"
 #include "playback/devices/tracktion_PhysicalMidiInputDevice.cpp"
 #include "playback/devices/tracktion_VirtualMidiInputDevice.cpp"
 #include "playback/devices/tracktion_MidiOutputDevice.cpp"
@@ -308,6 +310,7 @@ static inline void sprintf (char* dest, size_t maxLength, const char* format, ..
 #include "control_surfaces/tracktion_ExternalControllerManager.cpp"
 #include "control_surfaces/tracktion_ExternalController.cpp"
 #include "control_surfaces/tracktion_CustomControlSurface.cpp"
+#include "control_surfaces/tracktion_ExternalController.test.cpp"
 
 #if TRACKTION_ENABLE_CONTROL_SURFACES
  #if TRACKTION_ENABLE_CONTROL_SURFACE_MACKIEC4
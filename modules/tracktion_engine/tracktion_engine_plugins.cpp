@@ -92,6 +92,7 @@ using namespace std::literals;
 #include "plugins/cmajor/tracktion_CmajorPluginFormat.cpp"
 
 #include "plugins/tracktion_Plugins.test.cpp"
+#include "plugins/tracktion_PluginBenchmarks.test.cpp"
 
 #ifdef __GNUC__
  #pragma GCC diagnostic pop
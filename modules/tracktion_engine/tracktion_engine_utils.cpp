@@ -78,11 +78,17 @@ extern "C" char MacGetMacFSRefForREXDLL (FSRef* fsRef)
 #include "utilities/tracktion_Envelope.cpp"
 #include "utilities/tracktion_FileUtilities.cpp"
 #include "utilities/tracktion_Oscillators.cpp"
+#include "utilities/tracktion_BiquadCascade.cpp"
+#include "utilities/tracktion_PartitionedConvolution.cpp"
+#include "utilities/tracktion_PartitionedConvolution.test.cpp"
 #include "utilities/tracktion_PropertyStorage.cpp"
 #include "utilities/tracktion_ParameterHelpers.cpp"
 #include "utilities/tracktion_UIBehaviour.cpp"
+#include "utilities/tracktion_UndoDelta.cpp"
+#include "utilities/tracktion_UndoDelta.test.cpp"
 #include "utilities/tracktion_TemporaryFileManager.cpp"
 #include "utilities/tracktion_Engine.cpp"
+#include "utilities/tracktion_Engine.test.cpp"
 #include "utilities/tracktion_Threads.cpp"
 #include "utilities/tracktion_BinaryData.cpp"
 #include "utilities/tracktion_ScreenSaverDefeater.cpp"
@@ -493,9 +493,15 @@ struct AudioScratchBuffer::BufferList   : private juce::DeletedAtShutdown
                     return b;
         }
 
+        // The pool only grows when more buffers are in use at once than ever before.
+        // A counting operator new only sees the Buffer object itself, the sample data
+        // is allocated by juce::HeapBlock with malloc so it's recorded here
         auto newBuffer = new Buffer();
         newBuffer->isFree = false;
 
+        auto& b = newBuffer->buffer;
+        tracktion::graph::allocation::recordAllocation ((size_t) b.getNumChannels() * (size_t) b.getNumSamples() * sizeof (float));
+
         const std::unique_lock sl (mutex);
         buffers.add (newBuffer);
         return newBuffer;
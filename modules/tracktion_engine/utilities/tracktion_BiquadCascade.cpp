@@ -0,0 +1,221 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+
+namespace tracktion { inline namespace engine
+{
+
+BiquadCascade::Coefficients BiquadCascade::Coefficients::from (const juce::IIRCoefficients& c) noexcept
+{
+    return { c.coefficients[0], c.coefficients[1], c.coefficients[2], c.coefficients[3], c.coefficients[4] };
+}
+
+BiquadCascade::Coefficients BiquadCascade::Coefficients::from (const std::array<float, 6>& c) noexcept
+{
+    const auto a0 = c[3];
+    jassert (a0 != 0.0f);
+
+    return { c[0] / a0, c[1] / a0, c[2] / a0, c[4] / a0, c[5] / a0 };
+}
+
+//==============================================================================
+void BiquadCascade::Lanes::resize (size_t num, float initialB0)
+{
+    b0.assign (num, initialB0);
+    b1.assign (num, 0.0f);
+    b2.assign (num, 0.0f);
+    a1.assign (num, 0.0f);
+    a2.assign (num, 0.0f);
+}
+
+bool BiquadCascade::Lanes::equals (size_t lane, const Coefficients& c) const noexcept
+{
+    return b0[lane] == c.b0 && b1[lane] == c.b1 && b2[lane] == c.b2
+             && a1[lane] == c.a1 && a2[lane] == c.a2;
+}
+
+void BiquadCascade::Lanes::set (size_t lane, const Coefficients& c) noexcept
+{
+    b0[lane] = c.b0;
+    b1[lane] = c.b1;
+    b2[lane] = c.b2;
+    a1[lane] = c.a1;
+    a2[lane] = c.a2;
+}
+
+//==============================================================================
+void BiquadCascade::prepare (int newNumChannels, int newNumStages)
+{
+    jassert (newNumChannels > 0 && newNumChannels <= maxNumChannels);
+    jassert (newNumStages > 0);
+
+    numChannels = juce::jlimit (1, maxNumChannels, newNumChannels);
+    numStages = std::max (1, newNumStages);
+
+    // The lanes are padded to a multiple of 4 so the loops have whole SIMD registers,
+    // the padding lanes have zero coefficients so never produce anything
+    numLanes = (numChannels * numStages + 3) & ~3;
+
+    for (auto lanes : { &coefficients, &targets, &deltas })
+        lanes->resize ((size_t) numLanes, 0.0f);
+
+    for (int l = 0; l < numChannels * numStages; ++l)
+    {
+        coefficients.set ((size_t) l, {});
+        targets.set ((size_t) l, {});
+    }
+
+    for (auto v : { &input, &output, &state1, &state2 })
+        v->assign ((size_t) numLanes, 0.0f);
+
+    needsInterpolating = false;
+}
+
+void BiquadCascade::reset() noexcept
+{
+    std::fill (output.begin(), output.end(), 0.0f);
+    std::fill (state1.begin(), state1.end(), 0.0f);
+    std::fill (state2.begin(), state2.end(), 0.0f);
+
+    coefficients = targets;
+    needsInterpolating = false;
+}
+
+void BiquadCascade::setCoefficients (int stage, const Coefficients& c, bool interpolate) noexcept
+{
+    jassert (juce::isPositiveAndBelow (stage, numStages));
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto lane = (size_t) (stage * numChannels + channel);
+        targets.set (lane, c);
+
+        if (! interpolate)
+            coefficients.set (lane, c);
+        else if (! coefficients.equals (lane, c))
+            needsInterpolating = true;
+    }
+}
+
+//==============================================================================
+void BiquadCascade::process (float* const* channels, int numChannelsToProcess, int numSamples) noexcept
+{
+    if (numLanes == 0 || numSamples <= 0)
+        return;
+
+    numChannelsToProcess = std::min (numChannelsToProcess, numChannels);
+
+    if (needsInterpolating)
+    {
+        const auto scale = 1.0f / (float) numSamples;
+
+        for (int l = 0; l < numLanes; ++l)
+        {
+            deltas.b0[(size_t) l] = (targets.b0[(size_t) l] - coefficients.b0[(size_t) l]) * scale;
+            deltas.b1[(size_t) l] = (targets.b1[(size_t) l] - coefficients.b1[(size_t) l]) * scale;
+            deltas.b2[(size_t) l] = (targets.b2[(size_t) l] - coefficients.b2[(size_t) l]) * scale;
+            deltas.a1[(size_t) l] = (targets.a1[(size_t) l] - coefficients.a1[(size_t) l]) * scale;
+            deltas.a2[(size_t) l] = (targets.a2[(size_t) l] - coefficients.a2[(size_t) l]) * scale;
+        }
+
+        processSteps<true> (channels, numChannelsToProcess, numSamples);
+
+        // Avoid any rounding errors from the increments
+        coefficients = targets;
+        needsInterpolating = false;
+    }
+    else
+    {
+        processSteps<false> (channels, numChannelsToProcess, numSamples);
+    }
+
+    for (int l = 0; l < numLanes; ++l)
+    {
+        JUCE_SNAP_TO_ZERO (state1[(size_t) l]);
+        JUCE_SNAP_TO_ZERO (state2[(size_t) l]);
+    }
+}
+
+void BiquadCascade::process (juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    jassert (startSample + numSamples <= buffer.getNumSamples());
+    float* channels[maxNumChannels];
+    const auto num = std::min (buffer.getNumChannels(), numChannels);
+
+    for (int c = 0; c < num; ++c)
+        channels[c] = buffer.getWritePointer (c, startSample);
+
+    process (channels, num, numSamples);
+}
+
+void BiquadCascade::process (const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    float* channels[maxNumChannels];
+    const auto num = std::min ((int) block.getNumChannels(), numChannels);
+
+    for (int c = 0; c < num; ++c)
+        channels[c] = block.getChannelPointer ((size_t) c);
+
+    process (channels, num, (int) block.getNumSamples());
+}
+
+template<bool interpolate>
+void BiquadCascade::processSteps (float* const* channels, int numChannelsToProcess, int numSamples) noexcept
+{
+    auto b0 = coefficients.b0.data(), b1 = coefficients.b1.data(), b2 = coefficients.b2.data(),
+         a1 = coefficients.a1.data(), a2 = coefficients.a2.data();
+    auto in = input.data(), out = output.data(), s1 = state1.data(), s2 = state2.data();
+    const auto lastStage = numStages - 1;
+
+    for (int step = 0; step < numSamples + lastStage; ++step)
+    {
+        // Stage n is on sample (step - n) so only some stages are running whilst the pipeline fills and drains
+        const auto firstStage = std::max (0, step - numSamples + 1);
+        const auto endStage = std::min (numStages, step + 1);
+        const auto firstLane = firstStage * numChannels;
+        const auto endLane = endStage == numStages ? numLanes : endStage * numChannels;
+
+        if (step < numSamples)
+            for (int c = 0; c < numChannels; ++c)
+                in[c] = c < numChannelsToProcess ? channels[c][step] : 0.0f;
+
+        // Each stage takes the previous stage's output from the last step
+        std::copy (out, out + (numLanes - numChannels), in + numChannels);
+
+        for (int l = firstLane; l < endLane; ++l)
+        {
+            const auto x = in[l];
+            const auto y = b0[l] * x + s1[l];
+            s1[l] = b1[l] * x - a1[l] * y + s2[l];
+            s2[l] = b2[l] * x - a2[l] * y;
+            out[l] = y;
+
+            if constexpr (interpolate)
+            {
+                b0[l] += deltas.b0[(size_t) l];
+                b1[l] += deltas.b1[(size_t) l];
+                b2[l] += deltas.b2[(size_t) l];
+                a1[l] += deltas.a1[(size_t) l];
+                a2[l] += deltas.a2[(size_t) l];
+            }
+        }
+
+        if (endStage == numStages)
+        {
+            const auto sample = step - lastStage;
+            auto lastStageOutput = out + lastStage * numChannels;
+
+            for (int c = 0; c < numChannelsToProcess; ++c)
+                channels[c][sample] = lastStageOutput[c];
+        }
+    }
+}
+
+}} // namespace tracktion { inline namespace engine
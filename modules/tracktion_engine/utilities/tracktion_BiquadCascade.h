@@ -0,0 +1,105 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+/**
+    A series of biquad filters applied to several channels at once.
+
+    Each channel of each stage is a "lane" with its own transposed direct form II
+    state. The stages are pipelined so that on each step, stage n processes the
+    sample stage n - 1 produced on the previous step. This means every lane is
+    independent within a step and all the channels and stages run together in
+    SIMD lanes, rather than one filter per channel per stage running a sample at
+    a time. The pipeline is filled and drained within each block so there's no
+    added latency.
+
+    Coefficients can be changed while processing, by default they're linearly
+    interpolated across the next block to avoid zipper noise when automated.
+*/
+class BiquadCascade
+{
+public:
+    //==============================================================================
+    /** Normalised biquad coefficients. The default is a pass-through. */
+    struct Coefficients
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+
+        /** Creates a set from some juce::IIRCoefficients. */
+        static Coefficients from (const juce::IIRCoefficients&) noexcept;
+
+        /** Creates a set from the b0, b1, b2, a0, a1, a2 array juce::dsp::IIR::ArrayCoefficients creates. */
+        static Coefficients from (const std::array<float, 6>&) noexcept;
+    };
+
+    /** The maximum number of channels that can be processed. */
+    static constexpr int maxNumChannels = 8;
+
+    //==============================================================================
+    /** Creates an empty cascade, call prepare before using it. */
+    BiquadCascade() = default;
+
+    /** Sets the number of channels and stages. This allocates so shouldn't be
+        called on the audio thread. All the stages are reset to pass-through.
+    */
+    void prepare (int numChannels, int numStages);
+
+    /** Clears the filter state and jumps to any coefficients being interpolated to. */
+    void reset() noexcept;
+
+    /** Sets the coefficients for one of the stages on all channels.
+        If interpolate is true, the change will be spread over the next block processed.
+        Setting the same coefficients again doesn't cost anything so this can be called every block.
+    */
+    void setCoefficients (int stage, const Coefficients&, bool interpolate = true) noexcept;
+
+    //==============================================================================
+    /** Processes some channels in place. Any channels the cascade has been
+        prepared with that aren't passed in are fed silence.
+    */
+    void process (float* const* channels, int numChannels, int numSamples) noexcept;
+
+    /** Processes a section of a buffer in place. */
+    void process (juce::AudioBuffer<float>&, int startSample, int numSamples) noexcept;
+
+    /** Processes an AudioBlock in place. */
+    void process (const juce::dsp::AudioBlock<float>&) noexcept;
+
+    /** Returns the number of channels the cascade has been prepared with. */
+    int getNumChannels() const noexcept             { return numChannels; }
+
+    /** Returns the number of stages the cascade has been prepared with. */
+    int getNumStages() const noexcept               { return numStages; }
+
+private:
+    //==============================================================================
+    struct Lanes
+    {
+        std::vector<float> b0, b1, b2, a1, a2;
+
+        void resize (size_t, float initialB0);
+        bool equals (size_t lane, const Coefficients&) const noexcept;
+        void set (size_t lane, const Coefficients&) noexcept;
+    };
+
+    int numChannels = 0, numStages = 0, numLanes = 0;
+    Lanes coefficients, targets, deltas;
+    std::vector<float> input, output, state1, state2;
+    bool needsInterpolating = false;
+
+    template<bool interpolate>
+    void processSteps (float* const* channels, int numChannelsToProcess, int numSamples) noexcept;
+};
+
+}} // namespace tracktion { inline namespace engine
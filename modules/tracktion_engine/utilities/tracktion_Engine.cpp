@@ -46,36 +46,90 @@ Engine::Engine (juce::String applicationName)  : Engine (applicationName, nullpt
 
 void Engine::initialise()
 {
-    Selectable::initialise();
-    AudioScratchBuffer::initialise();
-
-    projectManager             = std::make_unique<ProjectManager> (*this);
-    activeEdits                = std::unique_ptr<ActiveEdits> (new ActiveEdits());
-    temporaryFileManager       = std::make_unique<TemporaryFileManager> (*this);
-    recordingThumbnailManager  = std::make_unique<RecordingThumbnailManager> (*this);
-    waveInputRecordingThread   = std::make_unique<WaveInputRecordingThread> (*this);
-    editDeleter                = std::unique_ptr<EditDeleter> (new EditDeleter());
-    audioFileFormatManager     = std::make_unique<AudioFileFormatManager>();
-    midiLearnState             = std::make_unique<MidiLearnState> (*this);
-    renderManager              = std::make_unique<RenderManager> (*this);
-    audioFileManager           = std::make_unique<AudioFileManager> (*this);
-    deviceManager              = std::unique_ptr<DeviceManager> (new DeviceManager (*this));
-    midiProgramManager         = std::make_unique<MidiProgramManager> (*this);
-    externalControllerManager  = std::unique_ptr<ExternalControllerManager> (new ExternalControllerManager (*this));
-    backgroundJobManager       = std::make_unique<BackgroundJobManager>();
-    pluginManager              = std::make_unique<PluginManager> (*this);
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    auto timePhase = [this] (const char* name, auto&& fn)
+    {
+        const auto phaseStart = juce::Time::getMillisecondCounterHiRes();
+        fn();
+        addStartupPhase (name, phaseStart, false);
+    };
+
+    // The audio formats don't depend on anything else so are created whilst the
+    // other managers are built and the devices opened. Their constructors only fill
+    // in names and extensions, nothing that needs the message thread or COM.
+    pendingAudioFileFormatManager = std::async (std::launch::async, [this]
+    {
+        const auto phaseStart = juce::Time::getMillisecondCounterHiRes();
+        auto formatManager = std::make_unique<AudioFileFormatManager>();
+        addStartupPhase ("AudioFileFormatManager", phaseStart, true);
+        return formatManager;
+    });
+
+    timePhase ("Core managers", [this]
+    {
+        Selectable::initialise();
+        AudioScratchBuffer::initialise();
+
+        activeEdits                = std::unique_ptr<ActiveEdits> (new ActiveEdits());
+        temporaryFileManager       = std::make_unique<TemporaryFileManager> (*this);
+        recordingThumbnailManager  = std::make_unique<RecordingThumbnailManager> (*this);
+        waveInputRecordingThread   = std::make_unique<WaveInputRecordingThread> (*this);
+        editDeleter                = std::unique_ptr<EditDeleter> (new EditDeleter());
+        midiLearnState             = std::make_unique<MidiLearnState> (*this);
+        renderManager              = std::make_unique<RenderManager> (*this);
+        renderCache                = std::make_unique<RenderCache> (*this);
+    });
+
+    timePhase ("AudioFileManager",          [this] { audioFileManager = std::make_unique<AudioFileManager> (*this); });
+    timePhase ("DeviceManager",             [this] { deviceManager = std::unique_ptr<DeviceManager> (new DeviceManager (*this)); });
+    timePhase ("ExternalControllerManager", [this] { externalControllerManager = std::unique_ptr<ExternalControllerManager> (new ExternalControllerManager (*this)); });
+    timePhase ("BackgroundJobManager",      [this] { backgroundJobManager = std::make_unique<BackgroundJobManager>(); });
+    timePhase ("PluginManager",             [this] { pluginManager = std::make_unique<PluginManager> (*this); });
 
     if (engineBehaviour->autoInitialiseDeviceManager())
     {
-        deviceManager->initialise (getEngineBehaviour().shouldOpenAudioInputByDefault()
-                                        ? DeviceManager::defaultNumChannelsToOpen : 0,
-                                   DeviceManager::defaultNumChannelsToOpen);
+        timePhase ("Opening devices", [this]
+        {
+            deviceManager->initialise (getEngineBehaviour().shouldOpenAudioInputByDefault()
+                                            ? DeviceManager::defaultNumChannelsToOpen : 0,
+                                       DeviceManager::defaultNumChannelsToOpen);
+        });
     }
 
-    pluginManager->initialise();
-    getProjectManager().initialise();
+    timePhase ("Plugin list", [this] { pluginManager->initialise(); });
+
+    // The ProjectManager and MidiProgramManager are created when first used
+    if (engineBehaviour->autoInitialiseExternalControllers())
+        timePhase ("Control surfaces", [this] { externalControllerManager->initialise(); });
+
+    addStartupPhase ("Total", startTime, false);
+    TRACKTION_LOG (getStartupReportAsString());
+}
+
+void Engine::addStartupPhase (juce::String name, double startTimeMs, bool concurrent) const
+{
+    const auto durationMs = juce::Time::getMillisecondCounterHiRes() - startTimeMs;
+    const std::scoped_lock sl (startupReportLock);
+    startupReport.push_back ({ std::move (name), durationMs, concurrent });
+}
 
-    externalControllerManager->initialise();
+std::vector<Engine::StartupPhase> Engine::getStartupReport() const
+{
+    const std::scoped_lock sl (startupReportLock);
+    return startupReport;
+}
+
+juce::String Engine::getStartupReportAsString() const
+{
+    juce::String report ("Engine startup:");
+
+    for (auto& phase : getStartupReport())
+        report << juce::newLine << "  " << phase.name.paddedRight (' ', 30)
+               << juce::String (phase.durationMs, 2).paddedLeft (' ', 10) << " ms"
+               << (phase.concurrent ? " (background)" : "");
+
+    return report;
 }
 
 Engine::~Engine()
@@ -83,11 +137,13 @@ Engine::~Engine()
     // First make sure to clear any edits that are in line to be deleted
     editDeleter.reset();
 
-    getProjectManager().saveList();
+    if (hasProjectManager())
+        projectManager->saveList();
 
     getExternalControllerManager().shutdown();
     getDeviceManager().closeDevices();
     getBackgroundJobs().stopAndDeleteAllRunningJobs();
+    audioFileAnalyser.reset();
 
     temporaryFileManager->cleanUp();
 
@@ -102,6 +158,7 @@ Engine::~Engine()
     temporaryFileManager.reset();
     projectManager.reset();
 
+    renderCache.reset();
     renderManager.reset();
     externalControllerManager.reset();
     propertyStorage.reset();
@@ -109,12 +166,18 @@ Engine::~Engine()
     engineBehaviour.reset();
     audioFileManager.reset();
     midiLearnState.reset();
+
+    if (pendingAudioFileFormatManager.valid())
+        pendingAudioFileFormatManager.wait();
+
     audioFileFormatManager.reset();
     backToArrangerUpdateTimer.reset();
     bufferedAudioFileManager.reset();
 
-    instance = nullptr;
     engines.removeFirstMatchingValue (this);
+
+    if (instance == this)
+        instance = engines.getLast();
 }
 
 juce::String Engine::getVersion()
@@ -135,14 +198,32 @@ Engine& Engine::getInstance()
 }
 #endif
 
+// The managers created on demand only use the PropertyStorage, ValueTrees and their own
+// locked lists, so they can be created on whichever thread uses them first. This relies on
+// the PropertyStorage being thread-safe, which the default PropertiesFile-based one is.
 ProjectManager& Engine::getProjectManager() const
 {
+    std::call_once (projectManagerCreated, [this]
+                    {
+                        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+                        projectManager = std::make_unique<ProjectManager> (const_cast<Engine&> (*this));
+                        projectManager->initialise();
+                        projectManagerExists.store (true, std::memory_order_release);
+                        addStartupPhase ("ProjectManager (on demand)", startTime, false);
+                    });
+
     jassert (projectManager != nullptr);
     return *projectManager;
 }
 
 AudioFileFormatManager& Engine::getAudioFileFormatManager() const
 {
+    std::call_once (audioFileFormatManagerCreated, [this]
+                    {
+                        jassert (pendingAudioFileFormatManager.valid());
+                        audioFileFormatManager = pendingAudioFileFormatManager.get();
+                    });
+
     jassert (audioFileFormatManager != nullptr);
     return *audioFileFormatManager;
 }
@@ -155,10 +236,28 @@ DeviceManager& Engine::getDeviceManager() const
 
 MidiProgramManager& Engine::getMidiProgramManager() const
 {
+    std::call_once (midiProgramManagerCreated, [this]
+                    {
+                        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+                        midiProgramManager = std::make_unique<MidiProgramManager> (const_cast<Engine&> (*this));
+                        midiProgramManagerExists.store (true, std::memory_order_release);
+                        addStartupPhase ("MidiProgramManager (on demand)", startTime, false);
+                    });
+
     jassert (midiProgramManager);
     return *midiProgramManager;
 }
 
+bool Engine::hasProjectManager() const noexcept
+{
+    return projectManagerExists.load (std::memory_order_acquire);
+}
+
+bool Engine::hasMidiProgramManager() const noexcept
+{
+    return midiProgramManagerExists.load (std::memory_order_acquire);
+}
+
 ExternalControllerManager& Engine::getExternalControllerManager() const
 {
     jassert (externalControllerManager != nullptr);
@@ -171,6 +270,12 @@ RenderManager& Engine::getRenderManager() const
     return *renderManager;
 }
 
+RenderCache& Engine::getRenderCache() const
+{
+    jassert (renderCache != nullptr);
+    return *renderCache;
+}
+
 BackgroundJobManager& Engine::getBackgroundJobs() const
 {
     jassert (backgroundJobManager != nullptr);
@@ -201,6 +306,14 @@ AudioFileManager& Engine::getAudioFileManager() const
     return *audioFileManager;
 }
 
+AudioFileAnalyser& Engine::getAudioFileAnalyser() const
+{
+    // This is used from background jobs so may be first called on any thread
+    std::call_once (audioFileAnalyserCreated, [this] { audioFileAnalyser = std::make_unique<AudioFileAnalyser> (const_cast<Engine&> (*this)); });
+
+    return *audioFileAnalyser;
+}
+
 MidiLearnState& Engine::getMidiLearnState() const
 {
     jassert (midiLearnState != nullptr);
@@ -65,8 +65,10 @@ public:
     MidiProgramManager& getMidiProgramManager() const;                  ///< Returns the MidiProgramManager instance that handles MIDI banks, programs, sets or presets.
     ExternalControllerManager& getExternalControllerManager() const;    ///< Returns the ExternalControllerManager instance.
     RenderManager& getRenderManager() const;                            ///< Returns the RenderManager instance.
+    RenderCache& getRenderCache() const;                                ///< Returns the RenderCache shared by all the Edits' renders.
     BackgroundJobManager& getBackgroundJobs() const;                    ///< Returns the BackgroundJobManager instance.
     AudioFileManager& getAudioFileManager() const;                      ///< Returns the AudioFileManager instance.
+    AudioFileAnalyser& getAudioFileAnalyser() const;                    ///< Returns the AudioFileAnalyser instance.
     MidiLearnState& getMidiLearnState() const;                          ///< Returns the MidiLearnState instance.
     PluginManager& getPluginManager() const;                            ///< Returns the PluginManager instance.
     EditDeleter& getEditDeleter() const;                                ///< Returns the EditDeleter instance.
@@ -80,23 +82,53 @@ public:
     SharedTimer& getBackToArrangerUpdateTimer() const;                  ///< Returns the SharedTimer instance.
     BufferedAudioFileManager& getBufferedAudioFileManager();            ///< Returns the BufferedAudioFileManager instance
 
+    /** Returns true if the ProjectManager has been created, without creating it.
+        Use this for things like clean-up tasks that only need to run if projects have been used.
+    */
+    bool hasProjectManager() const noexcept;
+
+    /** Returns true if the MidiProgramManager has been created, without creating it. */
+    bool hasMidiProgramManager() const noexcept;
+
     using WeakRef = juce::WeakReference<Engine>;
 
+    //==============================================================================
+    /** The time taken by one of the phases of the Engine's startup. */
+    struct StartupPhase
+    {
+        juce::String name;          ///< The manager or operation being timed
+        double durationMs = 0.0;    ///< How long it took
+        bool concurrent = false;    ///< True if this ran on a background thread alongside the other phases
+    };
+
+    /** Returns how long each phase of the Engine's startup took.
+        Managers that are created on demand, such as the ProjectManager and
+        MidiProgramManager, are added to this when they're first used.
+    */
+    std::vector<StartupPhase> getStartupReport() const;
+
+    /** Returns the startup report as a readable table. */
+    juce::String getStartupReportAsString() const;
+
 private:
     void initialise();
+    void addStartupPhase (juce::String name, double startTimeMs, bool concurrent) const;
 
-    std::unique_ptr<ProjectManager> projectManager;
+    mutable std::unique_ptr<ProjectManager> projectManager;
     std::unique_ptr<TemporaryFileManager> temporaryFileManager;
-    std::unique_ptr<AudioFileFormatManager> audioFileFormatManager;
+    mutable std::unique_ptr<AudioFileFormatManager> audioFileFormatManager;
+    mutable std::future<std::unique_ptr<AudioFileFormatManager>> pendingAudioFileFormatManager;
     std::unique_ptr<DeviceManager> deviceManager;
-    std::unique_ptr<MidiProgramManager> midiProgramManager;
+    mutable std::unique_ptr<MidiProgramManager> midiProgramManager;
     std::unique_ptr<PropertyStorage> propertyStorage;
     std::unique_ptr<EngineBehaviour> engineBehaviour;
     std::unique_ptr<UIBehaviour> uiBehaviour;
     std::unique_ptr<ExternalControllerManager> externalControllerManager;
     std::unique_ptr<BackgroundJobManager> backgroundJobManager;
     std::unique_ptr<RenderManager> renderManager;
+    std::unique_ptr<RenderCache> renderCache;
     std::unique_ptr<AudioFileManager> audioFileManager;
+    mutable std::unique_ptr<AudioFileAnalyser> audioFileAnalyser;
     std::unique_ptr<MidiLearnState> midiLearnState;
     std::unique_ptr<PluginManager> pluginManager;
     std::unique_ptr<EditDeleter> editDeleter;
@@ -109,6 +141,11 @@ private:
     mutable std::unique_ptr<SharedTimer> backToArrangerUpdateTimer;
     std::unique_ptr<BufferedAudioFileManager> bufferedAudioFileManager;
 
+    mutable std::once_flag projectManagerCreated, midiProgramManagerCreated, audioFileFormatManagerCreated, audioFileAnalyserCreated;
+    mutable std::atomic<bool> projectManagerExists { false }, midiProgramManagerExists { false };
+    mutable std::mutex startupReportLock;
+    mutable std::vector<StartupPhase> startupReport;
+
     JUCE_DECLARE_WEAK_REFERENCEABLE (Engine)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Engine)
 };
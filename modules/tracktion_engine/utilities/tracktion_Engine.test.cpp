@@ -0,0 +1,167 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_ENGINE
+
+//==============================================================================
+//==============================================================================
+class EngineTests  : public juce::UnitTest
+{
+public:
+    EngineTests()
+        : juce::UnitTest ("Engine", "tracktion_engine")
+    {
+    }
+
+    void runTest() override
+    {
+        auto folder = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                        .getNonexistentChildFile ("EngineTests", {}, false);
+        expect (folder.createDirectory());
+
+        beginTest ("On-demand managers aren't created during startup or shutdown");
+        {
+            SettingsRead settingsRead;
+
+            {
+                auto engine = createEngine (folder, settingsRead);
+                expect (! engine->hasProjectManager());
+                expect (! engine->hasMidiProgramManager());
+
+                auto report = engine->getStartupReport();
+                expect (hasPhase (report, "AudioFileFormatManager"));
+                expect (! hasPhase (report, "ProjectManager (on demand)"));
+                expect (! hasPhase (report, "MidiProgramManager (on demand)"));
+            }
+
+            // The settings they load on creation show whether they were built during shutdown
+            expect (! settingsRead.contains (SettingID::projectList));
+            expect (! settingsRead.contains (SettingID::midiProgramManager));
+        }
+
+        beginTest ("On-demand managers can be created from a background thread");
+        {
+            SettingsRead settingsRead;
+
+            {
+                auto engine = createEngine (folder, settingsRead);
+
+                std::thread ([&engine]
+                             {
+                                 engine->getProjectManager();
+                                 engine->getMidiProgramManager();
+                                 engine->getAudioFileFormatManager();
+                             }).join();
+
+                expect (engine->hasProjectManager());
+                expect (engine->hasMidiProgramManager());
+                expect (engine->getAudioFileFormatManager().getDefaultFormat() != nullptr);
+
+                auto report = engine->getStartupReport();
+                expect (hasPhase (report, "ProjectManager (on demand)"));
+                expect (hasPhase (report, "MidiProgramManager (on demand)"));
+            }
+
+            expect (settingsRead.contains (SettingID::projectList));
+            expect (settingsRead.contains (SettingID::midiProgramManager));
+        }
+
+        beginTest ("Destroying an Engine leaves the others registered");
+        {
+            auto& firstEngine = *Engine::getEngines().getFirst();
+            const auto numEngines = Engine::getEngines().size();
+
+            {
+                SettingsRead settingsRead;
+                auto engine = createEngine (folder, settingsRead);
+                expectEquals (Engine::getEngines().size(), numEngines + 1);
+            }
+
+            expectEquals (Engine::getEngines().size(), numEngines);
+            expect (Engine::getEngines().getFirst() == &firstEngine);
+
+           #if TRACKTION_ENABLE_SINGLETONS
+            expect (&Engine::getInstance() == Engine::getEngines().getLast());
+           #endif
+        }
+
+        folder.deleteRecursively();
+    }
+
+private:
+    //==============================================================================
+    struct SettingsRead
+    {
+        bool contains (SettingID setting) const
+        {
+            const std::scoped_lock sl (mutex);
+            return std::find (settings.begin(), settings.end(), setting) != settings.end();
+        }
+
+        void add (SettingID setting)
+        {
+            const std::scoped_lock sl (mutex);
+            settings.push_back (setting);
+        }
+
+        mutable std::mutex mutex;
+        std::vector<SettingID> settings;
+    };
+
+    /** Keeps the settings in a temporary folder and records which XML settings are read. */
+    struct TestPropertyStorage  : public PropertyStorage
+    {
+        TestPropertyStorage (juce::File folder_, SettingsRead& settingsRead_)
+            : PropertyStorage ("EngineTests"), folder (folder_), settingsRead (settingsRead_)
+        {
+        }
+
+        juce::File getAppPrefsFolder() override
+        {
+            return folder;
+        }
+
+        std::unique_ptr<juce::XmlElement> getXmlProperty (SettingID setting) override
+        {
+            settingsRead.add (setting);
+            return PropertyStorage::getXmlProperty (setting);
+        }
+
+        juce::File folder;
+        SettingsRead& settingsRead;
+    };
+
+    struct HeadlessBehaviour  : public EngineBehaviour
+    {
+        bool autoInitialiseDeviceManager() override         { return false; }
+        bool autoInitialiseExternalControllers() override   { return false; }
+    };
+
+    static std::unique_ptr<Engine> createEngine (const juce::File& folder, SettingsRead& settingsRead)
+    {
+        return std::make_unique<Engine> (std::make_unique<TestPropertyStorage> (folder, settingsRead),
+                                         nullptr, std::make_unique<HeadlessBehaviour>());
+    }
+
+    static bool hasPhase (const std::vector<Engine::StartupPhase>& report, const juce::String& name)
+    {
+        return std::any_of (report.begin(), report.end(),
+                            [&name] (auto& phase) { return phase.name == name; });
+    }
+};
+
+static EngineTests engineTests;
+
+#endif
+
+}} // namespace tracktion { inline namespace engine
@@ -116,6 +116,12 @@ public:
     /// thread to reduce audio CPU use.
     virtual bool enableReadAheadForTimeStretchNodes()                               { return false; }
 
+    /// If this returns true, SmartThumbnails will draw from memory-mapped peak pyramid files
+    /// (see PeakPyramidCache) rather than the thumbnail type created by UIBehaviour.
+    /// Recordings and renders will also write their pyramids as they go so they never
+    /// need to be re-read to be drawn.
+    virtual bool usePeakPyramidThumbnails()                                         { return false; }
+
     /// Should return true if the incoming timestamp for MIDI messages should be used.
     /// If this returns false, the current system time will be used (which could be less accurate).
     /// N.B. this is called from multiple threads, including the MIDI thread for every
@@ -127,6 +133,16 @@ public:
 
     virtual int getNumberOfCPUsToUseForAudio()                                      { return juce::jmax (1, juce::SystemStats::getNumCpus()); }
 
+    /// Should return the scheduling policy, priority and CPU cores to use for the audio
+    /// device thread and the playback graph's worker threads.
+    /// By default no affinity is set and the platform's default real-time policy is used.
+    /// Failures to apply these are logged unless an onFailure callback is set.
+    virtual tracktion::graph::ThreadSchedulingOptions getThreadSchedulingOptions()  { return {}; }
+
+    /// If this returns true, the Nodes of each playback graph are allocated from a
+    /// single NodeArena which is freed in one go once the graph has been replaced.
+    virtual bool shouldAllocatePlaybackGraphsFromArena()                            { return false; }
+
     /// Should muted tracks processing be disabled to save CPU
     virtual bool shouldProcessMutedTracks()                                         { return false; }
 
@@ -207,6 +223,13 @@ public:
         return MidiList::createDefaultPlaybackMidiSequence (list, clip, tb, generateMPE);
     }
 
+    /// MidiClips cache the sequences createPlaybackMidiSequence returns and, if this
+    /// returns true, update them in place when a single note is moved or changed rather
+    /// than creating them again.
+    /// If you override createPlaybackMidiSequence to change or add to the note events,
+    /// you should return false here.
+    virtual bool canUpdatePlaybackMidiSequencesIncrementally()                      { return true; }
+
     /// Must return the default looped sequence type to use.
     ///
     /// Current options are:
@@ -254,6 +277,11 @@ public:
     /// Return the control surfaces you want enabled in the engine
     virtual ControlSurfaces getDesiredControlSurfaces()                             { return {}; }
 
+    /// Return false to skip creating the control surfaces when the Engine starts,
+    /// e.g. for headless render processes. You can call ExternalControllerManager::initialise
+    /// yourself later on if they turn out to be needed.
+    virtual bool autoInitialiseExternalControllers()                                { return true; }
+
     /// Restore a custom control surface from custom XML
     virtual ControlSurface* getCustomControlSurfaceForXML (ExternalControllerManager&, const juce::XmlElement&)     { return {}; }
 };
@@ -196,34 +196,35 @@ void Oscillator::processSquare (juce::AudioBuffer<float>& buffer, int startSampl
 }
 
 //==============================================================================
-MultiVoiceOscillator::MultiVoiceOscillator (int maxVoices)
+MultiVoiceOscillator::MultiVoiceOscillator (int maxNumVoices)
+    : maxVoices (maxNumVoices),
+      phases ((size_t) maxNumVoices), deltas ((size_t) maxNumVoices),
+      leftGains ((size_t) maxNumVoices), rightGains ((size_t) maxNumVoices),
+      upTables ((size_t) maxNumVoices), downTables ((size_t) maxNumVoices),
+      generators ((size_t) maxNumVoices),
+      normalDistributions ((size_t) maxNumVoices, std::normal_distribution<float> (0.0f, 0.1f))
 {
-    for (int i = 0; i < maxVoices * 2; i++)
-        oscillators.add (new Oscillator());
 }
 
 void MultiVoiceOscillator::start()
 {
     static juce::Random r;
 
-    for (int i = 0; i < oscillators.size(); i += 2)
-    {
-        float phase = r.nextFloat();
-        oscillators[i + 0]->start (phase);
-        oscillators[i + 1]->start (phase);
-    }
+    for (auto& p : phases)
+        p = r.nextFloat();
 }
 
 void MultiVoiceOscillator::setSampleRate (double sr)
 {
-    for (auto o : oscillators)
-        o->setSampleRate (sr);
+    sampleRate = sr;
+
+    if (lookupTables == nullptr || sampleRate != lookupTables->sampleRate)
+        lookupTables = BandlimitedWaveLookupTables::getLookupTables (sampleRate);
 }
 
 void MultiVoiceOscillator::setWave (Oscillator::Waves w)
 {
-    for (auto o : oscillators)
-        o->setWave (w);
+    wave = w;
 }
 
 void MultiVoiceOscillator::setNote (float n)
@@ -243,8 +244,7 @@ void MultiVoiceOscillator::setPan (float p)
 
 void MultiVoiceOscillator::setPulseWidth (float p)
 {
-    for (auto o : oscillators)
-        o->setPulseWidth (p);
+    pulseWidth = p;
 }
 
 void MultiVoiceOscillator::setNumVoices (int n)
@@ -262,55 +262,123 @@ void MultiVoiceOscillator::setSpread (float s)
     spread = s;
 }
 
-void MultiVoiceOscillator::process (juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+void MultiVoiceOscillator::updateVoices (int numVoices)
 {
-    if (voices == 1)
+    auto& tables = wave == Oscillator::triangle ? lookupTables->triangleFunctions
+                                                : lookupTables->sawUpFunctions;
+
+    for (int i = 0; i < numVoices; i++)
     {
-        float leftGain  = 1.0f - pan;
-        float rightGain = 1.0f + pan;
+        float voiceNote = note;
+        float localPan = pan;
 
-        for (int i = 0; i < 2; i++)
+        if (voices > 1)
         {
-            bool left = (i % 2) == 0;
-            float panGain = left ? leftGain : rightGain;
-
-            float* data = buffer.getWritePointer (left ? 0 : 1, startSample);
-            float* dataPointers[] = {data};
+            voiceNote = (note - detune / 2) + detune / (voices - 1) * i;
+            localPan = juce::jlimit (-1.0f, 1.0f, ((i % 2 == 0) ? 1 : -1) * spread);
+        }
 
-            juce::AudioBuffer<float> channelBuffer (dataPointers, 1, numSamples);
+        const float frequency = std::min (float (sampleRate) / 2.0f, 440.0f * std::pow (2.0f, (voiceNote - 69.0f) / 12.0f));
+        const float period = 1.0f / float (frequency);
+        const float periodInSamples = float (period * sampleRate);
+        deltas[(size_t) i] = 1.0f / periodInSamples;
 
-            auto& o = *oscillators[i];
+        leftGains[(size_t) i]  = gain * (1.0f - localPan) / voices;
+        rightGains[(size_t) i] = gain * (1.0f + localPan) / voices;
 
-            o.setGain (gain * panGain / voices);
-            o.setNote (note);
-            o.process (channelBuffer, 0, numSamples);
-        }
+        const int tableIndex = juce::jlimit (0, tables.size() - 1, int ((voiceNote - 0.5) / lookupTables->tablePerNumNotes));
+        upTables[(size_t) i] = tables[tableIndex];
+        downTables[(size_t) i] = lookupTables->sawDownFunctions[tableIndex];
     }
-    else
+}
+
+template<typename GetValueFunction>
+void MultiVoiceOscillator::processVoices (float* left, float* right, int numVoices, int numSamples, GetValueFunction&& getValue)
+{
+    auto phase = phases.data();
+    auto delta = deltas.data();
+    auto leftGain = leftGains.data();
+    auto rightGain = rightGains.data();
+
+    for (int samp = 0; samp < numSamples; samp++)
     {
-        for (int i = 0; i < std::min (voices * 2, oscillators.size()); i++)
+        float l = 0, r = 0;
+
+        for (int i = 0; i < numVoices; i++)
         {
-            int voiceIndex = (i / 2);
-            float localPan = juce::jlimit (-1.0f, 1.0f, ((voiceIndex % 2 == 0) ? 1 : -1) * spread);
+            const float value = getValue (i, phase[i]);
+            l += value * leftGain[i];
+            r += value * rightGain[i];
 
-            float leftGain  = 1.0f - localPan;
-            float rightGain = 1.0f + localPan;
+            // The delta is never more than 0.5 so this only needs to wrap once
+            phase[i] += delta[i];
+            phase[i] = phase[i] >= 1.0f ? phase[i] - 1.0f : phase[i];
+        }
 
-            float base = note - detune / 2;
-            float delta = detune / (voices - 1);
-            bool left = (i % 2) == 0;
-            float panGain = left ? leftGain : rightGain;
+        left[samp] += l;
+        right[samp] += r;
+    }
+}
 
-            float* data = buffer.getWritePointer (left ? 0 : 1, startSample);
-            float* dataPointers[] = {data};
+void MultiVoiceOscillator::process (juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    if (lookupTables == nullptr || wave == Oscillator::none)
+        return;
 
-            juce::AudioBuffer<float> channelBuffer (dataPointers, 1, numSamples);
+    const int numVoices = std::min (voices, maxVoices);
+    updateVoices (numVoices);
 
-            auto& o = *oscillators[i];
+    auto left  = buffer.getWritePointer (0, startSample);
+    auto right = buffer.getWritePointer (1, startSample);
 
-            o.setGain (gain * panGain / voices);
-            o.setNote (base + delta * (i / 2));
-            o.process (channelBuffer, 0, numSamples);
+    switch (wave)
+    {
+        case Oscillator::none:
+            break;
+
+        case Oscillator::sine:
+        {
+            auto& sine = lookupTables->sineFunction;
+            processVoices (left, right, numVoices, numSamples,
+                           [&sine] (int, float phase) { return sine[phase]; });
+            break;
+        }
+
+        case Oscillator::saw:
+        case Oscillator::triangle:
+        {
+            auto tables = upTables.data();
+            processVoices (left, right, numVoices, numSamples,
+                           [tables] (int i, float phase) { return tables[i]->processSampleUnchecked (phase); });
+            break;
+        }
+
+        case Oscillator::square:
+        {
+            auto tables1 = upTables.data();
+            auto tables2 = downTables.data();
+            const float halfWidth = 0.5f * pulseWidth;
+
+            processVoices (left, right, numVoices, numSamples,
+                           [tables1, tables2, halfWidth] (int i, float phase)
+                           {
+                               float phaseUp   = phase + halfWidth;
+                               float phaseDown = phase - halfWidth;
+
+                               if (phaseUp   > 1.0f) phaseUp   -= 1.0f;
+                               if (phaseDown < 0.0f) phaseDown += 1.0f;
+
+                               return tables1[i]->processSampleUnchecked (phaseUp)
+                                        + tables2[i]->processSampleUnchecked (phaseDown);
+                           });
+            break;
+        }
+
+        case Oscillator::noise:
+        {
+            processVoices (left, right, numVoices, numSamples,
+                           [this] (int i, float) { return normalDistributions[(size_t) i] (generators[(size_t) i]); });
+            break;
         }
     }
 }
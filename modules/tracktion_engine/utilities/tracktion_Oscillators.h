@@ -83,6 +83,14 @@ private:
 };
 
 //==============================================================================
+/**
+    A set of detuned, panned Oscillators.
+
+    The unison voices are stored as a structure of arrays and rendered together
+    a sample at a time, so the phase updates and interpolation run across voices
+    in SIMD lanes. The left and right channels of each voice share a phase and a
+    single table lookup.
+*/
 class MultiVoiceOscillator
 {
 public:
@@ -103,10 +111,25 @@ public:
     void process (juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
 
 private:
-    juce::OwnedArray<Oscillator> oscillators;
+    using LookupTable = juce::dsp::LookupTableTransform<float>;
+
+    void updateVoices (int numVoices);
+
+    template<typename GetValueFunction>
+    void processVoices (float* left, float* right, int numVoices, int numSamples, GetValueFunction&&);
+
+    const int maxVoices;
+    BandlimitedWaveLookupTables::Ptr lookupTables;
+    double sampleRate = 44100.0;
+    Oscillator::Waves wave = Oscillator::sine;
+
+    std::vector<float> phases, deltas, leftGains, rightGains;
+    std::vector<const LookupTable*> upTables, downTables;
+    std::vector<std::default_random_engine> generators;
+    std::vector<std::normal_distribution<float>> normalDistributions;
 
     int voices = 1;
-    float detune = 0, spread = 0, gain = 1.0f, note = 69.0f, pan = 0.0f;
+    float detune = 0, spread = 0, gain = 1.0f, note = 69.0f, pan = 0.0f, pulseWidth = 0.5f;
 };
 
 }} // namespace tracktion { inline namespace engine
@@ -0,0 +1,781 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+
+namespace tracktion { inline namespace engine
+{
+
+namespace convolution_utils
+{
+    static int getFFTOrder (int fftSize)
+    {
+        jassert (juce::isPowerOfTwo (fftSize));
+        return juce::findHighestSetBit ((uint32_t) fftSize);
+    }
+
+    static juce::AudioBuffer<float> resample (const juce::AudioBuffer<float>& source, double sourceRate, double destRate)
+    {
+        const auto ratio = sourceRate / destRate;
+        const auto numChannels = source.getNumChannels();
+        const auto numSamples = (int) std::ceil (source.getNumSamples() / ratio);
+
+        // The interpolator reads a few samples ahead so pad the end with silence
+        juce::AudioBuffer<float> padded (numChannels, source.getNumSamples() + (int) std::ceil (ratio) + 8);
+        padded.clear();
+
+        juce::AudioBuffer<float> result (numChannels, numSamples);
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            padded.copyFrom (c, 0, source, c, 0, source.getNumSamples());
+
+            juce::LagrangeInterpolator interpolator;
+            interpolator.process (ratio, padded.getReadPointer (c), result.getWritePointer (c), numSamples);
+        }
+
+        return result;
+    }
+
+    static juce::AudioBuffer<float> trimSilence (const juce::AudioBuffer<float>& source)
+    {
+        const auto threshold = juce::Decibels::decibelsToGain (-80.0f);
+        const auto numSamples = source.getNumSamples();
+        int start = numSamples, end = 0;
+
+        for (int c = 0; c < source.getNumChannels(); ++c)
+        {
+            auto data = source.getReadPointer (c);
+
+            for (int i = 0; i < start; ++i)
+            {
+                if (std::abs (data[i]) >= threshold)
+                {
+                    start = i;
+                    break;
+                }
+            }
+
+            for (int i = numSamples; --i >= end;)
+            {
+                if (std::abs (data[i]) >= threshold)
+                {
+                    end = i + 1;
+                    break;
+                }
+            }
+        }
+
+        if (start >= end)
+            return juce::AudioBuffer<float> (source.getNumChannels(), 1);
+
+        juce::AudioBuffer<float> result (source.getNumChannels(), end - start);
+
+        for (int c = 0; c < source.getNumChannels(); ++c)
+            result.copyFrom (c, 0, source, c, start, end - start);
+
+        return result;
+    }
+
+    static void normalise (juce::AudioBuffer<float>& buffer)
+    {
+        float maxSumOfSquares = 0.0f;
+
+        for (int c = 0; c < buffer.getNumChannels(); ++c)
+        {
+            auto data = buffer.getReadPointer (c);
+            maxSumOfSquares = std::max (maxSumOfSquares,
+                                        std::accumulate (data, data + buffer.getNumSamples(), 0.0f,
+                                                         [] (float sum, float s) { return sum + s * s; }));
+        }
+
+        // This matches the level of a normalised juce::dsp::Convolution
+        if (maxSumOfSquares > 0.0f)
+            buffer.applyGain (0.125f / std::sqrt (maxSumOfSquares));
+    }
+
+    static PartitionedImpulseResponse::Partitions createPartitions (const float* data, int numSamples, int partitionSize)
+    {
+        PartitionedImpulseResponse::Partitions partitions;
+        partitions.partitionSize = partitionSize;
+        partitions.numPartitions = std::max (0, (numSamples + partitionSize - 1) / partitionSize);
+
+        const auto fftSize = partitionSize * 2;
+        const auto numBinFloats = (size_t) (partitionSize + 1) * 2;
+        juce::dsp::FFT fft (getFFTOrder (fftSize));
+        std::vector<float> fftData ((size_t) fftSize * 2);
+        partitions.spectra.resize ((size_t) partitions.numPartitions * numBinFloats);
+
+        for (int i = 0; i < partitions.numPartitions; ++i)
+        {
+            const auto start = i * partitionSize;
+            const auto num = std::min (partitionSize, numSamples - start);
+
+            std::fill (fftData.begin(), fftData.end(), 0.0f);
+            std::copy (data + start, data + start + num, fftData.begin());
+            fft.performRealOnlyForwardTransform (fftData.data(), true);
+
+            std::copy (fftData.begin(), fftData.begin() + (std::ptrdiff_t) numBinFloats,
+                       partitions.spectra.begin() + (std::ptrdiff_t) ((size_t) i * numBinFloats));
+        }
+
+        return partitions;
+    }
+}
+
+//==============================================================================
+PartitionedImpulseResponse::PartitionedImpulseResponse (juce::AudioBuffer<float> ir, double irSampleRate, const Options& o)
+    : options (o)
+{
+    using namespace convolution_utils;
+    jassert (juce::isPowerOfTwo (options.headPartitionSize));
+    jassert (ir.getNumChannels() > 0);
+
+    if (irSampleRate > 0.0 && irSampleRate != options.sampleRate)
+        ir = resample (ir, irSampleRate, options.sampleRate);
+
+    if (options.trimSilence)
+        ir = trimSilence (ir);
+
+    if (options.normalise)
+        normalise (ir);
+
+    length = ir.getNumSamples();
+
+    // The head covers the first two tail partitions, which gives the background
+    // threads a whole tail partition to convolve each block in
+    const auto headLength = std::min (length, getTailPartitionSize() * 2);
+
+    for (int c = 0; c < ir.getNumChannels(); ++c)
+    {
+        auto data = ir.getReadPointer (c);
+
+        Channel channel;
+        channel.head = createPartitions (data, headLength, getHeadPartitionSize());
+        channel.tail = createPartitions (data + headLength, length - headLength, getTailPartitionSize());
+        channels.push_back (std::move (channel));
+    }
+}
+
+std::shared_ptr<const PartitionedImpulseResponse> PartitionedImpulseResponse::create (const juce::MemoryBlock& audioFileData, const Options& o)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    if (auto reader = std::unique_ptr<juce::AudioFormatReader> (formatManager.createReaderFor (std::make_unique<juce::MemoryInputStream> (audioFileData, false))))
+    {
+        if (reader->numChannels == 0 || reader->lengthInSamples <= 0)
+            return {};
+
+        juce::AudioBuffer<float> buffer ((int) reader->numChannels, (int) reader->lengthInSamples);
+        reader->read (&buffer, 0, buffer.getNumSamples(), 0, true, true);
+
+        return std::make_shared<const PartitionedImpulseResponse> (std::move (buffer), reader->sampleRate, o);
+    }
+
+    return {};
+}
+
+size_t PartitionedImpulseResponse::getNumBytesUsed() const noexcept
+{
+    size_t numBytes = 0;
+
+    for (auto& c : channels)
+        numBytes += (c.head.spectra.size() + c.tail.spectra.size()) * sizeof (float);
+
+    return numBytes;
+}
+
+//==============================================================================
+ImpulseResponseCache& ImpulseResponseCache::getInstance()
+{
+    static ImpulseResponseCache cache;
+    return cache;
+}
+
+std::shared_ptr<const PartitionedImpulseResponse> ImpulseResponseCache::getImpulseResponse (const juce::MemoryBlock& audioFileData,
+                                                                                            const PartitionedImpulseResponse::Options& options)
+{
+    CRASH_TRACER
+    const auto hash = std::hash<std::string_view>() (std::string_view (static_cast<const char*> (audioFileData.getData()),
+                                                                       audioFileData.getSize()));
+
+    // The lock is held while creating the IR so two threads asking for the same IR don't both create it
+    const std::scoped_lock sl (mutex);
+    removeUnusedEntries();
+
+    for (auto& e : entries)
+        if (e.hash == hash && e.dataSize == audioFileData.getSize() && e.options == options)
+            if (auto ir = e.impulseResponse.lock())
+                return ir;
+
+    auto ir = PartitionedImpulseResponse::create (audioFileData, options);
+
+    if (ir != nullptr)
+        entries.push_back ({ hash, audioFileData.getSize(), options, ir });
+
+    return ir;
+}
+
+int ImpulseResponseCache::getNumImpulseResponses()
+{
+    const std::scoped_lock sl (mutex);
+    removeUnusedEntries();
+    return (int) entries.size();
+}
+
+void ImpulseResponseCache::removeUnusedEntries()
+{
+    std::erase_if (entries, [] (auto& e) { return e.impulseResponse.expired(); });
+}
+
+//==============================================================================
+/** A uniformly partitioned overlap-add convolver for one set of partitions. */
+struct PartitionedConvolver::UniformConvolver
+{
+    UniformConvolver (const PartitionedImpulseResponse::Partitions& p)
+        : partitions (p),
+          partitionSize (p.partitionSize),
+          fftSize (p.partitionSize * 2),
+          numBinFloats ((p.partitionSize + 1) * 2),
+          fft (convolution_utils::getFFTOrder (fftSize))
+    {
+        segments.resize ((size_t) std::max (1, partitions.numPartitions) * (size_t) numBinFloats);
+        inputData.resize ((size_t) partitionSize);
+        fftData.resize ((size_t) fftSize * 2);
+        accumulated.resize ((size_t) numBinFloats);
+        overlap.resize ((size_t) partitionSize);
+    }
+
+    void reset() noexcept
+    {
+        std::fill (segments.begin(), segments.end(), 0.0f);
+        std::fill (inputData.begin(), inputData.end(), 0.0f);
+        std::fill (overlap.begin(), overlap.end(), 0.0f);
+        inputPosition = 0;
+        currentSegment = 0;
+    }
+
+    /** Convolves any number of samples with no latency. This transforms the
+        partial input block on every call, so is only used for the small head partitions.
+    */
+    void processImmediate (const float* input, float* output, int numSamples) noexcept
+    {
+        if (partitions.numPartitions == 0)
+        {
+            std::fill (output, output + numSamples, 0.0f);
+            return;
+        }
+
+        for (int done = 0; done < numSamples;)
+        {
+            const bool isNewBlock = inputPosition == 0;
+            const auto num = std::min (numSamples - done, partitionSize - inputPosition);
+            std::copy (input + done, input + done + num, inputData.begin() + inputPosition);
+
+            auto segment = transformInput (inputData.data(), currentSegment);
+
+            // The older segments don't change during a block so are only accumulated once
+            if (isNewBlock)
+            {
+                std::fill (accumulated.begin(), accumulated.end(), 0.0f);
+
+                for (int i = 1; i < partitions.numPartitions; ++i)
+                    multiplyAccumulate (getSegment ((currentSegment + i) % partitions.numPartitions),
+                                        partitions.getPartition (i), accumulated.data());
+            }
+
+            std::copy (accumulated.begin(), accumulated.end(), fftData.begin());
+            multiplyAccumulate (segment, partitions.getPartition (0), fftData.data());
+            inverseTransform();
+
+            juce::FloatVectorOperations::add (output + done, fftData.data() + inputPosition,
+                                              overlap.data() + inputPosition, num);
+            inputPosition += num;
+            done += num;
+
+            if (inputPosition == partitionSize)
+            {
+                std::copy (fftData.begin() + partitionSize, fftData.begin() + fftSize, overlap.begin());
+                std::fill (inputData.begin(), inputData.end(), 0.0f);
+                nextSegment();
+            }
+        }
+    }
+
+    /** Convolves a whole partition of input. */
+    void processBlock (const float* input, float* output) noexcept
+    {
+        if (partitions.numPartitions == 0)
+        {
+            std::fill (output, output + partitionSize, 0.0f);
+            return;
+        }
+
+        transformInput (input, currentSegment);
+        std::fill (fftData.begin(), fftData.begin() + numBinFloats, 0.0f);
+
+        for (int i = 0; i < partitions.numPartitions; ++i)
+            multiplyAccumulate (getSegment ((currentSegment + i) % partitions.numPartitions),
+                                partitions.getPartition (i), fftData.data());
+
+        inverseTransform();
+        juce::FloatVectorOperations::add (output, fftData.data(), overlap.data(), partitionSize);
+        std::copy (fftData.begin() + partitionSize, fftData.begin() + fftSize, overlap.begin());
+        nextSegment();
+    }
+
+    const PartitionedImpulseResponse::Partitions& partitions;
+    const int partitionSize, fftSize, numBinFloats;
+
+private:
+    juce::dsp::FFT fft;
+    std::vector<float> segments, inputData, fftData, accumulated, overlap;
+    int inputPosition = 0, currentSegment = 0;
+
+    float* getSegment (int index) noexcept
+    {
+        return segments.data() + (size_t) index * (size_t) numBinFloats;
+    }
+
+    float* transformInput (const float* input, int index) noexcept
+    {
+        std::copy (input, input + partitionSize, fftData.begin());
+        std::fill (fftData.begin() + partitionSize, fftData.end(), 0.0f);
+        fft.performRealOnlyForwardTransform (fftData.data(), true);
+
+        auto segment = getSegment (index);
+        std::copy (fftData.begin(), fftData.begin() + numBinFloats, segment);
+        return segment;
+    }
+
+    void inverseTransform() noexcept
+    {
+        // Fill in the negative frequencies as not all FFT engines ignore them
+        for (int i = partitionSize + 1; i < fftSize; ++i)
+        {
+            fftData[(size_t) (2 * i)]     =  fftData[(size_t) (2 * (fftSize - i))];
+            fftData[(size_t) (2 * i + 1)] = -fftData[(size_t) (2 * (fftSize - i) + 1)];
+        }
+
+        fft.performRealOnlyInverseTransform (fftData.data());
+    }
+
+    void nextSegment() noexcept
+    {
+        inputPosition = 0;
+        currentSegment = currentSegment > 0 ? currentSegment - 1
+                                            : partitions.numPartitions - 1;
+    }
+
+    static void multiplyAccumulate (const float* a, const float* b, float* dest, int numFloats) noexcept
+    {
+        for (int i = 0; i < numFloats; i += 2)
+        {
+            dest[i]     += a[i] * b[i]     - a[i + 1] * b[i + 1];
+            dest[i + 1] += a[i] * b[i + 1] + a[i + 1] * b[i];
+        }
+    }
+
+    void multiplyAccumulate (const float* a, const float* b, float* dest) const noexcept
+    {
+        multiplyAccumulate (a, b, dest, numBinFloats);
+    }
+};
+
+//==============================================================================
+/** The background threads shared by all the convolvers. */
+class PartitionedConvolver::TailThreads
+{
+public:
+    TailThreads()
+    {
+        const auto numThreads = std::max (1, juce::SystemStats::getNumCpus() / 2);
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            workers.push_back (std::make_unique<Worker> (*this));
+
+            // The audio thread may have to wait for a job that's running so these
+            // mustn't be pre-empted by lower priority threads
+            if (! workers.back()->startRealtimeThread ({}))
+                workers.back()->startThread (juce::Thread::Priority::highest);
+        }
+    }
+
+    ~TailThreads()
+    {
+        for (auto& w : workers)
+            w->signalThreadShouldExit();
+
+        for (auto& w : workers)
+        {
+            event.signal();
+            w->stopThread (5000);
+        }
+    }
+
+    void addJob (TailJob& job)
+    {
+        const std::scoped_lock sl (mutex);
+        jobs.push_back (&job);
+    }
+
+    void removeJob (TailJob& job)
+    {
+        const std::scoped_lock sl (mutex);
+        std::erase (jobs, &job);
+    }
+
+    void notify() noexcept
+    {
+        event.signal();
+    }
+
+private:
+    struct Worker  : public juce::Thread
+    {
+        Worker (TailThreads& o)
+            : juce::Thread ("Convolution"), owner (o)
+        {
+        }
+
+        void run() override;
+
+        TailThreads& owner;
+    };
+
+    std::mutex mutex;
+    std::vector<TailJob*> jobs;
+    juce::WaitableEvent event;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    TailJob* claimJob();
+};
+
+//==============================================================================
+/** A tail partition's worth of input waiting to be convolved. */
+struct PartitionedConvolver::TailJob
+{
+    TailJob (const PartitionedImpulseResponse::Partitions& p)
+        : convolver (p),
+          input ((size_t) p.partitionSize),
+          output ((size_t) p.partitionSize)
+    {
+        threads->addJob (*this);
+    }
+
+    ~TailJob()
+    {
+        threads->removeJob (*this);
+        waitUntilFinished();
+    }
+
+    /** Called by the audio thread to hand the input over. */
+    void start() noexcept
+    {
+        state.store (pending, std::memory_order_release);
+        threads->notify();
+    }
+
+    /** Called by the audio thread when it needs the output. If the job hasn't
+        been started yet, it's run on this thread, otherwise this waits for the
+        worker running it, spinning briefly before blocking.
+    */
+    void waitUntilFinished() noexcept
+    {
+        if (state.load (std::memory_order_acquire) == idle)
+            return;
+
+        if (claim())
+            run();
+        else
+            finishedOnWorker.wait();
+
+        state.store (idle, std::memory_order_relaxed);
+    }
+
+    bool claim() noexcept
+    {
+        auto expected = pending;
+        return state.compare_exchange_strong (expected, running, std::memory_order_acquire);
+    }
+
+    void run() noexcept
+    {
+        convolver.processBlock (input.data(), output.data());
+        state.store (finished, std::memory_order_release);
+    }
+
+    enum State { idle, pending, running, finished };
+
+    UniformConvolver convolver;
+    std::vector<float> input, output;
+    std::atomic<State> state { idle };
+    graph::LightweightSemaphore finishedOnWorker;
+    juce::SharedResourcePointer<TailThreads> threads;
+};
+
+void PartitionedConvolver::TailThreads::Worker::run()
+{
+    juce::FloatVectorOperations::disableDenormalisedNumberSupport();
+
+    while (! threadShouldExit())
+    {
+        if (auto job = owner.claimJob())
+        {
+            // Wake another thread in case there are more jobs waiting
+            owner.event.signal();
+            job->run();
+            job->finishedOnWorker.signal();
+        }
+        else
+        {
+            owner.event.wait (100);
+        }
+    }
+}
+
+PartitionedConvolver::TailJob* PartitionedConvolver::TailThreads::claimJob()
+{
+    const std::scoped_lock sl (mutex);
+
+    for (auto job : jobs)
+        if (job->claim())
+            return job;
+
+    return nullptr;
+}
+
+//==============================================================================
+PartitionedConvolver::PartitionedConvolver (std::shared_ptr<const PartitionedImpulseResponse> ir, int channel)
+    : impulseResponse (std::move (ir))
+{
+    jassert (impulseResponse != nullptr);
+    auto& partitions = impulseResponse->channels[(size_t) juce::jlimit (0, impulseResponse->getNumChannels() - 1, channel)];
+
+    head = std::make_unique<UniformConvolver> (partitions.head);
+
+    if (partitions.tail.numPartitions > 0)
+    {
+        tail = std::make_unique<TailJob> (partitions.tail);
+        tailInput.resize ((size_t) partitions.tail.partitionSize);
+        tailOutput.resize ((size_t) partitions.tail.partitionSize);
+    }
+}
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+}
+
+void PartitionedConvolver::process (const float* input, float* output, int numSamples) noexcept
+{
+    if (tail == nullptr)
+        return head->processImmediate (input, output, numSamples);
+
+    const auto tailSize = (int) tailInput.size();
+
+    for (int done = 0; done < numSamples;)
+    {
+        const auto num = std::min (numSamples - done, tailSize - tailPosition);
+
+        // Take a copy of the input first as the output may be the same buffer
+        std::copy (input + done, input + done + num, tailInput.begin() + tailPosition);
+        head->processImmediate (input + done, output + done, num);
+        juce::FloatVectorOperations::add (output + done, tailOutput.data() + tailPosition, num);
+
+        tailPosition += num;
+        done += num;
+
+        if (tailPosition == tailSize)
+        {
+            // The previous job's output covers the next partition, then this
+            // partition's input is handed over to be ready for the one after
+            tailPosition = 0;
+            tail->waitUntilFinished();
+            std::swap (tailOutput, tail->output);
+            std::swap (tailInput, tail->input);
+            tail->start();
+        }
+    }
+}
+
+void PartitionedConvolver::reset() noexcept
+{
+    head->reset();
+
+    if (tail != nullptr)
+    {
+        tail->waitUntilFinished();
+        tail->convolver.reset();
+        std::fill (tailInput.begin(), tailInput.end(), 0.0f);
+        std::fill (tailOutput.begin(), tailOutput.end(), 0.0f);
+        std::fill (tail->output.begin(), tail->output.end(), 0.0f);
+        tailPosition = 0;
+    }
+}
+
+//==============================================================================
+struct PartitionedConvolution::ConvolverSet
+{
+    ConvolverSet (std::shared_ptr<const PartitionedImpulseResponse> ir, int numChannels)
+    {
+        for (int c = 0; c < numChannels; ++c)
+            convolvers.push_back (std::make_unique<PartitionedConvolver> (ir, c));
+    }
+
+    void process (const juce::dsp::AudioBlock<float>& block, int numSamples) noexcept
+    {
+        for (size_t c = 0; c < std::min (convolvers.size(), block.getNumChannels()); ++c)
+            convolvers[c]->process (block.getChannelPointer (c), block.getChannelPointer (c), numSamples);
+    }
+
+    std::vector<std::unique_ptr<PartitionedConvolver>> convolvers;
+};
+
+PartitionedConvolution::PartitionedConvolution()
+{
+}
+
+PartitionedConvolution::~PartitionedConvolution()
+{
+}
+
+void PartitionedConvolution::prepare (const juce::dsp::ProcessSpec& newSpec)
+{
+    spec = newSpec;
+    fadeBuffer.setSize ((int) spec.numChannels, (int) spec.maximumBlockSize);
+    fadeLength = juce::roundToInt (spec.sampleRate * 0.05);
+    fadeSamplesRemaining = 0;
+
+    std::unique_ptr<ConvolverSet> oldActive, oldPending, oldRetired, oldFinished;
+
+    {
+        const juce::SpinLock::ScopedLockType sl (swapLock);
+        oldPending = std::move (pending);
+        oldRetired = std::move (retired);
+        oldFinished = std::move (finished);
+    }
+
+    oldActive = std::move (active);
+
+    // Keep the IR if it suits the new spec so re-preparing doesn't create it again
+    if (currentImpulseResponse != nullptr)
+    {
+        auto& options = currentImpulseResponse->options;
+
+        if (options == getImpulseResponseOptions (options.normalise, options.trimSilence))
+            active = std::make_unique<ConvolverSet> (currentImpulseResponse, (int) spec.numChannels);
+        else
+            currentImpulseResponse.reset();
+    }
+}
+
+void PartitionedConvolution::reset() noexcept
+{
+    fadeSamplesRemaining = 0;
+
+    if (active != nullptr)
+        for (auto& c : active->convolvers)
+            c->reset();
+}
+
+void PartitionedConvolution::process (const juce::dsp::ProcessContextReplacing<float>& context) noexcept
+{
+    if (context.isBypassed)
+        return;
+
+    auto& block = context.getOutputBlock();
+    const auto numSamples = (int) block.getNumSamples();
+
+    // If the message thread is swapping the sets the next block will pick up the new IR.
+    // A new IR waits for any fade in progress to finish so the fade is never cut short
+    if (const juce::SpinLock::ScopedTryLockType sl (swapLock); sl.isLocked())
+    {
+        if (retired != nullptr && fadeSamplesRemaining == 0 && finished == nullptr)
+            finished = std::move (retired);
+
+        if (pending != nullptr && retired == nullptr)
+        {
+            retired = std::exchange (active, std::move (pending));
+            fadeSamplesRemaining = retired != nullptr ? fadeLength : 0;
+        }
+    }
+
+    if (active == nullptr)
+        return;
+
+    const auto numToFade = std::min ({ numSamples, fadeSamplesRemaining, fadeBuffer.getNumSamples() });
+
+    if (numToFade > 0)
+    {
+        // The old IR carries on for the length of the fade then the new one takes over
+        auto fadeBlock = juce::dsp::AudioBlock<float> (fadeBuffer).getSubsetChannelBlock (0, std::min (block.getNumChannels(), (size_t) fadeBuffer.getNumChannels()))
+                                                                  .getSubBlock (0, (size_t) numToFade);
+        fadeBlock.copyFrom (block.getSubBlock (0, (size_t) numToFade));
+        retired->process (fadeBlock, numToFade);
+        active->process (block, numSamples);
+
+        const auto startGain = 1.0f - fadeSamplesRemaining / (float) fadeLength;
+        const auto gainDelta = 1.0f / (float) fadeLength;
+
+        for (size_t c = 0; c < fadeBlock.getNumChannels(); ++c)
+        {
+            auto dest = block.getChannelPointer (c);
+            auto old = fadeBlock.getChannelPointer (c);
+
+            for (int i = 0; i < numToFade; ++i)
+            {
+                const auto gain = startGain + i * gainDelta;
+                dest[i] = dest[i] * gain + old[i] * (1.0f - gain);
+            }
+        }
+
+        fadeSamplesRemaining -= numToFade;
+
+        if (numToFade < numSamples)
+            fadeSamplesRemaining = 0;
+    }
+    else
+    {
+        active->process (block, numSamples);
+    }
+}
+
+PartitionedImpulseResponse::Options PartitionedConvolution::getImpulseResponseOptions (bool normalise, bool trimSilence) const
+{
+    jassert (spec.sampleRate > 0.0);
+
+    PartitionedImpulseResponse::Options options;
+    options.sampleRate = spec.sampleRate;
+    options.headPartitionSize = juce::nextPowerOfTwo (std::max (64, (int) spec.maximumBlockSize));
+    options.normalise = normalise;
+    options.trimSilence = trimSilence;
+    return options;
+}
+
+void PartitionedConvolution::setImpulseResponse (std::shared_ptr<const PartitionedImpulseResponse> ir)
+{
+    if (ir == nullptr)
+        return;
+
+    jassert (ir->options.sampleRate == spec.sampleRate);
+    currentImpulseResponse = ir;
+    auto newSet = std::make_unique<ConvolverSet> (std::move (ir), (int) spec.numChannels);
+    std::unique_ptr<ConvolverSet> oldPending, oldFinished;
+
+    // The old sets are deleted outside the lock
+    {
+        const juce::SpinLock::ScopedLockType sl (swapLock);
+        oldPending = std::exchange (pending, std::move (newSet));
+        oldFinished = std::move (finished);
+    }
+}
+
+}} // namespace tracktion { inline namespace engine
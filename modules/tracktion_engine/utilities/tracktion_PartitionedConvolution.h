@@ -0,0 +1,249 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+/**
+    An impulse response that has been resampled, trimmed, normalised and split
+    in to the frequency domain partitions a PartitionedConvolver uses.
+
+    These are immutable once created so can be shared by any number of
+    convolvers on any thread. Use the ImpulseResponseCache to get one so that
+    several plugins using the same IR only decode and transform it once.
+
+    The start of the IR is split in to small "head" partitions which are
+    convolved on the audio thread. The rest is split in to "tail" partitions
+    tailPartitionMultiple times larger which are convolved on background threads.
+*/
+class PartitionedImpulseResponse
+{
+public:
+    //==============================================================================
+    /** The settings an IR is prepared with. */
+    struct Options
+    {
+        double sampleRate = 44100.0;    ///< The sample rate the IR will be used at, it's resampled if this differs from the source
+        int headPartitionSize = 128;    ///< The size of the audio thread partitions, this must be a power of 2
+        bool normalise = true;          ///< Normalises the IR's energy
+        bool trimSilence = false;       ///< Trims silence from the start and end of the IR
+
+        bool operator== (const Options&) const = default;
+    };
+
+    /** The size of the tail partitions relative to the head partitions. */
+    static constexpr int tailPartitionMultiple = 8;
+
+    /** Creates an IR from a buffer at the given sample rate. */
+    PartitionedImpulseResponse (juce::AudioBuffer<float> impulseResponse,
+                                double impulseResponseSampleRate,
+                                const Options&);
+
+    /** Creates an IR from the data of an audio file e.g. a WAV or FLAC file.
+        Returns nullptr if the data couldn't be read.
+    */
+    static std::shared_ptr<const PartitionedImpulseResponse> create (const juce::MemoryBlock& audioFileData, const Options&);
+
+    //==============================================================================
+    /** The options the IR was prepared with. */
+    const Options options;
+
+    /** Returns the number of channels in the IR. */
+    int getNumChannels() const noexcept             { return (int) channels.size(); }
+
+    /** Returns the length of the IR in samples at the Options sample rate. */
+    int getLength() const noexcept                  { return length; }
+
+    /** Returns the size of the partitions convolved on the audio thread. */
+    int getHeadPartitionSize() const noexcept       { return options.headPartitionSize; }
+
+    /** Returns the size of the partitions convolved on background threads. */
+    int getTailPartitionSize() const noexcept       { return options.headPartitionSize * tailPartitionMultiple; }
+
+    /** Returns the number of bytes used by the partitions. */
+    size_t getNumBytesUsed() const noexcept;
+
+    //==============================================================================
+    /** @internal */
+    struct Partitions
+    {
+        int partitionSize = 0, numPartitions = 0;
+        std::vector<float> spectra; // partitionSize + 1 interleaved complex bins per partition
+
+        const float* getPartition (int index) const noexcept
+        {
+            return spectra.data() + (size_t) index * (size_t) (partitionSize + 1) * 2;
+        }
+    };
+
+    /** @internal */
+    struct Channel
+    {
+        Partitions head, tail;
+    };
+
+    /** @internal */
+    std::vector<Channel> channels;
+
+private:
+    int length = 0;
+};
+
+
+//==============================================================================
+/**
+    Keeps track of the PartitionedImpulseResponses in use by the process so
+    identical IRs are only decoded and partitioned once.
+
+    IRs are identified by a hash of their audio file data and their Options.
+    The cache only holds weak references so an IR is freed as soon as the last
+    convolver using it has been deleted.
+*/
+class ImpulseResponseCache
+{
+public:
+    /** Returns the process-wide cache. */
+    static ImpulseResponseCache& getInstance();
+
+    /** Returns an IR for some audio file data, creating it if there isn't already
+        one in use with the same data and options.
+        Returns nullptr if the data couldn't be read.
+    */
+    std::shared_ptr<const PartitionedImpulseResponse> getImpulseResponse (const juce::MemoryBlock& audioFileData,
+                                                                          const PartitionedImpulseResponse::Options&);
+
+    /** Returns the number of IRs currently in use. */
+    int getNumImpulseResponses();
+
+private:
+    struct Entry
+    {
+        size_t hash = 0, dataSize = 0;
+        PartitionedImpulseResponse::Options options;
+        std::weak_ptr<const PartitionedImpulseResponse> impulseResponse;
+    };
+
+    std::mutex mutex;
+    std::vector<Entry> entries;
+
+    ImpulseResponseCache() = default;
+    void removeUnusedEntries();
+};
+
+
+//==============================================================================
+/**
+    Convolves a single channel with zero latency using a non-uniform partitioning
+    of a PartitionedImpulseResponse.
+
+    The head partitions are convolved on the calling thread. Each time a tail
+    partition's worth of input has been collected it's handed to a set of
+    real-time background threads shared by all the convolvers, and the result
+    isn't needed until a whole tail partition later. If the background threads
+    haven't started the job by then, the calling thread does it itself so the
+    audio thread only ever waits on a job that's already running.
+*/
+class PartitionedConvolver
+{
+public:
+    /** Creates a convolver for one of the IR's channels. */
+    PartitionedConvolver (std::shared_ptr<const PartitionedImpulseResponse>, int impulseResponseChannel);
+
+    /** Destructor. */
+    ~PartitionedConvolver();
+
+    /** Convolves a block of samples. The input and output can be the same. */
+    void process (const float* input, float* output, int numSamples) noexcept;
+
+    /** Clears the convolver's history. */
+    void reset() noexcept;
+
+    /** Returns the IR being used. */
+    const PartitionedImpulseResponse& getImpulseResponse() const noexcept   { return *impulseResponse; }
+
+private:
+    struct UniformConvolver;
+    struct TailJob;
+    class TailThreads;
+
+    std::shared_ptr<const PartitionedImpulseResponse> impulseResponse;
+    std::unique_ptr<UniformConvolver> head;
+    std::unique_ptr<TailJob> tail;
+    std::vector<float> tailInput, tailOutput;
+    int tailPosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartitionedConvolver)
+};
+
+
+//==============================================================================
+/**
+    A multi-channel convolution processor that can be used in a juce::dsp::ProcessorChain
+    in place of a juce::dsp::Convolution.
+
+    IRs are set from the message thread and swapped in on the audio thread with a
+    short crossfade. With no IR set, the audio is passed through unchanged.
+
+    The audio thread owns the active and fading-out convolvers. Once a fade has
+    finished the old convolvers are handed back to be deleted by the next call to
+    setImpulseResponse or prepare, so nothing is freed on the audio thread.
+*/
+class PartitionedConvolution
+{
+public:
+    /** Creates an empty PartitionedConvolution. */
+    PartitionedConvolution();
+
+    /** Destructor. */
+    ~PartitionedConvolution();
+
+    /** Prepares the processor. If the current IR was created with the options
+        getImpulseResponseOptions now returns it's kept, otherwise it's removed and
+        a new one should be set.
+    */
+    void prepare (const juce::dsp::ProcessSpec&);
+
+    /** Clears the convolution's history. */
+    void reset() noexcept;
+
+    /** Convolves the block. */
+    void process (const juce::dsp::ProcessContextReplacing<float>&) noexcept;
+
+    /** The convolution doesn't add any latency. */
+    int getLatency() const noexcept                 { return 0; }
+
+    /** Returns the options an IR should be created with to be used with this processor. */
+    PartitionedImpulseResponse::Options getImpulseResponseOptions (bool normalise, bool trimSilence) const;
+
+    /** Sets the IR to use. This can be called while the audio thread is processing
+        but not at the same time as prepare.
+        A mono IR is applied to all channels.
+    */
+    void setImpulseResponse (std::shared_ptr<const PartitionedImpulseResponse>);
+
+    /** Returns the IR last set, which may still be waiting to be swapped in. */
+    std::shared_ptr<const PartitionedImpulseResponse> getImpulseResponse() const  { return currentImpulseResponse; }
+
+private:
+    struct ConvolverSet;
+
+    juce::dsp::ProcessSpec spec { 0.0, 0, 0 };
+    std::shared_ptr<const PartitionedImpulseResponse> currentImpulseResponse;
+    std::unique_ptr<ConvolverSet> active, pending, retired, finished;
+    juce::SpinLock swapLock;
+    juce::AudioBuffer<float> fadeBuffer;
+    int fadeLength = 0, fadeSamplesRemaining = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartitionedConvolution)
+};
+
+}} // namespace tracktion { inline namespace engine
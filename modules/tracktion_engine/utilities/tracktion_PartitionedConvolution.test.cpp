@@ -0,0 +1,197 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_CONVOLUTION
+
+#include <tracktion_engine/../3rd_party/doctest/tracktion_doctest.hpp>
+
+namespace tracktion::inline engine
+{
+
+TEST_SUITE ("tracktion_engine")
+{
+    static juce::AudioBuffer<float> createNoise (int numChannels, int numSamples, juce::Random& r)
+    {
+        juce::AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int c = 0; c < numChannels; ++c)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (c, i, r.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    TEST_CASE ("PartitionedConvolver matches direct convolution")
+    {
+        juce::Random r (42);
+        const int irLength = 5000, numSamples = 20000;
+        auto irBuffer = createNoise (1, irLength, r);
+        auto input = createNoise (1, numSamples, r);
+
+        PartitionedImpulseResponse::Options options;
+        options.headPartitionSize = 64;
+        options.normalise = false;
+
+        auto ir = std::make_shared<const PartitionedImpulseResponse> (irBuffer, options.sampleRate, options);
+        CHECK_EQ (ir->getLength(), irLength);
+        REQUIRE_EQ (ir->getNumChannels(), 1);
+        CHECK (ir->channels[0].tail.numPartitions > 0);
+
+        // Process in place with random block sizes so partitions are split across calls
+        PartitionedConvolver convolver (ir, 0);
+        juce::AudioBuffer<float> output (input);
+        auto data = output.getWritePointer (0);
+
+        for (int done = 0; done < numSamples;)
+        {
+            const auto num = std::min (numSamples - done, r.nextInt ({ 1, 300 }));
+            convolver.process (data + done, data + done, num);
+            done += num;
+        }
+
+        auto x = input.getReadPointer (0);
+        auto h = irBuffer.getReadPointer (0);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            double expected = 0.0;
+
+            for (int j = 0; j <= std::min (i, irLength - 1); ++j)
+                expected += h[j] * x[i - j];
+
+            REQUIRE_EQ (data[i], doctest::Approx (expected).epsilon (1.0e-3));
+        }
+    }
+
+    TEST_CASE ("ImpulseResponseCache shares IRs")
+    {
+        juce::Random r (1);
+        auto irBuffer = createNoise (2, 2000, r);
+        juce::MemoryBlock data;
+
+        if (auto writer = std::unique_ptr<juce::AudioFormatWriter> (juce::WavAudioFormat().createWriterFor (new juce::MemoryOutputStream (data, false),
+                                                                                                            44100.0, 2, 32, {}, 0)))
+            writer->writeFromAudioSampleBuffer (irBuffer, 0, irBuffer.getNumSamples());
+
+        auto& cache = ImpulseResponseCache::getInstance();
+        const auto numBefore = cache.getNumImpulseResponses();
+
+        PartitionedImpulseResponse::Options options;
+        auto first = cache.getImpulseResponse (data, options);
+        auto second = cache.getImpulseResponse (data, options);
+        REQUIRE (first != nullptr);
+        CHECK_EQ (first, second);
+        CHECK_EQ (first->getNumChannels(), 2);
+        CHECK_EQ (cache.getNumImpulseResponses(), numBefore + 1);
+
+        options.sampleRate = 48000.0;
+        auto resampled = cache.getImpulseResponse (data, options);
+        REQUIRE (resampled != nullptr);
+        CHECK_NE (resampled, first);
+        CHECK (resampled->getLength() > first->getLength());
+        CHECK_EQ (cache.getNumImpulseResponses(), numBefore + 2);
+
+        first.reset();
+        second.reset();
+        resampled.reset();
+        CHECK_EQ (cache.getNumImpulseResponses(), numBefore);
+
+        CHECK (cache.getImpulseResponse (juce::MemoryBlock (16, true), options) == nullptr);
+    }
+
+    TEST_CASE ("PartitionedConvolution keeps its IR when re-prepared")
+    {
+        juce::Random r (7);
+        auto irBuffer = createNoise (1, 3000, r);
+        auto input = createNoise (2, 256, r);
+
+        PartitionedConvolution convolution;
+        juce::dsp::ProcessSpec spec { 44100.0, 256, 2 };
+        convolution.prepare (spec);
+
+        auto ir = std::make_shared<const PartitionedImpulseResponse> (irBuffer, spec.sampleRate, convolution.getImpulseResponseOptions (true, false));
+        std::weak_ptr<const PartitionedImpulseResponse> weakIR = ir;
+        convolution.setImpulseResponse (std::move (ir));
+
+        // The same head partition size is used for block sizes up to the next power of 2
+        spec.maximumBlockSize = 200;
+        convolution.prepare (spec);
+        REQUIRE (! weakIR.expired());
+        CHECK (convolution.getImpulseResponse() == weakIR.lock());
+
+        // The kept IR is used straight away, without a fade from the dry signal
+        PartitionedConvolver expected (weakIR.lock(), 0);
+        juce::AudioBuffer<float> expectedOutput (input);
+        expected.process (expectedOutput.getWritePointer (0), expectedOutput.getWritePointer (0), 200);
+
+        juce::AudioBuffer<float> output (input);
+        juce::dsp::AudioBlock<float> block (output.getArrayOfWritePointers(), 2, 200);
+        convolution.process (juce::dsp::ProcessContextReplacing<float> (block));
+
+        for (int i = 0; i < 200; ++i)
+            REQUIRE_EQ (output.getSample (0, i), doctest::Approx (expectedOutput.getSample (0, i)));
+
+        spec.sampleRate = 48000.0;
+        convolution.prepare (spec);
+        CHECK (convolution.getImpulseResponse() == nullptr);
+        CHECK (weakIR.expired());
+    }
+
+    TEST_CASE ("PartitionedConvolution finishes a crossfade before starting the next")
+    {
+        PartitionedConvolution convolution;
+        const juce::dsp::ProcessSpec spec { 44100.0, 256, 1 };
+        convolution.prepare (spec);
+
+        // Single sample IRs turn a DC input in to the IR's gain
+        auto createIR = [&] (float gain)
+        {
+            juce::AudioBuffer<float> buffer (1, 1);
+            buffer.setSample (0, 0, gain);
+            return std::make_shared<const PartitionedImpulseResponse> (buffer, spec.sampleRate, convolution.getImpulseResponseOptions (false, false));
+        };
+
+        std::vector<float> output;
+
+        auto processBlocks = [&] (int numBlocks)
+        {
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                juce::AudioBuffer<float> buffer (1, (int) spec.maximumBlockSize);
+                std::fill_n (buffer.getWritePointer (0), buffer.getNumSamples(), 1.0f);
+                juce::dsp::AudioBlock<float> block (buffer);
+                convolution.process (juce::dsp::ProcessContextReplacing<float> (block));
+                output.insert (output.end(), buffer.getReadPointer (0), buffer.getReadPointer (0) + buffer.getNumSamples());
+            }
+        };
+
+        convolution.setImpulseResponse (createIR (1.0f));
+        processBlocks (1);
+        CHECK_EQ (output.back(), doctest::Approx (1.0f));
+
+        // Setting another IR part way through a fade mustn't cut it short
+        convolution.setImpulseResponse (createIR (0.5f));
+        processBlocks (2);
+        convolution.setImpulseResponse (createIR (0.25f));
+        processBlocks (40);
+        CHECK_EQ (output.back(), doctest::Approx (0.25f));
+
+        float maxStep = 0.0f;
+
+        for (size_t i = 1; i < output.size(); ++i)
+            maxStep = std::max (maxStep, std::abs (output[i] - output[i - 1]));
+
+        CHECK (maxStep < 0.5f / (float) juce::roundToInt (spec.sampleRate * 0.05) + 1.0e-5f);
+    }
+}
+
+} // namespace tracktion::inline engine
+
+#endif
@@ -79,6 +79,7 @@ juce::StringRef PropertyStorage::settingToString (SettingID setting)
         case SettingID::renameClipRenamesSource:            return "renameClipRenamesSource";
         case SettingID::renameMode:                         return "renameMode";
         case SettingID::renderRecentFilesList:              return "renderRecentFilesList";
+        case SettingID::renderCacheSize:                    return "renderCacheSize";
         case SettingID::safeRecord:                         return "safeRecord";
         case SettingID::resetCursorOnPlay:                  return "resetCursorOnPlay";
         case SettingID::retrospectiveRecord:                return "retrospectiveRecord";
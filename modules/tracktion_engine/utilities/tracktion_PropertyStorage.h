@@ -13,7 +13,9 @@ namespace tracktion { inline namespace engine
 
 /**
     Create a subclass of PropertyStorage to customize how settings are saved
-    and recalled
+    and recalled.
+    Some of the Engine's managers are created on demand from background threads
+    so a subclass's methods must be thread-safe.
 */
 class PropertyStorage
 {
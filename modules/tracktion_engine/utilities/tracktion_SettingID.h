@@ -78,6 +78,7 @@ enum class SettingID
     renameClipRenamesSource,
     renameMode,
     renderRecentFilesList,
+    renderCacheSize,
     resetCursorOnPlay,
     retrospectiveRecord,
     reWireEnabled,
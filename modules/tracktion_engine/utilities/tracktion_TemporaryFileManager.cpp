@@ -147,9 +147,22 @@ void TemporaryFileManager::cleanUp()
     CRASH_TRACER
     TRACKTION_LOG ("Cleaning up temp files..");
 
+    engine.getAudioFileManager().peakPyramids.purgeOrphanedPyramids();
+
     auto tempFiles = tempDir.findChildFiles (juce::File::findFiles, true);
 
-    deleteEditPreviewsNotInUse (engine, tempFiles);
+    // The RenderCache keeps its own renders within their budget
+    auto& renderCache = engine.getRenderCache();
+    tempFiles.removeIf ([&renderCache] (const juce::File& f) { return renderCache.isCachedRender (f); });
+
+    // Analysis results are small and checked against their source when they're loaded,
+    // so they shouldn't be counted towards the number of files or deleted for their age
+    const auto analysisFolder = getAnalysisFolder();
+    tempFiles.removeIf ([&analysisFolder] (const juce::File& f) { return f.isAChildOf (analysisFolder); });
+
+    // Previews belong to project items so there's nothing to check if projects haven't been used
+    if (engine.hasProjectManager())
+        deleteEditPreviewsNotInUse (engine, tempFiles);
 
     int64_t totalBytes = 0;
 
@@ -179,6 +192,8 @@ void TemporaryFileManager::cleanUp()
     for (auto entry : juce::RangedDirectoryIterator (getTempDirectory(), false, "edit_*", juce::File::findDirectories))
         if (entry.getFile().getNumberOfChildFiles (juce::File::findFilesAndDirectories) == 0)
             entry.getFile().deleteRecursively();
+
+    renderCache.trim();
 }
 
 juce::File TemporaryFileManager::getTempFile (const juce::String& filename) const
@@ -198,6 +213,16 @@ juce::File TemporaryFileManager::getThumbnailsFolder() const
     return getTempDirectory().getChildFile ("thumbnails");
 }
 
+juce::File TemporaryFileManager::getAnalysisFolder() const
+{
+    return getTempDirectory().getChildFile ("analysis");
+}
+
+juce::File TemporaryFileManager::getRenderCacheFolder() const
+{
+    return getTempDirectory().getChildFile ("render_cache");
+}
+
 //==============================================================================
 static juce::String getClipProxyPrefix()                { return "clip_"; }
 static juce::String getFileProxyPrefix()                { return "proxy_"; }
@@ -205,29 +230,27 @@ static juce::String getDeviceFreezePrefix (Edit& edit)  { return "freeze_" + edi
 static juce::String getTrackFreezePrefix()              { return "trackFreeze_"; }
 static juce::String getCompPrefix()                     { return "comp_"; }
 
-static AudioFile getCachedEditFile (Edit& edit, const juce::String& prefix, HashCode hash)
-{
-    return AudioFile (edit.engine, edit.getTempDirectory (true).getChildFile (prefix + juce::String::toHexString (hash) + ".wav"));
-}
-
-static AudioFile getCachedClipFileWithPrefix (const AudioClipBase& clip, const juce::String& prefix, HashCode hash)
+AudioFile TemporaryFileManager::getFileForCachedSourceRender (const AudioClipBase& clip, HashCode hash)
 {
-    return getCachedEditFile (clip.edit, prefix + "0_" + clip.itemID.toString() + "_", hash);
+    return clip.edit.engine.getRenderCache().getFile (RenderCache::createKey (RenderManager::getFileRenderPrefix(), hash));
 }
 
 AudioFile TemporaryFileManager::getFileForCachedClipRender (const AudioClipBase& clip, HashCode hash)
 {
-    return getCachedClipFileWithPrefix (clip, getClipProxyPrefix(), hash);
+    // Proxy hashes include the source file's hash so these can be shared between Edits
+    return clip.edit.engine.getRenderCache().getFile (RenderCache::createKey (getClipProxyPrefix(), hash));
 }
 
 AudioFile TemporaryFileManager::getFileForCachedCompRender (const AudioClipBase& clip, HashCode takeHash)
 {
-    return getCachedClipFileWithPrefix (clip, getCompPrefix(), takeHash);
+    // Take hashes are made from the take indexes so only mean something to this clip
+    auto& edit = clip.edit;
+    return edit.engine.getRenderCache().getFile (RenderCache::createKey (edit, getCompPrefix() + clip.itemID.toString(), takeHash));
 }
 
 AudioFile TemporaryFileManager::getFileForCachedFileRender (Edit& edit, HashCode hash)
 {
-    return getCachedEditFile (edit, getFileProxyPrefix(), hash);
+    return edit.engine.getRenderCache().getFile (RenderCache::createKey (edit, getFileProxyPrefix(), hash));
 }
 
 juce::File TemporaryFileManager::getFreezeFileForDevice (Edit& edit, OutputDevice& device)
@@ -58,6 +58,12 @@ public:
     /** */
     juce::File getThumbnailsFolder() const;
 
+    /** */
+    juce::File getAnalysisFolder() const;
+
+    /** Returns the folder the RenderCache keeps its renders in. */
+    juce::File getRenderCacheFolder() const;
+
     /** */
     juce::File getTempFile (const juce::String& filename) const;
 
@@ -65,13 +71,16 @@ public:
     juce::File getUniqueTempFile (const juce::String& prefix, const juce::String& ext) const;
 
     //==============================================================================
-    /** */
+    /** Returns the RenderCache file for a clip's rendered source that can be shared by any Edit. */
+    static AudioFile getFileForCachedSourceRender (const AudioClipBase&, HashCode);
+
+    /** Returns the RenderCache file for a clip render that can be shared by any Edit. */
     static AudioFile getFileForCachedClipRender (const AudioClipBase&, HashCode);
 
-    /** */
+    /** Returns the RenderCache file for a clip's comp, this is only shared within the clip. */
     static AudioFile getFileForCachedCompRender (const AudioClipBase&, HashCode);
 
-    /** */
+    /** Returns the RenderCache file for a render that can be shared within an Edit. */
     static AudioFile getFileForCachedFileRender (Edit&, HashCode hash);
 
     /** */
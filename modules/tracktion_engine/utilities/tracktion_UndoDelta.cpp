@@ -0,0 +1,502 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+UndoJournal::UndoJournal (juce::File journalFile, size_t maxBytes)
+    : file (std::move (journalFile)), maxBytesInMemory (maxBytes)
+{
+    file.deleteFile();
+}
+
+UndoJournal::~UndoJournal()
+{
+    // The UndoManager should have been cleared before this is deleted
+    jassert (entries.empty());
+    file.deleteFile();
+}
+
+UndoJournal::EntryHandle UndoJournal::add (juce::MemoryBlock& data)
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    entries.push_back ({ &data, -1, 0, data.getSize() });
+    numBytesInMemory += data.getSize();
+    auto handle = std::prev (entries.end());
+
+    spillIfNeeded();
+    return handle;
+}
+
+void UndoJournal::remove (EntryHandle entry)
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+
+    if (entry->fileOffset < 0)
+        numBytesInMemory -= entry->originalSize;
+
+    entries.erase (entry);
+
+    // Space in the file isn't reclaimed until the history is cleared
+    if (entries.empty())
+    {
+        file.deleteFile();
+        numBytesOnDisk = 0;
+    }
+}
+
+juce::MemoryBlock UndoJournal::read (EntryHandle entry) const
+{
+    jassert (entry->fileOffset >= 0);
+    juce::MemoryBlock result;
+
+    if (juce::FileInputStream in (file); in.openedOk() && in.setPosition (entry->fileOffset))
+    {
+        juce::MemoryBlock compressed;
+        in.readIntoMemoryBlock (compressed, entry->fileSize);
+
+        juce::MemoryInputStream compressedStream (compressed, false);
+        juce::GZIPDecompressorInputStream decompressor (compressedStream);
+        decompressor.readIntoMemoryBlock (result, (int64_t) entry->originalSize);
+    }
+
+    jassert (result.getSize() == entry->originalSize);
+    return result;
+}
+
+void UndoJournal::spillIfNeeded()
+{
+    if (numBytesInMemory <= maxBytesInMemory)
+        return;
+
+    juce::FileOutputStream out (file);
+
+    if (! out.openedOk())
+    {
+        jassertfalse;
+        return;
+    }
+
+    // Leave the newest entry in memory as it's the most likely to be undone
+    for (auto entry = entries.begin(); entry != entries.end() && std::next (entry) != entries.end(); ++entry)
+    {
+        if (numBytesInMemory <= maxBytesInMemory)
+            break;
+
+        if (entry->fileOffset >= 0)
+            continue;
+
+        juce::MemoryBlock compressed;
+
+        {
+            juce::MemoryOutputStream compressedStream (compressed, false);
+            juce::GZIPCompressorOutputStream compressor (compressedStream, 6);
+            compressor.write (entry->data->getData(), entry->data->getSize());
+        }
+
+        entry->fileOffset = out.getPosition();
+        entry->fileSize = (int64_t) compressed.getSize();
+
+        if (! out.write (compressed.getData(), compressed.getSize()))
+        {
+            entry->fileOffset = -1;
+            break;
+        }
+
+        numBytesOnDisk += entry->fileSize;
+        numBytesInMemory -= entry->originalSize;
+        entry->data->reset();
+    }
+
+    out.flush();
+}
+
+//==============================================================================
+class ValueTreeDeltaRecorder::Action  : public juce::UndoableAction
+{
+public:
+    enum class Op : uint8_t
+    {
+        setProperty,
+        removeProperty,
+        addChild,
+        removeChild
+    };
+
+    Action (UndoJournal* j)
+        : journal (j)
+    {
+        stream = std::make_unique<juce::MemoryOutputStream> (data, false);
+    }
+
+    ~Action() override
+    {
+        if (journalEntry)
+            journal->remove (*journalEntry);
+    }
+
+    //==============================================================================
+    void recordSetProperty (juce::ValueTree& tree, const juce::Identifier& id, const juce::var& newValue)
+    {
+        // DynamicObjects can't be encoded
+        jassert (! newValue.isObject());
+
+        auto oldValue = tree.getPropertyPointer (id);
+        writeHeader (Op::setProperty, tree);
+        stream->writeCompressedInt (getIdentifierIndex (id));
+        stream->writeBool (oldValue != nullptr);
+
+        if (oldValue != nullptr)
+            oldValue->writeToStream (*stream);
+
+        newValue.writeToStream (*stream);
+        tree.setProperty (id, newValue, nullptr);
+    }
+
+    void recordRemoveProperty (juce::ValueTree& tree, const juce::Identifier& id)
+    {
+        auto oldValue = tree.getPropertyPointer (id);
+
+        if (oldValue == nullptr)
+            return;
+
+        writeHeader (Op::removeProperty, tree);
+        stream->writeCompressedInt (getIdentifierIndex (id));
+        oldValue->writeToStream (*stream);
+        tree.removeProperty (id, nullptr);
+    }
+
+    void recordAddChild (juce::ValueTree& parent, const juce::ValueTree& child, int index)
+    {
+        writeHeader (Op::addChild, parent);
+        stream->writeCompressedInt (getTreeIndex (child));
+        parent.addChild (child, index, nullptr);
+        stream->writeCompressedInt (parent.indexOf (child));
+        numChildBytes += estimateSize (child);
+    }
+
+    void recordRemoveChild (juce::ValueTree& parent, const juce::ValueTree& child)
+    {
+        const auto index = parent.indexOf (child);
+
+        if (index < 0)
+            return;
+
+        writeHeader (Op::removeChild, parent);
+        stream->writeCompressedInt (getTreeIndex (child));
+        stream->writeCompressedInt (index);
+        parent.removeChild (index, nullptr);
+        numChildBytes += estimateSize (child);
+    }
+
+    /** Finishes recording and registers the data with the journal. */
+    void finish()
+    {
+        // Deleting the stream trims the block to the size written
+        dataSize = stream->getDataSize();
+        stream.reset();
+        trees.shrink_to_fit();
+
+        if (journal != nullptr)
+            journalEntry = journal->add (data);
+    }
+
+    int getNumChanges() const noexcept      { return numChanges; }
+
+    size_t getNumBytesUsed() const noexcept
+    {
+        return (stream != nullptr ? stream->getDataSize() : dataSize)
+                + trees.size() * sizeof (juce::ValueTree)
+                + identifiers.size() * sizeof (juce::Identifier)
+                + numChildBytes;
+    }
+
+    //==============================================================================
+    bool perform() override
+    {
+        // The changes were applied whilst recording
+        if (std::exchange (isFirstPerform, false))
+            return true;
+
+        apply (false);
+        return true;
+    }
+
+    bool undo() override
+    {
+        apply (true);
+        return true;
+    }
+
+    int getSizeInUnits() override
+    {
+        return (int) std::min (getNumBytesUsed(), (size_t) std::numeric_limits<int>::max());
+    }
+
+private:
+    UndoJournal* journal;
+    std::optional<UndoJournal::EntryHandle> journalEntry;
+
+    juce::MemoryBlock data;
+    std::unique_ptr<juce::MemoryOutputStream> stream;
+    size_t dataSize = 0;
+    std::vector<juce::ValueTree> trees;
+    std::vector<juce::Identifier> identifiers;
+    size_t numChildBytes = 0;
+    int numChanges = 0;
+    bool isFirstPerform = true;
+
+    //==============================================================================
+    void writeHeader (Op op, const juce::ValueTree& tree)
+    {
+        stream->writeByte ((char) op);
+        stream->writeCompressedInt (getTreeIndex (tree));
+        ++numChanges;
+    }
+
+    int getTreeIndex (const juce::ValueTree& tree)
+    {
+        // Changes usually come in runs on the same tree so checking
+        // the last few avoids storing duplicates without a lookup table
+        const auto numToCheck = std::min (trees.size(), (size_t) 4);
+
+        for (size_t i = trees.size(); i > trees.size() - numToCheck; --i)
+            if (trees[i - 1] == tree)
+                return (int) i - 1;
+
+        trees.push_back (tree);
+        return (int) trees.size() - 1;
+    }
+
+    int getIdentifierIndex (const juce::Identifier& id)
+    {
+        for (size_t i = 0; i < identifiers.size(); ++i)
+            if (identifiers[i] == id)
+                return (int) i;
+
+        identifiers.push_back (id);
+        return (int) identifiers.size() - 1;
+    }
+
+    static size_t estimateSize (const juce::ValueTree& tree)
+    {
+        size_t size = sizeof (juce::ValueTree) + (size_t) tree.getNumProperties() * (sizeof (juce::Identifier) + sizeof (juce::var));
+
+        for (const auto& child : tree)
+            size += estimateSize (child);
+
+        return size;
+    }
+
+    //==============================================================================
+    void apply (bool isUndo)
+    {
+        if (journalEntry && (*journalEntry)->fileOffset >= 0)
+        {
+            auto restored = journal->read (*journalEntry);
+            apply (restored, isUndo);
+        }
+        else
+        {
+            apply (data, isUndo);
+        }
+    }
+
+    void apply (const juce::MemoryBlock& block, bool isUndo)
+    {
+        juce::MemoryInputStream in (block, false);
+
+        if (! isUndo)
+        {
+            while (! in.isExhausted())
+                applyRecord (in, false);
+
+            return;
+        }
+
+        // Records are variable length so find where they start then apply them in reverse
+        std::vector<int64_t> recordStarts;
+        recordStarts.reserve ((size_t) numChanges);
+
+        while (! in.isExhausted())
+        {
+            recordStarts.push_back (in.getPosition());
+            skipRecord (in);
+        }
+
+        for (auto start = recordStarts.rbegin(); start != recordStarts.rend(); ++start)
+        {
+            in.setPosition (*start);
+            applyRecord (in, true);
+        }
+    }
+
+    void applyRecord (juce::MemoryInputStream& in, bool isUndo)
+    {
+        const auto op = (Op) in.readByte();
+        auto& tree = trees[(size_t) in.readCompressedInt()];
+
+        switch (op)
+        {
+            case Op::setProperty:
+            {
+                const auto& id = identifiers[(size_t) in.readCompressedInt()];
+                const bool hadOldValue = in.readBool();
+                auto oldValue = hadOldValue ? juce::var::readFromStream (in) : juce::var();
+                auto newValue = juce::var::readFromStream (in);
+
+                if (! isUndo)
+                    tree.setProperty (id, newValue, nullptr);
+                else if (hadOldValue)
+                    tree.setProperty (id, oldValue, nullptr);
+                else
+                    tree.removeProperty (id, nullptr);
+
+                break;
+            }
+
+            case Op::removeProperty:
+            {
+                const auto& id = identifiers[(size_t) in.readCompressedInt()];
+                auto oldValue = juce::var::readFromStream (in);
+
+                if (isUndo)
+                    tree.setProperty (id, oldValue, nullptr);
+                else
+                    tree.removeProperty (id, nullptr);
+
+                break;
+            }
+
+            case Op::addChild:
+            case Op::removeChild:
+            {
+                auto& child = trees[(size_t) in.readCompressedInt()];
+                const auto index = in.readCompressedInt();
+                const bool shouldAdd = (op == Op::addChild) != isUndo;
+
+                if (shouldAdd)
+                    tree.addChild (child, index, nullptr);
+                else
+                    tree.removeChild (child, nullptr);
+
+                break;
+            }
+        }
+    }
+
+    static void skipRecord (juce::MemoryInputStream& in)
+    {
+        const auto op = (Op) in.readByte();
+        in.readCompressedInt();
+
+        switch (op)
+        {
+            case Op::setProperty:
+                in.readCompressedInt();
+
+                if (in.readBool())
+                    juce::var::readFromStream (in);
+
+                juce::var::readFromStream (in);
+                break;
+
+            case Op::removeProperty:
+                in.readCompressedInt();
+                juce::var::readFromStream (in);
+                break;
+
+            case Op::addChild:
+            case Op::removeChild:
+                in.readCompressedInt();
+                in.readCompressedInt();
+                break;
+        }
+    }
+};
+
+//==============================================================================
+ValueTreeDeltaRecorder::ValueTreeDeltaRecorder (juce::UndoManager* um, UndoJournal* j)
+    : undoManager (um), journal (j)
+{
+}
+
+ValueTreeDeltaRecorder::~ValueTreeDeltaRecorder()
+{
+    commit();
+}
+
+ValueTreeDeltaRecorder::Action& ValueTreeDeltaRecorder::getAction()
+{
+    if (! action)
+        action = std::make_unique<Action> (journal);
+
+    return *action;
+}
+
+void ValueTreeDeltaRecorder::setProperty (juce::ValueTree& tree, const juce::Identifier& id, const juce::var& newValue)
+{
+    if (undoManager == nullptr)
+        tree.setProperty (id, newValue, nullptr);
+    else if (auto oldValue = tree.getPropertyPointer (id); oldValue == nullptr || ! oldValue->equalsWithSameType (newValue))
+        getAction().recordSetProperty (tree, id, newValue);
+}
+
+void ValueTreeDeltaRecorder::removeProperty (juce::ValueTree& tree, const juce::Identifier& id)
+{
+    if (undoManager == nullptr)
+        tree.removeProperty (id, nullptr);
+    else
+        getAction().recordRemoveProperty (tree, id);
+}
+
+void ValueTreeDeltaRecorder::addChild (juce::ValueTree& parent, const juce::ValueTree& child, int index)
+{
+    if (undoManager == nullptr)
+        parent.addChild (child, index, nullptr);
+    else
+        getAction().recordAddChild (parent, child, index);
+}
+
+void ValueTreeDeltaRecorder::removeChild (juce::ValueTree& parent, const juce::ValueTree& child)
+{
+    if (undoManager == nullptr)
+        parent.removeChild (child, nullptr);
+    else
+        getAction().recordRemoveChild (parent, child);
+}
+
+void ValueTreeDeltaRecorder::commit()
+{
+    if (action == nullptr)
+        return;
+
+    if (action->getNumChanges() == 0)
+    {
+        action.reset();
+        return;
+    }
+
+    action->finish();
+    undoManager->perform (action.release());
+}
+
+int ValueTreeDeltaRecorder::getNumChanges() const noexcept
+{
+    return action != nullptr ? action->getNumChanges() : 0;
+}
+
+size_t ValueTreeDeltaRecorder::getNumBytesUsed() const noexcept
+{
+    return action != nullptr ? action->getNumBytesUsed() : 0;
+}
+
+}} // namespace tracktion { inline namespace engine
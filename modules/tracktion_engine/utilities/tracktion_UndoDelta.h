@@ -0,0 +1,151 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+/**
+    Moves the data of old ValueTreeDeltaRecorder transactions out of memory and
+    into a compressed file.
+
+    Once more than the given number of bytes of recorded changes are held in
+    memory, the oldest transactions are compressed and appended to the file.
+    A transaction is read back from the file only while it's being undone or
+    redone, so that cost depends on the size of the transaction rather than the
+    length of the history.
+
+    This must outlive any UndoManager holding transactions that use it.
+*/
+class UndoJournal
+{
+public:
+    /** Creates a journal that writes to the given file, replacing any existing one. */
+    UndoJournal (juce::File journalFile, size_t maxBytesInMemory);
+
+    /** Destructor. Deletes the journal file. */
+    ~UndoJournal();
+
+    /** Returns the number of bytes of recorded changes still held in memory. */
+    size_t getNumBytesInMemory() const noexcept         { return numBytesInMemory; }
+
+    /** Returns the number of bytes that have been written to the journal file. */
+    int64_t getNumBytesOnDisk() const noexcept          { return numBytesOnDisk; }
+
+    /** Returns the file being written to. */
+    const juce::File& getFile() const noexcept          { return file; }
+
+    //==============================================================================
+    /** @internal */
+    struct Entry
+    {
+        juce::MemoryBlock* data = nullptr;
+        int64_t fileOffset = -1, fileSize = 0;
+        size_t originalSize = 0;
+    };
+
+    /** @internal */
+    using EntryHandle = std::list<Entry>::iterator;
+    /** @internal */
+    EntryHandle add (juce::MemoryBlock&);
+    /** @internal */
+    void remove (EntryHandle);
+    /** @internal */
+    juce::MemoryBlock read (EntryHandle) const;
+
+private:
+    const juce::File file;
+    const size_t maxBytesInMemory;
+    size_t numBytesInMemory = 0;
+    int64_t numBytesOnDisk = 0;
+    std::list<Entry> entries;
+
+    void spillIfNeeded();
+
+    JUCE_DECLARE_NON_COPYABLE (UndoJournal)
+};
+
+//==============================================================================
+/**
+    Records a set of changes to ValueTrees and adds them to an UndoManager as a
+    single, compact UndoableAction.
+
+    Calling ValueTree::setProperty with an UndoManager creates an action object
+    holding a full copy of the old and new values for every change. For bulk
+    edits (e.g. quantising thousands of MIDI notes) this uses a lot of memory.
+    This class instead encodes each change as a few bytes of binary delta and
+    reports its real size to the UndoManager, so a budget set with
+    UndoManager::setMaxNumberOfStoredUnits works as a limit in bytes.
+
+    The changes are applied to the trees straight away, so the rest of the code
+    can read the new values back. They're added to the UndoManager as one
+    transaction when commit() is called or the recorder is deleted.
+
+    Properties holding DynamicObjects can't be encoded so shouldn't be set with this.
+
+    @code
+    {
+        ValueTreeDeltaRecorder recorder (&edit.getUndoManager(), edit.getUndoJournal());
+
+        for (auto note : notes)
+            recorder.setProperty (note->state, IDs::b, newStart);
+    }
+    @endcode
+*/
+class ValueTreeDeltaRecorder
+{
+public:
+    /** Creates a recorder for an UndoManager.
+        If the UndoManager is nullptr, changes are simply applied.
+        If a journal is supplied, the recorded data may be moved to disk once it's old.
+    */
+    ValueTreeDeltaRecorder (juce::UndoManager*, UndoJournal* = nullptr);
+
+    /** Destructor. Commits any changes that haven't been yet. */
+    ~ValueTreeDeltaRecorder();
+
+    //==============================================================================
+    /** Sets a property, recording the change. */
+    void setProperty (juce::ValueTree&, const juce::Identifier&, const juce::var& newValue);
+
+    /** Removes a property, recording the change. */
+    void removeProperty (juce::ValueTree&, const juce::Identifier&);
+
+    /** Adds a child, recording the change. */
+    void addChild (juce::ValueTree& parent, const juce::ValueTree& child, int index);
+
+    /** Removes a child, recording the change. */
+    void removeChild (juce::ValueTree& parent, const juce::ValueTree& child);
+
+    //==============================================================================
+    /** Adds the changes recorded so far to the UndoManager.
+        Any further changes will be added as a new action.
+    */
+    void commit();
+
+    /** Returns the number of changes recorded since the last commit. */
+    int getNumChanges() const noexcept;
+
+    /** Returns the number of bytes the changes recorded since the last commit are using. */
+    size_t getNumBytesUsed() const noexcept;
+
+private:
+    class Action;
+
+    juce::UndoManager* undoManager;
+    UndoJournal* journal;
+    std::unique_ptr<Action> action;
+
+    Action& getAction();
+
+    JUCE_DECLARE_NON_COPYABLE (ValueTreeDeltaRecorder)
+};
+
+}} // namespace tracktion { inline namespace engine
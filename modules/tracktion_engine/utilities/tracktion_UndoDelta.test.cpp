@@ -0,0 +1,134 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_UNDO_DELTA
+
+#include <tracktion_engine/../3rd_party/doctest/tracktion_doctest.hpp>
+
+namespace tracktion::inline engine
+{
+
+TEST_SUITE ("tracktion_engine")
+{
+    static juce::ValueTree createTreeWithEvents (int numEvents)
+    {
+        juce::ValueTree root ("ROOT");
+
+        for (int i = 0; i < numEvents; ++i)
+            root.appendChild (juce::ValueTree ("EVENT", { { "b", (double) i }, { "name", "event" + juce::String (i) } }), nullptr);
+
+        return root;
+    }
+
+    TEST_CASE ("ValueTreeDeltaRecorder undo and redo")
+    {
+        auto root = createTreeWithEvents (100);
+        const auto original = root.createCopy();
+        juce::UndoManager um;
+
+        {
+            ValueTreeDeltaRecorder recorder (&um);
+
+            for (auto event : root)
+                recorder.setProperty (event, "b", (double) event.getProperty ("b") + 1.0);
+
+            recorder.removeProperty (root.getChild (0), "name");
+            recorder.removeChild (root, root.getChild (1));
+            recorder.addChild (root, juce::ValueTree ("EVENT", { { "b", 1000.0 } }), 5);
+            CHECK_EQ (recorder.getNumChanges(), 103);
+
+            // Nothing is added if the value is the same
+            recorder.setProperty (root.getChild (2), "b", root.getChild (2).getProperty ("b"));
+            CHECK_EQ (recorder.getNumChanges(), 103);
+        }
+
+        const auto modified = root.createCopy();
+        CHECK_EQ (root.getNumChildren(), 100);
+        CHECK_EQ ((double) root.getChild (0).getProperty ("b"), 1.0);
+        CHECK (! root.getChild (0).hasProperty ("name"));
+        CHECK_EQ ((double) root.getChild (5).getProperty ("b"), 1000.0);
+
+        // All the changes should be a single transaction
+        CHECK (um.canUndo());
+        CHECK (um.undo());
+        CHECK (! um.canUndo());
+        CHECK (root.isEquivalentTo (original));
+
+        CHECK (um.redo());
+        CHECK (root.isEquivalentTo (modified));
+
+        CHECK (um.undo());
+        CHECK (root.isEquivalentTo (original));
+    }
+
+    TEST_CASE ("ValueTreeDeltaRecorder stores compact deltas")
+    {
+        constexpr int numEvents = 1000;
+        juce::UndoManager um (std::numeric_limits<int>::max(), 1);
+
+        {
+            auto root = createTreeWithEvents (numEvents);
+            ValueTreeDeltaRecorder recorder (&um);
+
+            for (auto event : root)
+                recorder.setProperty (event, "b", (double) event.getProperty ("b") + 1.0);
+
+            // Old and new doubles plus the tree and identifier indexes
+            CHECK (recorder.getNumBytesUsed() < (size_t) numEvents * 48);
+        }
+
+        CHECK (um.getNumActionsInCurrentTransaction() == 1);
+    }
+
+    TEST_CASE ("UndoJournal")
+    {
+        juce::TemporaryFile tempFile;
+        auto root = createTreeWithEvents (1000);
+        const auto original = root.createCopy();
+
+        UndoJournal journal (tempFile.getFile(), 1024);
+        juce::UndoManager um (std::numeric_limits<int>::max(), 100);
+
+        for (int transaction = 0; transaction < 10; ++transaction)
+        {
+            um.beginNewTransaction();
+            ValueTreeDeltaRecorder recorder (&um, &journal);
+
+            for (auto event : root)
+                recorder.setProperty (event, "b", (double) event.getProperty ("b") + 1.0);
+        }
+
+        const auto modified = root.createCopy();
+
+        // Only the newest transaction should still be in memory
+        CHECK (journal.getNumBytesInMemory() > 0);
+        CHECK (journal.getNumBytesInMemory() < 64 * 1024);
+        CHECK (journal.getNumBytesOnDisk() > 0);
+        CHECK (journal.getFile().existsAsFile());
+
+        while (um.canUndo())
+            CHECK (um.undo());
+
+        CHECK (root.isEquivalentTo (original));
+
+        while (um.canRedo())
+            CHECK (um.redo());
+
+        CHECK (root.isEquivalentTo (modified));
+
+        um.clearUndoHistory();
+        CHECK_EQ (journal.getNumBytesInMemory(), 0);
+        CHECK (! journal.getFile().exists());
+    }
+}
+
+} // namespace tracktion::inline engine
+
+#endif
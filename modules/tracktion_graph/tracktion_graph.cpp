@@ -50,8 +50,10 @@
 #include "utilities/tracktion_Semaphore.cpp"
 #include "utilities/tracktion_Semaphore.tests.cpp"
 #include "utilities/tracktion_Threads.cpp"
+#include "utilities/tracktion_Threads.tests.cpp"
 
 // Put this last to avoid macro leakage
+#include "utilities/tracktion_Allocation.cpp"
 #include "utilities/tracktion_Allocation.test.cpp"
 #include "../3rd_party/rpmalloc/rpallocator.cpp"
 
@@ -58,10 +58,24 @@
  #define GRAPH_UNIT_TESTS_QUICK_VALIDATE 0
 #endif
 
+//==============================================================================
+/** Config: TRACKTION_COUNT_REALTIME_ALLOCATIONS
+
+    If this is enabled, the global operator new and delete are replaced so that
+    every allocation made on a thread marked as real-time is counted.
+    @see allocation::getRealTimeAllocationCounters
+*/
+#ifndef TRACKTION_COUNT_REALTIME_ALLOCATIONS
+ #define TRACKTION_COUNT_REALTIME_ALLOCATIONS 0
+#endif
+
 //==============================================================================
 //==============================================================================
 #include <cassert>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include <optional>
 #include <any>
 
@@ -95,6 +109,7 @@
 #include "utilities/tracktion_MidiMessageArray.h"
 namespace tracktion_engine = tracktion::engine;
 
+#include "utilities/tracktion_Allocation.h"
 #include "tracktion_graph/tracktion_Node.h"
 #include "tracktion_graph/tracktion_Utility.h"
 
@@ -183,6 +183,11 @@ public:
 
         LockFreeMultiThreadedNodePlayer& player;
 
+        /** The priority and affinity options subclasses should apply to the threads they create.
+            @see applyWorkerThreadSchedulingOptions
+        */
+        ThreadSchedulingOptions schedulingOptions;
+
     private:
         std::atomic<bool> threadsShouldExit { false };
         std::atomic<LockFreeMultiThreadedNodePlayer::PreparedNode*> currentPreparedNode { nullptr };
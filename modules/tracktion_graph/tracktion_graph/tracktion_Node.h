@@ -220,6 +220,22 @@ public:
     Node() = default;
     virtual ~Node() = default;
 
+    //==============================================================================
+    /** Nodes are allocated from the calling thread's NodeArena if it has one.
+        @see ScopedNodeArena
+    */
+    static void* operator new (size_t);
+    /** @internal */
+    static void* operator new (size_t, std::align_val_t);
+    /** @internal */
+    static void* operator new (size_t, void* p) noexcept            { return p; }
+    /** @internal */
+    static void operator delete (void*) noexcept;
+    /** @internal */
+    static void operator delete (void*, std::align_val_t) noexcept;
+    /** @internal */
+    static void operator delete (void*, void*) noexcept             {}
+
     //==============================================================================
     /** Call once after the graph has been constructed to initialise buffers etc. */
     void initialise (const PlaybackInitialisationInfo&);
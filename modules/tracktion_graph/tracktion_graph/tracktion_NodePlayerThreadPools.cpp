@@ -55,8 +55,12 @@ struct ThreadPoolCV : public LockFreeMultiThreadedNodePlayer::ThreadPool
 
         for (size_t i = 0; i < numThreads; ++i)
         {
-            threads.emplace_back ([this] { runThread(); });
-            setThreadPriority (threads.back(), 10);
+            threads.emplace_back ([this]
+                                 {
+                                     allocation::markCurrentThreadAsRealTime();
+                                     runThread();
+                                 });
+            applyWorkerThreadSchedulingOptions (threads.back(), i, schedulingOptions);
             tryToUpgradeCurrentThreadToRealtime (rtOpts);
         }
     }
@@ -190,8 +194,12 @@ struct ThreadPoolRT : public LockFreeMultiThreadedNodePlayer::ThreadPool
 
         for (size_t i = 0; i < numThreads; ++i)
         {
-            threads.emplace_back ([this] { runThread(); });
-            setThreadPriority (threads.back(), 10);
+            threads.emplace_back ([this]
+                                 {
+                                     allocation::markCurrentThreadAsRealTime();
+                                     runThread();
+                                 });
+            applyWorkerThreadSchedulingOptions (threads.back(), i, schedulingOptions);
             tryToUpgradeCurrentThreadToRealtime (rtOpts);
         }
     }
@@ -300,8 +308,12 @@ struct ThreadPoolHybrid : public LockFreeMultiThreadedNodePlayer::ThreadPool
 
         for (size_t i = 0; i < numThreads; ++i)
         {
-            threads.emplace_back ([this] { runThread(); });
-            setThreadPriority (threads.back(), 10);
+            threads.emplace_back ([this]
+                                 {
+                                     allocation::markCurrentThreadAsRealTime();
+                                     runThread();
+                                 });
+            applyWorkerThreadSchedulingOptions (threads.back(), i, schedulingOptions);
             tryToUpgradeCurrentThreadToRealtime (rtOpts);
         }
     }
@@ -456,8 +468,12 @@ struct ThreadPoolSem : public LockFreeMultiThreadedNodePlayer::ThreadPool
 
         for (size_t i = 0; i < numThreads; ++i)
         {
-            threads.emplace_back ([this] { runThread(); });
-            setThreadPriority (threads.back(), 10);
+            threads.emplace_back ([this]
+                                 {
+                                     allocation::markCurrentThreadAsRealTime();
+                                     runThread();
+                                 });
+            applyWorkerThreadSchedulingOptions (threads.back(), i, schedulingOptions);
             tryToUpgradeCurrentThreadToRealtime (rtOpts);
         }
     }
@@ -563,8 +579,12 @@ struct ThreadPoolSemHybrid : public LockFreeMultiThreadedNodePlayer::ThreadPool
 
         for (size_t i = 0; i < numThreads; ++i)
         {
-            threads.emplace_back ([this] { runThread(); });
-            setThreadPriority (threads.back(), 10);
+            threads.emplace_back ([this]
+                                 {
+                                     allocation::markCurrentThreadAsRealTime();
+                                     runThread();
+                                 });
+            applyWorkerThreadSchedulingOptions (threads.back(), i, schedulingOptions);
             tryToUpgradeCurrentThreadToRealtime (rtOpts);
         }
     }
@@ -692,6 +712,17 @@ LockFreeMultiThreadedNodePlayer::ThreadPoolCreator getPoolCreatorFunction (Threa
     }
 }
 
+LockFreeMultiThreadedNodePlayer::ThreadPoolCreator getPoolCreatorFunction (ThreadPoolStrategy poolType,
+                                                                           ThreadSchedulingOptions schedulingOptions)
+{
+    return [creator = getPoolCreatorFunction (poolType), schedulingOptions] (LockFreeMultiThreadedNodePlayer& p)
+    {
+        auto pool = creator (p);
+        pool->schedulingOptions = schedulingOptions;
+        return pool;
+    };
+}
+
 
 #ifdef _MSC_VER
  #pragma warning (pop)
@@ -33,4 +33,9 @@ enum class ThreadPoolStrategy
 /** Returns a function to create a ThreadPool for the given stategy. */
 LockFreeMultiThreadedNodePlayer::ThreadPoolCreator getPoolCreatorFunction (ThreadPoolStrategy);
 
+/** Returns a function to create a ThreadPool for the given stategy whose threads
+    will use the given scheduling options.
+*/
+LockFreeMultiThreadedNodePlayer::ThreadPoolCreator getPoolCreatorFunction (ThreadPoolStrategy, ThreadSchedulingOptions);
+
 }}
@@ -0,0 +1,349 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace graph
+{
+
+namespace allocation_detail
+{
+    // Every Node allocation is prefixed with the arena it came from, or nullptr
+    constexpr size_t headerSize = alignof (std::max_align_t);
+
+    inline thread_local NodeArena* currentArena = nullptr;
+    inline thread_local bool isRealTimeThread = false;
+
+    inline std::atomic<uint64_t> numRealTimeAllocations { 0 }, numRealTimeBytes { 0 };
+}
+
+//==============================================================================
+struct NodeArena::Block
+{
+    Block* previous = nullptr;
+    size_t size = 0, used = 0;
+
+    static constexpr size_t dataOffset = (sizeof (Block*) + 2 * sizeof (size_t) + allocation_detail::headerSize - 1)
+                                            & ~(allocation_detail::headerSize - 1);
+
+    std::byte* getData() noexcept       { return reinterpret_cast<std::byte*> (this) + dataOffset; }
+};
+
+NodeArena::Ptr::Ptr (NodeArena* a) noexcept
+    : arena (a)
+{
+    if (arena != nullptr)
+    {
+        arena->numPtrs.fetch_add (1, std::memory_order_relaxed);
+        arena->incReferenceCount();
+    }
+}
+
+NodeArena::Ptr::Ptr (const Ptr& other) noexcept
+    : Ptr (other.arena)
+{
+}
+
+NodeArena::Ptr::Ptr (Ptr&& other) noexcept
+    : arena (std::exchange (other.arena, nullptr))
+{
+}
+
+NodeArena::Ptr& NodeArena::Ptr::operator= (Ptr other) noexcept
+{
+    std::swap (arena, other.arena);
+    return *this;
+}
+
+NodeArena::Ptr::~Ptr()
+{
+    if (arena != nullptr)
+    {
+        arena->numPtrs.fetch_sub (1, std::memory_order_relaxed);
+        arena->decReferenceCount();
+    }
+}
+
+NodeArena::Ptr NodeArena::create (size_t blockSize)
+{
+    return Ptr (new NodeArena (blockSize));
+}
+
+NodeArena::NodeArena (size_t size)
+    : blockSize (std::max (size, (size_t) 1024))
+{
+}
+
+NodeArena::~NodeArena()
+{
+    rpallocator<std::byte> allocator;
+
+    while (currentBlock != nullptr)
+    {
+        auto block = currentBlock;
+        currentBlock = block->previous;
+        allocator.deallocate (reinterpret_cast<std::byte*> (block), block->size);
+    }
+}
+
+size_t NodeArena::getNumLiveAllocations() const noexcept
+{
+    return refCount.load (std::memory_order_relaxed) - numPtrs.load (std::memory_order_relaxed);
+}
+
+void* NodeArena::allocate (size_t numBytes)
+{
+    using namespace allocation_detail;
+    numBytes = (numBytes + headerSize - 1) & ~(headerSize - 1);
+
+    if (currentBlock == nullptr || currentBlock->used + numBytes > currentBlock->size - Block::dataOffset)
+    {
+        const auto size = std::max (blockSize, numBytes + Block::dataOffset);
+        auto block = new (rpallocator<std::byte>().allocate (size)) Block();
+        block->previous = currentBlock;
+        block->size = size;
+        currentBlock = block;
+        ++numBlocks;
+    }
+
+    auto result = currentBlock->getData() + currentBlock->used;
+    currentBlock->used += numBytes;
+    numBytesAllocated.fetch_add (numBytes, std::memory_order_relaxed);
+    return result;
+}
+
+void NodeArena::incReferenceCount() noexcept
+{
+    refCount.fetch_add (1, std::memory_order_relaxed);
+}
+
+void NodeArena::decReferenceCount() noexcept
+{
+    if (refCount.fetch_sub (1, std::memory_order_acq_rel) == 1)
+        delete this;
+}
+
+void* NodeArena::allocateNode (size_t numBytes)
+{
+    using namespace allocation_detail;
+    allocation::recordAllocation (numBytes);
+
+    std::byte* memory = nullptr;
+
+    if (auto arena = currentArena)
+    {
+        memory = static_cast<std::byte*> (arena->allocate (numBytes + headerSize));
+        arena->incReferenceCount();
+    }
+    else
+    {
+        // N.B. This uses malloc so it isn't counted again if the global operator new is being counted
+        memory = static_cast<std::byte*> (std::malloc (numBytes + headerSize));
+
+        if (memory == nullptr)
+            throw std::bad_alloc();
+    }
+
+    *reinterpret_cast<NodeArena**> (memory) = currentArena;
+    return memory + headerSize;
+}
+
+void NodeArena::deallocateNode (void* p) noexcept
+{
+    using namespace allocation_detail;
+
+    if (p == nullptr)
+        return;
+
+    auto memory = static_cast<std::byte*> (p) - headerSize;
+
+    if (auto arena = *reinterpret_cast<NodeArena**> (memory))
+        arena->decReferenceCount();
+    else
+        std::free (memory);
+}
+
+//==============================================================================
+ScopedNodeArena::ScopedNodeArena (NodeArena::Ptr a)
+    : arena (std::move (a)),
+      previous (std::exchange (allocation_detail::currentArena, arena.get()))
+{
+}
+
+ScopedNodeArena::~ScopedNodeArena()
+{
+    allocation_detail::currentArena = previous;
+}
+
+NodeArena* ScopedNodeArena::getCurrent() noexcept
+{
+    return allocation_detail::currentArena;
+}
+
+//==============================================================================
+//==============================================================================
+void* Node::operator new (size_t numBytes)
+{
+    return NodeArena::allocateNode (numBytes);
+}
+
+void* Node::operator new (size_t numBytes, std::align_val_t alignment)
+{
+    allocation::recordAllocation (numBytes);
+    return ::operator new (numBytes, alignment);
+}
+
+void Node::operator delete (void* p) noexcept
+{
+    NodeArena::deallocateNode (p);
+}
+
+void Node::operator delete (void* p, std::align_val_t alignment) noexcept
+{
+    ::operator delete (p, alignment);
+}
+
+//==============================================================================
+//==============================================================================
+namespace allocation
+{
+    void markCurrentThreadAsRealTime()
+    {
+        allocation_detail::isRealTimeThread = true;
+    }
+
+    bool isCurrentThreadRealTime() noexcept
+    {
+        return allocation_detail::isRealTimeThread;
+    }
+
+    void recordAllocation (size_t numBytes) noexcept
+    {
+        using namespace allocation_detail;
+
+        if (! isRealTimeThread)
+            return;
+
+        numRealTimeAllocations.fetch_add (1, std::memory_order_relaxed);
+        numRealTimeBytes.fetch_add (numBytes, std::memory_order_relaxed);
+    }
+
+    RealTimeAllocationCounters getRealTimeAllocationCounters() noexcept
+    {
+        return { allocation_detail::numRealTimeAllocations.load (std::memory_order_relaxed),
+                 allocation_detail::numRealTimeBytes.load (std::memory_order_relaxed) };
+    }
+
+    void resetRealTimeAllocationCounters() noexcept
+    {
+        allocation_detail::numRealTimeAllocations = 0;
+        allocation_detail::numRealTimeBytes = 0;
+    }
+}
+
+}} // namespace tracktion_graph
+
+
+//==============================================================================
+//==============================================================================
+#if TRACKTION_COUNT_REALTIME_ALLOCATIONS
+
+// All the replaceable forms are counted so allocations can't bypass the counters
+// by being over-aligned or non-throwing
+namespace tracktion { inline namespace graph { namespace allocation_detail
+{
+    inline void* countedMalloc (std::size_t numBytes) noexcept
+    {
+        allocation::recordAllocation (numBytes);
+        return std::malloc (numBytes == 0 ? 1 : numBytes);
+    }
+
+    inline void* countedAlignedMalloc (std::size_t numBytes, std::align_val_t alignment) noexcept
+    {
+        allocation::recordAllocation (numBytes);
+        const auto align = std::max ((std::size_t) alignment, sizeof (void*));
+
+       #if JUCE_WINDOWS
+        return _aligned_malloc (numBytes == 0 ? 1 : numBytes, align);
+       #else
+        void* p = nullptr;
+        return posix_memalign (&p, align, numBytes == 0 ? 1 : numBytes) == 0 ? p : nullptr;
+       #endif
+    }
+
+    inline void alignedFree (void* p) noexcept
+    {
+       #if JUCE_WINDOWS
+        _aligned_free (p);
+       #else
+        std::free (p);
+       #endif
+    }
+}}}
+
+void* operator new (std::size_t numBytes)
+{
+    if (auto p = tracktion::graph::allocation_detail::countedMalloc (numBytes))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t numBytes)
+{
+    return operator new (numBytes);
+}
+
+void* operator new (std::size_t numBytes, const std::nothrow_t&) noexcept
+{
+    return tracktion::graph::allocation_detail::countedMalloc (numBytes);
+}
+
+void* operator new[] (std::size_t numBytes, const std::nothrow_t&) noexcept
+{
+    return tracktion::graph::allocation_detail::countedMalloc (numBytes);
+}
+
+void* operator new (std::size_t numBytes, std::align_val_t alignment)
+{
+    if (auto p = tracktion::graph::allocation_detail::countedAlignedMalloc (numBytes, alignment))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t numBytes, std::align_val_t alignment)
+{
+    return operator new (numBytes, alignment);
+}
+
+void* operator new (std::size_t numBytes, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return tracktion::graph::allocation_detail::countedAlignedMalloc (numBytes, alignment);
+}
+
+void* operator new[] (std::size_t numBytes, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return tracktion::graph::allocation_detail::countedAlignedMalloc (numBytes, alignment);
+}
+
+void operator delete (void* p) noexcept                                                     { std::free (p); }
+void operator delete[] (void* p) noexcept                                                   { std::free (p); }
+void operator delete (void* p, std::size_t) noexcept                                        { std::free (p); }
+void operator delete[] (void* p, std::size_t) noexcept                                      { std::free (p); }
+void operator delete (void* p, const std::nothrow_t&) noexcept                              { std::free (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept                            { std::free (p); }
+
+void operator delete (void* p, std::align_val_t) noexcept                                   { tracktion::graph::allocation_detail::alignedFree (p); }
+void operator delete[] (void* p, std::align_val_t) noexcept                                 { tracktion::graph::allocation_detail::alignedFree (p); }
+void operator delete (void* p, std::size_t, std::align_val_t) noexcept                      { tracktion::graph::allocation_detail::alignedFree (p); }
+void operator delete[] (void* p, std::size_t, std::align_val_t) noexcept                    { tracktion::graph::allocation_detail::alignedFree (p); }
+void operator delete (void* p, std::align_val_t, const std::nothrow_t&) noexcept            { tracktion::graph::allocation_detail::alignedFree (p); }
+void operator delete[] (void* p, std::align_val_t, const std::nothrow_t&) noexcept          { tracktion::graph::allocation_detail::alignedFree (p); }
+
+#endif
@@ -0,0 +1,148 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#pragma once
+
+namespace tracktion { inline namespace graph
+{
+
+//==============================================================================
+/**
+    Memory that all the Nodes of a graph can be allocated from in one go.
+
+    While a ScopedNodeArena is active on a thread, every Node created on that
+    thread is allocated from its arena by bumping a pointer into large blocks
+    taken from rpmalloc, rather than one call to the global allocator per Node.
+    Deleting one of these Nodes doesn't free anything, the blocks are freed
+    together once the last Node and the last Ptr to the arena have gone, which
+    is usually when the graph is replaced.
+
+    Nodes that outlive their graph (e.g. by being moved to a new one) keep the
+    arena alive so this is always safe.
+*/
+class NodeArena
+{
+public:
+    //==============================================================================
+    /** A reference counted pointer to an arena. */
+    class Ptr
+    {
+    public:
+        Ptr() = default;
+        Ptr (NodeArena*) noexcept;
+        Ptr (const Ptr&) noexcept;
+        Ptr (Ptr&&) noexcept;
+        Ptr& operator= (Ptr) noexcept;
+        ~Ptr();
+
+        NodeArena* get() const noexcept                 { return arena; }
+        NodeArena* operator->() const noexcept          { return arena; }
+        explicit operator bool() const noexcept         { return arena != nullptr; }
+
+    private:
+        NodeArena* arena = nullptr;
+    };
+
+    /** Creates an arena that allocates blocks of at least the given size. */
+    static Ptr create (size_t blockSize = 64 * 1024);
+
+    //==============================================================================
+    /** Returns the number of bytes that have been handed out. */
+    size_t getNumBytesAllocated() const noexcept        { return numBytesAllocated.load (std::memory_order_relaxed); }
+
+    /** Returns the number of Nodes allocated from this arena that haven't been deleted. */
+    size_t getNumLiveAllocations() const noexcept;
+
+    /** Returns the number of blocks taken from rpmalloc. */
+    size_t getNumBlocks() const noexcept                { return numBlocks; }
+
+    //==============================================================================
+    /** @internal */
+    static void* allocateNode (size_t);
+    /** @internal */
+    static void deallocateNode (void*) noexcept;
+
+private:
+    //==============================================================================
+    struct Block;
+
+    NodeArena (size_t blockSize);
+    ~NodeArena();
+
+    const size_t blockSize;
+    Block* currentBlock = nullptr;
+    size_t numBlocks = 0;
+    std::atomic<size_t> numBytesAllocated { 0 }, refCount { 0 }, numPtrs { 0 };
+
+    void* allocate (size_t);
+    void incReferenceCount() noexcept;
+    void decReferenceCount() noexcept;
+};
+
+//==============================================================================
+/**
+    Makes all the Nodes created on this thread come from an arena whilst it's in scope.
+    These can be nested, the previous arena is restored when this is deleted.
+    An arena isn't thread-safe so must only be current on one thread at a time.
+*/
+class ScopedNodeArena
+{
+public:
+    /** Makes the given arena the current one for this thread.
+        If it's nullptr, Nodes will use the global allocator.
+    */
+    ScopedNodeArena (NodeArena::Ptr);
+
+    /** Restores the previous arena. */
+    ~ScopedNodeArena();
+
+    /** Returns the arena being used by the current thread, if there is one. */
+    static NodeArena* getCurrent() noexcept;
+
+private:
+    NodeArena::Ptr arena;
+    NodeArena* previous = nullptr;
+};
+
+//==============================================================================
+//==============================================================================
+namespace allocation
+{
+    /** Counts of the allocations made on threads marked as real-time. */
+    struct RealTimeAllocationCounters
+    {
+        uint64_t numAllocations = 0;    ///< The number of allocations
+        uint64_t numBytes = 0;          ///< The total size of the allocations
+    };
+
+    /** Marks the calling thread as a real-time thread, i.e. an audio device or
+        graph worker thread. Allocations made on it will then be counted.
+    */
+    void markCurrentThreadAsRealTime();
+
+    /** Returns true if the calling thread has been marked as a real-time thread. */
+    bool isCurrentThreadRealTime() noexcept;
+
+    /** Records an allocation. If the calling thread is a real-time thread, this
+        is added to the counters.
+        The engine calls this for Nodes and pooled buffers. If the module is
+        compiled with TRACKTION_COUNT_REALTIME_ALLOCATIONS=1, every use of the
+        global operator new is recorded too.
+    */
+    void recordAllocation (size_t numBytes) noexcept;
+
+    /** Returns the allocations that have been made on real-time threads. */
+    RealTimeAllocationCounters getRealTimeAllocationCounters() noexcept;
+
+    /** Resets the real-time allocation counters. */
+    void resetRealTimeAllocationCounters() noexcept;
+}
+
+}} // namespace tracktion_graph
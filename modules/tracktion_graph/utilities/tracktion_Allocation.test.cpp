@@ -26,6 +26,7 @@ public:
     void runTest() override
     {
         runRPMallocTests();
+        runNodeArenaTests();
     }
 
 private:
@@ -218,6 +219,61 @@ private:
             expect (true);
         }
     }
+
+    void runNodeArenaTests()
+    {
+        beginTest ("NodeArena");
+        {
+            auto arena = NodeArena::create (1024);
+            std::unique_ptr<Node> root;
+
+            {
+                const ScopedNodeArena scopedArena (arena);
+                expect (ScopedNodeArena::getCurrent() == arena.get());
+
+                std::vector<std::unique_ptr<Node>> inputs;
+
+                for (int i = 0; i < 100; ++i)
+                    inputs.push_back (makeNode<test_utilities::SilentNode> (2));
+
+                root = makeNode<test_utilities::BasicSummingNode> (std::move (inputs));
+            }
+
+            expect (ScopedNodeArena::getCurrent() == nullptr);
+            expectEquals (arena->getNumLiveAllocations(), (size_t) 101);
+            expect (arena->getNumBlocks() > 1);
+            expect (arena->getNumBytesAllocated() >= 101 * sizeof (test_utilities::SilentNode));
+
+            // Nodes created outside the scope use the global allocator
+            auto globalNode = makeNode<test_utilities::SilentNode> (2);
+            expectEquals (arena->getNumLiveAllocations(), (size_t) 101);
+            globalNode.reset();
+
+            // The Nodes keep the arena alive once the last Ptr has gone
+            auto* rawArena = arena.get();
+            arena = {};
+            expectEquals (rawArena->getNumLiveAllocations(), (size_t) 101);
+            root.reset();
+        }
+
+        beginTest ("Real-time allocation counters");
+        {
+            allocation::resetRealTimeAllocationCounters();
+            expect (! allocation::isCurrentThreadRealTime());
+
+            std::thread ([]
+                         {
+                             allocation::markCurrentThreadAsRealTime();
+                             auto node = makeNode<test_utilities::SilentNode> (2);
+
+                             allocation::recordAllocation (256);
+                         }).join();
+
+            const auto counters = allocation::getRealTimeAllocationCounters();
+            expect (counters.numAllocations >= 2);
+            expect (counters.numBytes >= sizeof (test_utilities::SilentNode) + 256);
+        }
+    }
 };
 
 static AllocationTests allocationTests;
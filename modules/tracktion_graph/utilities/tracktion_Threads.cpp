@@ -12,6 +12,11 @@
 
 #ifdef _WIN32
  #include <windows.h>
+ #include <mmsystem.h>
+
+ #ifdef _MSC_VER
+  #pragma comment (lib, "winmm.lib")
+ #endif
 #endif
 
 namespace tracktion { inline namespace graph
@@ -32,9 +37,14 @@ namespace tracktion { inline namespace graph
 
         return SetThreadPriority (handle, pri) != FALSE;
     }
+
+    bool setThreadPriority (void* handle, int priority, const ThreadSchedulingOptions&)
+    {
+        return setThreadPriority (handle, priority);
+    }
 #else
     template<typename HandleType>
-    bool setThreadPriority (HandleType handle, int priority)
+    bool setThreadPriority (HandleType handle, int priority, const ThreadSchedulingOptions& options)
     {
         assert (handle != HandleType());
 
@@ -45,14 +55,54 @@ namespace tracktion { inline namespace graph
         if (pthread_getschedparam ((pthread_t) handle, &policy, &param) != 0)
             return false;
 
-        policy = priority == 0 ? SCHED_OTHER : SCHED_RR;
+        if (priority == 0)
+            policy = SCHED_OTHER;
+        else
+            policy = options.policy == ThreadSchedulingOptions::Policy::fifo ? SCHED_FIFO : SCHED_RR;
 
         const int minPriority = sched_get_priority_min (policy);
         const int maxPriority = sched_get_priority_max (policy);
 
-        param.sched_priority = ((maxPriority - minPriority) * priority) / 10 + minPriority;
+        if (policy != SCHED_OTHER && options.nativePriority)
+            param.sched_priority = std::max (minPriority, std::min (maxPriority, *options.nativePriority));
+        else
+            param.sched_priority = ((maxPriority - minPriority) * priority) / 10 + minPriority;
+
         return pthread_setschedparam ((pthread_t) handle, policy, &param) == 0;
     }
+
+    template<typename HandleType>
+    bool setThreadPriority (HandleType handle, int priority)
+    {
+        return setThreadPriority (handle, priority, ThreadSchedulingOptions());
+    }
+#endif
+
+#if JUCE_LINUX
+    bool setThreadAffinity (pthread_t handle, const std::vector<int>& cores)
+    {
+        if (cores.empty())
+            return false;
+
+        cpu_set_t cpuSet;
+        CPU_ZERO (&cpuSet);
+
+        for (auto core : cores)
+        {
+            if (core < 0 || core >= CPU_SETSIZE)
+                return false;
+
+            CPU_SET (core, &cpuSet);
+        }
+
+        return pthread_setaffinity_np (handle, sizeof (cpuSet), &cpuSet) == 0;
+    }
+#else
+    template<typename HandleType>
+    bool setThreadAffinity (HandleType, const std::vector<int>&)
+    {
+        return false;
+    }
 #endif
 
 #if JUCE_MAC
@@ -119,4 +169,113 @@ bool setThreadPriority (std::thread& t, int priority)
     return setThreadPriority (t.native_handle(), priority);
 }
 
+bool setThreadPriority (std::thread& t, int priority, const ThreadSchedulingOptions& options)
+{
+    return setThreadPriority (t.native_handle(), priority, options);
+}
+
+bool setThreadAffinity (std::thread& t, const std::vector<int>& cores)
+{
+    return setThreadAffinity (t.native_handle(), cores);
+}
+
+bool setCurrentThreadAffinity (const std::vector<int>& cores)
+{
+   #if JUCE_LINUX
+    return setThreadAffinity (pthread_self(), cores);
+   #else
+    juce::ignoreUnused (cores);
+    return false;
+   #endif
+}
+
+bool applyWorkerThreadSchedulingOptions (std::thread& t, size_t workerIndex, const ThreadSchedulingOptions& options)
+{
+    bool succeeded = true;
+
+    auto reportFailure = [&] (const std::string& message)
+    {
+        succeeded = false;
+
+        if (options.onFailure)
+            options.onFailure (message);
+    };
+
+    // Workers are always given a high priority but failing to get it is only
+    // reported if a real-time policy or priority was explicitly asked for
+    const bool realTimeRequested = options.policy == ThreadSchedulingOptions::Policy::fifo
+                                    || options.nativePriority.has_value();
+
+    if (! setThreadPriority (t, 10, options) && realTimeRequested)
+        reportFailure ("Unable to set real-time priority for graph worker thread " + std::to_string (workerIndex));
+
+    if (! options.workerThreadCores.empty())
+    {
+        const auto core = options.workerThreadCores[workerIndex % options.workerThreadCores.size()];
+
+        if (! setThreadAffinity (t, { core }))
+            reportFailure ("Unable to pin graph worker thread " + std::to_string (workerIndex) + " to core " + std::to_string (core));
+    }
+
+    return succeeded;
+}
+
+bool applyAudioThreadSchedulingOptions (const ThreadSchedulingOptions& options)
+{
+    bool succeeded = true;
+
+   #if JUCE_LINUX
+    if (options.policy == ThreadSchedulingOptions::Policy::fifo || options.nativePriority)
+        succeeded = setThreadPriority (pthread_self(), 10, options);
+   #endif
+
+    if (! options.audioThreadCores.empty())
+        succeeded = setCurrentThreadAffinity (options.audioThreadCores) && succeeded;
+
+    return succeeded;
+}
+
+//==============================================================================
+void DeadlineEvent::signal()
+{
+    // Only the first signal since the last wake posts so the count never goes above one
+    if (! signalled.exchange (true))
+        semaphore.signal();
+}
+
+bool DeadlineEvent::waitUntil (Clock::time_point deadline)
+{
+    for (;;)
+    {
+        const auto now = Clock::now();
+        const auto remaining = now < deadline ? std::chrono::ceil<std::chrono::microseconds> (deadline - now)
+                                              : std::chrono::microseconds (0);
+
+        if (semaphore.timed_wait ((std::uint64_t) remaining.count()))
+        {
+            signalled = false;
+            return true;
+        }
+
+        if (Clock::now() >= deadline)
+            return false;
+    }
+}
+
+//==============================================================================
+ScopedHighResolutionTimerPeriod::ScopedHighResolutionTimerPeriod()
+{
+   #ifdef _WIN32
+    active = timeBeginPeriod (1) == TIMERR_NOERROR;
+   #endif
+}
+
+ScopedHighResolutionTimerPeriod::~ScopedHighResolutionTimerPeriod()
+{
+   #ifdef _WIN32
+    if (active)
+        timeEndPeriod (1);
+   #endif
+}
+
 }} // namespace tracktion_engine
@@ -13,6 +13,48 @@
 namespace tracktion { inline namespace graph
 {
 
+//==============================================================================
+/**
+    Options controlling how real-time threads are scheduled and which CPU cores
+    they run on. This is useful on dedicated machines where cores have been isolated
+    from the OS scheduler (e.g. with isolcpus/nohz_full).
+
+    The policy and native priority are applied to worker threads on Linux and macOS
+    but only to the audio thread on Linux. Core affinity is only supported on Linux
+    and none of the options are used on Windows.
+*/
+struct ThreadSchedulingOptions
+{
+    /** The scheduling policy to use for real-time threads. */
+    enum class Policy
+    {
+        roundRobin,     /**< SCHED_RR, the default. */
+        fifo            /**< SCHED_FIFO, threads run until they block or yield. */
+    };
+
+    Policy policy = Policy::roundRobin;
+
+    /** If set, this native priority (e.g. 1-99 on Linux) is used for real-time threads
+        instead of one mapped from the 0-10 priority range.
+    */
+    std::optional<int> nativePriority;
+
+    /** CPU cores the audio thread should be pinned to. If empty, its affinity isn't changed. */
+    std::vector<int> audioThreadCores;
+
+    /** CPU cores the worker threads should be pinned to.
+        Worker n is pinned to the single core workerThreadCores[n % size] so workers
+        don't migrate between cores. If empty, their affinity isn't changed.
+    */
+    std::vector<int> workerThreadCores;
+
+    /** Called with a description if any of the options couldn't be applied to a worker thread.
+        Only options that have been changed from their defaults are reported.
+        This is called on the thread creating the workers.
+    */
+    std::function<void (const std::string&)> onFailure;
+};
+
 /** Changes the thread's priority.
 
     May return false if for some reason the priority can't be changed.
@@ -22,7 +64,91 @@ namespace tracktion { inline namespace graph
 */
 bool setThreadPriority (std::thread&, int priority);
 
+/** Changes the thread's priority using the policy and native priority in a set of ThreadSchedulingOptions.
+    @see setThreadPriority
+*/
+bool setThreadPriority (std::thread&, int priority, const ThreadSchedulingOptions&);
+
+/** Pins a thread to a set of CPU cores.
+    Returns false if the affinity couldn't be set or isn't supported on this platform.
+*/
+bool setThreadAffinity (std::thread&, const std::vector<int>& cores);
+
+/** Pins the calling thread to a set of CPU cores.
+    Returns false if the affinity couldn't be set or isn't supported on this platform.
+*/
+bool setCurrentThreadAffinity (const std::vector<int>& cores);
+
+/** Sets the priority and affinity of a newly created worker thread, calling
+    ThreadSchedulingOptions::onFailure for any requested option that couldn't be applied.
+    The thread is always given a high priority but failing to get one is only reported
+    if a fifo policy or native priority was requested.
+    Returns true if all the requested options were applied successfully.
+*/
+bool applyWorkerThreadSchedulingOptions (std::thread&, size_t workerIndex, const ThreadSchedulingOptions&);
+
+/** Sets the real-time policy, priority and affinity of the calling audio thread.
+    This doesn't call ThreadSchedulingOptions::onFailure as it's intended to be
+    called from the audio callback, check the return value instead.
+*/
+bool applyAudioThreadSchedulingOptions (const ThreadSchedulingOptions&);
+
 /** Tries to upgrade the current thread to realtime priority. */
 bool tryToUpgradeCurrentThreadToRealtime (const juce::Thread::RealtimeOptions&);
 
+//==============================================================================
+/**
+    An event a thread can wait on until it's signalled or an absolute deadline passes.
+
+    Waiting until a time point rather than for a duration means any time spent between
+    working out the deadline and starting to wait doesn't make the wake-up late.
+
+    Signalling doesn't take a lock so it can be called from the audio thread.
+    Signals made whilst a woken thread is returning from waitUntil are merged in to
+    the one that woke it.
+*/
+class DeadlineEvent
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    DeadlineEvent() = default;
+
+    /** Wakes a thread waiting in waitUntil, or stops the next call to it blocking.
+        This is lock-free so is safe to call from a real-time thread.
+    */
+    void signal();
+
+    /** Blocks until the event is signalled or the deadline has passed.
+        Returns true if the event was signalled, in which case it's reset.
+    */
+    bool waitUntil (Clock::time_point deadline);
+
+private:
+    LightweightSemaphore semaphore;
+    std::atomic<bool> signalled { false };
+
+    DeadlineEvent (const DeadlineEvent&) = delete;
+    DeadlineEvent& operator= (const DeadlineEvent&) = delete;
+};
+
+//==============================================================================
+/**
+    Raises the resolution of the OS timer while in scope so sleeps and timed waits
+    on the calling process wake closer to their deadlines.
+    This only has an effect on Windows, where the default resolution is around 15ms.
+*/
+class ScopedHighResolutionTimerPeriod
+{
+public:
+    ScopedHighResolutionTimerPeriod();
+    ~ScopedHighResolutionTimerPeriod();
+
+private:
+    [[maybe_unused]] bool active = false;
+
+    ScopedHighResolutionTimerPeriod (const ScopedHighResolutionTimerPeriod&) = delete;
+    ScopedHighResolutionTimerPeriod& operator= (const ScopedHighResolutionTimerPeriod&) = delete;
+};
+
 }} // namespace tracktion_engine
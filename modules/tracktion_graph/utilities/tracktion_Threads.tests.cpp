@@ -0,0 +1,139 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion { inline namespace graph
+{
+
+#if GRAPH_UNIT_TESTS_THREADS
+
+class ThreadsTests  : public juce::UnitTest
+{
+public:
+    ThreadsTests()
+        : juce::UnitTest ("Threads", "tracktion_graph") {}
+
+    //==============================================================================
+    void runTest() override
+    {
+        beginTest ("Default options don't report failures");
+        {
+            std::vector<std::string> failures;
+            auto options = createOptions (failures);
+
+            expect (applyToWorker (0, options));
+            expect (failures.empty());
+        }
+
+        beginTest ("Requested core pinning failures are reported");
+        {
+            std::vector<std::string> failures;
+            auto options = createOptions (failures);
+            options.workerThreadCores = { -1 };
+
+            expect (! applyToWorker (3, options));
+            expectEquals ((int) failures.size(), 1);
+
+            if (! failures.empty())
+                expect (juce::String (failures.front()).contains ("core -1"));
+        }
+
+        beginTest ("Requested real-time priority failures are reported");
+        {
+            std::vector<std::string> failures;
+            auto options = createOptions (failures);
+            options.policy = ThreadSchedulingOptions::Policy::fifo;
+            options.nativePriority = 99;
+
+            // This may or may not succeed depending on the process' privileges
+            // but a failure should only be reported when it doesn't
+            const bool succeeded = applyToWorker (1, options);
+            expectEquals ((int) failures.size(), succeeded ? 0 : 1);
+        }
+
+        runDeadlineEventTests();
+    }
+
+private:
+    void runDeadlineEventTests()
+    {
+        using Clock = DeadlineEvent::Clock;
+
+        beginTest ("DeadlineEvent times out without a signal");
+        {
+            DeadlineEvent event;
+
+            expect (! event.waitUntil (Clock::now() - std::chrono::seconds (1)));
+            expect (! event.waitUntil (Clock::now()));
+            expect (! event.waitUntil (Clock::now() + std::chrono::milliseconds (1)));
+        }
+
+        beginTest ("DeadlineEvent signals are consumed by a single wait");
+        {
+            DeadlineEvent event;
+
+            // Signals before a wait stop it blocking, even if its deadline has passed
+            event.signal();
+            expect (event.waitUntil (Clock::now() - std::chrono::seconds (1)));
+            expect (! event.waitUntil (Clock::now()));
+
+            // Repeated signals are merged in to one
+            event.signal();
+            event.signal();
+            event.signal();
+            expect (event.waitUntil (Clock::now() + std::chrono::seconds (10)));
+            expect (! event.waitUntil (Clock::now()));
+        }
+
+        beginTest ("DeadlineEvent wakes when signalled from another thread");
+        {
+            DeadlineEvent event;
+            Semaphore started;
+            std::atomic<bool> woken { false };
+
+            std::thread waiter ([&]
+                                {
+                                    started.signal();
+                                    woken = event.waitUntil (Clock::now() + std::chrono::hours (1));
+                                });
+
+            started.wait();
+            event.signal();
+            waiter.join();
+
+            expect (woken.load());
+            expect (! event.waitUntil (Clock::now()));
+        }
+    }
+
+    static ThreadSchedulingOptions createOptions (std::vector<std::string>& failures)
+    {
+        ThreadSchedulingOptions options;
+        options.onFailure = [&failures] (const std::string& message) { failures.push_back (message); };
+        return options;
+    }
+
+    static bool applyToWorker (size_t workerIndex, const ThreadSchedulingOptions& options)
+    {
+        Semaphore finish;
+        std::thread worker ([&finish] { finish.wait(); });
+
+        const bool succeeded = applyWorkerThreadSchedulingOptions (worker, workerIndex, options);
+        finish.signal();
+        worker.join();
+
+        return succeeded;
+    }
+};
+
+static ThreadsTests threadsTests;
+
+#endif
+
+}} // namespace tracktion { inline namespace graph